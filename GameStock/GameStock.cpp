@@ -23,6 +23,13 @@ int main()
 		return 0;
 	}
 
+	// Only older databases are compacted, and only the once
+	if (obj_database_manager.get_size_before_compaction() > 0) {
+		std::cout << "Purchase history compacted from " << obj_database_manager.get_size_before_compaction() / 1024 << "KB to "
+			<< obj_database_manager.get_size_after_compaction() / 1024 << "KB.\n";
+		util::pause();
+	}
+
 	obj_database_manager.insert_initial();
 	if (obj_database_manager.get_return_code() != SQLITE_OK && obj_database_manager.get_return_code() != SQLITE_ROW) {
 		std::cout << "Error: " << sqlite3_errmsg(obj_database_manager.get_database());
@@ -33,6 +40,24 @@ int main()
 	GameManager obj_game_manager = GameManager(obj_database_manager.get_database());
 	PurchaseManager obj_purchase_manager = PurchaseManager(obj_database_manager.get_database());
 
+	std::shared_ptr<CheckoutPipeline> ptr_checkout_pipeline;
+	sqlite3* db_checkout = NULL;
+
+	// Baskets are saved between sessions through the journal, purchases are committed through the checkout pipeline on its own connection,
+	// and purchases made are appended to the sales store and co-purchase index
+	try {
+		db_checkout = obj_database_manager.open_connection();
+		ptr_checkout_pipeline = std::make_shared<CheckoutPipeline>(db_checkout);
+		obj_game_manager.set_checkout_pipeline(ptr_checkout_pipeline);
+		obj_game_manager.set_basket_journal(std::make_shared<BasketJournal>(obj_database_manager.get_database(), std::filesystem::path(L"database") / L"baskets.journal"));
+		obj_game_manager.set_sales_store(obj_purchase_manager.get_sales_store());
+		obj_game_manager.set_co_purchase_index(obj_purchase_manager.get_co_purchase_index());
+	}
+	catch (std::exception& ex) {
+		std::cout << "Error: " << ex.what();
+		return 0;
+	}
+
 	ClassContainer class_container = { obj_database_manager, obj_user_manager, obj_game_manager, obj_purchase_manager };
 
 	MenuContainer objMenuContainer = MenuContainer("Welcome to GameStock.\nChoose one of the below options.\n(Esc to exit)\n");
@@ -45,4 +70,8 @@ int main()
 		system("cls");
 		objMenuContainer.execute();
 	}
+
+	// Commit anything still queued before the pipeline's connection is closed
+	ptr_checkout_pipeline->stop();
+	sqlite3_close(db_checkout);
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "AllUserReportBuilder.h"
+#include "DatabaseManager.h"
+
+AllUserReportBuilder::AllUserReportBuilder(sqlite3* db, size_t i_thread_count) {
+	const char* str_filename = sqlite3_db_filename(db, "main");
+
+	if (str_filename == NULL || str_filename[0] == '\0') {
+		throw std::invalid_argument("Reports can only be built from a database file.");
+	}
+
+	_db = db;
+	_str_database_path = str_filename;
+	_i_thread_count = i_thread_count;
+	_ll_last_purchase_id = 0;
+
+	if (_i_thread_count == 0) _i_thread_count = std::thread::hardware_concurrency();
+	if (_i_thread_count == 0) _i_thread_count = 1;
+}
+
+void AllUserReportBuilder::build(std::vector<User>& vec_users, std::ostream& os, ReportJob* ptr_job) {
+	// No point starting more workers than there are users
+	size_t i_partition_count = _i_thread_count < vec_users.size() ? _i_thread_count : vec_users.size();
+	std::vector<ReportPartition> vec_partitions(i_partition_count);
+	std::vector<std::thread> vec_threads;
+	sqlite3_stmt* stmt_last_purchase;
+
+	// Read on the provided connection, which when running as a job is within the job's snapshot. Ids are never reused, so this is the newest purchase
+	// even if it has since been archived
+	std::string str_last_purchase_sql = "SELECT COALESCE((SELECT seq FROM sqlite_sequence WHERE name = 'purchases'), 0)";
+
+	if (sqlite3_prepare_v2(_db, str_last_purchase_sql.c_str(), -1, &stmt_last_purchase, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	if (sqlite3_step(stmt_last_purchase) == SQLITE_ROW) {
+		_ll_last_purchase_id = sqlite3_column_int64(stmt_last_purchase, 0);
+	}
+
+	sqlite3_finalize(stmt_last_purchase);
+
+	os << "All user purchases summary\n";
+	os << "This summary shows each user and if they have made any purchases displays each purchase with a calculated total.\nSee the end of the report for a grand total/average\n";
+
+	// Blocks are consecutive, so writing the buffers out in partition order keeps the users in their original order
+	for (size_t i = 0; i < i_partition_count; i++) {
+		ReportPartition& obj_partition = vec_partitions[i];
+		obj_partition.i_first_user = i * vec_users.size() / i_partition_count;
+		obj_partition.i_end_user = (i + 1) * vec_users.size() / i_partition_count;
+		obj_partition.ss_buffer.imbue(os.getloc());
+
+		vec_threads.push_back(std::thread(&AllUserReportBuilder::build_partition, this, std::ref(vec_users), std::ref(obj_partition), ptr_job));
+	}
+
+	for (std::thread& thread : vec_threads) {
+		thread.join();
+	}
+
+	// Workers stop part way through when cancelled, so the sections would be incomplete
+	if (ptr_job != NULL && ptr_job->is_cancel_requested()) return;
+
+	Money obj_all_purchase_total;
+	bool bool_has_purchases = false;
+
+	for (ReportPartition& obj_partition : vec_partitions) {
+		if (obj_partition.ptr_error) std::rethrow_exception(obj_partition.ptr_error);
+
+		os << obj_partition.ss_buffer.rdbuf();
+		obj_all_purchase_total += obj_partition.obj_total;
+		bool_has_purchases = bool_has_purchases || obj_partition.bool_has_purchases;
+	}
+
+	// Sections written straight to the stream would have left it formatting money to 2 decimal places, the totals are written the same way
+	if (bool_has_purchases) {
+		os.precision(2);
+		os << std::fixed;
+	}
+
+	os << "\nAll purchases total: " << obj_all_purchase_total << "\n";
+	os << "All purchases average: " << obj_all_purchase_total.divide_by((std::int64_t)vec_users.size()) << "\n";
+
+	os << "\nNOTE: The above average assumes that for users who have made no purchases the total of their purchases is zero.\n";
+}
+
+void AllUserReportBuilder::build_partition(std::vector<User>& vec_users, ReportPartition& obj_partition, ReportJob* ptr_job) {
+	sqlite3* db = NULL;
+	sqlite3_stmt* stmt_fetch_purchases = NULL;
+
+	try {
+		if (sqlite3_open_v2(_str_database_path.c_str(), &db, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to open report connection: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		// Waits for a writer holding the database up (e.g. while a checkpoint is run) rather than failing straight away
+		sqlite3_busy_timeout(db, DatabaseManager::BUSY_TIMEOUT_MS);
+
+		// Every user is read within the one snapshot, rather than each statement taking and giving up its own
+		ReadSnapshot obj_snapshot(db);
+
+		// Each user's purchases are read through the purchases index, newest first, followed by any that have been archived
+		std::string str_fetch_purchases =
+			"SELECT id, total, datetime(date, 'unixepoch'), date FROM purchases WHERE user_id = ?1 AND id <= ?2 " \
+			"UNION ALL SELECT id, total, datetime(date, 'unixepoch'), date FROM purchases_archive WHERE user_id = ?1 AND id <= ?2 ORDER BY 4 DESC, 1";
+
+		if (sqlite3_prepare_v2(db, str_fetch_purchases.c_str(), -1, &stmt_fetch_purchases, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to prepare fetch statement: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		// Sections are collected by the formatter and written to the partition buffer in large blocks
+		RowFormatter obj_formatter(obj_partition.ss_buffer);
+
+		for (size_t i = obj_partition.i_first_user; i < obj_partition.i_end_user; i++) {
+			if (ptr_job != NULL && ptr_job->is_cancel_requested()) break;
+
+			User& obj_user = vec_users[i];
+			std::int64_t ll_section_start = obj_formatter.get_bytes_written();
+			UserPurchaseSummary obj_summary(obj_user.get_id());
+
+			sqlite3_bind_int(stmt_fetch_purchases, 1, obj_user.get_id());
+			sqlite3_bind_int64(stmt_fetch_purchases, 2, _ll_last_purchase_id);
+
+			int i_return_code;
+
+			while ((i_return_code = sqlite3_step(stmt_fetch_purchases)) == SQLITE_ROW) {
+				obj_summary.add_purchase(
+					Purchase(
+						sqlite3_column_int(stmt_fetch_purchases, 0),
+						Money(sqlite3_column_int64(stmt_fetch_purchases, 1)),
+						(char*)sqlite3_column_text(stmt_fetch_purchases, 2)));
+			}
+
+			// Anything other than reaching the end (e.g. still busy once the timeout ran out) fails the report, rather than showing the user as having no purchases
+			if (i_return_code != SQLITE_DONE) {
+				std::string str_error_msg = "Failed to read purchases for report: ";
+				str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+				throw std::runtime_error(str_error_msg);
+			}
+
+			sqlite3_reset(stmt_fetch_purchases);
+
+			write_user_section(obj_formatter, obj_user, obj_summary);
+			obj_partition.obj_total += obj_summary.get_total();
+			obj_partition.bool_has_purchases = obj_partition.bool_has_purchases || obj_summary.get_purchase_count() > 0;
+
+			if (ptr_job != NULL) ptr_job->add_progress(1, obj_formatter.get_bytes_written() - ll_section_start);
+		}
+
+		obj_formatter.flush();
+	}
+	catch (...) {
+		obj_partition.ptr_error = std::current_exception();
+	}
+
+	sqlite3_finalize(stmt_fetch_purchases);
+	sqlite3_close(db);
+}
+
+void AllUserReportBuilder::write_user_section(RowFormatter& obj_formatter, User& obj_user, UserPurchaseSummary& obj_summary) {
+	obj_formatter.end_row();
+	obj_formatter.text("Summary for user: ").text(obj_user.get_email()).end_row();
+	obj_formatter.end_row();
+	std::vector<Purchase>& vec_user_purchases = obj_summary.get_vec_purchases();
+
+	if (vec_user_purchases.size() > 0) {
+		obj_formatter.text("Purchases: ").end_row();
+		for (Purchase& purchase : vec_user_purchases) {
+			obj_formatter
+				.text("Date: ", 6)
+				.text(purchase.get_date(), 25)
+				.text("Total: ", 7)
+				.money(purchase.get_total(), 15)
+				.end_row();
+		}
+
+		obj_formatter
+			.text("\nUser purchases total: ", 23)
+			.money(obj_summary.get_total(), 15)
+			.text("User purchases average: ", 27)
+			.money(obj_summary.get_average(), 15)
+			.end_row();
+	}
+	else {
+		obj_formatter.text("This user has not yet made any purchases").end_row();
+	}
+	obj_formatter.text("__________________________________________________________________________________________").end_row();
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+#include <exception>
+#include "sqlite3.h"
+#include "User.h"
+#include "Purchase.h"
+#include "UserPurchaseSummary.h"
+#include "Money.h"
+#include "ReportJob.h"
+#include "RowFormatter.h"
+#include "ReadSnapshot.h"
+
+/// <summary>
+/// Class that writes the body of the all user purchases report using several worker threads. Users are split into one block per thread, each thread
+/// reads its users' purchases through its own read-only connection into its own buffer, and the buffers are then written out in the original user order.
+/// Each worker reads within a snapshot of its own, and only purchases up to the newest one when the report started are included, so every section is
+/// from the same point in time even though the workers' snapshots are not taken at exactly the same moment.
+/// </summary>
+class AllUserReportBuilder
+{
+	/// <summary>
+	/// A block of users handled by one worker, along with the report sections it has written for them
+	/// </summary>
+	struct ReportPartition {
+		size_t i_first_user = 0;
+		size_t i_end_user = 0;
+		std::stringstream ss_buffer;
+		Money obj_total;
+		bool bool_has_purchases = false;
+		std::exception_ptr ptr_error;
+	};
+
+	sqlite3* _db;
+	std::string _str_database_path;
+	size_t _i_thread_count;
+
+	// Highest purchase id when the report started, purchases made after it are left out
+	std::int64_t _ll_last_purchase_id;
+
+	/// <summary>
+	/// Worker for a single partition, opens a connection of its own and writes the section of each of its users to the partition buffer.
+	/// Errors are stored in the partition rather than thrown, so they can be rethrown once every worker has finished.
+	/// </summary>
+	/// <param name="vec_users"></param>
+	/// <param name="obj_partition"></param>
+	/// <param name="ptr_job">Job to report progress to and check for cancellation, may be NULL</param>
+	void build_partition(std::vector<User>& vec_users, ReportPartition& obj_partition, ReportJob* ptr_job);
+
+	/// <summary>
+	/// Writes a single user's section of the report
+	/// </summary>
+	/// <param name="obj_formatter"></param>
+	/// <param name="obj_user"></param>
+	/// <param name="obj_summary"></param>
+	void write_user_section(RowFormatter& obj_formatter, User& obj_user, UserPurchaseSummary& obj_summary);
+public:
+	/// <summary>
+	/// Workers open their own connections to the same database file as the provided connection, so it cannot be an in-memory database
+	/// </summary>
+	/// <param name="db"></param>
+	/// <param name="i_thread_count">Number of worker threads, 0 uses one per core</param>
+	AllUserReportBuilder(sqlite3* db, size_t i_thread_count = 0);
+
+	size_t get_thread_count() { return _i_thread_count; }
+
+	/// <summary>
+	/// Writes the summary of every provided user (in the order provided) followed by the totals. Output is the same whatever the number of threads.
+	/// When running as a background job, progress is counted in users and nothing more is written once the job is cancelled.
+	/// </summary>
+	/// <param name="vec_users"></param>
+	/// <param name="os">Stream to write to, the buffers are written using the same locale</param>
+	/// <param name="ptr_job">Job to report progress to and check for cancellation, may be NULL</param>
+	void build(std::vector<User>& vec_users, std::ostream& os, ReportJob* ptr_job = NULL);
+};
+
@@ -0,0 +1,92 @@
+#include "Basket.h"
+
+Basket::Basket() {
+	_i_user_id = 0;
+	_i_total_game_copies = 0;
+}
+
+Basket::Basket(int i_user_id) {
+	_i_user_id = i_user_id;
+	_i_total_game_copies = 0;
+}
+
+void Basket::apply_to_totals(PurchaseItem& obj_purchase_item, bool bool_subtract) {
+	if (bool_subtract) {
+		_obj_total -= obj_purchase_item.get_total();
+		_obj_total_before_vat -= obj_purchase_item.get_total_before_vat();
+		_i_total_game_copies -= obj_purchase_item.get_count();
+	}
+	else {
+		_obj_total += obj_purchase_item.get_total();
+		_obj_total_before_vat += obj_purchase_item.get_total_before_vat();
+		_i_total_game_copies += obj_purchase_item.get_count();
+	}
+}
+
+PurchaseItem* Basket::find_item(int i_game_id) {
+	auto position = _map_item_positions.find(i_game_id);
+
+	if (position == _map_item_positions.end()) return nullptr;
+
+	return &_vec_purchase_items[position->second];
+}
+
+void Basket::add_item(PurchaseItem obj_purchase_item) {
+	PurchaseItem* ptr_existing_item = find_item(obj_purchase_item.get_game_id());
+
+	// Combine with the existing item for the same game
+	if (ptr_existing_item != nullptr) {
+		set_item_count(obj_purchase_item.get_game_id(), ptr_existing_item->get_count() + obj_purchase_item.get_count());
+		return;
+	}
+
+	_map_item_positions[obj_purchase_item.get_game_id()] = _vec_purchase_items.size();
+	_vec_purchase_items.push_back(obj_purchase_item);
+	apply_to_totals(_vec_purchase_items.back(), false);
+}
+
+void Basket::set_item_count(int i_game_id, int i_count) {
+	PurchaseItem* ptr_item = find_item(i_game_id);
+
+	if (ptr_item == nullptr) {
+		throw std::invalid_argument("Cannot update game with id of " + std::to_string(i_game_id) + " in basket, item not found in basket.");
+	}
+
+	if (i_count < 1) {
+		remove_item(i_game_id);
+		return;
+	}
+
+	// Swap the item's old totals for the new ones
+	apply_to_totals(*ptr_item, true);
+	ptr_item->set_count(i_count);
+	apply_to_totals(*ptr_item, false);
+}
+
+void Basket::remove_item(int i_game_id) {
+	auto position = _map_item_positions.find(i_game_id);
+
+	if (position == _map_item_positions.end()) {
+		throw std::invalid_argument("Cannot remove game with id of " + std::to_string(i_game_id) + " from basket, item not found in basket.");
+	}
+
+	size_t i_index = position->second;
+	apply_to_totals(_vec_purchase_items[i_index], true);
+	_map_item_positions.erase(position);
+
+	// Move the last item into the removed item's place so nothing else has to shift
+	if (i_index != _vec_purchase_items.size() - 1) {
+		_vec_purchase_items[i_index] = _vec_purchase_items.back();
+		_map_item_positions[_vec_purchase_items[i_index].get_game_id()] = i_index;
+	}
+
+	_vec_purchase_items.pop_back();
+}
+
+void Basket::clear() {
+	_vec_purchase_items.clear();
+	_map_item_positions.clear();
+	_obj_total = Money();
+	_obj_total_before_vat = Money();
+	_i_total_game_copies = 0;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include "PurchaseItem.h"
+#include "Money.h"
+
+/// <summary>
+/// Class used to store the items a user intends to purchase. Items are indexed by game id and the totals are kept up to date
+/// as items are added/removed, so lookups, updates and totals do not depend on the number of items in the basket.
+/// </summary>
+class Basket
+{
+	int _i_user_id;
+	std::vector<PurchaseItem> _vec_purchase_items;
+	std::unordered_map<int, size_t> _map_item_positions;
+	Money _obj_total;
+	Money _obj_total_before_vat;
+	int _i_total_game_copies;
+
+	/// <summary>
+	/// Adds (or with bool_subtract, removes) an item's total, total before VAT and copies from the running totals
+	/// </summary>
+	/// <param name="obj_purchase_item"></param>
+	/// <param name="bool_subtract"></param>
+	void apply_to_totals(PurchaseItem& obj_purchase_item, bool bool_subtract);
+public:
+	Basket();
+	Basket(int i_user_id);
+
+	int get_user_id() { return _i_user_id; }
+	void set_user_id(int i_user_id) { _i_user_id = i_user_id; }
+
+	/// <summary>
+	/// Returns the items in the basket for display/persisting. Counts must be changed through add_item/set_item_count so that totals stay correct.
+	/// </summary>
+	/// <returns></returns>
+	std::vector<PurchaseItem>& get_vec_purchase_items() { return _vec_purchase_items; }
+
+	/// <summary>
+	/// Returns the basket item for the provided game id, or nullptr if the game is not in the basket
+	/// </summary>
+	/// <param name="i_game_id"></param>
+	/// <returns></returns>
+	PurchaseItem* find_item(int i_game_id);
+
+	/// <summary>
+	/// Adds a purchase item to the basket, if the game is already in the basket the counts are combined instead
+	/// </summary>
+	/// <param name="obj_purchase_item"></param>
+	void add_item(PurchaseItem obj_purchase_item);
+
+	/// <summary>
+	/// Sets the count of a game already in the basket, a count of less than 1 removes the game. Throws if the game is not in the basket.
+	/// </summary>
+	/// <param name="i_game_id"></param>
+	/// <param name="i_count"></param>
+	void set_item_count(int i_game_id, int i_count);
+
+	/// <summary>
+	/// Removes a game from the basket, throws if the game is not in the basket. Note the last item is moved into the removed item's place.
+	/// </summary>
+	/// <param name="i_game_id"></param>
+	void remove_item(int i_game_id);
+
+	/// <summary>
+	/// Empties the basket and resets the totals, user id is kept
+	/// </summary>
+	void clear();
+
+	Money get_total() { return _obj_total; }
+	Money get_total_before_vat() { return _obj_total_before_vat; }
+	int get_total_game_copies() { return _i_total_game_copies; }
+	int get_item_count() { return (int)_vec_purchase_items.size(); }
+	bool is_empty() { return _vec_purchase_items.empty(); }
+};
+
@@ -0,0 +1,171 @@
+#include "BasketJournal.h"
+
+BasketJournal::BasketJournal(sqlite3* db, std::filesystem::path journal_path, int i_compact_threshold) {
+	_db = db;
+	_journal_path = journal_path;
+	_i_compact_threshold = i_compact_threshold;
+	_i_records_since_compact = 0;
+
+	// Apply anything left over from the last run, which also opens the journal ready for appending
+	compact();
+}
+
+void BasketJournal::append(const std::string& str_record) {
+	std::lock_guard<std::recursive_mutex> lock(_mutex);
+	_ofs_journal << str_record << RECORD_TERMINATOR << '\n';
+	_ofs_journal.flush();
+
+	if (!_ofs_journal) {
+		throw std::runtime_error("Failed to write to basket journal.");
+	}
+
+	if (++_i_records_since_compact >= _i_compact_threshold) {
+		compact();
+	}
+}
+
+void BasketJournal::record_add(int i_user_id, int i_game_id, int i_count) {
+	append("A " + std::to_string(i_user_id) + " " + std::to_string(i_game_id) + " " + std::to_string(i_count));
+}
+
+void BasketJournal::record_set_count(int i_user_id, int i_game_id, int i_count) {
+	append("S " + std::to_string(i_user_id) + " " + std::to_string(i_game_id) + " " + std::to_string(i_count));
+}
+
+void BasketJournal::record_remove(int i_user_id, int i_game_id) {
+	append("R " + std::to_string(i_user_id) + " " + std::to_string(i_game_id));
+}
+
+void BasketJournal::record_clear(int i_user_id) {
+	append("C " + std::to_string(i_user_id));
+}
+
+void BasketJournal::compact() {
+	std::lock_guard<std::recursive_mutex> lock(_mutex);
+	sqlite3_stmt* stmt_upsert_item = NULL;
+	sqlite3_stmt* stmt_delete_item = NULL;
+	sqlite3_stmt* stmt_delete_basket = NULL;
+	// Skip items for users or games that have since been deleted rather than failing the whole compaction
+	std::string str_upsert_item_sql = "INSERT OR REPLACE INTO baskets(user_id, game_id, count) SELECT u.id, g.id, ?3 FROM users AS u, games AS g WHERE u.id = ?1 AND g.id = ?2";
+	std::string str_delete_item_sql = "DELETE FROM baskets WHERE user_id = ? AND game_id = ?";
+	std::string str_delete_basket_sql = "DELETE FROM baskets WHERE user_id = ?";
+
+	if (_ofs_journal.is_open()) {
+		_ofs_journal.close();
+	}
+
+	try {
+		if (sqlite3_prepare_v2(_db, str_upsert_item_sql.c_str(), -1, &stmt_upsert_item, NULL) != SQLITE_OK
+			|| sqlite3_prepare_v2(_db, str_delete_item_sql.c_str(), -1, &stmt_delete_item, NULL) != SQLITE_OK
+			|| sqlite3_prepare_v2(_db, str_delete_basket_sql.c_str(), -1, &stmt_delete_basket, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to prepare basket statement: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		// A savepoint rather than a transaction, so that compacting while the connection is already in a transaction nests within it
+		// instead of failing to begin and then ending the caller's transaction
+		if (sqlite3_exec(_db, "SAVEPOINT basket_compact;", NULL, NULL, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to begin compacting basket journal: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		try {
+			std::ifstream ifs_journal(_journal_path);
+			std::string str_line;
+
+			while (std::getline(ifs_journal, str_line)) {
+				// Only the final record can be missing its terminator, having been cut short by a crash. It is dropped even if what is left
+				// still reads as a record, as it may hold the wrong count (e.g. a count of 12 cut down to 1)
+				if (str_line.empty() || str_line.back() != RECORD_TERMINATOR) continue;
+				str_line.pop_back();
+
+				std::istringstream iss_record(str_line);
+				char c_type = 0;
+				int i_user_id = 0, i_game_id = 0, i_count = 0;
+				sqlite3_stmt* stmt_record = NULL;
+
+				iss_record >> c_type >> i_user_id;
+
+				if (c_type == 'C') {
+					stmt_record = stmt_delete_basket;
+					sqlite3_bind_int(stmt_record, 1, i_user_id);
+				}
+				else if (c_type == 'R' && iss_record >> i_game_id) {
+					stmt_record = stmt_delete_item;
+					sqlite3_bind_int(stmt_record, 1, i_user_id);
+					sqlite3_bind_int(stmt_record, 2, i_game_id);
+				}
+				else if ((c_type == 'A' || c_type == 'S') && iss_record >> i_game_id >> i_count) {
+					stmt_record = i_count > 0 ? stmt_upsert_item : stmt_delete_item;
+					sqlite3_bind_int(stmt_record, 1, i_user_id);
+					sqlite3_bind_int(stmt_record, 2, i_game_id);
+					if (i_count > 0) sqlite3_bind_int(stmt_record, 3, i_count);
+				}
+
+				if (stmt_record == NULL || iss_record.fail()) continue;
+
+				if (sqlite3_step(stmt_record) != SQLITE_DONE) {
+					std::string str_error_msg = "Failed to compact basket journal: ";
+					str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+					sqlite3_reset(stmt_record);
+					throw std::runtime_error(str_error_msg);
+				}
+
+				sqlite3_reset(stmt_record);
+			}
+
+			if (sqlite3_exec(_db, "RELEASE basket_compact;", NULL, NULL, NULL) != SQLITE_OK) {
+				std::string str_error_msg = "Failed to compact basket journal: ";
+				str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+				throw std::runtime_error(str_error_msg);
+			}
+		}
+		catch (std::exception&) {
+			sqlite3_exec(_db, "ROLLBACK TO basket_compact; RELEASE basket_compact;", NULL, NULL, NULL);
+			throw;
+		}
+	}
+	catch (std::exception&) {
+		// The records are left in the journal to be applied next time
+		sqlite3_finalize(stmt_upsert_item);
+		sqlite3_finalize(stmt_delete_item);
+		sqlite3_finalize(stmt_delete_basket);
+		_ofs_journal.open(_journal_path, std::ios::app);
+		throw;
+	}
+
+	sqlite3_finalize(stmt_upsert_item);
+	sqlite3_finalize(stmt_delete_item);
+	sqlite3_finalize(stmt_delete_basket);
+
+	// Records are now in the baskets table, so the journal can start again
+	_ofs_journal.open(_journal_path, std::ios::trunc);
+	_i_records_since_compact = 0;
+}
+
+std::vector<std::pair<int, int>> BasketJournal::load_basket(int i_user_id) {
+	std::lock_guard<std::recursive_mutex> lock(_mutex);
+	std::vector<std::pair<int, int>> vec_items;
+	sqlite3_stmt* stmt_basket;
+	std::string str_basket_sql = "SELECT game_id, count FROM baskets WHERE user_id = ?";
+
+	// Bring the baskets table up to date first, so only one place needs reading
+	compact();
+
+	if (sqlite3_prepare_v2(_db, str_basket_sql.c_str(), -1, &stmt_basket, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare select statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int(stmt_basket, 1, i_user_id);
+
+	while (sqlite3_step(stmt_basket) == SQLITE_ROW) {
+		vec_items.push_back(std::make_pair(sqlite3_column_int(stmt_basket, 0), sqlite3_column_int(stmt_basket, 1)));
+	}
+
+	sqlite3_finalize(stmt_basket);
+	return vec_items;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <filesystem>
+#include <utility>
+#include <mutex>
+#include "sqlite3.h"
+
+/// <summary>
+/// Class used to persist baskets between sessions. Every basket change is appended to a journal file as a single line, and the journal is
+/// periodically compacted into the baskets table, so a change only costs one sequential append rather than a database write.
+/// Records hold the resulting count of a game rather than the change in count, so replaying a record more than once (e.g. after a crash mid-compaction) is harmless.
+/// Each record ends with a terminator, so a record cut short by a crash is never replayed even when what was written still reads as a record.
+/// Safe to use from several threads at once.
+/// </summary>
+class BasketJournal
+{
+	sqlite3* _db;
+	std::filesystem::path _journal_path;
+	std::ofstream _ofs_journal;
+	int _i_compact_threshold;
+	int _i_records_since_compact;
+
+	// Sessions on several threads can record changes at once, recursive as appending can compact
+	std::recursive_mutex _mutex;
+
+	// Written at the end of every record, a final line without it was only partly written
+	static const char RECORD_TERMINATOR = ';';
+
+	/// <summary>
+	/// Appends a record to the journal and flushes it, compacting once the threshold is reached
+	/// </summary>
+	/// <param name="str_record"></param>
+	void append(const std::string& str_record);
+public:
+	/// <summary>
+	/// Opens (or creates) the journal, anything left in it from a previous run is compacted straight away
+	/// </summary>
+	/// <param name="db"></param>
+	/// <param name="journal_path"></param>
+	/// <param name="i_compact_threshold">Number of records appended before the journal is compacted into the baskets table</param>
+	BasketJournal(sqlite3* db, std::filesystem::path journal_path, int i_compact_threshold = 500);
+
+	BasketJournal(const BasketJournal&) = delete;
+	BasketJournal& operator=(const BasketJournal&) = delete;
+
+	/// <summary>
+	/// Records copies of a game being added to a user's basket
+	/// </summary>
+	/// <param name="i_user_id"></param>
+	/// <param name="i_game_id"></param>
+	/// <param name="i_count">The count of the game in the basket after the add</param>
+	void record_add(int i_user_id, int i_game_id, int i_count);
+
+	/// <summary>
+	/// Records the count of a game in a user's basket being changed, a count of less than 1 is treated as a remove
+	/// </summary>
+	/// <param name="i_user_id"></param>
+	/// <param name="i_game_id"></param>
+	/// <param name="i_count"></param>
+	void record_set_count(int i_user_id, int i_game_id, int i_count);
+
+	/// <summary>
+	/// Records a game being removed from a user's basket
+	/// </summary>
+	/// <param name="i_user_id"></param>
+	/// <param name="i_game_id"></param>
+	void record_remove(int i_user_id, int i_game_id);
+
+	/// <summary>
+	/// Records a user's basket being emptied (e.g. once purchased)
+	/// </summary>
+	/// <param name="i_user_id"></param>
+	void record_clear(int i_user_id);
+
+	/// <summary>
+	/// Applies every record in the journal to the baskets table within a single savepoint, then empties the journal. The savepoint nests within
+	/// a transaction the caller already has open on the connection rather than ending it. A partly written final record (from a crash while
+	/// appending) is ignored. Throws if the records could not be applied, leaving them in the journal.
+	/// </summary>
+	void compact();
+
+	/// <summary>
+	/// Replays the journal and returns the saved basket of a user
+	/// </summary>
+	/// <param name="i_user_id"></param>
+	/// <returns>Pairs of game id and count</returns>
+	std::vector<std::pair<int, int>> load_basket(int i_user_id);
+
+	int get_records_since_compact() { return _i_records_since_compact; }
+};
+
@@ -0,0 +1,36 @@
+#include "CatalogSnapshot.h"
+
+CatalogSnapshot::CatalogSnapshot() {
+	_ll_version = 0;
+}
+
+CatalogSnapshot::CatalogSnapshot(long long ll_version, std::vector<Game> vec_games) {
+	_ll_version = ll_version;
+	_vec_games = std::move(vec_games);
+
+	for (size_t i = 0; i < _vec_games.size(); i++) {
+		_map_game_positions[_vec_games[i].get_id()] = i;
+	}
+}
+
+const Game* CatalogSnapshot::find_game(int i_game_id) const {
+	auto position = _map_game_positions.find(i_game_id);
+
+	if (position == _map_game_positions.end()) return nullptr;
+
+	return &_vec_games[position->second];
+}
+
+std::vector<Game> CatalogSnapshot::get_games_in_genre(int i_genre_id) const {
+	if (i_genre_id < 1) return _vec_games;
+
+	std::vector<Game> vec_games;
+
+	for (const Game& obj_game : _vec_games) {
+		if (obj_game.get_genre().get_id() == i_genre_id) {
+			vec_games.push_back(obj_game);
+		}
+	}
+
+	return vec_games;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "Game.h"
+
+/// <summary>
+/// Immutable version of the games catalog. GameManager publishes a new snapshot each time games are fetched rather than changing the current one,
+/// so a reader holding a snapshot can keep using it for as long as it likes, and it is freed once the last reader lets go of it.
+/// </summary>
+class CatalogSnapshot
+{
+	long long _ll_version;
+	std::vector<Game> _vec_games;
+	std::unordered_map<int, size_t> _map_game_positions;
+public:
+	CatalogSnapshot();
+	CatalogSnapshot(long long ll_version, std::vector<Game> vec_games);
+
+	/// <summary>
+	/// Returns the version of the catalog, each snapshot published by a GameManager has a higher version than the last
+	/// </summary>
+	/// <returns></returns>
+	long long get_version() const { return _ll_version; }
+
+	const std::vector<Game>& get_vec_games() const { return _vec_games; }
+
+	/// <summary>
+	/// Returns the games in the provided genre, in catalog order, so each session can apply its own genre filter to the shared catalog.
+	/// All games are returned if the genre id is less than 1 (no filter).
+	/// </summary>
+	/// <param name="i_genre_id"></param>
+	/// <returns></returns>
+	std::vector<Game> get_games_in_genre(int i_genre_id) const;
+
+	/// <summary>
+	/// Returns the game with the provided id, or nullptr if it is not in this snapshot
+	/// </summary>
+	/// <param name="i_game_id"></param>
+	/// <returns></returns>
+	const Game* find_game(int i_game_id) const;
+};
+
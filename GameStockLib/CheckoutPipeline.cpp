@@ -0,0 +1,273 @@
+#include "CheckoutPipeline.h"
+
+CheckoutPipeline::CheckoutPipeline(sqlite3* db, size_t i_max_batch_size) {
+	_db = db;
+	_i_max_batch_size = i_max_batch_size > 0 ? i_max_batch_size : 1;
+	_i_batches_committed = 0;
+	_bool_stopping = false;
+	_thread_worker = std::thread(&CheckoutPipeline::run, this);
+}
+
+CheckoutPipeline::~CheckoutPipeline() {
+	stop();
+}
+
+std::future<Money> CheckoutPipeline::submit(Basket obj_basket) {
+	CheckoutRequest obj_request;
+	std::future<Money> obj_future = obj_request.obj_promise.get_future();
+
+	if (obj_basket.is_empty()) {
+		obj_request.obj_promise.set_exception(std::make_exception_ptr(std::invalid_argument("You cannot confirm a purchase with an empty basket.")));
+		return obj_future;
+	}
+
+	obj_request.obj_basket = std::move(obj_basket);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_bool_stopping) {
+			obj_request.obj_promise.set_exception(std::make_exception_ptr(std::runtime_error("Checkout is not currently available, please try again.")));
+			return obj_future;
+		}
+
+		_deque_requests.push_back(std::move(obj_request));
+	}
+
+	_cv_requests.notify_one();
+	return obj_future;
+}
+
+void CheckoutPipeline::stop() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_bool_stopping = true;
+	}
+
+	_cv_requests.notify_one();
+
+	if (_thread_worker.joinable()) {
+		_thread_worker.join();
+	}
+}
+
+int CheckoutPipeline::get_batches_committed() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _i_batches_committed;
+}
+
+void CheckoutPipeline::run() {
+	while (true) {
+		std::vector<CheckoutRequest> vec_batch;
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cv_requests.wait(lock, [this] { return _bool_stopping || !_deque_requests.empty(); });
+
+			if (_deque_requests.empty()) return;
+
+			// Anything that queued up while the previous batch was committing goes into this batch
+			while (!_deque_requests.empty() && vec_batch.size() < _i_max_batch_size) {
+				vec_batch.push_back(std::move(_deque_requests.front()));
+				_deque_requests.pop_front();
+			}
+		}
+
+		commit_batch(vec_batch);
+	}
+}
+
+CheckoutPipeline::CheckoutStatements::CheckoutStatements(sqlite3* db) {
+	std::string str_insert_purchase = "INSERT INTO purchases(user_id, total) VALUES (?, ?) RETURNING id";
+	std::string str_insert_game_snapshot = "INSERT OR IGNORE INTO game_snapshots(name, genre, rating) VALUES (?, ?, ?)";
+	std::string str_insert_purchase_item = "INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count, game_id) VALUES (?, (SELECT id FROM game_snapshots WHERE name = ? AND genre = ? AND rating = ?), ?, ?, ?)";
+	// Only take copies if there are enough left, so two sessions cannot both buy the last copies
+	std::string str_update_game_copies = "UPDATE games SET copies = copies - ? WHERE id = ? AND copies >= ?";
+
+	if (sqlite3_prepare_v2(db, str_insert_purchase.c_str(), -1, &stmt_insert_purchase, NULL) != SQLITE_OK
+		|| sqlite3_prepare_v2(db, str_insert_game_snapshot.c_str(), -1, &stmt_insert_game_snapshot, NULL) != SQLITE_OK
+		|| sqlite3_prepare_v2(db, str_insert_purchase_item.c_str(), -1, &stmt_insert_purchase_item, NULL) != SQLITE_OK
+		|| sqlite3_prepare_v2(db, str_update_game_copies.c_str(), -1, &stmt_update_game_copies, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare checkout statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+		// The destructor is not run for a constructor that throws, so finalize whichever statements were prepared here
+		sqlite3_finalize(stmt_insert_purchase);
+		sqlite3_finalize(stmt_insert_game_snapshot);
+		sqlite3_finalize(stmt_insert_purchase_item);
+		sqlite3_finalize(stmt_update_game_copies);
+		throw std::runtime_error(str_error_msg);
+	}
+}
+
+CheckoutPipeline::CheckoutStatements::~CheckoutStatements() {
+	sqlite3_finalize(stmt_insert_purchase);
+	sqlite3_finalize(stmt_insert_game_snapshot);
+	sqlite3_finalize(stmt_insert_purchase_item);
+	sqlite3_finalize(stmt_update_game_copies);
+}
+
+void CheckoutPipeline::CheckoutStatements::reset() {
+	sqlite3_reset(stmt_insert_purchase);
+	sqlite3_reset(stmt_insert_game_snapshot);
+	sqlite3_reset(stmt_insert_purchase_item);
+	sqlite3_reset(stmt_update_game_copies);
+}
+
+void CheckoutPipeline::commit_batch(std::vector<CheckoutRequest>& vec_batch) {
+	std::vector<Money> vec_totals(vec_batch.size());
+	std::vector<std::exception_ptr> vec_errors(vec_batch.size());
+	bool bool_committed = false;
+
+	try {
+		CheckoutStatements obj_statements(_db);
+
+		execute(_db, "BEGIN");
+
+		for (size_t i = 0; i < vec_batch.size(); i++) {
+			execute(_db, "SAVEPOINT checkout");
+
+			try {
+				vec_totals[i] = insert_basket(_db, vec_batch[i].obj_basket, obj_statements);
+				execute(_db, "RELEASE checkout");
+			}
+			catch (std::exception&) {
+				// Undo only this basket, the rest of the batch carries on
+				vec_errors[i] = std::current_exception();
+				obj_statements.reset();
+				execute(_db, "ROLLBACK TO checkout");
+				execute(_db, "RELEASE checkout");
+			}
+		}
+
+		execute(_db, "COMMIT");
+		bool_committed = true;
+	}
+	catch (std::exception&) {
+		// Nothing in the batch was committed, so every basket fails
+		std::exception_ptr ptr_error = std::current_exception();
+		sqlite3_exec(_db, "ROLLBACK", NULL, NULL, NULL);
+
+		for (auto& error : vec_errors) {
+			if (!error) error = ptr_error;
+		}
+	}
+
+	if (bool_committed) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_i_batches_committed++;
+	}
+
+	for (size_t i = 0; i < vec_batch.size(); i++) {
+		if (vec_errors[i]) {
+			vec_batch[i].obj_promise.set_exception(vec_errors[i]);
+		}
+		else {
+			vec_batch[i].obj_promise.set_value(vec_totals[i]);
+		}
+	}
+}
+
+Money CheckoutPipeline::commit_basket(sqlite3* db, Basket& obj_basket) {
+	if (obj_basket.is_empty()) {
+		throw std::invalid_argument("You cannot confirm a purchase with an empty basket.");
+	}
+
+	CheckoutStatements obj_statements(db);
+	Money obj_grand_total;
+
+	// Immediate, so the write lock is taken up front rather than part way through the checkout
+	execute(db, "BEGIN IMMEDIATE");
+
+	try {
+		obj_grand_total = insert_basket(db, obj_basket, obj_statements);
+		execute(db, "COMMIT");
+	}
+	catch (std::exception&) {
+		obj_statements.reset();
+		sqlite3_exec(db, "ROLLBACK", NULL, NULL, NULL);
+		throw;
+	}
+
+	return obj_grand_total;
+}
+
+Money CheckoutPipeline::insert_basket(sqlite3* db, Basket& obj_basket, CheckoutStatements& obj_statements) {
+	sqlite3_stmt* stmt_insert_purchase = obj_statements.stmt_insert_purchase;
+	sqlite3_stmt* stmt_insert_game_snapshot = obj_statements.stmt_insert_game_snapshot;
+	sqlite3_stmt* stmt_insert_purchase_item = obj_statements.stmt_insert_purchase_item;
+	sqlite3_stmt* stmt_update_game_copies = obj_statements.stmt_update_game_copies;
+	Money obj_grand_total = obj_basket.get_total();
+
+	sqlite3_bind_int(stmt_insert_purchase, 1, obj_basket.get_user_id());
+	sqlite3_bind_int64(stmt_insert_purchase, 2, obj_grand_total.get_cents());
+
+	// The purchase id (needed while inserting purchase items for this purchase) is returned by the insert itself
+	if (sqlite3_step(stmt_insert_purchase) != SQLITE_ROW) {
+		throw std::runtime_error(sqlite3_errmsg(db));
+	}
+
+	int i_purchase_id = sqlite3_column_int(stmt_insert_purchase, 0);
+
+	if (sqlite3_step(stmt_insert_purchase) != SQLITE_DONE) {
+		throw std::runtime_error(sqlite3_errmsg(db));
+	}
+
+	sqlite3_reset(stmt_insert_purchase);
+
+	for (auto& item : obj_basket.get_vec_purchase_items()) {
+		// Game name, genre and rating are stored once in game_snapshots, with each purchase item referring to them
+		sqlite3_bind_text(stmt_insert_game_snapshot, 1, item.get_game().get_name().c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt_insert_game_snapshot, 2, item.get_game().get_genre().get_genre().c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt_insert_game_snapshot, 3, item.get_game().get_rating().get_rating().c_str(), -1, SQLITE_TRANSIENT);
+
+		if (sqlite3_step(stmt_insert_game_snapshot) != SQLITE_DONE) {
+			throw std::runtime_error("Something went wrong while performing an insert, please try again.");
+		}
+
+		sqlite3_reset(stmt_insert_game_snapshot);
+
+		sqlite3_bind_int(stmt_insert_purchase_item, 1, i_purchase_id);
+		sqlite3_bind_text(stmt_insert_purchase_item, 2, item.get_game().get_name().c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt_insert_purchase_item, 3, item.get_game().get_genre().get_genre().c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt_insert_purchase_item, 4, item.get_game().get_rating().get_rating().c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_int64(stmt_insert_purchase_item, 5, item.get_price().get_cents());
+		sqlite3_bind_int(stmt_insert_purchase_item, 6, item.get_count());
+		sqlite3_bind_int(stmt_insert_purchase_item, 7, item.get_game().get_id());
+
+		if (sqlite3_step(stmt_insert_purchase_item) != SQLITE_DONE) {
+			throw std::runtime_error("Something went wrong while performing an insert, please try again.");
+		}
+
+		sqlite3_reset(stmt_insert_purchase_item);
+
+		sqlite3_bind_int(stmt_update_game_copies, 1, item.get_count());
+		sqlite3_bind_int(stmt_update_game_copies, 2, item.get_game().get_id());
+		sqlite3_bind_int(stmt_update_game_copies, 3, item.get_count());
+
+		if (sqlite3_step(stmt_update_game_copies) != SQLITE_DONE) {
+			throw std::runtime_error("Something went wrong while performing an update, please try again.");
+		}
+
+		sqlite3_reset(stmt_update_game_copies);
+
+		// No row updated means the game has fewer copies left than this basket wants
+		if (sqlite3_changes(db) == 0) {
+			throw std::runtime_error("Could not purchase " + std::to_string(item.get_count()) + " copies of " + item.get_game().get_name() + " as there are not enough copies remaining.");
+		}
+	}
+
+	return obj_grand_total;
+}
+
+void CheckoutPipeline::execute(sqlite3* db, const std::string& str_sql) {
+	char* ptr_error_message = NULL;
+
+	if (sqlite3_exec(db, str_sql.c_str(), NULL, NULL, &ptr_error_message) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to execute '" + str_sql + "': ";
+		if (ptr_error_message != NULL) {
+			str_error_msg = str_error_msg + ptr_error_message;
+			sqlite3_free(ptr_error_message);
+		}
+		throw std::runtime_error(str_error_msg);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include "sqlite3.h"
+#include "Basket.h"
+#include "Money.h"
+
+/// <summary>
+/// Class that queues completed baskets from any number of sessions and commits them to the database in batches, so that many checkouts
+/// share a single transaction commit. Each basket is still all-or-nothing, its result (or the error that stopped it) is returned through the future given by submit.
+/// </summary>
+class CheckoutPipeline
+{
+	/// <summary>
+	/// A queued basket and the promise used to report its result back to the submitting session
+	/// </summary>
+	struct CheckoutRequest {
+		Basket obj_basket;
+		std::promise<Money> obj_promise;
+	};
+
+	sqlite3* _db;
+	size_t _i_max_batch_size;
+	int _i_batches_committed;
+	bool _bool_stopping;
+
+	std::deque<CheckoutRequest> _deque_requests;
+	std::mutex _mutex;
+	std::condition_variable _cv_requests;
+	std::thread _thread_worker;
+
+	/// <summary>
+	/// Worker loop, takes whatever has been queued (up to the max batch size) and commits it as one batch until stopped and the queue is empty
+	/// </summary>
+	void run();
+
+	/// <summary>
+	/// The statements a checkout is made with, prepared together (throwing if any fails) and finalized when this goes out of scope
+	/// </summary>
+	struct CheckoutStatements {
+		sqlite3_stmt* stmt_insert_purchase = NULL;
+		sqlite3_stmt* stmt_insert_game_snapshot = NULL;
+		sqlite3_stmt* stmt_insert_purchase_item = NULL;
+		sqlite3_stmt* stmt_update_game_copies = NULL;
+
+		CheckoutStatements(sqlite3* db);
+		~CheckoutStatements();
+
+		CheckoutStatements(const CheckoutStatements&) = delete;
+		CheckoutStatements& operator=(const CheckoutStatements&) = delete;
+
+		/// <summary>
+		/// Resets each statement, so they can be used again after a checkout failed part way through
+		/// </summary>
+		void reset();
+	};
+
+	/// <summary>
+	/// Commits a batch of baskets inside a single transaction, each basket within its own savepoint so a failed basket does not affect the others.
+	/// Promises are only fulfilled once the transaction has been committed.
+	/// </summary>
+	/// <param name="vec_batch"></param>
+	void commit_batch(std::vector<CheckoutRequest>& vec_batch);
+
+	/// <summary>
+	/// Inserts the purchase and purchase items for a basket and takes the copies from stock, throws if any step fails (including not enough copies remaining).
+	/// Should be called within a transaction, so a basket that fails part way can be rolled back.
+	/// </summary>
+	/// <param name="db"></param>
+	/// <param name="obj_basket"></param>
+	/// <param name="obj_statements"></param>
+	/// <returns>The total of the purchase</returns>
+	static Money insert_basket(sqlite3* db, Basket& obj_basket, CheckoutStatements& obj_statements);
+
+	/// <summary>
+	/// Executes a statement that returns no rows, throws on failure
+	/// </summary>
+	/// <param name="db"></param>
+	/// <param name="str_sql"></param>
+	static void execute(sqlite3* db, const std::string& str_sql);
+public:
+	/// <summary>
+	/// Starts the pipeline, the connection should be dedicated to the pipeline as batches hold a transaction open on it
+	/// </summary>
+	/// <param name="db"></param>
+	/// <param name="i_max_batch_size">Maximum number of baskets committed in one transaction</param>
+	CheckoutPipeline(sqlite3* db, size_t i_max_batch_size = 256);
+
+	/// <summary>
+	/// Stops the pipeline, any baskets already queued are still committed
+	/// </summary>
+	~CheckoutPipeline();
+
+	CheckoutPipeline(const CheckoutPipeline&) = delete;
+	CheckoutPipeline& operator=(const CheckoutPipeline&) = delete;
+
+	/// <summary>
+	/// Queues a basket for checkout, an empty basket or a basket submitted after stop is failed straight away
+	/// </summary>
+	/// <param name="obj_basket"></param>
+	/// <returns>Future holding the total of the purchase once committed, or the exception that caused the checkout to fail</returns>
+	std::future<Money> submit(Basket obj_basket);
+
+	/// <summary>
+	/// Commits a single basket straight away in its own transaction on the provided connection, for checkouts that do not go through a pipeline.
+	/// Copies are taken from the stock held in the database rather than the basket's copy of each game, so the checkout fails (and nothing is
+	/// committed) if another session has bought the copies since they were added to the basket. The connection should be used by this checkout
+	/// alone, as anything else run on it while the transaction is open would be committed or rolled back along with the basket.
+	/// </summary>
+	/// <param name="db"></param>
+	/// <param name="obj_basket"></param>
+	/// <returns>The total of the purchase</returns>
+	static Money commit_basket(sqlite3* db, Basket& obj_basket);
+
+	/// <summary>
+	/// Commits anything still queued and then stops the worker, safe to call more than once
+	/// </summary>
+	void stop();
+
+	/// <summary>
+	/// Returns the number of transactions committed so far
+	/// </summary>
+	/// <returns></returns>
+	int get_batches_committed();
+};
+
@@ -1,11 +1,14 @@
 #pragma once
+#include <memory>
 #include "UserManager.h"
 #include "DatabaseManager.h"
 #include "GameManager.h"
 #include "PurchaseManager.h"
 
 /// <summary>
-/// Used as a nice convenient way to group the various manager classes togehter so that they can be accessed/used from various menu pages
+/// Used as a nice convenient way to group the various manager classes togehter so that they can be accessed/used from various menu pages.
+/// Also holds the session the console is being used through, which is replaced at login and logout as the managers do not keep one.
+/// The managers share the database manager's connection; purchases are not committed on it, they go through the checkout pipeline's own connection.
 /// </summary>
 struct ClassContainer
 {
@@ -13,5 +16,6 @@ struct ClassContainer
 	UserManager& ptr_user_manager;
 	GameManager& ptr_game_manager;
 	PurchaseManager& ptr_purchase_manager;
+	std::shared_ptr<Session> ptr_session = std::make_shared<Session>();
 };
 
@@ -0,0 +1,175 @@
+#include "CoPurchaseIndex.h"
+#include <algorithm>
+#include <mutex>
+
+CoPurchaseIndex::CoPurchaseIndex(size_t i_thread_count) {
+	_ll_last_purchase_id = 0;
+	_i_thread_count = i_thread_count;
+
+	if (_i_thread_count == 0) _i_thread_count = std::thread::hardware_concurrency();
+	if (_i_thread_count == 0) _i_thread_count = 1;
+}
+
+void CoPurchaseIndex::increment_locked(int i_game_id, int i_other_game_id) {
+	std::vector<CoPurchase>& vec_row = _map_rows[i_game_id];
+	size_t i_position = 0;
+
+	while (i_position < vec_row.size() && vec_row[i_position].i_game_id != i_other_game_id) i_position++;
+
+	if (i_position == vec_row.size()) {
+		vec_row.push_back(CoPurchase{ i_other_game_id, 0 });
+	}
+
+	vec_row[i_position].i_purchases++;
+
+	// Counts only go up by one, so the game only has to move past those it now has more purchases than (or as many, with a higher id)
+	while (i_position > 0 && (vec_row[i_position - 1].i_purchases < vec_row[i_position].i_purchases ||
+		(vec_row[i_position - 1].i_purchases == vec_row[i_position].i_purchases && vec_row[i_position - 1].i_game_id > vec_row[i_position].i_game_id))) {
+		std::swap(vec_row[i_position - 1], vec_row[i_position]);
+		i_position--;
+	}
+}
+
+void CoPurchaseIndex::add_purchase_locked(const int* ptr_game_ids, size_t i_game_count) {
+	for (size_t i = 0; i < i_game_count; i++) {
+		for (size_t j = i + 1; j < i_game_count; j++) {
+			increment_locked(ptr_game_ids[i], ptr_game_ids[j]);
+			increment_locked(ptr_game_ids[j], ptr_game_ids[i]);
+		}
+	}
+}
+
+void CoPurchaseIndex::build_locked(const std::vector<int>& vec_game_ids, const std::vector<size_t>& vec_purchase_starts) {
+	size_t i_purchase_count = vec_purchase_starts.size() - 1;
+	size_t i_partition_count = _i_thread_count < i_purchase_count ? _i_thread_count : i_purchase_count;
+	if (i_partition_count == 0) i_partition_count = 1;
+
+	std::vector<std::unordered_map<int, std::vector<CoPurchase>>> vec_partition_rows(i_partition_count);
+	std::vector<std::thread> vec_threads;
+
+	// Each thread owns the rows of the games whose id falls in its partition and reads every purchase for them, so no two threads write to the
+	// same row and nothing has to be merged afterwards
+	for (size_t partition = 0; partition < i_partition_count; partition++) {
+		vec_threads.push_back(std::thread([&, partition]() {
+			std::unordered_map<std::uint64_t, int> map_pair_counts;
+
+			for (size_t purchase = 0; purchase < i_purchase_count; purchase++) {
+				for (size_t i = vec_purchase_starts[purchase]; i < vec_purchase_starts[purchase + 1]; i++) {
+					if ((unsigned int)vec_game_ids[i] % i_partition_count != partition) continue;
+
+					for (size_t j = vec_purchase_starts[purchase]; j < vec_purchase_starts[purchase + 1]; j++) {
+						if (i != j) map_pair_counts[((std::uint64_t)(unsigned int)vec_game_ids[i] << 32) | (unsigned int)vec_game_ids[j]]++;
+					}
+				}
+			}
+
+			std::unordered_map<int, std::vector<CoPurchase>>& map_rows = vec_partition_rows[partition];
+			for (auto& pair_count : map_pair_counts) {
+				map_rows[(int)(pair_count.first >> 32)].push_back(CoPurchase{ (int)(pair_count.first & 0xFFFFFFFF), pair_count.second });
+			}
+
+			for (auto& row : map_rows) {
+				std::sort(row.second.begin(), row.second.end(), [](const CoPurchase& a, const CoPurchase& b) {
+					return a.i_purchases != b.i_purchases ? a.i_purchases > b.i_purchases : a.i_game_id < b.i_game_id;
+					});
+			}
+			}));
+	}
+
+	for (std::thread& thread : vec_threads) {
+		thread.join();
+	}
+
+	_map_rows.clear();
+	for (auto& map_rows : vec_partition_rows) {
+		for (auto& row : map_rows) {
+			_map_rows[row.first] = std::move(row.second);
+		}
+	}
+}
+
+size_t CoPurchaseIndex::load_new(sqlite3* db) {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	sqlite3_stmt* stmt_items;
+	std::vector<int> vec_game_ids;
+	std::vector<size_t> vec_purchase_starts;
+	std::int64_t ll_purchase_id = 0;
+
+	// Walks purchase items in purchase order from the last purchase loaded. Archived purchases are only read by the first load, as purchases are
+	// archived long after they were made
+	std::string str_items_sql =
+		"SELECT purchase_id, game_id FROM purchase_items WHERE purchase_id > ?1 AND game_id IS NOT NULL " \
+		"UNION ALL SELECT purchase_id, game_id FROM purchase_items_archive WHERE ?1 = 0 AND game_id IS NOT NULL " \
+		"ORDER BY 1, 2";
+
+	if (sqlite3_prepare_v2(db, str_items_sql.c_str(), -1, &stmt_items, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int64(stmt_items, 1, _ll_last_purchase_id);
+
+	while (sqlite3_step(stmt_items) == SQLITE_ROW) {
+		int i_game_id = sqlite3_column_int(stmt_items, 1);
+
+		if (vec_purchase_starts.empty() || sqlite3_column_int64(stmt_items, 0) != ll_purchase_id) {
+			ll_purchase_id = sqlite3_column_int64(stmt_items, 0);
+			vec_purchase_starts.push_back(vec_game_ids.size());
+		}
+		// Items are in game order within a purchase, so the same game twice is always straight after itself
+		else if (vec_game_ids.back() == i_game_id) {
+			continue;
+		}
+
+		vec_game_ids.push_back(i_game_id);
+	}
+
+	sqlite3_finalize(stmt_items);
+
+	if (vec_purchase_starts.empty()) return 0;
+	vec_purchase_starts.push_back(vec_game_ids.size());
+
+	if (_ll_last_purchase_id == 0 && _map_rows.empty()) {
+		build_locked(vec_game_ids, vec_purchase_starts);
+	}
+	else {
+		for (size_t purchase = 0; purchase + 1 < vec_purchase_starts.size(); purchase++) {
+			add_purchase_locked(vec_game_ids.data() + vec_purchase_starts[purchase], vec_purchase_starts[purchase + 1] - vec_purchase_starts[purchase]);
+		}
+	}
+
+	_ll_last_purchase_id = ll_purchase_id;
+	return vec_purchase_starts.size() - 1;
+}
+
+void CoPurchaseIndex::add_purchase(std::vector<int> vec_game_ids) {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+
+	std::sort(vec_game_ids.begin(), vec_game_ids.end());
+	vec_game_ids.erase(std::unique(vec_game_ids.begin(), vec_game_ids.end()), vec_game_ids.end());
+
+	add_purchase_locked(vec_game_ids.data(), vec_game_ids.size());
+}
+
+void CoPurchaseIndex::clear() {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+
+	_map_rows.clear();
+	_ll_last_purchase_id = 0;
+}
+
+bool CoPurchaseIndex::is_loaded() const {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	return _ll_last_purchase_id > 0 || !_map_rows.empty();
+}
+
+std::vector<CoPurchase> CoPurchaseIndex::get_top(int i_game_id, size_t i_limit) const {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	auto position = _map_rows.find(i_game_id);
+
+	if (position == _map_rows.end()) return std::vector<CoPurchase>();
+
+	const std::vector<CoPurchase>& vec_row = position->second;
+	return std::vector<CoPurchase>(vec_row.begin(), vec_row.begin() + (i_limit < vec_row.size() ? i_limit : vec_row.size()));
+}
\ No newline at end of file
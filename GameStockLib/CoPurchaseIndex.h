@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <thread>
+#include <stdexcept>
+#include <cstdint>
+#include "sqlite3.h"
+
+/// <summary>
+/// Another game bought alongside a game, with the number of purchases the two were bought together in
+/// </summary>
+struct CoPurchase {
+	int i_game_id = 0;
+	int i_purchases = 0;
+};
+
+/// <summary>
+/// Class that keeps a sparse game-by-game count of how many purchases each pair of games was bought together in, used for "customers who bought this
+/// also bought". Each game's row only holds the games it has been bought with, kept sorted with the most purchases first, so the top games for a game
+/// are simply the start of its row. The first load counts every purchase across several threads; later loads (after each checkout) add just the new
+/// purchases. Purchases deleted or games removed after being loaded stay counted until the index is cleared and loaded again.
+/// Safe to read from several threads while another loads.
+/// </summary>
+class CoPurchaseIndex
+{
+	std::unordered_map<int, std::vector<CoPurchase>> _map_rows;
+
+	// Highest purchase id loaded from the database, load_new only reads purchases after it
+	std::int64_t _ll_last_purchase_id;
+
+	size_t _i_thread_count;
+
+	mutable std::shared_mutex _mutex;
+
+	/// <summary>
+	/// Adds one to the count of i_other_game_id in i_game_id's row, moving it forward to keep the row sorted. Caller must hold the lock exclusively.
+	/// </summary>
+	/// <param name="i_game_id"></param>
+	/// <param name="i_other_game_id"></param>
+	void increment_locked(int i_game_id, int i_other_game_id);
+
+	/// <summary>
+	/// Adds a single purchase's games to the rows. Caller must hold the lock exclusively.
+	/// </summary>
+	void add_purchase_locked(const int* ptr_game_ids, size_t i_game_count);
+
+	/// <summary>
+	/// Counts the pairs within every purchase across several threads and replaces the rows with the result. Caller must hold the lock exclusively.
+	/// </summary>
+	/// <param name="vec_game_ids">Game ids of every purchase, one purchase after another</param>
+	/// <param name="vec_purchase_starts">Index into vec_game_ids each purchase starts at, followed by the size of vec_game_ids</param>
+	void build_locked(const std::vector<int>& vec_game_ids, const std::vector<size_t>& vec_purchase_starts);
+public:
+	/// <summary>
+	/// Creates an empty index
+	/// </summary>
+	/// <param name="i_thread_count">Number of threads the first load counts purchases across, 0 to use one per hardware thread</param>
+	CoPurchaseIndex(size_t i_thread_count = 0);
+
+	CoPurchaseIndex(const CoPurchaseIndex&) = delete;
+	CoPurchaseIndex& operator=(const CoPurchaseIndex&) = delete;
+
+	/// <summary>
+	/// Adds the purchases stored in the database since the last load. The first load builds the index from every purchase (archived purchases included),
+	/// later loads add just the new purchases. Purchase items no longer linked to a game are skipped. Throws if the purchase items could not be read.
+	/// </summary>
+	/// <param name="db"></param>
+	/// <returns>The number of purchases added</returns>
+	size_t load_new(sqlite3* db);
+
+	/// <summary>
+	/// Adds a single purchase that is not stored in the database (purchases that are should be added through load_new, so they are not counted twice)
+	/// </summary>
+	/// <param name="vec_game_ids">Each game bought in the purchase, games listed more than once are only counted once</param>
+	void add_purchase(std::vector<int> vec_game_ids);
+
+	/// <summary>
+	/// Removes every count, so the next load_new builds the index from every purchase again
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Returns whether any purchase has been loaded or added since the index was created or last cleared
+	/// </summary>
+	/// <returns></returns>
+	bool is_loaded() const;
+
+	/// <summary>
+	/// Gets the games most often bought in the same purchase as a game, most purchases first (games with the same count are in id order)
+	/// </summary>
+	/// <param name="i_game_id"></param>
+	/// <param name="i_limit">Maximum number of games to return</param>
+	/// <returns>Empty if the game has not been bought with any other game</returns>
+	std::vector<CoPurchase> get_top(int i_game_id, size_t i_limit) const;
+};
@@ -2,6 +2,8 @@
 
 DatabaseManager::DatabaseManager() {
 	_i_return_code = 0;
+	_ll_size_before_compaction = 0;
+	_ll_size_after_compaction = 0;
 	ensure_directory_exists();
 }
 
@@ -14,26 +16,411 @@ void DatabaseManager::ensure_directory_exists() {
 void DatabaseManager::connect(std::string str_db_name) {
 	std::filesystem::path db_path = _database_path /= str_db_name;
 	_i_return_code = sqlite3_open(db_path.string().c_str(), &_db);
+	if (_i_return_code != SQLITE_OK) return;
+
+	// In WAL mode reports reading a snapshot of the database do not stop checkouts from being committed, and are not stopped by them
+	_i_return_code = sqlite3_exec(_db, "PRAGMA journal_mode = WAL;", NULL, NULL, NULL);
+
+	// Checkouts are committed on their own connection, so writes here may have to wait for one to finish
+	sqlite3_busy_timeout(_db, BUSY_TIMEOUT_MS);
+}
+
+sqlite3* DatabaseManager::open_connection() {
+	sqlite3* db;
+
+	if (sqlite3_open_v2(sqlite3_db_filename(_db, "main"), &db, SQLITE_OPEN_READWRITE, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to open database connection: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+		sqlite3_close(db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_busy_timeout(db, BUSY_TIMEOUT_MS);
+	return db;
+}
+
+bool DatabaseManager::table_exists(std::string str_table_name) {
+	sqlite3_stmt* stmt_table;
+	std::string str_table_sql = "SELECT name FROM sqlite_master WHERE type = 'table' AND name = ?";
+
+	sqlite3_prepare_v2(_db, str_table_sql.c_str(), -1, &stmt_table, NULL);
+	sqlite3_bind_text(stmt_table, 1, str_table_name.c_str(), -1, SQLITE_TRANSIENT);
+	bool bool_exists = sqlite3_step(stmt_table) == SQLITE_ROW;
+	sqlite3_finalize(stmt_table);
+
+	return bool_exists;
+}
+
+bool DatabaseManager::column_exists(std::string str_table_name, std::string str_column_name) {
+	sqlite3_stmt* stmt_column;
+	std::string str_column_sql = "SELECT name FROM pragma_table_xinfo(?) WHERE name = ?";
+
+	sqlite3_prepare_v2(_db, str_column_sql.c_str(), -1, &stmt_column, NULL);
+	sqlite3_bind_text(stmt_column, 1, str_table_name.c_str(), -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt_column, 2, str_column_name.c_str(), -1, SQLITE_TRANSIENT);
+	bool bool_exists = sqlite3_step(stmt_column) == SQLITE_ROW;
+	sqlite3_finalize(stmt_column);
+
+	return bool_exists;
+}
+
+int DatabaseManager::get_schema_version() {
+	sqlite3_stmt* stmt_version;
+	int i_version = 0;
+
+	sqlite3_prepare_v2(_db, "PRAGMA user_version;", -1, &stmt_version, NULL);
+	if (sqlite3_step(stmt_version) == SQLITE_ROW) {
+		i_version = sqlite3_column_int(stmt_version, 0);
+	}
+	sqlite3_finalize(stmt_version);
+
+	return i_version;
 }
 
 void DatabaseManager::create_tables_if_not_exist() {
 	char* errorMessage;
+	// Database is only considered new if the games table has not been created yet, otherwise it may need migrating
+	bool bool_new_database = !table_exists("games");
 
 	// Create the tables, uses IF NOT EXISTS to ensure command can be executed without needing to worry about checking for table existance first.
 	std::string str_create_sql =
 		"PRAGMA foreign_keys = off;" \
 		"BEGIN TRANSACTION;" \
-		"CREATE TABLE IF NOT EXISTS games(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, name TEXT NOT NULL, genre_id INTEGER NOT NULL REFERENCES genres(id) ON DELETE CASCADE, age_rating INTEGER NOT NULL REFERENCES ratings(id) ON DELETE CASCADE, price REAL NOT NULL, copies INTEGER NOT NULL DEFAULT(0));" \
+		"CREATE TABLE IF NOT EXISTS games(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, name TEXT NOT NULL, genre_id INTEGER NOT NULL REFERENCES genres(id) ON DELETE CASCADE, age_rating INTEGER NOT NULL REFERENCES ratings(id) ON DELETE CASCADE, price INTEGER NOT NULL, copies INTEGER NOT NULL DEFAULT(0));" \
 		"CREATE TABLE IF NOT EXISTS genres(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, genre TEXT NOT NULL UNIQUE);" \
-		"CREATE TABLE IF NOT EXISTS purchase_items(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, purchase_id INTEGER REFERENCES purchases(id) ON DELETE CASCADE NOT NULL, game_name TEXT NOT NULL, game_price REAL NOT NULL, game_genre TEXT NOT NULL, game_rating TEXT NOT NULL, count INTEGER NOT NULL, total REAL NOT NULL AS(count * game_price) VIRTUAL);" \
-		"CREATE TABLE IF NOT EXISTS purchases(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, total REAL NOT NULL, date TEXT NOT NULL DEFAULT(datetime('now')));" \
+		"CREATE TABLE IF NOT EXISTS game_snapshots(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, name TEXT NOT NULL, genre TEXT NOT NULL, rating TEXT NOT NULL, UNIQUE(name, genre, rating));" \
+		"CREATE TABLE IF NOT EXISTS purchase_items(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, purchase_id INTEGER REFERENCES purchases(id) ON DELETE CASCADE NOT NULL, snapshot_id INTEGER REFERENCES game_snapshots(id) NOT NULL, game_price INTEGER NOT NULL, count INTEGER NOT NULL, total INTEGER NOT NULL AS(count * game_price) VIRTUAL, game_id INTEGER REFERENCES games(id) ON DELETE SET NULL);" \
+		"CREATE TABLE IF NOT EXISTS purchases(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, total INTEGER NOT NULL, date INTEGER NOT NULL DEFAULT(CAST(strftime('%s', 'now') AS INTEGER)));" \
 		"CREATE TABLE IF NOT EXISTS ratings(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, rating TEXT UNIQUE NOT NULL);" \
 		"CREATE TABLE IF NOT EXISTS status(is_init BOOLEAN NOT NULL DEFAULT(0));" \
 		"CREATE TABLE IF NOT EXISTS users(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, name TEXT NOT NULL, age INTEGER NOT NULL, email TEXT UNIQUE NOT NULL, password TEXT NOT NULL, is_admin BOOLEAN NOT NULL DEFAULT(0));" \
+		"CREATE TABLE IF NOT EXISTS user_purchase_stats(user_id INTEGER PRIMARY KEY REFERENCES users(id) ON DELETE CASCADE NOT NULL, purchase_count INTEGER NOT NULL DEFAULT(0), total INTEGER NOT NULL DEFAULT(0), game_copies INTEGER NOT NULL DEFAULT(0));" \
+		"CREATE TABLE IF NOT EXISTS sales_daily(day INTEGER PRIMARY KEY NOT NULL, revenue INTEGER NOT NULL DEFAULT(0), units INTEGER NOT NULL DEFAULT(0), orders INTEGER NOT NULL DEFAULT(0));" \
+		"CREATE TABLE IF NOT EXISTS sales_monthly(month INTEGER PRIMARY KEY NOT NULL, revenue INTEGER NOT NULL DEFAULT(0), units INTEGER NOT NULL DEFAULT(0), orders INTEGER NOT NULL DEFAULT(0));" \
+		"CREATE TABLE IF NOT EXISTS baskets(user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, game_id INTEGER REFERENCES games(id) ON DELETE CASCADE NOT NULL, count INTEGER NOT NULL, PRIMARY KEY(user_id, game_id));" \
+		"CREATE TABLE IF NOT EXISTS purchases_archive(user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, date INTEGER NOT NULL, id INTEGER NOT NULL, total INTEGER NOT NULL, PRIMARY KEY(user_id, date DESC, id)) WITHOUT ROWID;" \
+		"CREATE TABLE IF NOT EXISTS purchase_items_archive(purchase_id INTEGER NOT NULL, id INTEGER NOT NULL, snapshot_id INTEGER REFERENCES game_snapshots(id) NOT NULL, game_price INTEGER NOT NULL, count INTEGER NOT NULL, game_id INTEGER, PRIMARY KEY(purchase_id, id)) WITHOUT ROWID;" \
+		"CREATE TABLE IF NOT EXISTS report_watermarks(report_name TEXT PRIMARY KEY NOT NULL, last_purchase_id INTEGER NOT NULL DEFAULT(0), updated INTEGER NOT NULL DEFAULT(CAST(strftime('%s', 'now') AS INTEGER)));" \
+		"CREATE TABLE IF NOT EXISTS report_user_totals(report_name TEXT NOT NULL, user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, purchase_count INTEGER NOT NULL DEFAULT(0), total INTEGER NOT NULL DEFAULT(0), game_copies INTEGER NOT NULL DEFAULT(0), last_purchase_date INTEGER NOT NULL DEFAULT(0), PRIMARY KEY(report_name, user_id));" \
 		"COMMIT TRANSACTION;" \
 		"PRAGMA foreign_keys = on;";
 
 	_i_return_code = sqlite3_exec(_db, str_create_sql.c_str(), NULL, NULL, &errorMessage);
+	if (_i_return_code != SQLITE_OK) return;
+
+	// Brand new databases are already at the latest schema, so only need the version recording
+	if (bool_new_database) {
+		std::string str_version_sql = "PRAGMA user_version = " + std::to_string(SCHEMA_VERSION) + ";";
+		_i_return_code = sqlite3_exec(_db, str_version_sql.c_str(), NULL, NULL, &errorMessage);
+	}
+	else {
+		migrate_schema();
+	}
+
+	if (_i_return_code != SQLITE_OK) return;
+	create_indexes_if_not_exist();
+
+	if (_i_return_code != SQLITE_OK) return;
+	create_triggers_if_not_exist();
+}
+
+void DatabaseManager::create_indexes_if_not_exist() {
+	char* errorMessage;
+
+	// Purchase items are always looked up by purchase, and purchases by user newest first. The purchases index ends with the (implicit) id,
+	// so it also serves ordering by date then id and paging on both without sorting.
+	// Best sellers total each game's copies and revenue straight from the game index (which holds everything they need), and find the purchases
+	// within a period through the date index. The archive tables have the same two indexes, so best sellers still count archived purchases
+	std::string str_index_sql =
+		"CREATE INDEX IF NOT EXISTS idx_purchase_items_purchase_id ON purchase_items(purchase_id);" \
+		"CREATE INDEX IF NOT EXISTS idx_purchases_user_date ON purchases(user_id, date DESC);" \
+		"CREATE INDEX IF NOT EXISTS idx_purchase_items_game_id ON purchase_items(game_id, count, game_price);" \
+		"CREATE INDEX IF NOT EXISTS idx_purchases_date ON purchases(date);" \
+		"CREATE INDEX IF NOT EXISTS idx_purchase_items_archive_game_id ON purchase_items_archive(game_id, count, game_price);" \
+		"CREATE INDEX IF NOT EXISTS idx_purchases_archive_date ON purchases_archive(date);";
+
+	_i_return_code = sqlite3_exec(_db, str_index_sql.c_str(), NULL, NULL, &errorMessage);
+}
+
+void DatabaseManager::create_triggers_if_not_exist() {
+	char* errorMessage;
+
+	// Deleting a purchase takes off the copies of its items before they are removed, the items' own delete trigger then finds no purchase and does nothing.
+	// Daily and monthly sales are kept the same way, keyed on the start of the day/month (UTC) the purchase was made in
+	// Archived purchases are kept in user and date order rather than by id, so their items cannot reference them and are removed with them by trigger instead.
+	// The stats and rollups still count archived purchases, so deleting one (e.g. with its user) takes it off them the same way, before its items go
+	std::string str_trigger_sql =
+		"CREATE TRIGGER IF NOT EXISTS trg_purchases_insert_stats AFTER INSERT ON purchases BEGIN " \
+		"INSERT OR IGNORE INTO user_purchase_stats(user_id) VALUES(NEW.user_id); " \
+		"UPDATE user_purchase_stats SET purchase_count = purchase_count + 1, total = total + NEW.total WHERE user_id = NEW.user_id; " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchases_delete_stats BEFORE DELETE ON purchases BEGIN " \
+		"UPDATE user_purchase_stats SET purchase_count = purchase_count - 1, total = total - OLD.total, game_copies = game_copies - (SELECT COALESCE(SUM(count), 0) FROM purchase_items WHERE purchase_id = OLD.id) WHERE user_id = OLD.user_id; " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchase_items_insert_stats AFTER INSERT ON purchase_items BEGIN " \
+		"UPDATE user_purchase_stats SET game_copies = game_copies + NEW.count WHERE user_id = (SELECT user_id FROM purchases WHERE id = NEW.purchase_id); " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchase_items_delete_stats AFTER DELETE ON purchase_items BEGIN " \
+		"UPDATE user_purchase_stats SET game_copies = game_copies - OLD.count WHERE user_id = (SELECT user_id FROM purchases WHERE id = OLD.purchase_id); " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchases_insert_sales AFTER INSERT ON purchases BEGIN " \
+		"INSERT OR IGNORE INTO sales_daily(day) VALUES(CAST(strftime('%s', NEW.date, 'unixepoch', 'start of day') AS INTEGER)); " \
+		"UPDATE sales_daily SET revenue = revenue + NEW.total, orders = orders + 1 WHERE day = CAST(strftime('%s', NEW.date, 'unixepoch', 'start of day') AS INTEGER); " \
+		"INSERT OR IGNORE INTO sales_monthly(month) VALUES(CAST(strftime('%s', NEW.date, 'unixepoch', 'start of month') AS INTEGER)); " \
+		"UPDATE sales_monthly SET revenue = revenue + NEW.total, orders = orders + 1 WHERE month = CAST(strftime('%s', NEW.date, 'unixepoch', 'start of month') AS INTEGER); " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchases_delete_sales BEFORE DELETE ON purchases BEGIN " \
+		"UPDATE sales_daily SET revenue = revenue - OLD.total, orders = orders - 1, units = units - (SELECT COALESCE(SUM(count), 0) FROM purchase_items WHERE purchase_id = OLD.id) WHERE day = CAST(strftime('%s', OLD.date, 'unixepoch', 'start of day') AS INTEGER); " \
+		"UPDATE sales_monthly SET revenue = revenue - OLD.total, orders = orders - 1, units = units - (SELECT COALESCE(SUM(count), 0) FROM purchase_items WHERE purchase_id = OLD.id) WHERE month = CAST(strftime('%s', OLD.date, 'unixepoch', 'start of month') AS INTEGER); " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchase_items_insert_sales AFTER INSERT ON purchase_items BEGIN " \
+		"UPDATE sales_daily SET units = units + NEW.count WHERE day = (SELECT CAST(strftime('%s', date, 'unixepoch', 'start of day') AS INTEGER) FROM purchases WHERE id = NEW.purchase_id); " \
+		"UPDATE sales_monthly SET units = units + NEW.count WHERE month = (SELECT CAST(strftime('%s', date, 'unixepoch', 'start of month') AS INTEGER) FROM purchases WHERE id = NEW.purchase_id); " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchase_items_delete_sales AFTER DELETE ON purchase_items BEGIN " \
+		"UPDATE sales_daily SET units = units - OLD.count WHERE day = (SELECT CAST(strftime('%s', date, 'unixepoch', 'start of day') AS INTEGER) FROM purchases WHERE id = OLD.purchase_id); " \
+		"UPDATE sales_monthly SET units = units - OLD.count WHERE month = (SELECT CAST(strftime('%s', date, 'unixepoch', 'start of month') AS INTEGER) FROM purchases WHERE id = OLD.purchase_id); " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchases_archive_delete_stats BEFORE DELETE ON purchases_archive BEGIN " \
+		"UPDATE user_purchase_stats SET purchase_count = purchase_count - 1, total = total - OLD.total, game_copies = game_copies - (SELECT COALESCE(SUM(count), 0) FROM purchase_items_archive WHERE purchase_id = OLD.id) WHERE user_id = OLD.user_id; " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchases_archive_delete_sales BEFORE DELETE ON purchases_archive BEGIN " \
+		"UPDATE sales_daily SET revenue = revenue - OLD.total, orders = orders - 1, units = units - (SELECT COALESCE(SUM(count), 0) FROM purchase_items_archive WHERE purchase_id = OLD.id) WHERE day = CAST(strftime('%s', OLD.date, 'unixepoch', 'start of day') AS INTEGER); " \
+		"UPDATE sales_monthly SET revenue = revenue - OLD.total, orders = orders - 1, units = units - (SELECT COALESCE(SUM(count), 0) FROM purchase_items_archive WHERE purchase_id = OLD.id) WHERE month = CAST(strftime('%s', OLD.date, 'unixepoch', 'start of month') AS INTEGER); " \
+		"END;" \
+		"CREATE TRIGGER IF NOT EXISTS trg_purchases_archive_delete_items AFTER DELETE ON purchases_archive BEGIN " \
+		"DELETE FROM purchase_items_archive WHERE purchase_id = OLD.id; " \
+		"END;";
+
+	_i_return_code = sqlite3_exec(_db, str_trigger_sql.c_str(), NULL, NULL, &errorMessage);
+}
+
+void DatabaseManager::migrate_schema() {
+	int i_version = get_schema_version();
+
+	// Apply each migration in order, stopping at the first that fails
+	if (i_version < 1) {
+		migrate_to_integer_money();
+		if (_i_return_code != SQLITE_OK) return;
+	}
+
+	if (i_version < 2) {
+		migrate_to_purchase_stats();
+		if (_i_return_code != SQLITE_OK) return;
+	}
+
+	if (i_version < 3) {
+		migrate_to_integer_dates();
+		if (_i_return_code != SQLITE_OK) return;
+	}
+
+	if (i_version < 4) {
+		migrate_to_sales_rollups();
+		if (_i_return_code != SQLITE_OK) return;
+	}
+
+	if (i_version < 5) {
+		migrate_to_purchase_game_ids();
+		if (_i_return_code != SQLITE_OK) return;
+	}
+
+	if (i_version < 6) {
+		migrate_to_game_snapshots();
+		if (_i_return_code != SQLITE_OK) return;
+	}
+}
+
+void DatabaseManager::migrate_to_integer_money() {
+	char* errorMessage;
+
+	// SQLite cannot change a column type in place, so each table with a money column is rebuilt and copied across, converting to whole cents
+	std::string str_migrate_sql =
+		"PRAGMA foreign_keys = off;" \
+		"BEGIN TRANSACTION;" \
+		"CREATE TABLE games_migrate(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, name TEXT NOT NULL, genre_id INTEGER NOT NULL REFERENCES genres(id) ON DELETE CASCADE, age_rating INTEGER NOT NULL REFERENCES ratings(id) ON DELETE CASCADE, price INTEGER NOT NULL, copies INTEGER NOT NULL DEFAULT(0));" \
+		"INSERT INTO games_migrate(id, name, genre_id, age_rating, price, copies) SELECT id, name, genre_id, age_rating, CAST(ROUND(price * 100) AS INTEGER), copies FROM games;" \
+		"DROP TABLE games;" \
+		"ALTER TABLE games_migrate RENAME TO games;" \
+		"CREATE TABLE purchases_migrate(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, total INTEGER NOT NULL, date TEXT NOT NULL DEFAULT(datetime('now')));" \
+		"INSERT INTO purchases_migrate(id, user_id, total, date) SELECT id, user_id, CAST(ROUND(total * 100) AS INTEGER), date FROM purchases;" \
+		"DROP TABLE purchases;" \
+		"ALTER TABLE purchases_migrate RENAME TO purchases;" \
+		"CREATE TABLE purchase_items_migrate(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, purchase_id INTEGER REFERENCES purchases(id) ON DELETE CASCADE NOT NULL, game_name TEXT NOT NULL, game_price INTEGER NOT NULL, game_genre TEXT NOT NULL, game_rating TEXT NOT NULL, count INTEGER NOT NULL, total INTEGER NOT NULL AS(count * game_price) VIRTUAL);" \
+		"INSERT INTO purchase_items_migrate(id, purchase_id, game_name, game_price, game_genre, game_rating, count) SELECT id, purchase_id, game_name, CAST(ROUND(game_price * 100) AS INTEGER), game_genre, game_rating, count FROM purchase_items;" \
+		"DROP TABLE purchase_items;" \
+		"ALTER TABLE purchase_items_migrate RENAME TO purchase_items;" \
+		"PRAGMA user_version = 1;" \
+		"COMMIT TRANSACTION;" \
+		"PRAGMA foreign_keys = on;";
+
+	_i_return_code = sqlite3_exec(_db, str_migrate_sql.c_str(), NULL, NULL, &errorMessage);
+
+	// Leave the database as it was if any part of the migration failed
+	if (_i_return_code != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION; PRAGMA foreign_keys = on;", NULL, NULL, NULL);
+	}
+}
+
+void DatabaseManager::migrate_to_purchase_stats() {
+	char* errorMessage;
+
+	// Triggers only keep the stats up to date from here on, so work out the stats of purchases made before this version
+	std::string str_migrate_sql =
+		"PRAGMA foreign_keys = off;" \
+		"BEGIN TRANSACTION;" \
+		"DELETE FROM user_purchase_stats;" \
+		"INSERT INTO user_purchase_stats(user_id, purchase_count, total, game_copies) " \
+		"SELECT p.user_id, COUNT(*), SUM(p.total), SUM(COALESCE((SELECT SUM(i.count) FROM purchase_items AS i WHERE i.purchase_id = p.id), 0)) FROM purchases AS p GROUP BY p.user_id;" \
+		"PRAGMA user_version = 2;" \
+		"COMMIT TRANSACTION;" \
+		"PRAGMA foreign_keys = on;";
+
+	_i_return_code = sqlite3_exec(_db, str_migrate_sql.c_str(), NULL, NULL, &errorMessage);
+
+	// Leave the database as it was if any part of the migration failed
+	if (_i_return_code != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION; PRAGMA foreign_keys = on;", NULL, NULL, NULL);
+	}
+}
+
+void DatabaseManager::migrate_to_integer_dates() {
+	char* errorMessage;
+
+	// Rebuild purchases with an integer date, converting each existing date to seconds since the epoch (dates already stored as integers are kept). The purchase items triggers refer to purchases
+	// so are dropped first, as renaming a table checks them. Triggers and indexes are created again once migrations are done
+	std::string str_migrate_sql =
+		"PRAGMA foreign_keys = off;" \
+		"BEGIN TRANSACTION;" \
+		"DROP TRIGGER IF EXISTS trg_purchase_items_insert_stats;" \
+		"DROP TRIGGER IF EXISTS trg_purchase_items_delete_stats;" \
+		"DROP TRIGGER IF EXISTS trg_purchase_items_insert_sales;" \
+		"DROP TRIGGER IF EXISTS trg_purchase_items_delete_sales;" \
+		"CREATE TABLE purchases_migrate(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, total INTEGER NOT NULL, date INTEGER NOT NULL DEFAULT(CAST(strftime('%s', 'now') AS INTEGER)));" \
+		"INSERT INTO purchases_migrate(id, user_id, total, date) SELECT id, user_id, total, CASE WHEN typeof(date) = 'integer' THEN date ELSE CAST(strftime('%s', date) AS INTEGER) END FROM purchases;" \
+		"DROP TABLE purchases;" \
+		"ALTER TABLE purchases_migrate RENAME TO purchases;" \
+		"PRAGMA user_version = 3;" \
+		"COMMIT TRANSACTION;" \
+		"PRAGMA foreign_keys = on;";
+
+	_i_return_code = sqlite3_exec(_db, str_migrate_sql.c_str(), NULL, NULL, &errorMessage);
+
+	// Leave the database as it was if any part of the migration failed
+	if (_i_return_code != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION; PRAGMA foreign_keys = on;", NULL, NULL, NULL);
+	}
+}
+
+void DatabaseManager::migrate_to_sales_rollups() {
+	char* errorMessage;
+
+	// Triggers only keep the rollups up to date from here on, so total up the purchases made before this version by the day and month they were made in
+	std::string str_migrate_sql =
+		"PRAGMA foreign_keys = off;" \
+		"BEGIN TRANSACTION;" \
+		"DELETE FROM sales_daily;" \
+		"DELETE FROM sales_monthly;" \
+		"INSERT INTO sales_daily(day, revenue, units, orders) " \
+		"SELECT CAST(strftime('%s', p.date, 'unixepoch', 'start of day') AS INTEGER) AS day, SUM(p.total), SUM(COALESCE((SELECT SUM(i.count) FROM purchase_items AS i WHERE i.purchase_id = p.id), 0)), COUNT(*) FROM purchases AS p GROUP BY day;" \
+		"INSERT INTO sales_monthly(month, revenue, units, orders) " \
+		"SELECT CAST(strftime('%s', day, 'unixepoch', 'start of month') AS INTEGER) AS month, SUM(revenue), SUM(units), SUM(orders) FROM sales_daily GROUP BY month;" \
+		"PRAGMA user_version = 4;" \
+		"COMMIT TRANSACTION;" \
+		"PRAGMA foreign_keys = on;";
+
+	_i_return_code = sqlite3_exec(_db, str_migrate_sql.c_str(), NULL, NULL, &errorMessage);
+
+	// Leave the database as it was if any part of the migration failed
+	if (_i_return_code != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION; PRAGMA foreign_keys = on;", NULL, NULL, NULL);
+	}
+}
+
+void DatabaseManager::migrate_to_purchase_game_ids() {
+	char* errorMessage;
+
+	// Purchase items made before this version only kept the game's name, so are matched to the game with that name. Items whose name matches no game
+	// (deleted or since renamed) or more than one game are left without a game id rather than guessed
+	// The column is only added if it is not already there, as the tables are created before migrating. Items already stored as game snapshots were
+	// created with their game id, so have nothing to match
+	std::string str_add_column_sql = column_exists("purchase_items", "game_id") ? "" : "ALTER TABLE purchase_items ADD COLUMN game_id INTEGER REFERENCES games(id) ON DELETE SET NULL;";
+	std::string str_match_sql = !column_exists("purchase_items", "game_name") ? "" :
+		"UPDATE purchase_items SET game_id = (SELECT g.id FROM games AS g WHERE g.name = purchase_items.game_name) " \
+		"WHERE game_id IS NULL AND (SELECT COUNT(*) FROM games AS g WHERE g.name = purchase_items.game_name) = 1;";
+	std::string str_migrate_sql =
+		"PRAGMA foreign_keys = off;" \
+		"BEGIN TRANSACTION;" +
+		str_add_column_sql +
+		str_match_sql +
+		"PRAGMA user_version = 5;" \
+		"COMMIT TRANSACTION;" \
+		"PRAGMA foreign_keys = on;";
+
+	_i_return_code = sqlite3_exec(_db, str_migrate_sql.c_str(), NULL, NULL, &errorMessage);
+
+	// Leave the database as it was if any part of the migration failed
+	if (_i_return_code != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION; PRAGMA foreign_keys = on;", NULL, NULL, NULL);
+	}
+}
+
+void DatabaseManager::migrate_to_game_snapshots() {
+	char* errorMessage;
+
+	// Tables created at this version already store snapshots, so only the version needs recording
+	if (!column_exists("purchase_items", "game_name")) {
+		_i_return_code = sqlite3_exec(_db, "PRAGMA user_version = 6;", NULL, NULL, &errorMessage);
+		return;
+	}
+
+	_ll_size_before_compaction = get_database_size();
+
+	// Each distinct name/genre/rating is stored once, then purchase items are rebuilt to refer to it. The purchases delete triggers refer to purchase items
+	// so are dropped first, as renaming a table checks them. Triggers and indexes are created again once migrations are done
+	std::string str_migrate_sql =
+		"PRAGMA foreign_keys = off;" \
+		"BEGIN TRANSACTION;" \
+		"DROP TRIGGER IF EXISTS trg_purchases_delete_stats;" \
+		"DROP TRIGGER IF EXISTS trg_purchases_delete_sales;" \
+		"INSERT OR IGNORE INTO game_snapshots(name, genre, rating) SELECT game_name, game_genre, game_rating FROM purchase_items ORDER BY id;" \
+		"CREATE TABLE purchase_items_migrate(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, purchase_id INTEGER REFERENCES purchases(id) ON DELETE CASCADE NOT NULL, snapshot_id INTEGER REFERENCES game_snapshots(id) NOT NULL, game_price INTEGER NOT NULL, count INTEGER NOT NULL, total INTEGER NOT NULL AS(count * game_price) VIRTUAL, game_id INTEGER REFERENCES games(id) ON DELETE SET NULL);" \
+		"INSERT INTO purchase_items_migrate(id, purchase_id, snapshot_id, game_price, count, game_id) SELECT i.id, i.purchase_id, s.id, i.game_price, i.count, i.game_id FROM purchase_items AS i " \
+		"INNER JOIN game_snapshots AS s ON s.name = i.game_name AND s.genre = i.game_genre AND s.rating = i.game_rating;" \
+		"DROP TABLE purchase_items;" \
+		"ALTER TABLE purchase_items_migrate RENAME TO purchase_items;" \
+		"PRAGMA user_version = 6;" \
+		"COMMIT TRANSACTION;" \
+		"PRAGMA foreign_keys = on;";
+
+	_i_return_code = sqlite3_exec(_db, str_migrate_sql.c_str(), NULL, NULL, &errorMessage);
+
+	// Leave the database as it was if any part of the migration failed
+	if (_i_return_code != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION; PRAGMA foreign_keys = on;", NULL, NULL, NULL);
+		_ll_size_before_compaction = 0;
+		return;
+	}
+
+	// Dropping the old table only frees its pages within the file, vacuuming gives them back. The migration has already been committed,
+	// so a failed vacuum just leaves the file its old size
+	if (sqlite3_exec(_db, "VACUUM;", NULL, NULL, &errorMessage) != SQLITE_OK) {
+		sqlite3_free(errorMessage);
+	}
+
+	_ll_size_after_compaction = get_database_size();
+}
+
+std::int64_t DatabaseManager::get_database_size() {
+	sqlite3_stmt* stmt_size;
+	std::int64_t ll_size = 0;
+
+	sqlite3_prepare_v2(_db, "SELECT page_count * page_size FROM pragma_page_count(), pragma_page_size();", -1, &stmt_size, NULL);
+	if (sqlite3_step(stmt_size) == SQLITE_ROW) {
+		ll_size = sqlite3_column_int64(stmt_size, 0);
+	}
+	sqlite3_finalize(stmt_size);
+
+	return ll_size;
 }
 
 void DatabaseManager::insert_initial() {
@@ -51,10 +438,10 @@ void DatabaseManager::insert_initial() {
 		std::string str_insert_sql =
 			"PRAGMA foreign_keys = off;" \
 			"BEGIN TRANSACTION;" \
-			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(1, 'Factorio', 1, 3, 21.0, 170);" \
-			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(2, 'Rogue Legacy 2', 2, 2, 15.49, 250);" \
-			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(3, 'Flight Simulator', 10, 5, 59.99, 140);" \
-			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(4, 'Fall Guys', 2, 6, 15.99, 300);" \
+			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(1, 'Factorio', 1, 3, 2100, 170);" \
+			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(2, 'Rogue Legacy 2', 2, 2, 1549, 250);" \
+			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(3, 'Flight Simulator', 10, 5, 5999, 140);" \
+			"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(4, 'Fall Guys', 2, 6, 1599, 300);" \
 			"INSERT INTO genres(id, genre) VALUES(1, 'Strategy');" \
 			"INSERT INTO genres(id, genre) VALUES(2, 'Action');" \
 			"INSERT INTO genres(id, genre) VALUES(3, 'FPS');" \
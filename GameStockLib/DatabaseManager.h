@@ -2,6 +2,8 @@
 #include <iostream>
 #include "sqlite3.h"
 #include <filesystem>
+#include <cstdint>
+#include <stdexcept>
 
 /// <summary>
 /// Class that contains any database management related functions; such as initialising the database structure, inserting initial data etc
@@ -10,22 +12,110 @@ class DatabaseManager
 {
 	sqlite3* _db;
 	int _i_return_code;
+	std::int64_t _ll_size_before_compaction;
+	std::int64_t _ll_size_after_compaction;
 	std::filesystem::path _database_path = std::filesystem::path(L"database");
 	/// <summary>
 	/// Creates the .\database directory if it does not yet exist
 	/// </summary>
 	void ensure_directory_exists();
+
+	/// <summary>
+	/// Returns true if the named table already exists within the connected database
+	/// </summary>
+	/// <param name="str_table_name"></param>
+	/// <returns></returns>
+	bool table_exists(std::string str_table_name);
+
+	/// <summary>
+	/// Returns true if the named column exists within the named table
+	/// </summary>
+	/// <param name="str_table_name"></param>
+	/// <param name="str_column_name"></param>
+	/// <returns></returns>
+	bool column_exists(std::string str_table_name, std::string str_column_name);
+
+	/// <summary>
+	/// Returns the schema version stored in the database (PRAGMA user_version)
+	/// </summary>
+	/// <returns></returns>
+	int get_schema_version();
+
+	/// <summary>
+	/// Creates the indexes used by lookups, run after any migrations as rebuilding a table drops its indexes
+	/// </summary>
+	void create_indexes_if_not_exist();
+
+	/// <summary>
+	/// Creates the triggers that keep user_purchase_stats and the sales rollups up to date as purchases and purchase items are inserted/deleted, run after any migrations for the same reason as indexes
+	/// </summary>
+	void create_triggers_if_not_exist();
+
+	/// <summary>
+	/// Brings a database created by an older version of GameStock up to SCHEMA_VERSION, one version at a time
+	/// </summary>
+	void migrate_schema();
+
+	/// <summary>
+	/// Migration to schema version 1; converts prices and totals from REAL to INTEGER cents
+	/// </summary>
+	void migrate_to_integer_money();
+
+	/// <summary>
+	/// Migration to schema version 2; fills user_purchase_stats from the purchases already made
+	/// </summary>
+	void migrate_to_purchase_stats();
+
+	/// <summary>
+	/// Migration to schema version 3; converts purchase dates from TEXT to INTEGER seconds since the epoch, so they can be ordered and paged on through an index
+	/// </summary>
+	void migrate_to_integer_dates();
+
+	/// <summary>
+	/// Migration to schema version 4; fills the daily and monthly sales rollups from the purchases already made
+	/// </summary>
+	void migrate_to_sales_rollups();
+
+	/// <summary>
+	/// Migration to schema version 5; adds the game id to purchase items, matching the items already purchased to their game by name
+	/// </summary>
+	void migrate_to_purchase_game_ids();
+
+	/// <summary>
+	/// Migration to schema version 6; moves each purchase item's game name, genre and rating into game_snapshots, so that each distinct combination
+	/// is stored once rather than on every item, then vacuums the file and records its size before and after
+	/// </summary>
+	void migrate_to_game_snapshots();
 public:
+	/// <summary>
+	/// The schema version that create_tables_if_not_exist creates, and that older databases are migrated up to
+	/// </summary>
+	static const int SCHEMA_VERSION = 6;
+
+	/// <summary>
+	/// How long a connection waits for another connection's write to finish before giving up, in milliseconds
+	/// </summary>
+	static const int BUSY_TIMEOUT_MS = 5000;
+
 	DatabaseManager();
 
 	/// <summary>
 	/// Opens a connection to the specified database name using the name provided, cannot create paths, so runs ensure_directory_exists first to ensure database directory exists as well
+	/// The database is switched to WAL mode, so reads on other connections and writes on this one do not block each other.
 	/// </summary>
 	/// <param name="str_db_name"></param>
 	void connect(std::string str_db_name);
 
+	/// <summary>
+	/// Opens another connection to the connected database, for work that holds transactions open on its own connection (such as the checkout pipeline).
+	/// Throws if the connection could not be opened, the caller closes the connection once done with it.
+	/// </summary>
+	/// <returns></returns>
+	sqlite3* open_connection();
+
 	/// <summary>
 	/// Runs operation against the database that creates the database structure (tables, relationships etc) if they do not yet exist.
+	/// Existing databases from older versions are migrated to the current schema version.
 	/// </summary>
 	void create_tables_if_not_exist();
 
@@ -45,5 +135,23 @@ public:
 	/// </summary>
 	/// <returns></returns>
 	int get_return_code() { return _i_return_code; }
+
+	/// <summary>
+	/// Returns the size of the connected database in bytes, including pages that are free for reuse
+	/// </summary>
+	/// <returns></returns>
+	std::int64_t get_database_size();
+
+	/// <summary>
+	/// Returns the size in bytes of the database before it was compacted into game snapshots, 0 if no compaction was needed when the tables were created
+	/// </summary>
+	/// <returns></returns>
+	std::int64_t get_size_before_compaction() { return _ll_size_before_compaction; }
+
+	/// <summary>
+	/// Returns the size in bytes of the database after it was compacted into game snapshots, 0 if no compaction was needed when the tables were created
+	/// </summary>
+	/// <returns></returns>
+	std::int64_t get_size_after_compaction() { return _ll_size_after_compaction; }
 };
 
@@ -3,7 +3,7 @@
 Game::Game() {
 	_i_id = 0;
 	_str_name = "";
-	_d_price = 0;
+	_obj_price = Money();
 	_i_copies = 0;
 }
 
@@ -12,24 +12,24 @@ Game::Game(std::string str_name, Genre obj_genre, Rating obj_rating) {
 	_str_name = str_name;
 	_obj_genre = obj_genre;
 	_obj_rating = obj_rating;
-	_d_price = 0;
+	_obj_price = Money();
 	_i_copies = 0;
 }
 
-Game::Game(std::string str_name, Genre obj_genre, Rating obj_rating, double d_price, int i_copies) {
+Game::Game(std::string str_name, Genre obj_genre, Rating obj_rating, Money obj_price, int i_copies) {
 	_i_id = 0;
 	_str_name = str_name;
 	_obj_genre = obj_genre;
 	_obj_rating = obj_rating;
-	_d_price = d_price;
+	_obj_price = obj_price;
 	_i_copies = i_copies;
 }
 
-Game::Game(int i_id, std::string str_name, Genre obj_genre, Rating obj_rating, double d_price, int i_copies) {
+Game::Game(int i_id, std::string str_name, Genre obj_genre, Rating obj_rating, Money obj_price, int i_copies) {
 	_i_id = i_id;
 	_str_name = str_name;
 	_obj_genre = obj_genre;
 	_obj_rating = obj_rating;
-	_d_price = d_price;
+	_obj_price = obj_price;
 	_i_copies = i_copies;
 }
\ No newline at end of file
@@ -1,4 +1,13 @@
 #include "GameManager.h"
+#include "DatabaseManager.h"
+
+GameManager::GameManager(sqlite3* db) {
+	const char* str_filename = db != NULL ? sqlite3_db_filename(db, "main") : NULL;
+
+	_db = db;
+	// Kept for opening checkout connections, so the manager's connection is not asked for it from whichever thread is checking out
+	_str_database_path = str_filename != NULL ? str_filename : "";
+}
 
 void GameManager::initialise_games() {
 	// Only fetch games when not already initialised
@@ -17,9 +26,19 @@ void GameManager::refresh_games() {
 	}
 }
 
+std::optional<Game> GameManager::find_game(int i_game_id) const {
+	// The snapshot is held until the game has been copied out of it
+	std::shared_ptr<const CatalogSnapshot> ptr_catalog = get_catalog();
+	const Game* ptr_game = ptr_catalog->find_game(i_game_id);
+
+	if (ptr_game == nullptr) return std::nullopt;
+
+	return *ptr_game;
+}
+
 int GameManager::get_games() {
-	// Ensure games vector is empty first
-	_vec_games.clear();
+	// Games are built up separately and then published as a new snapshot, so anyone still reading the current snapshot is unaffected
+	std::vector<Game> vec_games;
 	int i_return_code;
 	sqlite3_stmt* stmt_games;
 
@@ -31,14 +50,6 @@ int GameManager::get_games() {
 		str_status_sql = "SELECT g.id, g.name, r.id as rating_id, r.rating, x.id as genre_id, x.genre, g.price, g.copies FROM games AS g LEFT JOIN ratings AS r on g.age_rating = r.id LEFT JOIN genres as x ON g.genre_id = x.id";
 	}
 
-	// Append a filter for genre if present
-	if (_obj_filter_genre.get_id() > 0 && _bool_admin_flag) {
-		str_status_sql = str_status_sql += " WHERE g.genre_id = " + std::to_string(_obj_filter_genre.get_id());
-	}
-	else if (_obj_filter_genre.get_id() > 0 && !_bool_admin_flag){
-		str_status_sql = str_status_sql += " AND g.genre_id = " + std::to_string(_obj_filter_genre.get_id());
-	}
-
 	// Iterate through result and add to vec_games
 	sqlite3_prepare_v2(_db, str_status_sql.c_str(), -1, &stmt_games, NULL);
 	while ((i_return_code = sqlite3_step(stmt_games)) == SQLITE_ROW) {
@@ -47,60 +58,112 @@ int GameManager::get_games() {
 			(char*)sqlite3_column_text(stmt_games, 1),
 			Genre(sqlite3_column_int(stmt_games, 4), (char*)sqlite3_column_text(stmt_games, 5)),
 			Rating(sqlite3_column_int(stmt_games, 2), (char*)sqlite3_column_text(stmt_games, 3)),
-			sqlite3_column_double(stmt_games, 6),
+			Money(sqlite3_column_int64(stmt_games, 6)),
 			sqlite3_column_int(stmt_games, 7));
 
-		_vec_games.push_back(obj_game);
+		vec_games.push_back(obj_game);
 	}
 
 	sqlite3_finalize(stmt_games);
+
+	std::shared_ptr<const CatalogSnapshot> ptr_current_catalog = get_catalog();
+	std::atomic_store(&_ptr_catalog, std::make_shared<const CatalogSnapshot>(ptr_current_catalog->get_version() + 1, std::move(vec_games)));
+
 	return i_return_code;
 }
 
-void GameManager::add_basket_item(PurchaseItem& obj_purchase_item) { 
-	// Get position of basket item and game
-	auto position = std::find_if(_obj_basket.get_vec_purchase_items().begin(), _obj_basket.get_vec_purchase_items().end(), [&obj_purchase_item](PurchaseItem& obj) { return obj.get_game_id() == obj_purchase_item.get_game_id(); });
-	auto game_position = std::find_if(_vec_games.begin(), _vec_games.end(), [&](Game& obj) { return obj.get_id() == obj_purchase_item.get_game_id(); });
+void GameManager::add_basket_item(Session& obj_session, PurchaseItem& obj_purchase_item) {
+	Basket& obj_basket = obj_session.get_basket();
+	PurchaseItem* ptr_current_item = obj_basket.find_item(obj_purchase_item.get_game_id());
 
-	if (position != _obj_basket.get_vec_purchase_items().end()) {
-		auto& obj_current_game = _obj_basket.get_vec_purchase_items().at(std::distance(_obj_basket.get_vec_purchase_items().begin(), position));
-		Game& obj_game = _vec_games.at(std::distance(_vec_games.begin(), game_position));
+	if (ptr_current_item != nullptr) {
+		std::shared_ptr<const CatalogSnapshot> ptr_catalog = get_catalog();
+		const Game* ptr_game = ptr_catalog->find_game(obj_purchase_item.get_game_id());
+		int i_available_copies = ptr_game != nullptr ? ptr_game->get_copies() : ptr_current_item->get_game().get_copies();
 
 		// Do not allow purchase item to be added to basket if this new count would be more than the available amount of games.
-		if (obj_current_game.get_count() + obj_purchase_item.get_count() > obj_game.get_copies()) {
+		if (ptr_current_item->get_count() + obj_purchase_item.get_count() > i_available_copies) {
 			throw std::runtime_error("Could not add " + std::to_string(obj_purchase_item.get_count()) + " copies of " + obj_purchase_item.get_game().get_name() + " as this would result in the basket count being more than the available games");
 		}
 
-		obj_current_game.set_count(obj_current_game.get_count() + obj_purchase_item.get_count());
+		obj_basket.set_item_count(obj_purchase_item.get_game_id(), ptr_current_item->get_count() + obj_purchase_item.get_count());
 	}
 	else {
 		// If game not currently in the basket, assume it is safe to add (count check is handled in UI)
-		_obj_basket.get_vec_purchase_items().push_back(obj_purchase_item);
+		obj_basket.add_item(obj_purchase_item);
+	}
+
+	if (_ptr_basket_journal && obj_basket.get_user_id() > 0) {
+		_ptr_basket_journal->record_add(obj_basket.get_user_id(), obj_purchase_item.get_game_id(), obj_basket.find_item(obj_purchase_item.get_game_id())->get_count());
 	}
 }
 
-void GameManager::remove_basket_item(int i_game_id) {
-	// Get the position of the purchase item in the basket
-	auto position = std::find_if(_obj_basket.get_vec_purchase_items().begin(), _obj_basket.get_vec_purchase_items().end(), [&i_game_id](PurchaseItem& obj) { return obj.get_game_id() == i_game_id; });
+void GameManager::remove_basket_item(Session& obj_session, int i_game_id) {
+	Basket& obj_basket = obj_session.get_basket();
 
-	// Remove the purchase item if found
-	if (position != _obj_basket.get_vec_purchase_items().end()) {
-		_obj_basket.get_vec_purchase_items().erase(position);
+	// Basket throws std::invalid_argument if the game is not in the basket
+	obj_basket.remove_item(i_game_id);
+
+	if (_ptr_basket_journal && obj_basket.get_user_id() > 0) {
+		_ptr_basket_journal->record_remove(obj_basket.get_user_id(), i_game_id);
 	}
-	else {
-		throw std::invalid_argument("Cannot remove game with id of " + std::to_string(i_game_id) + " from basket, item not found in basket.");
+}
+
+void GameManager::set_basket_item_count(Session& obj_session, int i_game_id, int i_count) {
+	Basket& obj_basket = obj_session.get_basket();
+	PurchaseItem* ptr_current_item = obj_basket.find_item(i_game_id);
+
+	if (ptr_current_item == nullptr) {
+		throw std::invalid_argument("Cannot update game with id of " + std::to_string(i_game_id) + " in basket, item not found in basket.");
+	}
+
+	// Check against the latest fetched copies where possible, otherwise the copies captured when the game was added
+	std::shared_ptr<const CatalogSnapshot> ptr_catalog = get_catalog();
+	const Game* ptr_game = ptr_catalog->find_game(i_game_id);
+	int i_available_copies = ptr_game != nullptr ? ptr_game->get_copies() : ptr_current_item->get_game().get_copies();
+
+	if (i_count > i_available_copies) {
+		throw std::runtime_error("Could not update basket to " + std::to_string(i_count) + " copies of " + ptr_current_item->get_game().get_name() + " as this would result in the basket count being more than the available games");
+	}
+
+	obj_basket.set_item_count(i_game_id, i_count);
+
+	if (_ptr_basket_journal && obj_basket.get_user_id() > 0) {
+		_ptr_basket_journal->record_set_count(obj_basket.get_user_id(), i_game_id, i_count);
 	}
 }
 
-double GameManager::get_basket_total() {
-	// Calculate total of all purchase items in the basket
-	return std::accumulate(_obj_basket.get_vec_purchase_items().begin(), _obj_basket.get_vec_purchase_items().end(), 0.0, [&](double total, PurchaseItem& item) {
-		return total + item.get_total();
-	});
+void GameManager::reset_basket(Session& obj_session) {
+	Basket& obj_basket = obj_session.get_basket();
+
+	obj_basket.clear();
+
+	if (_ptr_basket_journal && obj_basket.get_user_id() > 0) {
+		_ptr_basket_journal->record_clear(obj_basket.get_user_id());
+	}
 }
 
-void GameManager::reset_basket() {
-	_obj_basket.get_vec_purchase_items().clear();
+void GameManager::restore_basket(Session& obj_session, int i_user_id) {
+	Basket& obj_basket = obj_session.get_basket();
+
+	obj_basket.clear();
+	obj_basket.set_user_id(i_user_id);
+
+	if (!_ptr_basket_journal) return;
+
+	// Need the current games to rebuild the basket items from
+	refresh_games();
+	std::shared_ptr<const CatalogSnapshot> ptr_catalog = get_catalog();
+
+	for (auto& item : _ptr_basket_journal->load_basket(i_user_id)) {
+		const Game* ptr_game = ptr_catalog->find_game(item.first);
+		if (ptr_game == nullptr) continue;
+
+		int i_count = std::min(item.second, ptr_game->get_copies());
+		if (i_count < 1) continue;
+
+		obj_basket.add_item(PurchaseItem(ptr_game->get_id(), *ptr_game, i_count, ptr_game->get_price()));
+	}
 }
 
 void GameManager::add_game(Game& obj_game) {
@@ -117,7 +180,7 @@ void GameManager::add_game(Game& obj_game) {
 	sqlite3_bind_text(stmt_insert_game, 1, obj_game.get_name().c_str(), -1, SQLITE_TRANSIENT);
 	sqlite3_bind_int(stmt_insert_game, 2, obj_game.get_genre().get_id());
 	sqlite3_bind_int(stmt_insert_game, 3, obj_game.get_rating().get_id());
-	sqlite3_bind_double(stmt_insert_game, 4, obj_game.get_price());
+	sqlite3_bind_int64(stmt_insert_game, 4, obj_game.get_price().get_cents());
 	sqlite3_bind_int(stmt_insert_game, 5, obj_game.get_copies());
 
 	// Throw if insert does not produce expected result
@@ -215,7 +278,7 @@ void GameManager::update_game_genre(int i_game_id, int i_genre_id) {
 	sqlite3_finalize(stmt_update_genre);
 }
 
-void GameManager::update_game_price(int i_game_id, double d_price) {
+void GameManager::update_game_price(int i_game_id, Money obj_price) {
 	sqlite3_stmt* stmt_update_price;
 
 	// Update the game's based on the game price
@@ -227,7 +290,7 @@ void GameManager::update_game_price(int i_game_id, double d_price) {
 		throw std::runtime_error(str_error_msg);
 	}
 
-	if (sqlite3_bind_double(stmt_update_price, 1, d_price) != SQLITE_OK) {
+	if (sqlite3_bind_int64(stmt_update_price, 1, obj_price.get_cents()) != SQLITE_OK) {
 		std::string str_error_msg = "Error while binding price: ";
 		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
 		throw std::runtime_error(str_error_msg);
@@ -415,86 +478,65 @@ const std::vector<Genre> GameManager::get_genres() {
 	return vec_genres;
 }
 
-double GameManager::make_purchase() {
-	char* errorMessage;
-	// Get the grand total
-	double d_grand_total = get_basket_total();
-
-	// Build insert string for purchase
-	std::stringstream ss;
-	ss.setf(std::ios::fixed);
-	ss << "INSERT INTO purchases(user_id, total) VALUES (" << _obj_basket.get_user_id() << ", " << std::setprecision(2) << d_grand_total << ")";
-	std::string temp = ss.str();
+Money GameManager::make_purchase(Session& obj_session) {
+	Basket& obj_basket = obj_session.get_basket();
+	Money obj_grand_total;
 
-	// Insert purchase
-	if (sqlite3_exec(_db, ss.str().c_str(), NULL, NULL, &errorMessage) != SQLITE_OK) {
-		throw std::runtime_error(sqlite3_errmsg(_db));
+	if (_ptr_checkout_pipeline) {
+		// Queued alongside other sessions' checkouts and committed in the same transaction, get rethrows whatever stopped this basket
+		obj_grand_total = _ptr_checkout_pipeline->submit(obj_basket).get();
 	}
+	else {
+		// A connection of its own for this checkout, so a checkout from another session (or any other write on this manager's connection)
+		// is never made inside this basket's transaction
+		sqlite3* db_checkout = NULL;
 
-	// Get purchase Id (needed while inserting purchase items for this purchase
-	int i_purchase_id = (int)sqlite3_last_insert_rowid(_db);
-
-	sqlite3_stmt* stmt_insert_purchase_item;
-	std::string str_insert_purchase_item = "INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES (?, ?, ?, ?, ?, ?)";
+		if (_str_database_path.empty()) {
+			throw std::runtime_error("Purchases can only be made directly against a database file, set a checkout pipeline otherwise.");
+		}
 
-	if (sqlite3_prepare_v2(_db, str_insert_purchase_item.c_str(), -1, &stmt_insert_purchase_item, NULL) != SQLITE_OK) {
-		std::string str_error_msg = "Failed to prepare insert statement: ";
-		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
-		throw std::runtime_error(str_error_msg);
-	}
+		if (sqlite3_open_v2(_str_database_path.c_str(), &db_checkout, SQLITE_OPEN_READWRITE, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to open checkout connection: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db_checkout);
+			sqlite3_close(db_checkout);
+			throw std::runtime_error(str_error_msg);
+		}
 
-	// Insert each purchase item against the previously inserted purchase
-	for (auto& item : _obj_basket.get_vec_purchase_items()) {
-		sqlite3_bind_int(stmt_insert_purchase_item, 1, i_purchase_id);
-		sqlite3_bind_text(stmt_insert_purchase_item, 2, item.get_game().get_name().c_str(), -1, SQLITE_TRANSIENT);
-		sqlite3_bind_double(stmt_insert_purchase_item, 3, item.get_price());
-		sqlite3_bind_text(stmt_insert_purchase_item, 4, item.get_game().get_genre().get_genre().c_str(), -1, SQLITE_TRANSIENT);
-		sqlite3_bind_text(stmt_insert_purchase_item, 5, item.get_game().get_rating().get_rating().c_str(), -1, SQLITE_TRANSIENT);
-		sqlite3_bind_int(stmt_insert_purchase_item, 6, item.get_count());
+		// Waits for another session's checkout to finish rather than failing straight away
+		sqlite3_busy_timeout(db_checkout, DatabaseManager::BUSY_TIMEOUT_MS);
 
-		if (sqlite3_step(stmt_insert_purchase_item) != SQLITE_DONE) {
-			sqlite3_finalize(stmt_insert_purchase_item);
-			throw std::runtime_error("Something went wrong while performing an insert, please try again.");
+		try {
+			obj_grand_total = CheckoutPipeline::commit_basket(db_checkout, obj_basket);
+		}
+		catch (std::exception&) {
+			sqlite3_close(db_checkout);
+			throw;
 		}
 
-		// Reset to allow same statement to be reused
-		sqlite3_reset(stmt_insert_purchase_item);
+		sqlite3_close(db_checkout);
 	}
 
-	sqlite3_finalize(stmt_insert_purchase_item);
-
-	sqlite3_stmt* stmt_update_game_copies;
-	// Update the game available copies as well
-	std::string str_update_game_copies = "UPDATE games SET copies = ? WHERE id = ?";
-
-	if (sqlite3_prepare_v2(_db, str_update_game_copies.c_str(), -1, &stmt_update_game_copies, NULL) != SQLITE_OK) {
-		std::string str_error_msg = "Failed to prepare insert statement: ";
-		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
-		throw std::runtime_error(str_error_msg);
+	// The purchase has been made either way, if the new items cannot be read now the store and index pick them up the next time they load.
+	// Only a store or index that has been loaded is caught up, otherwise the first checkout would read every purchase item (and build the whole
+	// index) while the customer waits
+	if (_ptr_sales_store && _ptr_sales_store->get_row_count() > 0) {
+		try {
+			_ptr_sales_store->load_new(_db);
+		}
+		catch (std::exception&) {}
 	}
 
-	// For each of the purchase items, update the specified game's copies
-	for (auto& item : _obj_basket.get_vec_purchase_items()) {
-		sqlite3_bind_int(stmt_update_game_copies, 1, item.get_game().get_copies() - item.get_count());
-		sqlite3_bind_int(stmt_update_game_copies, 2, item.get_game().get_id());
-
-		if (sqlite3_step(stmt_update_game_copies) != SQLITE_DONE) {
-			sqlite3_finalize(stmt_update_game_copies);
-			throw std::runtime_error("Something went wrong while performing an update, please try again.");
+	if (_ptr_co_purchase_index && _ptr_co_purchase_index->is_loaded()) {
+		try {
+			_ptr_co_purchase_index->load_new(_db);
 		}
-
-		// Reset statement so it can be used multiple times in a row.
-		sqlite3_reset(stmt_update_game_copies);
+		catch (std::exception&) {}
 	}
 
-	sqlite3_finalize(stmt_update_game_copies);
-
-	return d_grand_total;
+	return obj_grand_total;
 }
 
 void GameManager::logout() {
 	// Used to reset state of GameManager when a user logs out
 	set_initialised(false);
-	set_filter_genre(Genre());
-	reset_basket();
 }
\ No newline at end of file
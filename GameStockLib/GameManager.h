@@ -3,32 +3,44 @@
 #include <algorithm>
 #include <stdexcept>
 #include <numeric>
-#include <sstream>
-#include <iomanip>
+#include <memory>
+#include <optional>
+#include <string>
 #include "sqlite3.h"
 #include "Game.h"
+#include "CatalogSnapshot.h"
 #include "Rating.h"
 #include "Genre.h"
-#include "Purchase.h"
 #include "PurchaseItem.h"
+#include "Basket.h"
+#include "Session.h"
+#include "BasketJournal.h"
+#include "SalesColumnStore.h"
+#include "CoPurchaseIndex.h"
+#include "CheckoutPipeline.h"
+#include "Money.h"
 
 /// <summary>
-/// Class that is used to perform operations against games, and against game sub objects, such as genre and rating
+/// Class that is used to perform operations against games, and against game sub objects, such as genre and rating. The manager holds no session
+/// of its own, basket operations act on the basket of the session provided, so one manager can serve any number of sessions.
 /// </summary>
 class GameManager
 {
 	sqlite3* _db;
-	std::vector<Game> _vec_games;
-	Purchase _obj_basket;
-	Genre _obj_filter_genre;
+	std::string _str_database_path;
+	std::shared_ptr<const CatalogSnapshot> _ptr_catalog = std::make_shared<const CatalogSnapshot>();
+	std::shared_ptr<BasketJournal> _ptr_basket_journal;
+	std::shared_ptr<SalesColumnStore> _ptr_sales_store;
+	std::shared_ptr<CoPurchaseIndex> _ptr_co_purchase_index;
+	std::shared_ptr<CheckoutPipeline> _ptr_checkout_pipeline;
 	bool _bool_initialised = false;
 	bool _bool_admin_flag = false;
 	int get_games();
 public:
-	GameManager(sqlite3* db) { _db = db; }
+	GameManager(sqlite3* db);
 
 	/// <summary>
-	/// Initialises the games into the internal class vector, only initialises when bool_initialised is false
+	/// Initialises the games into the internal class vector, only initialises when bool_initialised is false. All games are fetched, each session filters them by genre through the catalog.
 	/// </summary>
 	void initialise_games();
 
@@ -38,45 +50,86 @@ public:
 	void refresh_games();
 
 	/// <summary>
-	/// Returns the games found via the initialise/refresh methods
+	/// Returns the current catalog snapshot (the games found via the initialise/refresh methods). Safe to call from any thread while games are being refreshed,
+	/// the snapshot stays valid for as long as the returned pointer is held.
 	/// </summary>
 	/// <returns></returns>
-	std::vector<Game>& get_vec_games() { return _vec_games; }
+	std::shared_ptr<const CatalogSnapshot> get_catalog() const { return std::atomic_load(&_ptr_catalog); }
 
 	/// <summary>
-	/// Gets the basket instance (which is really just a purchase being re-purposed for this)
+	/// Returns a copy of the games found via the initialise/refresh methods. Copied as another session may fetch games (freeing the current snapshot)
+	/// at any time, hold the snapshot from get_catalog instead to read the games without copying them.
 	/// </summary>
 	/// <returns></returns>
-	Purchase& get_basket() { return _obj_basket; }
+	std::vector<Game> get_vec_games() const { return get_catalog()->get_vec_games(); }
 
 	/// <summary>
-	/// Sets the user id in the basket, which is needed when persisting any purchases
+	/// Returns a copy of the game with the provided id from the games found via the initialise/refresh methods, or nothing if it was not found
 	/// </summary>
+	/// <param name="i_game_id"></param>
+	/// <returns></returns>
+	std::optional<Game> find_game(int i_game_id) const;
+
+	/// <summary>
+	/// Sets the journal that basket changes are recorded to, baskets are only kept in memory if this is not set
+	/// </summary>
+	/// <param name="ptr_basket_journal"></param>
+	void set_basket_journal(std::shared_ptr<BasketJournal> ptr_basket_journal) { _ptr_basket_journal = ptr_basket_journal; }
+
+	/// <summary>
+	/// Sets the sales store that purchase items are appended to once a purchase is made, nothing is appended if this is not set
+	/// </summary>
+	/// <param name="ptr_sales_store"></param>
+	void set_sales_store(std::shared_ptr<SalesColumnStore> ptr_sales_store) { _ptr_sales_store = ptr_sales_store; }
+
+	/// <summary>
+	/// Sets the co-purchase index that purchases are added to once made, nothing is added if this is not set
+	/// </summary>
+	/// <param name="ptr_co_purchase_index"></param>
+	void set_co_purchase_index(std::shared_ptr<CoPurchaseIndex> ptr_co_purchase_index) { _ptr_co_purchase_index = ptr_co_purchase_index; }
+
+	/// <summary>
+	/// Sets the pipeline purchases are committed through, so checkouts from several sessions share a transaction. If this is not set, each purchase
+	/// is committed in its own transaction on a connection opened for that checkout alone, so checkouts from several sessions (and anything else
+	/// using this manager's connection) cannot end up in each other's transactions.
+	/// </summary>
+	/// <param name="ptr_checkout_pipeline"></param>
+	void set_checkout_pipeline(std::shared_ptr<CheckoutPipeline> ptr_checkout_pipeline) { _ptr_checkout_pipeline = ptr_checkout_pipeline; }
+
+	/// <summary>
+	/// Sets the basket user and restores their saved basket from the journal (if set). Games that no longer exist are dropped and counts are limited to the copies available.
+	/// </summary>
+	/// <param name="obj_session"></param>
 	/// <param name="i_user_id"></param>
-	void set_basket_user(int i_user_id) { _obj_basket.set_user_id(i_user_id); }
+	void restore_basket(Session& obj_session, int i_user_id);
 
 	/// <summary>
 	/// Adds a purchase item to the basket, combines purchase items if they are the same game, errors if count would be higher than available number of games.
 	/// </summary>
+	/// <param name="obj_session"></param>
 	/// <param name="obj_purhcase_item"></param>
-	void add_basket_item(PurchaseItem& obj_purhcase_item);
+	void add_basket_item(Session& obj_session, PurchaseItem& obj_purhcase_item);
 
 	/// <summary>
 	/// Removes a game from the basket (vec_purchase_items)
 	/// </summary>
+	/// <param name="obj_session"></param>
 	/// <param name="i_game_id"></param>
-	void remove_basket_item(int i_game_id);
+	void remove_basket_item(Session& obj_session, int i_game_id);
 
 	/// <summary>
-	/// Calculates the total of all the purcahse items within the basket
+	/// Sets the number of copies of a game in the basket (removing it if less than 1), errors if count would be higher than available number of games or the game is not in the basket.
 	/// </summary>
-	/// <returns></returns>
-	double get_basket_total();
+	/// <param name="obj_session"></param>
+	/// <param name="i_game_id"></param>
+	/// <param name="i_count"></param>
+	void set_basket_item_count(Session& obj_session, int i_game_id, int i_count);
 
 	/// <summary>
-	/// Clears the basket to allow it to be re-used within the same user session
+	/// Clears the basket to allow it to be re-used within the same user session, the saved basket is cleared as well
 	/// </summary>
-	void reset_basket();
+	/// <param name="obj_session"></param>
+	void reset_basket(Session& obj_session);
 
 	bool get_admin_flag() { return _bool_admin_flag; }
 
@@ -122,8 +175,8 @@ public:
 	/// Updates the specified game's price in the database
 	/// </summary>
 	/// <param name="i_game_id"></param>
-	/// <param name="d_price"></param>
-	void update_game_price(int i_game_id, double d_price);
+	/// <param name="obj_price"></param>
+	void update_game_price(int i_game_id, Money obj_price);
 
 	/// <summary>
 	/// Updates the specified game's rating in the database.
@@ -172,20 +225,15 @@ public:
 
 	/// <summary>
 	/// Used to persist items in a basket to the database, and update the number of copies available of games that have been purchased.
+	/// Goes through the checkout pipeline (if set), waiting until the batch the basket joined has been committed. Throws, committing nothing, if
+	/// any game in the basket no longer has enough copies (for instance when another session bought them first). The new purchase items are then appended to the sales store and co-purchase index (if set and already loaded).
 	/// </summary>
+	/// <param name="obj_session"></param>
 	/// <returns></returns>
-	double make_purchase();
-
-	Genre& get_filter_genre() { return _obj_filter_genre; }
-
-	/// <summary>
-	/// Sets the genre to filter by when fetching games from the database
-	/// </summary>
-	/// <param name="obj_filter_genre"></param>
-	void set_filter_genre(Genre obj_filter_genre) { _obj_filter_genre = obj_filter_genre; }
+	Money make_purchase(Session& obj_session);
 
 	/// <summary>
-	/// Performs the necessary actions to reset the GameManager's state upon a user logout.
+	/// Performs the necessary actions to reset the GameManager's state upon a user logout, the user's session is ended through the UserManager.
 	/// </summary>
 	void logout();
 };
@@ -0,0 +1,13 @@
+#include "GameSales.h"
+
+GameSales::GameSales() {
+	_i_game_id = 0;
+	_i_units = 0;
+}
+
+GameSales::GameSales(int i_game_id, std::string str_game_name, int i_units, Money obj_revenue) {
+	_i_game_id = i_game_id;
+	_str_game_name = str_game_name;
+	_i_units = i_units;
+	_obj_revenue = obj_revenue;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include "Money.h"
+
+/// <summary>
+/// Class used to store the copies sold (units) and revenue of a single game, as returned by the best seller lists
+/// </summary>
+class GameSales
+{
+	int _i_game_id;
+	std::string _str_game_name;
+	int _i_units;
+	Money _obj_revenue;
+public:
+	GameSales();
+	GameSales(int i_game_id, std::string str_game_name, int i_units, Money obj_revenue);
+
+	int get_game_id() { return _i_game_id; }
+
+	/// <summary>
+	/// Returns the game's current name, which may differ from the name it was purchased under if it has since been renamed
+	/// </summary>
+	/// <returns></returns>
+	std::string get_game_name() { return _str_game_name; }
+	int get_units() { return _i_units; }
+	Money get_revenue() { return _obj_revenue; }
+};
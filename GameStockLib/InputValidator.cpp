@@ -71,20 +71,67 @@ std::string validate::validate_string(int max_length, bool max_flag) {
 	}
 }
 
+std::string validate::check_string(const std::string& str_input, int min_length, int max_length) {
+	if (util::is_more_than(str_input.length(), (size_t)max_length)) {
+		return "To long, max length is " + std::to_string(max_length);
+	}
+	else if (util::is_less_than(str_input.length(), (size_t)min_length)) {
+		return "To short, min length is " + std::to_string(min_length);
+	}
+
+	return "";
+}
+
+std::string validate::check_full_name(const std::string& str_input, int min_length, int max_length) {
+	// Built once, as imports check a name on every line
+	static const std::regex full_name_regex("[A-Z].+ [A-Z].+", std::regex_constants::ECMAScript);
+	std::string strMessage = check_string(str_input, min_length, max_length);
+
+	if (strMessage.empty() && !std::regex_search(str_input, full_name_regex)) {
+		strMessage = "Provided name does not match expected format, e.g. John Doe";
+	}
+
+	return strMessage;
+}
+
+std::string validate::check_email(const std::string& str_input, int min_length, int max_length) {
+	static const std::regex email_regex("^[^\\s@]+@[^\\s@]+\\.[^\\s@]+$", std::regex_constants::ECMAScript);
+	std::string strMessage = check_string(str_input, min_length, max_length);
+
+	if (strMessage.empty() && !std::regex_search(str_input, email_regex)) {
+		strMessage = "Provided email does not match expected format, e.g. test@test.com";
+	}
+
+	return strMessage;
+}
+
+std::string validate::check_int(const std::string& str_input, int min_size, int max_size, int& i_value) {
+	int iInput;
+
+	try {
+		iInput = std::stoi(str_input);
+	}
+	catch (std::exception) {
+		return "Not a valid number";
+	}
+
+	if (!util::is_between(min_size, max_size, iInput)) {
+		return "Input not within valid range (" + std::to_string(min_size) + " to " + std::to_string(max_size) + ")";
+	}
+
+	i_value = iInput;
+	return "";
+}
+
 std::string validate::validate_string(int min_length, int max_length) {
 	std::string strInput;
 
 	while (true) {
-		std::string strMessage = "";
 		std::getline(std::cin, strInput);
+		std::string strMessage = check_string(strInput, min_length, max_length);
 
 		// Try again until provided user input in expected format
-		if (util::is_more_than(strInput.length(), (size_t)max_length)) {
-			strMessage = "To long, max length is " + std::to_string(max_length);
-			std::cout << strMessage << ", try again: ";
-		}
-		else if (util::is_less_than(strInput.length(), (size_t)min_length)) {
-			strMessage = "To short, min length is " + std::to_string(min_length);
+		if (!strMessage.empty()) {
 			std::cout << strMessage << ", try again: ";
 		}
 		else {
@@ -95,23 +142,13 @@ std::string validate::validate_string(int min_length, int max_length) {
 
 std::string validate::validate_full_name(int min_length, int max_length) {
 	std::string strInput;
-	std::regex full_name_regex("[A-Z].+ [A-Z].+", std::regex_constants::ECMAScript);
 
 	while (true) {
-		std::string strMessage = "";
 		std::getline(std::cin, strInput);
+		std::string strMessage = check_full_name(strInput, min_length, max_length);
 
 		// Try again until provided user input in expected format
-		if (util::is_more_than(strInput.length(), (size_t)max_length)) {
-			strMessage = "To long, max length is " + std::to_string(max_length);
-			std::cout << strMessage << ", try again: ";
-		}
-		else if (util::is_less_than(strInput.length(), (size_t)min_length)) {
-			strMessage = "To short, min length is " + std::to_string(min_length);
-			std::cout << strMessage << ", try again: ";
-		}
-		else if (!std::regex_search(strInput, full_name_regex)) {
-			strMessage = "Provided name does not match expected format, e.g. John Doe";
+		if (!strMessage.empty()) {
 			std::cout << strMessage << ", try again: ";
 		}
 		else {
@@ -122,23 +159,13 @@ std::string validate::validate_full_name(int min_length, int max_length) {
 
 std::string validate::validate_email(int min_length, int max_length) {
 	std::string strInput;
-	std::regex email_regex("^[^\\s@]+@[^\\s@]+\\.[^\\s@]+$", std::regex_constants::ECMAScript);
 
 	while (true) {
-		std::string strMessage = "";
 		std::getline(std::cin, strInput);
+		std::string strMessage = check_email(strInput, min_length, max_length);
 
 		// Try again until provided user input in expected format
-		if (util::is_more_than(strInput.length(), (size_t)max_length)) {
-			strMessage = "To long, max length is " + std::to_string(max_length);
-			std::cout << strMessage << ", try again: ";
-		}
-		else if (util::is_less_than(strInput.length(), (size_t)min_length)) {
-			strMessage = "To short, min length is " + std::to_string(min_length);
-			std::cout << strMessage << ", try again: ";
-		}
-		else if (!std::regex_search(strInput, email_regex)) {
-			strMessage = "Provided email does not match expected format, e.g. test@test.com";
+		if (!strMessage.empty()) {
 			std::cout << strMessage << ", try again: ";
 		}
 		else {
@@ -190,23 +217,18 @@ int validate::validate_int(int min_size) {
 
 int validate::validate_int(int min_size, int max_size) {
 	std::string strInput;
-	int iInput;
+	int iInput = 0;
 
 	while (true) {
 		std::getline(std::cin, strInput);
-		try {
-			iInput = std::stoi(strInput);
+		std::string strMessage = check_int(strInput, min_size, max_size, iInput);
 
-			if (!util::is_between(min_size, max_size, iInput)) {
-				std::cout << "Input not within valid range (" << min_size << " to " << max_size << ") : ";
-			}
-			else {
-				return iInput;
-			}
-		}
 		// Try again until provided user input in expected format
-		catch (std::exception) {
-			std::cout << "Not a valid number: ";
+		if (!strMessage.empty()) {
+			std::cout << strMessage << ": ";
+		}
+		else {
+			return iInput;
 		}
 	}
 }
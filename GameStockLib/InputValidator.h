@@ -70,6 +70,43 @@ namespace validate {
 	/// <returns></returns>
 	std::string validate_email(int min_length, int max_length);
 
+	/// <summary>
+	/// Checks a string is between the specified min and max lengths, without asking for input. Used by validate_string and by imports.
+	/// </summary>
+	/// <param name="str_input"></param>
+	/// <param name="min_length"></param>
+	/// <param name="max_length"></param>
+	/// <returns>Why the string is not valid, or an empty string if it is</returns>
+	std::string check_string(const std::string& str_input, int min_length, int max_length);
+
+	/// <summary>
+	/// Checks a full name is within length requirements and matches the expected two capital word format, without asking for input
+	/// </summary>
+	/// <param name="str_input"></param>
+	/// <param name="min_length"></param>
+	/// <param name="max_length"></param>
+	/// <returns>Why the name is not valid, or an empty string if it is</returns>
+	std::string check_full_name(const std::string& str_input, int min_length, int max_length);
+
+	/// <summary>
+	/// Checks an email is within length requirements and is in fact a valid email, without asking for input
+	/// </summary>
+	/// <param name="str_input"></param>
+	/// <param name="min_length"></param>
+	/// <param name="max_length"></param>
+	/// <returns>Why the email is not valid, or an empty string if it is</returns>
+	std::string check_email(const std::string& str_input, int min_length, int max_length);
+
+	/// <summary>
+	/// Checks a string is an int between or equal to the specified min and maximum values, without asking for input
+	/// </summary>
+	/// <param name="str_input"></param>
+	/// <param name="min_size"></param>
+	/// <param name="max_size"></param>
+	/// <param name="i_value">Set to the int on success</param>
+	/// <returns>Why the string is not valid, or an empty string if it is</returns>
+	std::string check_int(const std::string& str_input, int min_size, int max_size, int& i_value);
+
 	/// <summary>
 	/// Validates that user input is an integer value.
 	/// </summary>
@@ -77,31 +77,59 @@ void LoginMenu::execute() {
 
 	try {
 		// Attempt to login with provided details
-		_ptr_class_container.ptr_user_manager.attempt_login(obj_user);
-		bool bool_user_is_admin = _ptr_class_container.ptr_user_manager.get_current_user().get_is_admin();
+		_ptr_class_container.ptr_session = _ptr_class_container.ptr_user_manager.attempt_login(obj_user);
+		bool bool_user_is_admin = _ptr_class_container.ptr_session->get_user().get_is_admin();
+
+		// Pick up the basket from the user's last session
+		if (!bool_user_is_admin) {
+			_ptr_class_container.ptr_game_manager.restore_basket(*_ptr_class_container.ptr_session, _ptr_class_container.ptr_session->get_user().get_id());
+		}
 
 		// Display differnet menu options based on if user is an admin or not
-		MenuContainer obj_menu_container = MenuContainer("Logged in as " + obj_user.get_email() + ".\nChoose one of the below options.\n(Esc to logout)\n");
+		std::string str_menu_text = "Logged in as " + obj_user.get_email() + ".\nChoose one of the below options.\n(Esc to logout)\n";
+		MenuContainer obj_menu_container = MenuContainer(str_menu_text);
 		if (bool_user_is_admin) {
 			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ViewGamesMenu("Manage games", _ptr_class_container)));
 			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ManageGenresMenu("Manage genres", _ptr_class_container)));
 			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ManageUsersMenu("Manage users", _ptr_class_container)));
-			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new UserUpdateOptionsMenu("Manage account", _ptr_class_container, _ptr_class_container.ptr_user_manager.get_current_user())));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new UserUpdateOptionsMenu("Manage account", _ptr_class_container, _ptr_class_container.ptr_session->get_user())));
 			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new SelectUserPurchasesViewMenu("Purchase history and reports", _ptr_class_container)));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new SalesAnalyticsMenu("Sales analytics", _ptr_class_container)));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new SalesBreakdownMenu("Sales breakdown", _ptr_class_container)));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ArchivePurchasesMenu("Archive old purchases", _ptr_class_container)));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ViewReportJobsMenu("Report jobs", _ptr_class_container)));
 		}
 		else {
 			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ViewGamesMenu("View games", _ptr_class_container)));
-			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new UserUpdateOptionsMenu("Manage account", _ptr_class_container, _ptr_class_container.ptr_user_manager.get_current_user())));
-			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ViewUserPurchasesMenu("View purchase history", _ptr_class_container, _ptr_class_container.ptr_user_manager.get_current_user())));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new UserUpdateOptionsMenu("Manage account", _ptr_class_container, _ptr_class_container.ptr_session->get_user())));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ViewUserPurchasesMenu("View purchase history", _ptr_class_container, _ptr_class_container.ptr_session->get_user())));
+			obj_menu_container.add_menu_item(std::unique_ptr<MenuItem>(new ViewReportJobsMenu("Report jobs", _ptr_class_container)));
 		}
 
 		while (!obj_menu_container.get_exit_menu()) {
+			// Let the user know about any reports that have finished in the background since the menu was last shown
+			std::string str_report_notices;
+			for (std::shared_ptr<ReportJob>& ptr_job : _ptr_class_container.ptr_purchase_manager.take_finished_report_jobs()) {
+				if (ptr_job->get_status() == ReportJobStatus::Completed) {
+					str_report_notices += "Report ready: " + ptr_job->get_file_name() + " has been saved in the saves directory\n";
+				}
+				else if (ptr_job->get_status() == ReportJobStatus::Cancelled) {
+					str_report_notices += "Report cancelled: " + ptr_job->get_file_name() + "\n";
+				}
+				else {
+					str_report_notices += "Report failed: " + ptr_job->get_file_name() + " (" + ptr_job->get_error() + ")\n";
+				}
+			}
+
+			obj_menu_container.set_menu_text(str_report_notices.empty() ? str_menu_text : str_menu_text + "\n" + str_report_notices);
 			system("cls");
 			obj_menu_container.execute();
 		}
 
-		_ptr_class_container.ptr_user_manager.logout();
+		// The in-memory basket and genre filter are let go of with the session, the saved basket is restored on next login
+		_ptr_class_container.ptr_user_manager.logout(*_ptr_class_container.ptr_session);
 		_ptr_class_container.ptr_game_manager.logout();
+		_ptr_class_container.ptr_session = std::make_shared<Session>();
 	}
 	// If login fails, show error and allow user to come back and try again
 	catch (std::exception& ex) {
@@ -159,7 +187,7 @@ void ViewGamesMenu::execute() {
 	int i_highlighted_index = 0;
 	HANDLE h_output_console = GetStdHandle(STD_OUTPUT_HANDLE);
 	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
-	bool bool_user_is_admin = _ptr_class_container.ptr_user_manager.get_current_user().get_is_admin();
+	bool bool_user_is_admin = _ptr_class_container.ptr_session->get_user().get_is_admin();
 	int i_current_page = 0;
 	int i_page_size = 10;
 	int i_page_count = 0;
@@ -168,10 +196,12 @@ void ViewGamesMenu::execute() {
 		// Get current games
 		_ptr_class_container.ptr_game_manager.set_admin_flag(bool_user_is_admin);
 		_ptr_class_container.ptr_game_manager.initialise_games();
-		std::vector<Game>& vec_games = _ptr_class_container.ptr_game_manager.get_vec_games();
 		std::vector<Game> vec_paged_games;
 
 		while (key.wVirtualKeyCode != VK_ESCAPE) {
+			// Take the latest catalog each redraw, as games may have been refreshed since the last one
+			std::shared_ptr<const CatalogSnapshot> ptr_catalog = _ptr_class_container.ptr_game_manager.get_catalog();
+			const std::vector<Game> vec_games = ptr_catalog->get_games_in_genre(_ptr_class_container.ptr_session->get_filter_genre().get_id());
 			system("cls");
 			// Display different options based on if user is an admin or not
 			if (bool_user_is_admin) {
@@ -193,8 +223,8 @@ void ViewGamesMenu::execute() {
 				std::cout << "There are currently no games to display.\n";
 			}
 			else {
-				if (_ptr_class_container.ptr_game_manager.get_filter_genre().get_id() > 0) {
-					std::cout << "Current genre filter: " << _ptr_class_container.ptr_game_manager.get_filter_genre().get_genre() << "\n\n";
+				if (_ptr_class_container.ptr_session->get_filter_genre().get_id() > 0) {
+					std::cout << "Current genre filter: " << _ptr_class_container.ptr_session->get_filter_genre().get_genre() << "\n\n";
 				}
 
 				util::output_games_header();
@@ -254,7 +284,7 @@ void ViewGamesMenu::execute() {
 				break;
 			case VK_ESCAPE:
 				// Unset filter when leaving games page
-				_ptr_class_container.ptr_game_manager.set_filter_genre(Genre());
+				_ptr_class_container.ptr_session->set_filter_genre(Genre());
 				_ptr_class_container.ptr_game_manager.set_initialised(false);
 				return;
 			case VK_F1:
@@ -302,6 +332,24 @@ void ViewGamesMenu::execute() {
 							break;
 						}
 
+						// Customers who bought this also bought, only games within the games being shown are listed. Not being able to show them should not stop the purchase
+						try {
+							std::vector<CoPurchase> vec_recommendations = _ptr_class_container.ptr_purchase_manager.get_recommendations(obj_game.get_id(), 5);
+							int i_shown = 0;
+
+							for (CoPurchase& recommendation : vec_recommendations) {
+								const Game* ptr_recommended_game = ptr_catalog->find_game(recommendation.i_game_id);
+								if (ptr_recommended_game == nullptr || i_shown == 3) continue;
+
+								if (i_shown == 0) std::cout << "Customers who bought '" << obj_game.get_name() << "' also bought:\n";
+								std::cout << "  " << ptr_recommended_game->get_name() << "\n";
+								i_shown++;
+							}
+
+							if (i_shown > 0) std::cout << "\n";
+						}
+						catch (std::exception&) {}
+
 						int i_copies = 0;
 						std::cout << "Please enter the number of copies of '" << obj_game.get_name() << "' that you would like to add to your basket\n";
 						std::cout << "(Minimum 1, Maximum " << obj_game.get_copies() << ")\n";
@@ -311,7 +359,7 @@ void ViewGamesMenu::execute() {
 						try {
 							// Attempt to add selected game to basket
 							PurchaseItem obj_purchase_item = PurchaseItem(obj_game.get_id(), obj_game, i_copies, obj_game.get_price());
-							_ptr_class_container.ptr_game_manager.add_basket_item(obj_purchase_item);
+							_ptr_class_container.ptr_game_manager.add_basket_item(*_ptr_class_container.ptr_session, obj_purchase_item);
 
 							std::cout << i_copies << " copies of '" << obj_game.get_name() << "' succesfully added to basket.\n";
 							util::pause();
@@ -462,7 +510,7 @@ void AddGameMenu::execute() {
 	system("cls");
 	std::cout << "Please enter the price for '" << obj_game.get_name() << "'\n";
 	std::cout << "Game Price: ";
-	obj_game.set_price(validate::validate_double(0.0));
+	obj_game.set_price(Money::from_decimal(validate::validate_double(0.0)));
 	std::cout << "\n";
 
 	std::cout << "Please enter the number of available copies for '" << obj_game.get_name() << "'\n";
@@ -472,7 +520,7 @@ void AddGameMenu::execute() {
 	try {
 		// Attempt to add game, unset filter and re-initialise games upon success
 		_ptr_class_container.ptr_game_manager.add_game(obj_game);
-		_ptr_class_container.ptr_game_manager.set_filter_genre(Genre());
+		_ptr_class_container.ptr_session->set_filter_genre(Genre());
 		_ptr_class_container.ptr_game_manager.set_initialised(false);
 		_ptr_class_container.ptr_game_manager.initialise_games();
 		std::cout << "\n'" << obj_game.get_name() << "' successfully added\nGo to the manage game screen if you wish to manage this game.\n";
@@ -505,8 +553,8 @@ void SelectGenreFilterMenu::execute() {
 		system("cls");
 		std::cout << "Select genre to filter by\nNavigate with [Arrow Keys]\nPress [F1] to clear current filter\nPress [Enter] to select choice\nPress [Esc] to cancel.\n\n";
 
-		if (_ptr_class_container.ptr_game_manager.get_filter_genre().get_id() > 0) {
-			std::cout << "Current genre filter: " << _ptr_class_container.ptr_game_manager.get_filter_genre().get_genre() << "\n\n";
+		if (_ptr_class_container.ptr_session->get_filter_genre().get_id() > 0) {
+			std::cout << "Current genre filter: " << _ptr_class_container.ptr_session->get_filter_genre().get_genre() << "\n\n";
 		}
 
 		util::for_each_iterator(vec_genres.begin(), vec_genres.end(), 0, [&](int index, Genre& item) {
@@ -532,17 +580,14 @@ void SelectGenreFilterMenu::execute() {
 			break;
 		case VK_F1:
 			// Unset the current genre filter
-			_ptr_class_container.ptr_game_manager.set_filter_genre(Genre());
-			_ptr_class_container.ptr_game_manager.set_initialised(false);
-			_ptr_class_container.ptr_game_manager.initialise_games();
+			// The filter is applied to the catalog each time games are shown, so games do not need fetching again
+			_ptr_class_container.ptr_session->set_filter_genre(Genre());
 			break;
 		case VK_RETURN:
 			if ((int)vec_genres.size() - 1 >= i_highlighted_index && i_highlighted_index >= 0) {
 				// Set selected genre as the filter
 				Genre obj_genre = vec_genres[i_highlighted_index];
-				_ptr_class_container.ptr_game_manager.set_filter_genre(obj_genre);
-				_ptr_class_container.ptr_game_manager.set_initialised(false);
-				_ptr_class_container.ptr_game_manager.initialise_games();
+				_ptr_class_container.ptr_session->set_filter_genre(obj_genre);
 				return;
 			}
 			else {
@@ -559,13 +604,13 @@ void SelectGenreFilterMenu::execute() {
 }
 
 void ViewBasketMenu::execute() {
-	std::vector<PurchaseItem>& vec_basket_items = _ptr_class_container.ptr_game_manager.get_basket().get_vec_purchase_items();
+	Basket& obj_basket = _ptr_class_container.ptr_session->get_basket();
+	std::vector<PurchaseItem>& vec_basket_items = obj_basket.get_vec_purchase_items();
 
 	KEY_EVENT_RECORD key{};
 	int i_highlighted_index = 0;
 	HANDLE h_output_console = GetStdHandle(STD_OUTPUT_HANDLE);
 	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
-	double d_basket_total = _ptr_class_container.ptr_game_manager.get_basket_total();
 
 	// Display current basket state to user
 	while (key.wVirtualKeyCode != VK_ESCAPE) {
@@ -593,7 +638,10 @@ void ViewBasketMenu::execute() {
 				}
 				});
 
-			std::cout << "\nTotal: " << d_basket_total << "\n";
+			// Basket keeps its totals up to date, so these do not need recalculating each redraw
+			std::cout << "\nCopies: " << obj_basket.get_total_game_copies() << "\n";
+			std::cout << "Total (excl. VAT): " << obj_basket.get_total_before_vat() << "\n";
+			std::cout << "Total: " << obj_basket.get_total() << "\n";
 		}
 
 		while (!validate::get_control_char(key, h_input_console));
@@ -617,12 +665,13 @@ void ViewBasketMenu::execute() {
 
 			try {
 				// Attempt to persist basket to database
-				_ptr_class_container.ptr_game_manager.set_basket_user(_ptr_class_container.ptr_user_manager.get_user_id());
-				std::cout << "\nPurchase successfully placed totalling " << std::setprecision(2) << _ptr_class_container.ptr_game_manager.make_purchase() << "\n";
+				Session& obj_session = *_ptr_class_container.ptr_session;
+				obj_session.get_basket().set_user_id(obj_session.get_user().get_id());
+				std::cout << "\nPurchase successfully placed totalling " << std::setprecision(2) << _ptr_class_container.ptr_game_manager.make_purchase(obj_session) << "\n";
 				std::cout << "Please go to the main menu and 'View Purchase History' to see this invoice\n\n";
 				_ptr_class_container.ptr_game_manager.set_initialised(false);
 				_ptr_class_container.ptr_game_manager.initialise_games();
-				_ptr_class_container.ptr_game_manager.reset_basket();
+				_ptr_class_container.ptr_game_manager.reset_basket(obj_session);
 				util::pause();
 				return;
 			}
@@ -643,13 +692,12 @@ void ViewBasketMenu::execute() {
 				PurchaseItem obj_purchase_item = vec_basket_items[i_highlighted_index];
 				std::cout << "\nRemoving '" << obj_purchase_item.get_game().get_name() << "' from basket...\n";
 
-				_ptr_class_container.ptr_game_manager.remove_basket_item(obj_purchase_item.get_game_id());
+				_ptr_class_container.ptr_game_manager.remove_basket_item(*_ptr_class_container.ptr_session, obj_purchase_item.get_game_id());
 				if (i_highlighted_index > (int)vec_basket_items.size() - 1) {
 					i_highlighted_index--;
 				}
 
 				std::cout << "'" << obj_purchase_item.get_game().get_name() << "' removed from basket.\n";
-				d_basket_total = _ptr_class_container.ptr_game_manager.get_basket_total();
 				util::pause();
 				break;
 			}
@@ -817,19 +865,19 @@ void UpdateGameGenreMenu::execute() {
 }
 
 void UpdateGamePriceMenu::execute() {
-	double d_update_price = 0;
+	Money obj_update_price;
 
 	system("cls");
 	std::cout << "Updating game price of '" << _obj_game.get_name() << "' (Currently " << _obj_game.get_price() << ")\n\n";
 	std::cout << "Please enter new price : ";
-	d_update_price = validate::validate_double(0.0);
+	obj_update_price = Money::from_decimal(validate::validate_double(0.0));
 
 	try {
 		// Attempt to persist updated game's price
-		_ptr_class_container.ptr_game_manager.update_game_price(_obj_game.get_id(), d_update_price);
+		_ptr_class_container.ptr_game_manager.update_game_price(_obj_game.get_id(), obj_update_price);
 		_ptr_class_container.ptr_game_manager.set_initialised(false);
-		std::cout << "'" << _obj_game.get_name() << "' price updated to '" << std::setprecision(2) << d_update_price << "' successfully.\n";
-		_obj_game.set_price(d_update_price);
+		std::cout << "'" << _obj_game.get_name() << "' price updated to '" << std::setprecision(2) << obj_update_price << "' successfully.\n";
+		_obj_game.set_price(obj_update_price);
 		util::pause();
 	}
 	catch (std::exception& ex) {
@@ -1169,7 +1217,8 @@ void ManageUsersMenu::execute() {
 			std::cout << "Manage/Update users\n";
 			std::cout << "Use [Arrow Keys] to navigate users/pages, press [Enter] to select genre to manage\n";
 			std::cout << "Press [Esc] to go back\n";
-			std::cout << "Press [F1] to add new user\n\n";
+			std::cout << "Press [F1] to add new user\n";
+			std::cout << "Press [F2] to import users from a file\n\n";
 
 			std::cout << "NOTE: Users cannot be deleted, this is in order to preserve purchase history and maintain data integrity\n";
 			std::cout << "WARNING: Ensure that you leave at least one user with an admin status, otherwise once you log out there will not be any more admin users\n\n";
@@ -1240,6 +1289,34 @@ void ManageUsersMenu::execute() {
 				_ptr_class_container.ptr_user_manager.fetch_users();
 				vec_users = _ptr_class_container.ptr_user_manager.get_vec_users();
 				break;
+			case VK_F2:
+			{
+				// Import users listed one per line, reporting the lines that were not imported
+				system("cls");
+				std::cout << "Each line of the file should be a user's full name, age, email and password separated by commas, e.g. John Doe,25,john@doe.com,password123\n";
+				std::cout << "Enter the path of the file to import: ";
+				std::string str_import_path = validate::validate_string(1, 260);
+
+				try {
+					UserImportResult obj_result = _ptr_class_container.ptr_user_manager.import_users(std::filesystem::path(str_import_path));
+
+					std::cout << "\nImported " << obj_result.i_imported << " users\n";
+					for (UserImportIssue& issue : obj_result.vec_duplicates) {
+						std::cout << "Line " << issue.i_line_number << " not imported, " << issue.str_email << " is already registered\n";
+					}
+					for (UserImportIssue& issue : obj_result.vec_invalid) {
+						std::cout << "Line " << issue.i_line_number << " not imported: " << issue.str_reason << "\n";
+					}
+				}
+				catch (std::exception& ex) {
+					std::cout << "Error: " << ex.what() << "\n";
+				}
+
+				util::pause();
+				_ptr_class_container.ptr_user_manager.fetch_users();
+				vec_users = _ptr_class_container.ptr_user_manager.get_vec_users();
+				break;
+			}
 			case VK_RETURN:
 				if (vec_users.size() < 1) {
 					std::cout << "You cannot manage users when there are none to display.\n";
@@ -1560,16 +1637,19 @@ void ViewUserPurchasesMenu::execute() {
 	int i_highlighted_index = 0;
 	HANDLE h_output_console = GetStdHandle(STD_OUTPUT_HANDLE);
 	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
-	int i_current_page = 0;
 	int i_page_size = 10;
 	int i_page_count = 0;
-	bool bool_admin_status = _ptr_class_container.ptr_user_manager.get_current_user().get_is_admin();
+	bool bool_admin_status = _ptr_class_container.ptr_session->get_user().get_is_admin();
 
 	try {
-		// Fetch all purchases of provided user
-		_ptr_class_container.ptr_purchase_manager.fetch_purchases(_obj_user);
-		std::vector<Purchase>& vec_purchases = _ptr_class_container.ptr_purchase_manager.get_vec_purchases();
-		std::vector<Purchase> vec_paged_purchases;
+		// Only the current page of purchases is fetched, the count comes from the user's stats so the page count can be shown
+		UserPurchaseSummary obj_stats = _ptr_class_container.ptr_purchase_manager.get_user_purchase_stats(_obj_user);
+		i_page_count = (obj_stats.get_purchase_count() + i_page_size - 1) / i_page_size;
+
+		// Keys that each page visited so far starts after, going back a page is just removing the last key
+		std::vector<PurchasePageKey> vec_page_keys = { PurchasePageKey() };
+		PurchasePage obj_page = _ptr_class_container.ptr_purchase_manager.fetch_purchase_page(_obj_user, i_page_size, vec_page_keys.back());
+		std::vector<Purchase>& vec_paged_purchases = obj_page.get_vec_purchases();
 
 		// List found purchases to user
 		while (key.wVirtualKeyCode != VK_ESCAPE) {
@@ -1584,27 +1664,11 @@ void ViewUserPurchasesMenu::execute() {
 			std::cout << "Press [Esc] to go back\n";
 			std::cout << "Press [F1] to generate summary of all purchases\n\n";
 
-			if (vec_purchases.size() < 1) {
+			if (vec_paged_purchases.size() < 1) {
 				// This should not be possible, but leaving it here in case something goes wrong while fetching/paging users.
 				std::cout << "There are currently no purchases to display.\n";
 			}
 			else {
-				i_page_count = ((int)vec_purchases.size() + i_page_size - 1) / i_page_size;
-
-				// As protection from index overflows, reset current page if it is more than the zero-index adjusted page count
-				// This is really a mess, but I can't think of many better ways of doing it.
-				if (i_current_page > (i_page_count - 1)) i_current_page = 0;
-
-				int i_final_item = 0;
-				if (((i_current_page * 10) + 10) > (int)vec_purchases.size() - 1) {
-					i_final_item = (int)vec_purchases.size();
-				}
-				else {
-					i_final_item = ((i_current_page * 10) + 10);
-				}
-
-				vec_paged_purchases = std::vector<Purchase>(vec_purchases.begin() + (i_current_page * 10), vec_purchases.begin() + i_final_item);
-
 				util::output_purchase_header();
 				util::for_each_iterator(vec_paged_purchases.begin(), vec_paged_purchases.end(), 0, [&](int index, Purchase& item) {
 					if (i_highlighted_index == index) {
@@ -1617,7 +1681,9 @@ void ViewUserPurchasesMenu::execute() {
 					}
 					});
 
-				std::cout << "\nPage " << i_current_page + 1 << " of " << i_page_count << "\n";
+				// Purchases may have been made since the count was read, so never show fewer pages than have been visited
+				if (i_page_count < (int)vec_page_keys.size()) i_page_count = (int)vec_page_keys.size();
+				std::cout << "\nPage " << vec_page_keys.size() << " of " << i_page_count << "\n";
 			}
 
 			while (!validate::get_control_char(key, h_input_console));
@@ -1631,14 +1697,16 @@ void ViewUserPurchasesMenu::execute() {
 				if (i_highlighted_index > 0) i_highlighted_index--;
 				break;
 			case VK_LEFT:
-				if (i_current_page > 0) {
-					i_current_page--;
+				if (vec_page_keys.size() > 1) {
+					vec_page_keys.pop_back();
+					obj_page = _ptr_class_container.ptr_purchase_manager.fetch_purchase_page(_obj_user, i_page_size, vec_page_keys.back());
 					i_highlighted_index = 0;
 				}
 				break;
 			case VK_RIGHT:
-				if (i_current_page + 1 < i_page_count) {
-					i_current_page++;
+				if (obj_page.get_has_more()) {
+					vec_page_keys.push_back(obj_page.get_next_key());
+					obj_page = _ptr_class_container.ptr_purchase_manager.fetch_purchase_page(_obj_user, i_page_size, vec_page_keys.back());
 					i_highlighted_index = 0;
 				}
 				break;
@@ -1646,12 +1714,12 @@ void ViewUserPurchasesMenu::execute() {
 				return;
 			case VK_F1:
 				// Allow summary of purchases to only be shown when there is one or more purchase
-				if (vec_purchases.size() > 0) {
+				if (vec_paged_purchases.size() > 0) {
 					ViewUserPurchasesSummaryMenu("Purchase summary", _ptr_class_container, _obj_user).execute();
 				}
 				break;
 			case VK_RETURN:
-				if (vec_purchases.size() < 1) {
+				if (vec_paged_purchases.size() < 1) {
 					std::cout << "You cannot select a purchase when there are none to display.\n";
 					util::pause();
 					break;
@@ -1738,9 +1806,12 @@ void AllUserPurchaseSummaryMenu::execute() {
 	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
 
 	try {
+		// Fetch every user's purchases and totals in one go, rather than once per user
+		std::vector<UserPurchaseSummary> vec_summaries = _ptr_class_container.ptr_purchase_manager.get_user_purchase_summaries(_vec_users, true);
+
 		// Allow summary to be viewed until user presses escape
 		while (key.wVirtualKeyCode != VK_ESCAPE) {
-			double d_all_purchase_total = 0;
+			Money obj_all_purchase_total;
 			system("cls");
 			std::cout << "All user purchases summary\n";
 			std::cout << "This summary shows each user and if they have made any purchases displays each purchase with a calculated total.\nSee the end of the report for a grand total/average\n";
@@ -1748,9 +1819,9 @@ void AllUserPurchaseSummaryMenu::execute() {
 			// Assumes users are already popualted if we've got this far
 			util::for_each_iterator(_vec_users.begin(), _vec_users.end(), 0, [&](int index, User& user) {
 				std::cout << "\nSummary for user: " << user.get_email() << "\n\n";
-				// Fetch the purchases of this user
-				_ptr_class_container.ptr_purchase_manager.fetch_purchases(user);
-				std::vector<Purchase>& vec_user_purchases = _ptr_class_container.ptr_purchase_manager.get_vec_purchases();
+				// Summary is at the same position as the user
+				UserPurchaseSummary& obj_summary = vec_summaries[index];
+				std::vector<Purchase>& vec_user_purchases = obj_summary.get_vec_purchases();
 
 				if (vec_user_purchases.size() > 0) {
 					std::cout << "Purchases: \n";
@@ -1769,11 +1840,11 @@ void AllUserPurchaseSummaryMenu::execute() {
 					std::cout <<
 						std::fixed <<
 						std::setw(23) << std::left << "\nUser purchases total: " <<
-						std::setw(15) << std::left << _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total() <<
+						std::setw(15) << std::left << obj_summary.get_total() <<
 						std::setw(27) << std::left << "User purchases average: " <<
-						std::setw(15) << std::left << _ptr_class_container.ptr_purchase_manager.get_purchase_average() << "\n";
+						std::setw(15) << std::left << obj_summary.get_average() << "\n";
 
-					d_all_purchase_total = d_all_purchase_total + _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total();
+					obj_all_purchase_total = obj_all_purchase_total + obj_summary.get_total();
 				}
 				else {
 					std::cout << "This user has not yet made any purchases\n";
@@ -1782,13 +1853,15 @@ void AllUserPurchaseSummaryMenu::execute() {
 				});
 
 			// Output totals
-			std::cout << "\nAll purchases total: " << d_all_purchase_total << "\n";
-			std::cout << "All purchases average: " << d_all_purchase_total / _vec_users.size() << "\n";
+			std::cout << "\nAll purchases total: " << obj_all_purchase_total << "\n";
+			std::cout << "All purchases average: " << obj_all_purchase_total.divide_by((std::int64_t)_vec_users.size()) << "\n";
 
 			std::cout << "\nNOTE: The above average assumes that for users who have made no purchases the total of their purchases is zero.\n";
 
 			std::cout << "\nPress [Esc] to go back\n";
-			std::cout << "Press [F1] to generate all user purchases summary\n\n";
+			std::cout << "Press [F1] to generate all user purchases summary\n";
+			std::cout << "Press [F2] to export all purchases as CSV, [F3] as JSON or [F4] as columnar binary\n";
+			std::cout << "Press [F5] to generate all user purchase totals (only purchases made since it was last generated are added up)\n\n";
 
 			while (!validate::get_control_char(key, h_input_console));
 
@@ -1800,6 +1873,18 @@ void AllUserPurchaseSummaryMenu::execute() {
 				// Allow this summary to be saved to file.
 				AllUserPurchaseSaveMenu("Save all user purchase summary", _ptr_class_container, _vec_users).execute();
 				break;
+			case VK_F2:
+				PurchaseExportSaveMenu("Export all purchases", _ptr_class_container, PurchaseExportFormat::Csv).execute();
+				break;
+			case VK_F3:
+				PurchaseExportSaveMenu("Export all purchases", _ptr_class_container, PurchaseExportFormat::Ndjson).execute();
+				break;
+			case VK_F4:
+				PurchaseExportSaveMenu("Export all purchases", _ptr_class_container, PurchaseExportFormat::Columnar).execute();
+				break;
+			case VK_F5:
+				AllUserPurchaseTotalsSaveMenu("Save all user purchase totals", _ptr_class_container, _vec_users).execute();
+				break;
 			default:
 				break;
 			}
@@ -1816,14 +1901,7 @@ void ViewUserPurchasesSummaryMenu::execute() {
 	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
 
 	try {
-		// Get all the purchases for a user
-		_ptr_class_container.ptr_purchase_manager.fetch_purchases(_obj_user);
-		std::vector<Purchase>& vec_purchases = _ptr_class_container.ptr_purchase_manager.get_vec_purchases();
-
-		// Populate the purchase items/details for each of hte purchases 
-		for (Purchase& purchase : vec_purchases) {
-			_ptr_class_container.ptr_purchase_manager.populate_purchase_details(purchase);
-		}
+		UserPurchaseSummary obj_stats(_obj_user.get_id());
 
 		// List each purchase and it's purchase items/details to user
 		while (key.wVirtualKeyCode != VK_ESCAPE) {
@@ -1831,39 +1909,51 @@ void ViewUserPurchasesSummaryMenu::execute() {
 			std::cout << "Purchase summary for: " << _obj_user.get_email() << "\n";
 			std::cout << "\nBelow is a summary of each purchase made, the items in the purchase, total of the individual purchase, purchase total, game copies total and a grand total at the end.\n";
 
-			if (vec_purchases.size() < 1) {
-				// This should not be possible, but leaving it here in case something goes wrong.
-				std::cout << "There are currently no purchases to display.\n";
-			}
-			else {
-				util::for_each_iterator(vec_purchases.begin(), vec_purchases.end(), 0, [&](int index, Purchase& purchase) {
-					std::cout << "\n";
-					std::cout << "Purchase date: " << purchase.get_date() << "\n";
+			{
+				// The totals are read from the same snapshot as the purchases listed, so a checkout made part way through cannot leave them disagreeing.
+				// Totals are kept up to date by the database, so are looked up rather than worked out from every purchase
+				ReadSnapshot obj_snapshot = _ptr_class_container.ptr_purchase_manager.read_snapshot();
+				obj_stats = _ptr_class_container.ptr_purchase_manager.get_user_purchase_stats(_obj_user);
+
+				if (obj_stats.get_purchase_count() < 1) {
+					// This should not be possible, but leaving it here in case something goes wrong.
+					std::cout << "There are currently no purchases to display.\n";
+				}
+				else {
+					// Output each purchase as it is read, rather than loading them all first
+					PurchaseCursor obj_cursor = _ptr_class_container.ptr_purchase_manager.open_purchase_cursor(_obj_user, true);
+					Purchase purchase;
 
-					util::output_purchase_item_header();
-					for (PurchaseItem& purchase_item : purchase.get_vec_purchase_items()) {
-						util::output_purchase_item(purchase_item);
-					}
+					while (obj_cursor.next(purchase)) {
+						std::cout << "\n";
+						std::cout << "Purchase date: " << purchase.get_date() << "\n";
 
-					std::cout << "\n";
-					std::cout.precision(2);
-					std::cout <<
-						std::fixed <<
-						std::setw(16) << std::left << "Purchase total: " <<
-						std::setw(15) << std::left << purchase.get_total() <<
-						std::setw(19) << std::left << "Total Game copies: " <<
-						std::setw(10) << std::left << purchase.get_total_game_copies() << "\n";
-					std::cout << "_______________________________________________________________________________________________________\n";
-					});
+						util::output_purchase_item_header();
+						for (PurchaseItem& purchase_item : purchase.get_vec_purchase_items()) {
+							util::output_purchase_item(purchase_item);
+						}
+
+						std::cout << "\n";
+						std::cout.precision(2);
+						std::cout <<
+							std::fixed <<
+							std::setw(16) << std::left << "Purchase total: " <<
+							std::setw(15) << std::left << purchase.get_total() <<
+							std::setw(19) << std::left << "Total Game copies: " <<
+							std::setw(10) << std::left << purchase.get_total_game_copies() << "\n";
+						std::cout << "_______________________________________________________________________________________________________\n";
+					}
 
-				// Output totals
-				std::cout << std::setprecision(2) << std::fixed << "\nPurchases grand total: " << _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total() << "\n";
-				std::cout << std::setprecision(2) << std::fixed << "Purchases grand total (Before VAT): " << _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total() * 0.8 << "\n";
-				std::cout << std::setprecision(2) << std::fixed << "Average purchase total: " << _ptr_class_container.ptr_purchase_manager.get_purchase_average() << "\n";
-				std::cout << std::setprecision(2) << std::fixed << "Total game copies: " << _ptr_class_container.ptr_purchase_manager.get_total_game_copies() << "\n";
+					// Output totals
+					std::cout << std::setprecision(2) << std::fixed << "\nPurchases grand total: " << obj_stats.get_total() << "\n";
+					std::cout << std::setprecision(2) << std::fixed << "Purchases grand total (Before VAT): " << obj_stats.get_total().get_before_vat() << "\n";
+					std::cout << std::setprecision(2) << std::fixed << "Average purchase total: " << obj_stats.get_average() << "\n";
+					std::cout << std::setprecision(2) << std::fixed << "Total game copies: " << obj_stats.get_total_game_copies() << "\n";
 
-				std::cout << "\nPress [Esc] to go back\n";
-				std::cout << "Press [F1] to save this user purchases summary\n";
+					std::cout << "\nPress [Esc] to go back\n";
+					std::cout << "Press [F1] to save this user purchases summary\n";
+					std::cout << "Press [F2] to export these purchases as CSV, [F3] as JSON or [F4] as columnar binary\n";
+				}
 			}
 
 			while (!validate::get_control_char(key, h_input_console));
@@ -1874,7 +1964,16 @@ void ViewUserPurchasesSummaryMenu::execute() {
 				return;
 			case VK_F1:
 				// Allow user to save this summary as a text file
-				if (vec_purchases.size() > 0) ViewUserPurchasesSaveMenu("Save user purchases summary", _ptr_class_container, _obj_user).execute();
+				if (obj_stats.get_purchase_count() > 0) ViewUserPurchasesSaveMenu("Save user purchases summary", _ptr_class_container, _obj_user).execute();
+				break;
+			case VK_F2:
+				if (obj_stats.get_purchase_count() > 0) PurchaseExportSaveMenu("Export user purchases", _ptr_class_container, PurchaseExportFormat::Csv, _obj_user.get_id()).execute();
+				break;
+			case VK_F3:
+				if (obj_stats.get_purchase_count() > 0) PurchaseExportSaveMenu("Export user purchases", _ptr_class_container, PurchaseExportFormat::Ndjson, _obj_user.get_id()).execute();
+				break;
+			case VK_F4:
+				if (obj_stats.get_purchase_count() > 0) PurchaseExportSaveMenu("Export user purchases", _ptr_class_container, PurchaseExportFormat::Columnar, _obj_user.get_id()).execute();
 				break;
 			default:
 				break;
@@ -1891,64 +1990,45 @@ void AllUserPurchaseSaveMenu::execute() {
 	std::tm tm_current_datetime = util::get_current_datetime();
 	std::string str_current_datetime = util::tm_to_filesafe_str(tm_current_datetime);
 	std::string str_file_name = "AllUserPurchasesReport_" + str_current_datetime + ".txt";
-	std::filesystem::path path_file_to_write = _ptr_class_container.ptr_purchase_manager.get_saves_path() / str_file_name;
+	// The report is written after this menu has returned, so it is given copies of everything it needs
+	std::vector<User> vec_users = _vec_users;
+	std::string str_generated_by = _ptr_class_container.ptr_session->get_user().get_email();
 
 	std::cout << "\nAttempting to save all user purchases report...\n";
 
 	try {
-		_ptr_class_container.ptr_purchase_manager.ensure_save_directory_exists();
-		// Repeat same output logic ans normal all user purchase summary, but this time so it can be written to a text file
-		double d_all_purchase_total = 0;
-		std::ofstream of_stream(path_file_to_write);
-
-		of_stream.imbue(std::locale("en_GB"));
-		of_stream << "Report generated at: " << std::put_time(&tm_current_datetime, "%c") << "\n";
-		of_stream << "Report generated by: " << _ptr_class_container.ptr_user_manager.get_current_user().get_email() << "\n\n";
-
-		of_stream << "All user purchases summary\n";
-		of_stream << "This summary shows each user and if they have made any purchases displays each purchase with a calculated total.\nSee the end of the report for a grand total/average\n";
-
-		util::for_each_iterator(_vec_users.begin(), _vec_users.end(), 0, [&](int index, User& user) {
-			of_stream << "\nSummary for user: " << user.get_email() << "\n\n";
-			_ptr_class_container.ptr_purchase_manager.fetch_purchases(user);
-			std::vector<Purchase>& vec_user_purchases = _ptr_class_container.ptr_purchase_manager.get_vec_purchases();
-
-			if (vec_user_purchases.size() > 0) {
-				of_stream << "Purchases: \n";
-				for (Purchase& purchase : vec_user_purchases) {
-					of_stream.precision(2);
-					of_stream <<
-						std::fixed <<
-						std::setw(6) << std::left << "Date: " <<
-						std::setw(25) << std::left << purchase.get_date() <<
-						std::setw(7) << std::left << "Total: " <<
-						std::setw(15) << std::left << purchase.get_total() << "\n";
-				}
-
-				of_stream.precision(2);
-				of_stream <<
-					std::fixed <<
-					std::setw(23) << std::left << "\nUser purchases total: " <<
-					std::setw(15) << std::left << _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total() <<
-					std::setw(27) << std::left << "User purchases average: " <<
-					std::setw(15) << std::left << _ptr_class_container.ptr_purchase_manager.get_purchase_average() << "\n";
+		_ptr_class_container.ptr_purchase_manager.queue_report(str_file_name, "users", (int)vec_users.size(), [=](ReportJob& obj_job, sqlite3* db, std::ostream& os) mutable {
+			os.imbue(std::locale("en_GB"));
+			os << "Report generated at: " << std::put_time(&tm_current_datetime, "%c") << "\n";
+			os << "Report generated by: " << str_generated_by << "\n\n";
 
-				d_all_purchase_total = d_all_purchase_total + _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total();
-			}
-			else {
-				of_stream << "This user has not yet made any purchases\n";
-			}
-			of_stream << "__________________________________________________________________________________________\n";
+			// Same output as the all user purchase summary, but built across several threads as it can take a while for a large number of users
+			AllUserReportBuilder(db).build(vec_users, os, &obj_job);
 			});
 
-		of_stream << "\nAll purchases total: " << d_all_purchase_total << "\n";
-		of_stream << "All purchases average: " << d_all_purchase_total / _vec_users.size() << "\n";
+		std::cout << "All user purchases report is being saved in the background as " << str_file_name << "\n";
+		std::cout << "You will be told when it is ready, its progress can be followed from Report jobs\n";
+		std::cout << "NOTE: The location for this save is in the saves directory where the GameStock.exe was run from\n\n";
+		util::pause();
+	}
+	catch (std::exception& ex) {
+		std::cout << "Error: " << ex.what() << "\n";
+		util::pause();
+	}
+}
+
+void AllUserPurchaseTotalsSaveMenu::execute() {
+	std::tm tm_current_datetime = util::get_current_datetime();
+	std::string str_current_datetime = util::tm_to_filesafe_str(tm_current_datetime);
+	std::string str_file_name = "AllUserPurchaseTotalsReport_" + str_current_datetime + ".txt";
 
-		of_stream << "\nNOTE: The above average assumes that for users who have made no purchases the total of their purchases is zero.\n";
+	std::cout << "\nAttempting to save all user purchase totals report...\n";
 
-		of_stream.close();
+	try {
+		_ptr_class_container.ptr_purchase_manager.queue_incremental_report(str_file_name, "all_user_totals");
 
-		std::cout << "All user purchases report saved as " << str_file_name << "\n";
+		std::cout << "All user purchase totals report is being saved in the background as " << str_file_name << "\n";
+		std::cout << "You will be told when it is ready, its progress can be followed from Report jobs\n";
 		std::cout << "NOTE: The location for this save is in the saves directory where the GameStock.exe was run from\n\n";
 		util::pause();
 	}
@@ -1962,51 +2042,68 @@ void ViewUserPurchasesSaveMenu::execute() {
 	std::tm tm_current_datetime = util::get_current_datetime();
 	std::string str_current_datetime = util::tm_to_filesafe_str(tm_current_datetime);
 	std::string str_file_name = "UserPurchasesReport_" + str_current_datetime + ".txt";
-	std::filesystem::path path_file_to_write = _ptr_class_container.ptr_purchase_manager.get_saves_path() / str_file_name;
+	// The report is written after this menu has returned, so it is given copies of everything it needs
+	User obj_user = _obj_user;
+	std::string str_generated_by = _ptr_class_container.ptr_session->get_user().get_email();
 
 	std::cout << "\nAttempting to save user purchases report...\n";
 
 	try {
-		_ptr_class_container.ptr_purchase_manager.ensure_save_directory_exists();
-		// Repeat same logic as normal user purchases summary menu, but this time output to a file. Assume purchases have already had their details populated if we've got this far
-		std::vector<Purchase>& vec_purchases = _ptr_class_container.ptr_purchase_manager.get_vec_purchases();
-		std::ofstream of_stream(path_file_to_write);
+		int i_purchase_count = _ptr_class_container.ptr_purchase_manager.get_user_purchase_stats(obj_user).get_purchase_count();
+
+		_ptr_class_container.ptr_purchase_manager.queue_report(str_file_name, "purchases", i_purchase_count, [=](ReportJob& obj_job, sqlite3* db, std::ostream& os) mutable {
+			// Repeat same logic as normal user purchases summary menu, but this time output to a file. Purchases are written as they are read so the whole history is never held in memory
+			PurchaseManager obj_purchase_manager(db);
+			PurchaseCursor obj_cursor = obj_purchase_manager.open_purchase_cursor(obj_user, true);
+			Purchase purchase;
+
+			os.imbue(std::locale("en_GB"));
+			os << "Report generated at: " << std::put_time(&tm_current_datetime, "%c") << "\n";
+			os << "Report generated by: " << str_generated_by << "\n\n";
+
+			os << "Purchase summary for: " << obj_user.get_email() << "\n";
+			os << "\nBelow is a summary of each purchase made, the items in the purchase, total of the individual purchase, purchase total, game copies total and a grand total at the end.\n";
+
+			// Purchase rows are collected by the formatter and written to the file in large blocks
+			RowFormatter obj_formatter(os);
+
+			while (!obj_job.is_cancel_requested() && obj_cursor.next(purchase)) {
+				std::int64_t ll_purchase_start = obj_formatter.get_bytes_written();
 
-		of_stream.imbue(std::locale("en_GB"));
-		of_stream << "Report generated at: " << std::put_time(&tm_current_datetime, "%c") << "\n";
-		of_stream << "Report generated by: " << _ptr_class_container.ptr_user_manager.get_current_user().get_email() << "\n\n";
+				obj_formatter.end_row();
+				obj_formatter.text("Purchase date: ").text(purchase.get_date()).end_row();
 
-		of_stream << "Purchase summary for: " << _obj_user.get_email() << "\n";
-		of_stream << "\nBelow is a summary of each purchase made, the items in the purchase, total of the individual purchase, purchase total, game copies total and a grand total at the end.\n";
+				util::output_purchase_item_header(obj_formatter);
+				for (PurchaseItem& purchase_item : purchase.get_vec_purchase_items()) {
+					util::output_purchase_item(purchase_item, obj_formatter);
+				}
 
-		util::for_each_iterator(vec_purchases.begin(), vec_purchases.end(), 0, [&](int index, Purchase& purchase) {
-			of_stream << "\n";
-			of_stream << "Purchase date: " << purchase.get_date() << "\n";
+				obj_formatter.end_row();
+				obj_formatter
+					.text("Purchase total: ", 16)
+					.money(purchase.get_total(), 15)
+					.text("Total Game copies: ", 19)
+					.integer(purchase.get_total_game_copies(), 10)
+					.end_row();
+				obj_formatter.text("_______________________________________________________________________________________________________").end_row();
 
-			util::output_purchase_item_header(of_stream);
-			for (PurchaseItem& purchase_item : purchase.get_vec_purchase_items()) {
-				util::output_purchase_item(purchase_item, of_stream);
+				obj_job.add_progress(1, obj_formatter.get_bytes_written() - ll_purchase_start);
 			}
 
-			of_stream << "\n";
-			of_stream.precision(2);
-			of_stream <<
-				std::fixed <<
-				std::setw(16) << std::left << "Purchase total: " <<
-				std::setw(15) << std::left << purchase.get_total() <<
-				std::setw(19) << std::left << "Total Game copies: " <<
-				std::setw(10) << std::left << purchase.get_total_game_copies() << "\n";
-			of_stream << "_______________________________________________________________________________________________________\n";
-			});
+			if (obj_job.is_cancel_requested()) return;
 
-		of_stream << std::setprecision(2) << std::fixed << "\nPurchases grand total: " << _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total() << "\n";
-		of_stream << std::setprecision(2) << std::fixed << "Purchases grand total (Before VAT): " << _ptr_class_container.ptr_purchase_manager.get_purchase_grand_total() * 0.8 << "\n";
-		of_stream << std::setprecision(2) << std::fixed << "Average purchase total: " << _ptr_class_container.ptr_purchase_manager.get_purchase_average() << "\n";
-		of_stream << std::setprecision(2) << std::fixed << "Total game copies: " << _ptr_class_container.ptr_purchase_manager.get_total_game_copies() << "\n";
+			obj_formatter.flush();
 
-		of_stream.close();
+			// Totals are kept up to date by the database, so are looked up rather than worked out from every purchase
+			UserPurchaseSummary obj_stats = obj_purchase_manager.get_user_purchase_stats(obj_user);
+			os << std::setprecision(2) << std::fixed << "\nPurchases grand total: " << obj_stats.get_total() << "\n";
+			os << std::setprecision(2) << std::fixed << "Purchases grand total (Before VAT): " << obj_stats.get_total().get_before_vat() << "\n";
+			os << std::setprecision(2) << std::fixed << "Average purchase total: " << obj_stats.get_average() << "\n";
+			os << std::setprecision(2) << std::fixed << "Total game copies: " << obj_stats.get_total_game_copies() << "\n";
+			});
 
-		std::cout << "User purchases report saved as " << str_file_name << "\n";
+		std::cout << "User purchases report is being saved in the background as " << str_file_name << "\n";
+		std::cout << "You will be told when it is ready, its progress can be followed from Report jobs\n";
 		std::cout << "NOTE: The location for this save is in the saves directory where the GameStock.exe was run from\n\n";
 		util::pause();
 	}
@@ -2020,38 +2117,65 @@ void ViewUserPurchaseItemsSaveMenu::execute() {
 	std::tm tm_current_datetime = util::get_current_datetime();
 	std::string str_current_datetime = util::tm_to_filesafe_str(tm_current_datetime);
 	std::string str_file_name = "PurchaseReport_" + str_current_datetime + ".txt";
-	std::filesystem::path path_file_to_write = _ptr_class_container.ptr_purchase_manager.get_saves_path() / str_file_name;
+	// The report is written after this menu has returned, so it is given copies of everything it needs
+	Purchase obj_purchase = _obj_purchase;
+	std::string str_generated_by = _ptr_class_container.ptr_session->get_user().get_email();
 
 	std::cout << "\nAttempting to save purchase items report...\n";
 
 	try {
-		_ptr_class_container.ptr_purchase_manager.ensure_save_directory_exists();
-		// Output the same as the purchase items summary, but this time to a file, assuming that purchase items for a provided purchase have already been fetched if we've got this far.
-		std::vector<PurchaseItem>& vec_purchase_items = _obj_purchase.get_vec_purchase_items();
-		std::ofstream of_stream(path_file_to_write);
+		_ptr_class_container.ptr_purchase_manager.queue_report(str_file_name, "items", (int)obj_purchase.get_vec_purchase_items().size(), [=](ReportJob& obj_job, sqlite3*, std::ostream& os) mutable {
+			// Output the same as the purchase items summary, but this time to a file, assuming that purchase items for a provided purchase have already been fetched if we've got this far.
+			std::vector<PurchaseItem>& vec_purchase_items = obj_purchase.get_vec_purchase_items();
+
+			os.imbue(std::locale("en_GB"));
+			os << "Report generated at: " << std::put_time(&tm_current_datetime, "%c") << "\n";
+			os << "Report generated by: " << str_generated_by << "\n\n";
+			os << "Summary of purchase placed on: " << obj_purchase.get_date() << "\n";
 
-		of_stream.imbue(std::locale("en_GB"));
-		of_stream << "Report generated at: " << std::put_time(&tm_current_datetime, "%c") << "\n";
-		of_stream << "Report generated by: " << _ptr_class_container.ptr_user_manager.get_current_user().get_email() << "\n\n";
-		of_stream << "Summary of purchase placed on: " << _obj_purchase.get_date() << "\n";
+			RowFormatter obj_formatter(os);
 
-		util::output_purchase_item_header(of_stream);
-		util::for_each_iterator(vec_purchase_items.begin(), vec_purchase_items.end(), 0, [&](int index, PurchaseItem& item) {
-			util::output_purchase_item(item, of_stream);
+			util::output_purchase_item_header(obj_formatter);
+			for (PurchaseItem& item : vec_purchase_items) {
+				if (obj_job.is_cancel_requested()) return;
+
+				std::int64_t ll_item_start = obj_formatter.get_bytes_written();
+				util::output_purchase_item(item, obj_formatter);
+				obj_job.add_progress(1, obj_formatter.get_bytes_written() - ll_item_start);
+			}
+
+			obj_formatter.end_row();
+			obj_formatter
+				.text("Purchase total: ", 16)
+				.money(obj_purchase.get_total(), 15)
+				.text("Total Game copies: ", 19)
+				.integer(obj_purchase.get_total_game_copies(), 10)
+				.end_row();
 			});
 
-		of_stream << "\n";
-		of_stream.precision(2);
-		of_stream <<
-			std::fixed <<
-			std::setw(16) << std::left << "Purchase total: " <<
-			std::setw(15) << std::left << _obj_purchase.get_total() <<
-			std::setw(19) << std::left << "Total Game copies: " <<
-			std::setw(10) << std::left << _obj_purchase.get_total_game_copies() << "\n";
+		std::cout << "Purchase Items report is being saved in the background as " << str_file_name << "\n";
+		std::cout << "You will be told when it is ready, its progress can be followed from Report jobs\n";
+		std::cout << "NOTE: The location for this save is in the saves directory where the GameStock.exe was run from\n\n";
+		util::pause();
+	}
+	catch (std::exception& ex) {
+		std::cout << "Error: " << ex.what() << "\n";
+		util::pause();
+	}
+}
+
+void PurchaseExportSaveMenu::execute() {
+	std::tm tm_current_datetime = util::get_current_datetime();
+	std::string str_current_datetime = util::tm_to_filesafe_str(tm_current_datetime);
+	std::string str_file_name = (_i_user_id == 0 ? "AllPurchasesExport_" : "UserPurchasesExport_") + str_current_datetime;
 
-		of_stream.close();
+	std::cout << "\nAttempting to export purchases...\n";
+
+	try {
+		std::shared_ptr<ReportJob> ptr_job = _ptr_class_container.ptr_purchase_manager.queue_purchase_export(str_file_name, _format, _i_user_id);
 
-		std::cout << "Purchase Items report saved as " << str_file_name << "\n";
+		std::cout << "Purchases are being exported in the background as " << ptr_job->get_file_name() << "\n";
+		std::cout << "You will be told when it is ready, its progress can be followed from Report jobs\n";
 		std::cout << "NOTE: The location for this save is in the saves directory where the GameStock.exe was run from\n\n";
 		util::pause();
 	}
@@ -2059,4 +2183,196 @@ void ViewUserPurchaseItemsSaveMenu::execute() {
 		std::cout << "Error: " << ex.what() << "\n";
 		util::pause();
 	}
+}
+
+void SalesAnalyticsMenu::execute() {
+	KEY_EVENT_RECORD key{};
+	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
+	SalesPeriod period = SalesPeriod::Month;
+
+	try {
+		while (key.wVirtualKeyCode != VK_ESCAPE) {
+			// Show the most recent periods up to and including the current one, alongside the same periods a year earlier
+			int i_period_count = period == SalesPeriod::Day ? 30 : 12;
+			int i_periods_per_year = period == SalesPeriod::Day ? 364 : (period == SalesPeriod::Week ? 52 : 12);
+			std::int64_t ll_current_start = SalesBucket::get_period_start(period, (std::int64_t)std::time(nullptr));
+			std::int64_t ll_from = SalesBucket::add_periods(period, ll_current_start, 1 - i_period_count);
+			std::int64_t ll_to = SalesBucket::add_periods(period, ll_current_start, 1);
+
+			std::vector<SalesBucket> vec_sales = _ptr_class_container.ptr_purchase_manager.get_sales(period, ll_from, ll_to);
+			std::vector<SalesBucket> vec_year_earlier_sales = _ptr_class_container.ptr_purchase_manager.get_sales(period, SalesBucket::add_periods(period, ll_from, -i_periods_per_year), SalesBucket::add_periods(period, ll_to, -i_periods_per_year));
+
+			system("cls");
+			std::cout << "Sales analytics (UTC)\n";
+			std::cout << "Press [F1] for daily sales over the last 30 days, [F2] for weekly sales over the last 12 weeks or [F3] for monthly sales over the last 12 months\n";
+			std::cout << "Press [Esc] to go back\n\n";
+
+			util::output_sales_header();
+			for (size_t i = 0; i < vec_sales.size() && i < vec_year_earlier_sales.size(); i++) {
+				util::output_sales_bucket(vec_sales[i], period, vec_year_earlier_sales[i]);
+			}
+
+			while (!validate::get_control_char(key, h_input_console));
+
+			switch (key.wVirtualKeyCode)
+			{
+			case VK_F1:
+				period = SalesPeriod::Day;
+				break;
+			case VK_F2:
+				period = SalesPeriod::Week;
+				break;
+			case VK_F3:
+				period = SalesPeriod::Month;
+				break;
+			case VK_ESCAPE:
+				return;
+			default:
+				break;
+			}
+		}
+	}
+	catch (std::exception& ex) {
+		std::cout << "Error: " << ex.what() << "\n";
+		util::pause();
+	}
+}
+
+void SalesBreakdownMenu::execute() {
+	KEY_EVENT_RECORD key{};
+	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
+	SalesDimension dimension = SalesDimension::Genre;
+
+	try {
+		while (key.wVirtualKeyCode != VK_ESCAPE) {
+			std::vector<SalesGroup> vec_groups = _ptr_class_container.ptr_purchase_manager.get_sales_breakdown(dimension, INT64_MIN, INT64_MAX);
+			Money obj_total_revenue = std::accumulate(vec_groups.begin(), vec_groups.end(), Money(), [](Money total, SalesGroup& group) {
+				return total + group.obj_revenue;
+			});
+
+			system("cls");
+			std::cout << "Sales breakdown (all time)\n";
+			std::cout << "Press [F1] to break down by genre, [F2] by age rating or [F3] by price band\n";
+			std::cout << "Press [Esc] to go back\n\n";
+
+			util::output_sales_group_header(dimension == SalesDimension::Genre ? "Genre" : (dimension == SalesDimension::Rating ? "Age rating" : "Price band"));
+			for (SalesGroup& group : vec_groups) {
+				util::output_sales_group(group, obj_total_revenue);
+			}
+
+			if (vec_groups.empty()) {
+				std::cout << "There have been no sales yet.\n";
+			}
+
+			while (!validate::get_control_char(key, h_input_console));
+
+			switch (key.wVirtualKeyCode)
+			{
+			case VK_F1:
+				dimension = SalesDimension::Genre;
+				break;
+			case VK_F2:
+				dimension = SalesDimension::Rating;
+				break;
+			case VK_F3:
+				dimension = SalesDimension::PriceBand;
+				break;
+			case VK_ESCAPE:
+				return;
+			default:
+				break;
+			}
+		}
+	}
+	catch (std::exception& ex) {
+		std::cout << "Error: " << ex.what() << "\n";
+		util::pause();
+	}
+}
+
+void ViewReportJobsMenu::execute() {
+	KEY_EVENT_RECORD key{};
+	int i_highlighted_index = 0;
+	HANDLE h_output_console = GetStdHandle(STD_OUTPUT_HANDLE);
+	HANDLE h_input_console = GetStdHandle(STD_INPUT_HANDLE);
+
+	try {
+		// List the report jobs, progress is read again each time a key is pressed
+		while (key.wVirtualKeyCode != VK_ESCAPE) {
+			std::vector<std::shared_ptr<ReportJob>> vec_jobs = _ptr_class_container.ptr_purchase_manager.get_report_jobs();
+
+			system("cls");
+			std::cout << "Reports saved in the background\n";
+			std::cout << "Use [Arrow Keys] to navigate reports, press [Delete] to cancel the highlighted report, press any other key to refresh\n";
+			std::cout << "Press [Esc] to go back\n\n";
+
+			if (vec_jobs.size() < 1) {
+				std::cout << "There are currently no reports to display.\n";
+			}
+			else {
+				util::output_report_jobs_header();
+				util::for_each_iterator(vec_jobs.begin(), vec_jobs.end(), 0, [&](int index, std::shared_ptr<ReportJob>& ptr_job) {
+					if (i_highlighted_index == index) {
+						SetConsoleTextAttribute(h_output_console, BACKGROUND_BLUE | FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED | FOREGROUND_INTENSITY | BACKGROUND_INTENSITY);
+						util::output_report_job(*ptr_job);
+						SetConsoleTextAttribute(h_output_console, FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED);
+					}
+					else {
+						util::output_report_job(*ptr_job);
+					}
+					});
+			}
+
+			while (!validate::get_control_char(key, h_input_console));
+
+			switch (key.wVirtualKeyCode)
+			{
+			case VK_DOWN:
+				if (i_highlighted_index < (int)vec_jobs.size() - 1) i_highlighted_index++;
+				break;
+			case VK_UP:
+				if (i_highlighted_index > 0) i_highlighted_index--;
+				break;
+			case VK_DELETE:
+				if ((int)vec_jobs.size() - 1 >= i_highlighted_index && i_highlighted_index >= 0) {
+					if (vec_jobs[i_highlighted_index]->is_finished()) {
+						std::cout << "This report has already finished.\n";
+						util::pause();
+						break;
+					}
+
+					vec_jobs[i_highlighted_index]->cancel();
+				}
+				break;
+			case VK_ESCAPE:
+				return;
+			default:
+				break;
+			}
+		}
+	}
+	catch (std::exception& ex) {
+		std::cout << "Error: " << ex.what() << "\n";
+		util::pause();
+	}
+}
+
+void ArchivePurchasesMenu::execute() {
+	int i_days = 0;
+
+	system("cls");
+	std::cout << "Archive old purchases\n\n";
+	std::cout << "Purchases older than the age entered are moved to the archive. They are still shown in purchase history and reports, but no longer count towards best sellers.\n\n";
+	std::cout << "Please enter the age in days purchases must be older than : ";
+	i_days = validate::validate_int(1);
+
+	try {
+		int i_archived_count = _ptr_class_container.ptr_purchase_manager.archive_purchases(i_days);
+		std::cout << i_archived_count << " purchases older than " << i_days << " days archived successfully.\n";
+		util::pause();
+	}
+	catch (std::exception& ex) {
+		std::cout << "Error: " << ex.what() << "\n";
+		util::pause();
+	}
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "Purchase.h"
 #include "PurchaseItem.h"
 #include "ClassContainer.h"
+#include "AllUserReportBuilder.h"
 #include "Game.h"
 
 /// <summary>
@@ -360,6 +361,15 @@ public:
     void execute();
 };
 
+/// <summary>
+/// Saves each user's purchase totals to a txt file, adding only the purchases made since the totals were last saved
+/// </summary>
+class AllUserPurchaseTotalsSaveMenu : public AllUserPurchaseSummaryMenu {
+public:
+    AllUserPurchaseTotalsSaveMenu(std::string output, ClassContainer& ptr_class_container, std::vector<User>& vec_users) : AllUserPurchaseSummaryMenu(output, ptr_class_container, vec_users) {};
+    void execute();
+};
+
 /// <summary>
 /// Saves a users purchases summary to a txt file
 /// </summary>
@@ -378,3 +388,50 @@ public:
     void execute();
 };
 
+/// <summary>
+/// Exports purchases as CSV, newline delimited JSON or columnar binary for analytics, for a single user or every user
+/// </summary>
+class PurchaseExportSaveMenu : public GeneralMenuItem {
+private:
+    PurchaseExportFormat _format;
+    int _i_user_id;
+public:
+    PurchaseExportSaveMenu(std::string output, ClassContainer& ptr_class_container, PurchaseExportFormat format, int i_user_id = 0) : GeneralMenuItem(output, ptr_class_container), _format(format), _i_user_id(i_user_id) {};
+    void execute();
+};
+
+/// <summary>
+/// Shows revenue, units and orders per day, week or month, compared against the same periods a year earlier
+/// </summary>
+class SalesAnalyticsMenu : public GeneralMenuItem {
+public:
+    SalesAnalyticsMenu(std::string output, ClassContainer& ptr_class_container) : GeneralMenuItem(output, ptr_class_container) {};
+    void execute();
+};
+
+/// <summary>
+/// Shows all time revenue, units and items broken down by genre, rating or price band
+/// </summary>
+class SalesBreakdownMenu : public GeneralMenuItem {
+public:
+    SalesBreakdownMenu(std::string output, ClassContainer& ptr_class_container) : GeneralMenuItem(output, ptr_class_container) {};
+    void execute();
+};
+
+/// <summary>
+/// Moves purchases older than an entered number of days to the archive
+/// </summary>
+class ArchivePurchasesMenu : public GeneralMenuItem {
+public:
+    ArchivePurchasesMenu(std::string output, ClassContainer& ptr_class_container) : GeneralMenuItem(output, ptr_class_container) {};
+    void execute();
+};
+
+/// <summary>
+/// Shows the reports being saved in the background along with their progress, and allows them to be cancelled
+/// </summary>
+class ViewReportJobsMenu : public GeneralMenuItem {
+public:
+    ViewReportJobsMenu(std::string output, ClassContainer& ptr_class_container) : GeneralMenuItem(output, ptr_class_container) {};
+    void execute();
+};
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "Money.h"
+
+Money::Money() {
+	_ll_cents = 0;
+}
+
+Money::Money(std::int64_t ll_cents) {
+	_ll_cents = ll_cents;
+}
+
+Money Money::from_decimal(double d_amount) {
+	// Round to nearest cent, so that values like 15.49 (which are not exact as a double) are stored correctly
+	return Money((std::int64_t)std::llround(d_amount * 100.0));
+}
+
+Money Money::get_before_vat() const {
+	// Equivalent to multiplying by 0.8, but done in whole cents and rounded half up
+	return Money((_ll_cents * 4 + 2) / 5);
+}
+
+Money Money::divide_by(std::int64_t ll_count) const {
+	if (ll_count == 0) return Money();
+
+	// Round half up rather than truncating
+	return Money((_ll_cents * 2 + ll_count) / (ll_count * 2));
+}
+
+std::ostream& operator<<(std::ostream& os, const Money& obj_money) {
+	return os << obj_money.to_decimal();
+}
\ No newline at end of file
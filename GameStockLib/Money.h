@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <ostream>
+
+/// <summary>
+/// Class used to represent an amount of money, stored as a whole number of cents so that prices, totals and sums are exact
+/// </summary>
+class Money
+{
+	std::int64_t _ll_cents;
+public:
+	Money();
+	explicit Money(std::int64_t ll_cents);
+
+	/// <summary>
+	/// Creates a Money from a decimal amount (such as user input of 15.49), rounding to the nearest cent
+	/// </summary>
+	/// <param name="d_amount"></param>
+	/// <returns></returns>
+	static Money from_decimal(double d_amount);
+
+	std::int64_t get_cents() const { return _ll_cents; }
+
+	/// <summary>
+	/// Returns the amount as a decimal, only intended to be used for display purposes
+	/// </summary>
+	/// <returns></returns>
+	double to_decimal() const { return (double)_ll_cents / 100.0; }
+
+	/// <summary>
+	/// Returns the amount with VAT (20%) removed, rounded to the nearest cent
+	/// </summary>
+	/// <returns></returns>
+	Money get_before_vat() const;
+
+	/// <summary>
+	/// Divides the amount by the provided count rounding to the nearest cent, returns zero when count is zero (used for averages)
+	/// </summary>
+	/// <param name="ll_count"></param>
+	/// <returns></returns>
+	Money divide_by(std::int64_t ll_count) const;
+
+	Money operator+(const Money& obj_money) const { return Money(_ll_cents + obj_money._ll_cents); }
+	Money operator-(const Money& obj_money) const { return Money(_ll_cents - obj_money._ll_cents); }
+	Money operator*(std::int64_t ll_count) const { return Money(_ll_cents * ll_count); }
+	Money& operator+=(const Money& obj_money) { _ll_cents += obj_money._ll_cents; return *this; }
+	Money& operator-=(const Money& obj_money) { _ll_cents -= obj_money._ll_cents; return *this; }
+
+	bool operator==(const Money& obj_money) const { return _ll_cents == obj_money._ll_cents; }
+	bool operator!=(const Money& obj_money) const { return _ll_cents != obj_money._ll_cents; }
+	bool operator<(const Money& obj_money) const { return _ll_cents < obj_money._ll_cents; }
+	bool operator>(const Money& obj_money) const { return _ll_cents > obj_money._ll_cents; }
+	bool operator<=(const Money& obj_money) const { return _ll_cents <= obj_money._ll_cents; }
+	bool operator>=(const Money& obj_money) const { return _ll_cents >= obj_money._ll_cents; }
+};
+
+/// <summary>
+/// Outputs money as a decimal, so that any precision/width/locale already set on the stream is respected
+/// </summary>
+/// <param name="os"></param>
+/// <param name="obj_money"></param>
+/// <returns></returns>
+std::ostream& operator<<(std::ostream& os, const Money& obj_money);
@@ -3,13 +3,13 @@
 Purchase::Purchase() {
 	_i_id = 0;
 	_i_user_id = 0;
-	_d_total = 0;
+	_obj_total = Money();
 	_str_date = "";
 }
 
-Purchase::Purchase(int i_id, double d_total, std::string str_date) {
+Purchase::Purchase(int i_id, Money obj_total, std::string str_date) {
 	_i_id = i_id;
-	_d_total = d_total;
+	_obj_total = obj_total;
 	_str_date = str_date;
 }
 
@@ -17,15 +17,15 @@ Purchase::Purchase(int i_user_id, std::vector<PurchaseItem> vec_purchase_items)
 	_i_id = 0;
 	_i_user_id = i_user_id;
 	_vec_purchase_items = vec_purchase_items;
-	_d_total = 0;
+	_obj_total = Money();
 	_str_date = "";
 }
 
-Purchase::Purchase(int i_id, int i_user_id, std::vector<PurchaseItem> vec_purchase_items, double d_total, std::string str_date) {
+Purchase::Purchase(int i_id, int i_user_id, std::vector<PurchaseItem> vec_purchase_items, Money obj_total, std::string str_date) {
 	_i_id = i_id;
 	_i_user_id = i_user_id;
 	_vec_purchase_items = vec_purchase_items;
-	_d_total = d_total;
+	_obj_total = obj_total;
 	_str_date = str_date;
 }
 
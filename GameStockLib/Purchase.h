@@ -3,6 +3,7 @@
 #include <vector>
 #include <numeric>
 #include "PurchaseItem.h"
+#include "Money.h"
 
 /// <summary>
 /// Class used to represent and store details for a purchase. Not that this class is also used as an object to store basket items
@@ -12,13 +13,13 @@ class Purchase
 	int _i_id;
 	int _i_user_id;
 	std::vector<PurchaseItem> _vec_purchase_items;
-	double _d_total;
+	Money _obj_total;
 	std::string _str_date;
 public:
 	Purchase();
-	Purchase(int i_id, double d_total, std::string str_date);
+	Purchase(int i_id, Money obj_total, std::string str_date);
 	Purchase(int i_user_id, std::vector<PurchaseItem> vec_purchase_items);
-	Purchase(int i_id, int i_user_id, std::vector<PurchaseItem> vec_purchase_items, double d_total, std::string str_date);
+	Purchase(int i_id, int i_user_id, std::vector<PurchaseItem> vec_purchase_items, Money obj_total, std::string str_date);
 
 	int get_id() { return _i_id; }
 	void set_id(int i_id) { _i_id = i_id; }
@@ -28,8 +29,8 @@ public:
 
 	std::vector<PurchaseItem>& get_vec_purchase_items() { return _vec_purchase_items; }
 
-	double get_total() { return _d_total; }
-	void set_total(double d_total) { _d_total = d_total; }
+	Money get_total() { return _obj_total; }
+	void set_total(Money obj_total) { _obj_total = obj_total; }
 
 	std::string get_date() { return _str_date; }
 	void set_date(std::string str_date) { _str_date = str_date; }
@@ -0,0 +1,89 @@
+#include "PurchaseCursor.h"
+
+PurchaseCursor::PurchaseCursor(sqlite3* db, sqlite3_stmt* stmt, bool bool_include_items) {
+	_db = db;
+	_stmt = stmt;
+	_bool_include_items = bool_include_items;
+	_i_step_result = SQLITE_DONE;
+
+	// Read the first row straight away, so next always has the row it needs waiting
+	try {
+		step();
+	}
+	catch (std::exception&) {
+		// Destructor will not run if the constructor throws
+		sqlite3_finalize(_stmt);
+		throw;
+	}
+}
+
+PurchaseCursor::~PurchaseCursor() {
+	sqlite3_finalize(_stmt);
+}
+
+PurchaseCursor::PurchaseCursor(PurchaseCursor&& obj_cursor) noexcept {
+	_db = obj_cursor._db;
+	_stmt = obj_cursor._stmt;
+	_bool_include_items = obj_cursor._bool_include_items;
+	_i_step_result = obj_cursor._i_step_result;
+	obj_cursor._stmt = NULL;
+	obj_cursor._i_step_result = SQLITE_DONE;
+}
+
+PurchaseCursor& PurchaseCursor::operator=(PurchaseCursor&& obj_cursor) noexcept {
+	if (this != &obj_cursor) {
+		sqlite3_finalize(_stmt);
+		_db = obj_cursor._db;
+		_stmt = obj_cursor._stmt;
+		_bool_include_items = obj_cursor._bool_include_items;
+		_i_step_result = obj_cursor._i_step_result;
+		obj_cursor._stmt = NULL;
+		obj_cursor._i_step_result = SQLITE_DONE;
+	}
+
+	return *this;
+}
+
+void PurchaseCursor::step() {
+	_i_step_result = sqlite3_step(_stmt);
+
+	if (_i_step_result != SQLITE_ROW && _i_step_result != SQLITE_DONE) {
+		std::string str_error_msg = "Failed to read purchases: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+}
+
+bool PurchaseCursor::next(Purchase& obj_purchase) {
+	if (_i_step_result != SQLITE_ROW) return false;
+
+	int i_purchase_id = sqlite3_column_int(_stmt, 0);
+	obj_purchase = Purchase(
+		i_purchase_id,
+		Money(sqlite3_column_int64(_stmt, 1)),
+		(char*)sqlite3_column_text(_stmt, 2));
+
+	if (!_bool_include_items) {
+		step();
+		return true;
+	}
+
+	// Keep reading items until the row belongs to the next purchase, leaving that row for the next call
+	do {
+		if (sqlite3_column_type(_stmt, 3) != SQLITE_NULL) {
+			obj_purchase.get_vec_purchase_items().push_back(
+				PurchaseItem(
+					sqlite3_column_int(_stmt, 3),
+					(char*)sqlite3_column_text(_stmt, 4),
+					Money(sqlite3_column_int64(_stmt, 5)),
+					(char*)sqlite3_column_text(_stmt, 6),
+					(char*)sqlite3_column_text(_stmt, 7),
+					sqlite3_column_int(_stmt, 8),
+					Money(sqlite3_column_int64(_stmt, 9))));
+		}
+
+		step();
+	} while (_i_step_result == SQLITE_ROW && sqlite3_column_int(_stmt, 0) == i_purchase_id);
+
+	return true;
+}
\ No newline at end of file
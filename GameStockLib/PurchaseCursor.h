@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <stdexcept>
+#include "sqlite3.h"
+#include "Purchase.h"
+#include "PurchaseItem.h"
+#include "Money.h"
+
+/// <summary>
+/// Class used to read purchases one at a time from a statement that is still running, so only the current purchase is ever held in memory.
+/// Created through PurchaseManager, the statement is finalized when the cursor is destroyed.
+/// </summary>
+class PurchaseCursor
+{
+	sqlite3* _db;
+	sqlite3_stmt* _stmt;
+	bool _bool_include_items;
+	int _i_step_result;
+
+	/// <summary>
+	/// Steps the statement, keeping the result so the row can be read by the next call to next
+	/// </summary>
+	void step();
+public:
+	/// <summary>
+	/// Takes ownership of a prepared and bound statement. Columns must be purchase id, total, date and, when including items, the purchase item columns
+	/// (id, game name, game price, game genre, game rating, count, total) with each purchase's rows together.
+	/// </summary>
+	/// <param name="db"></param>
+	/// <param name="stmt"></param>
+	/// <param name="bool_include_items"></param>
+	PurchaseCursor(sqlite3* db, sqlite3_stmt* stmt, bool bool_include_items);
+	~PurchaseCursor();
+
+	PurchaseCursor(const PurchaseCursor&) = delete;
+	PurchaseCursor& operator=(const PurchaseCursor&) = delete;
+	PurchaseCursor(PurchaseCursor&& obj_cursor) noexcept;
+	PurchaseCursor& operator=(PurchaseCursor&& obj_cursor) noexcept;
+
+	/// <summary>
+	/// Reads the next purchase (and its items, if included) into the provided purchase
+	/// </summary>
+	/// <param name="obj_purchase"></param>
+	/// <returns>False once there are no more purchases</returns>
+	bool next(Purchase& obj_purchase);
+};
+
@@ -0,0 +1,314 @@
+#include "PurchaseExportWriter.h"
+
+namespace {
+	// Size the buffer is allowed to grow to before it is written to the stream
+	const size_t BLOCK_SIZE = 64 * 1024;
+}
+
+PurchaseExportWriter::PurchaseExportWriter() {
+	_ptr_os = NULL;
+	_ll_bytes_written = 0;
+}
+
+std::unique_ptr<PurchaseExportWriter> PurchaseExportWriter::create(PurchaseExportFormat format) {
+	switch (format)
+	{
+	case PurchaseExportFormat::Csv:
+		return std::make_unique<CsvPurchaseExportWriter>();
+	case PurchaseExportFormat::Ndjson:
+		return std::make_unique<NdjsonPurchaseExportWriter>();
+	case PurchaseExportFormat::Columnar:
+		return std::make_unique<ColumnarPurchaseExportWriter>();
+	default:
+		throw std::invalid_argument("Unknown purchase export format.");
+	}
+}
+
+void PurchaseExportWriter::begin(std::ostream& os) {
+	_ptr_os = &os;
+	_str_buffer.clear();
+	_str_buffer.reserve(BLOCK_SIZE + 1024);
+	_ll_bytes_written = 0;
+}
+
+void PurchaseExportWriter::end() {
+	flush_buffer(true);
+}
+
+void PurchaseExportWriter::flush_buffer(bool bool_force) {
+	if (_str_buffer.empty() || (!bool_force && _str_buffer.size() < BLOCK_SIZE)) return;
+
+	if (_ptr_os == NULL) {
+		throw std::logic_error("Export has not been started.");
+	}
+
+	_ptr_os->write(_str_buffer.data(), _str_buffer.size());
+	_ll_bytes_written += _str_buffer.size();
+	_str_buffer.clear();
+}
+
+void PurchaseExportWriter::append_integer(std::int64_t ll_value) {
+	char str_digits[24];
+	std::to_chars_result result = std::to_chars(str_digits, str_digits + sizeof(str_digits), ll_value);
+	_str_buffer.append(str_digits, result.ptr - str_digits);
+}
+
+void PurchaseExportWriter::append_money(Money obj_money) {
+	std::int64_t ll_cents = obj_money.get_cents();
+	std::uint64_t ull_cents = ll_cents < 0 ? 0 - (std::uint64_t)ll_cents : (std::uint64_t)ll_cents;
+	char str_digits[24];
+
+	if (ll_cents < 0) _str_buffer.push_back('-');
+
+	std::to_chars_result result = std::to_chars(str_digits, str_digits + sizeof(str_digits), ull_cents / 100);
+	_str_buffer.append(str_digits, result.ptr - str_digits);
+	_str_buffer.push_back('.');
+	_str_buffer.push_back((char)('0' + ull_cents % 100 / 10));
+	_str_buffer.push_back((char)('0' + ull_cents % 10));
+}
+
+void CsvPurchaseExportWriter::append_field(const std::string& str_field) {
+	if (str_field.find_first_of(",\"\r\n") == std::string::npos) {
+		_str_buffer += str_field;
+		return;
+	}
+
+	_str_buffer.push_back('"');
+	for (char ch : str_field) {
+		if (ch == '"') _str_buffer.push_back('"');
+		_str_buffer.push_back(ch);
+	}
+	_str_buffer.push_back('"');
+}
+
+void CsvPurchaseExportWriter::begin(std::ostream& os) {
+	PurchaseExportWriter::begin(os);
+	_str_buffer += "purchase_id,user_id,date,game_name,game_genre,game_rating,count,price,total\n";
+}
+
+void CsvPurchaseExportWriter::write_row(const PurchaseExportRow& obj_row) {
+	append_integer(obj_row.i_purchase_id);
+	_str_buffer.push_back(',');
+	append_integer(obj_row.i_user_id);
+	_str_buffer.push_back(',');
+	append_field(obj_row.str_date);
+	_str_buffer.push_back(',');
+	append_field(obj_row.str_game_name);
+	_str_buffer.push_back(',');
+	append_field(obj_row.str_game_genre);
+	_str_buffer.push_back(',');
+	append_field(obj_row.str_game_rating);
+	_str_buffer.push_back(',');
+	append_integer(obj_row.i_count);
+	_str_buffer.push_back(',');
+	append_money(obj_row.obj_price);
+	_str_buffer.push_back(',');
+	append_money(obj_row.obj_total);
+	_str_buffer.push_back('\n');
+
+	flush_buffer();
+}
+
+void NdjsonPurchaseExportWriter::append_string(const std::string& str_value) {
+	static const char str_hex[] = "0123456789abcdef";
+
+	_str_buffer.push_back('"');
+	for (char ch : str_value) {
+		switch (ch)
+		{
+		case '"':
+			_str_buffer += "\\\"";
+			break;
+		case '\\':
+			_str_buffer += "\\\\";
+			break;
+		case '\n':
+			_str_buffer += "\\n";
+			break;
+		case '\r':
+			_str_buffer += "\\r";
+			break;
+		case '\t':
+			_str_buffer += "\\t";
+			break;
+		default:
+			// Any other control characters are written as unicode escapes, everything else (including UTF-8) is written as is
+			if ((unsigned char)ch < 0x20) {
+				_str_buffer += "\\u00";
+				_str_buffer.push_back(str_hex[(unsigned char)ch >> 4]);
+				_str_buffer.push_back(str_hex[(unsigned char)ch & 0xF]);
+			}
+			else {
+				_str_buffer.push_back(ch);
+			}
+			break;
+		}
+	}
+	_str_buffer.push_back('"');
+}
+
+void NdjsonPurchaseExportWriter::write_row(const PurchaseExportRow& obj_row) {
+	_str_buffer += "{\"purchase_id\":";
+	append_integer(obj_row.i_purchase_id);
+	_str_buffer += ",\"user_id\":";
+	append_integer(obj_row.i_user_id);
+	_str_buffer += ",\"date\":";
+	append_string(obj_row.str_date);
+	_str_buffer += ",\"game_name\":";
+	append_string(obj_row.str_game_name);
+	_str_buffer += ",\"game_genre\":";
+	append_string(obj_row.str_game_genre);
+	_str_buffer += ",\"game_rating\":";
+	append_string(obj_row.str_game_rating);
+	_str_buffer += ",\"count\":";
+	append_integer(obj_row.i_count);
+	_str_buffer += ",\"price\":";
+	append_money(obj_row.obj_price);
+	_str_buffer += ",\"total\":";
+	append_money(obj_row.obj_total);
+	_str_buffer += "}\n";
+
+	flush_buffer();
+}
+
+void ColumnarPurchaseExportWriter::Column::clear() {
+	vec_int32_values.clear();
+	vec_int64_values.clear();
+	str_bytes.clear();
+	vec_offsets.clear();
+}
+
+ColumnarPurchaseExportWriter::ColumnarPurchaseExportWriter() {
+	_ll_row_count = 0;
+	_ll_group_row_count = 0;
+}
+
+void ColumnarPurchaseExportWriter::append_le(std::uint64_t ll_value, int i_bytes) {
+	for (int i = 0; i < i_bytes; i++) {
+		_str_buffer.push_back((char)((ll_value >> (i * 8)) & 0xFF));
+	}
+}
+
+void ColumnarPurchaseExportWriter::align() {
+	while (get_position() % 8 != 0) {
+		_str_buffer.push_back('\0');
+	}
+}
+
+void ColumnarPurchaseExportWriter::begin(std::ostream& os) {
+	PurchaseExportWriter::begin(os);
+	_ll_row_count = 0;
+	_ll_group_row_count = 0;
+	_vec_row_group_index.clear();
+	_vec_columns = {
+		{ "purchase_id", ColumnarType::Int32 },
+		{ "user_id", ColumnarType::Int32 },
+		{ "date", ColumnarType::Int64 },
+		{ "game_name", ColumnarType::String },
+		{ "game_genre", ColumnarType::String },
+		{ "game_rating", ColumnarType::String },
+		{ "count", ColumnarType::Int32 },
+		{ "price", ColumnarType::Int64 },
+		{ "total", ColumnarType::Int64 }
+	};
+
+	// Header and column entries, the row and row group counts are only known at the end so are kept in the trailer
+	_str_buffer.append("GSPC", 4);
+	append_le(VERSION, 4);
+	append_le(_vec_columns.size(), 4);
+	append_le(0, 4);
+	append_le(ROW_GROUP_SIZE, 8);
+	append_le(0, 8);
+
+	for (Column& column : _vec_columns) {
+		std::string str_name = column.str_name.substr(0, COLUMN_NAME_SIZE);
+		_str_buffer += str_name;
+		_str_buffer.append(COLUMN_NAME_SIZE - str_name.size(), '\0');
+		append_le((std::uint64_t)column.type, 4);
+		append_le(0, 4);
+	}
+}
+
+void ColumnarPurchaseExportWriter::write_row(const PurchaseExportRow& obj_row) {
+	_vec_columns[0].vec_int32_values.push_back(obj_row.i_purchase_id);
+	_vec_columns[1].vec_int32_values.push_back(obj_row.i_user_id);
+	_vec_columns[2].vec_int64_values.push_back(obj_row.ll_date);
+	_vec_columns[3].str_bytes += obj_row.str_game_name;
+	_vec_columns[3].vec_offsets.push_back(_vec_columns[3].str_bytes.size());
+	_vec_columns[4].str_bytes += obj_row.str_game_genre;
+	_vec_columns[4].vec_offsets.push_back(_vec_columns[4].str_bytes.size());
+	_vec_columns[5].str_bytes += obj_row.str_game_rating;
+	_vec_columns[5].vec_offsets.push_back(_vec_columns[5].str_bytes.size());
+	_vec_columns[6].vec_int32_values.push_back(obj_row.i_count);
+	_vec_columns[7].vec_int64_values.push_back(obj_row.obj_price.get_cents());
+	_vec_columns[8].vec_int64_values.push_back(obj_row.obj_total.get_cents());
+
+	_ll_group_row_count++;
+	if (_ll_group_row_count == ROW_GROUP_SIZE) write_row_group();
+}
+
+void ColumnarPurchaseExportWriter::write_row_group() {
+	if (_ll_group_row_count == 0) return;
+
+	_vec_row_group_index.push_back(_ll_group_row_count);
+
+	for (Column& column : _vec_columns) {
+		align();
+		std::uint64_t ll_offset = get_position();
+
+		switch (column.type)
+		{
+		case ColumnarType::Int32:
+			for (std::int32_t i_value : column.vec_int32_values) {
+				append_le((std::uint32_t)i_value, 4);
+				flush_buffer();
+			}
+			break;
+		case ColumnarType::Int64:
+			for (std::int64_t ll_value : column.vec_int64_values) {
+				append_le((std::uint64_t)ll_value, 8);
+				flush_buffer();
+			}
+			break;
+		default:
+			append_le(0, 8);
+			for (std::uint64_t ll_end : column.vec_offsets) {
+				append_le(ll_end, 8);
+				flush_buffer();
+			}
+
+			_str_buffer += column.str_bytes;
+			break;
+		}
+
+		_vec_row_group_index.push_back(ll_offset);
+		_vec_row_group_index.push_back(get_position() - ll_offset);
+		column.clear();
+		flush_buffer();
+	}
+
+	_ll_row_count += _ll_group_row_count;
+	_ll_group_row_count = 0;
+}
+
+void ColumnarPurchaseExportWriter::end() {
+	write_row_group();
+
+	// Row group index, then the trailer pointing back to it
+	align();
+	std::uint64_t ll_index_offset = get_position();
+
+	for (std::uint64_t ll_value : _vec_row_group_index) {
+		append_le(ll_value, 8);
+	}
+
+	append_le(ll_index_offset, 8);
+	append_le(_ll_row_count, 8);
+	append_le(_vec_row_group_index.size() / (1 + 2 * _vec_columns.size()), 8);
+	_str_buffer.append("GSPC", 4);
+	append_le(0, 4);
+
+	PurchaseExportWriter::end();
+	_vec_columns.clear();
+	_vec_row_group_index.clear();
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include "Money.h"
+
+/// <summary>
+/// Formats purchases can be exported in for analytics
+/// </summary>
+enum class PurchaseExportFormat {
+	Csv,
+	Ndjson,
+	Columnar
+};
+
+/// <summary>
+/// A single purchase item along with the purchase it belongs to, the unit rows are exported in
+/// </summary>
+struct PurchaseExportRow {
+	int i_purchase_id = 0;
+	int i_user_id = 0;
+	std::int64_t ll_date = 0;
+	std::string str_date;
+	std::string str_game_name;
+	std::string str_game_genre;
+	std::string str_game_rating;
+	int i_count = 0;
+	Money obj_price;
+	Money obj_total;
+};
+
+/// <summary>
+/// Base class for writing exported purchase rows in a machine readable format. Rows are collected into a buffer and written to the stream
+/// in large blocks, begin must be called before the first row and end after the last.
+/// </summary>
+class PurchaseExportWriter
+{
+protected:
+	std::ostream* _ptr_os;
+	std::string _str_buffer;
+	std::int64_t _ll_bytes_written;
+
+	/// <summary>
+	/// Writes the buffer to the stream once it has grown past the block size, or always when forced
+	/// </summary>
+	/// <param name="bool_force"></param>
+	void flush_buffer(bool bool_force = false);
+
+	/// <summary>
+	/// Appends a whole number to the buffer, without any locale formatting
+	/// </summary>
+	/// <param name="ll_value"></param>
+	void append_integer(std::int64_t ll_value);
+
+	/// <summary>
+	/// Appends money to the buffer as a decimal to 2 places (e.g. 15.49), worked out from the cents rather than a double
+	/// </summary>
+	/// <param name="obj_money"></param>
+	void append_money(Money obj_money);
+public:
+	PurchaseExportWriter();
+	virtual ~PurchaseExportWriter() {}
+
+	PurchaseExportWriter(const PurchaseExportWriter&) = delete;
+	PurchaseExportWriter& operator=(const PurchaseExportWriter&) = delete;
+
+	/// <summary>
+	/// Creates the writer for the provided format
+	/// </summary>
+	/// <param name="format"></param>
+	/// <returns></returns>
+	static std::unique_ptr<PurchaseExportWriter> create(PurchaseExportFormat format);
+
+	/// <summary>
+	/// Extension (including the dot) that files written by this writer should be saved with
+	/// </summary>
+	/// <returns></returns>
+	virtual std::string get_file_extension() const = 0;
+
+	/// <summary>
+	/// Whether the output is binary, so the file must not have its line endings translated
+	/// </summary>
+	/// <returns></returns>
+	virtual bool is_binary() const { return false; }
+
+	/// <summary>
+	/// Starts writing an export to the provided stream
+	/// </summary>
+	/// <param name="os"></param>
+	virtual void begin(std::ostream& os);
+
+	/// <summary>
+	/// Adds a row to the export
+	/// </summary>
+	/// <param name="obj_row"></param>
+	virtual void write_row(const PurchaseExportRow& obj_row) = 0;
+
+	/// <summary>
+	/// Finishes the export, writing anything still buffered to the stream
+	/// </summary>
+	virtual void end();
+
+	/// <summary>
+	/// Returns the number of bytes written to the stream so far
+	/// </summary>
+	/// <returns></returns>
+	std::int64_t get_bytes_written() { return _ll_bytes_written; }
+};
+
+/// <summary>
+/// Writes rows as comma separated values with a header row. Text containing commas, quotes or new lines is quoted, with quotes doubled.
+/// </summary>
+class CsvPurchaseExportWriter : public PurchaseExportWriter
+{
+	/// <summary>
+	/// Appends a text field, quoting it only when needed
+	/// </summary>
+	/// <param name="str_field"></param>
+	void append_field(const std::string& str_field);
+public:
+	std::string get_file_extension() const { return ".csv"; }
+	void begin(std::ostream& os);
+	void write_row(const PurchaseExportRow& obj_row);
+};
+
+/// <summary>
+/// Writes each row as a JSON object on its own line (newline delimited JSON)
+/// </summary>
+class NdjsonPurchaseExportWriter : public PurchaseExportWriter
+{
+	/// <summary>
+	/// Appends a quoted JSON string, escaping quotes, backslashes and control characters
+	/// </summary>
+	/// <param name="str_value"></param>
+	void append_string(const std::string& str_value);
+public:
+	std::string get_file_extension() const { return ".ndjson"; }
+	void write_row(const PurchaseExportRow& obj_row);
+};
+
+/// <summary>
+/// Column types stored in a columnar export
+/// </summary>
+enum class ColumnarType : std::uint32_t {
+	Int32 = 1,
+	Int64 = 2,
+	String = 3
+};
+
+/// <summary>
+/// Writes rows as typed columns so they can be memory mapped and read without parsing. All values are little endian.
+/// 
+/// Header (32 bytes): magic "GSPC", uint32 version, uint32 column count, uint32 reserved, uint64 rows per row group, uint64 reserved.
+/// Followed by a 32 byte entry per column: name (24 bytes, zero padded), uint32 type, uint32 reserved.
+/// Rows are then written in row groups of up to ROW_GROUP_SIZE rows, each holding every column's data for its rows in column order. Each column's data
+/// starts on an 8 byte boundary. Int32/Int64 columns hold one value per row, String columns hold row count + 1 uint64 offsets into the bytes that follow them.
+/// Dates are seconds since the epoch and money is in cents.
+/// 
+/// The row groups are followed by their index, an entry per row group of uint64 row count then a uint64 data offset and uint64 data length for each column.
+/// The file ends with a 32 byte trailer: uint64 index offset, uint64 row count, uint64 row group count, magic "GSPC", uint32 reserved.
+/// 
+/// Only the row group being filled is held in memory, it is written out as soon as it is full.
+/// </summary>
+class ColumnarPurchaseExportWriter : public PurchaseExportWriter
+{
+	/// <summary>
+	/// A single column's values within the row group being filled, integers are kept in the vector for their type and text in str_bytes
+	/// with the end of each row's text in vec_offsets
+	/// </summary>
+	struct Column {
+		std::string str_name;
+		ColumnarType type;
+		std::vector<std::int32_t> vec_int32_values;
+		std::vector<std::int64_t> vec_int64_values;
+		std::string str_bytes;
+		std::vector<std::uint64_t> vec_offsets;
+
+		Column(std::string str_name, ColumnarType type) : str_name(str_name), type(type) {}
+
+		/// <summary>
+		/// Removes the column's values, ready for the next row group
+		/// </summary>
+		void clear();
+	};
+
+	std::vector<Column> _vec_columns;
+	std::uint64_t _ll_row_count;
+	std::uint64_t _ll_group_row_count;
+
+	// Index entries of the row groups written so far, the row count then each column's offset and length
+	std::vector<std::uint64_t> _vec_row_group_index;
+
+	/// <summary>
+	/// Appends an unsigned value to the buffer as little endian
+	/// </summary>
+	/// <param name="ll_value"></param>
+	/// <param name="i_bytes">Number of bytes to write, up to 8</param>
+	void append_le(std::uint64_t ll_value, int i_bytes);
+
+	/// <summary>
+	/// Appends zeros until the output is on an 8 byte boundary
+	/// </summary>
+	void align();
+
+	/// <summary>
+	/// Returns the offset in the file the next byte appended will be written at
+	/// </summary>
+	/// <returns></returns>
+	std::uint64_t get_position() const { return _ll_bytes_written + _str_buffer.size(); }
+
+	/// <summary>
+	/// Writes the rows held in the columns as a row group and clears them, does nothing when there are none
+	/// </summary>
+	void write_row_group();
+public:
+	static const std::uint32_t VERSION = 2;
+	static const size_t HEADER_SIZE = 32;
+	static const size_t COLUMN_ENTRY_SIZE = 32;
+	static const size_t COLUMN_NAME_SIZE = 24;
+	static const size_t TRAILER_SIZE = 32;
+	static const size_t ROW_GROUP_SIZE = 16384;
+
+	ColumnarPurchaseExportWriter();
+
+	std::string get_file_extension() const { return ".gspc"; }
+	bool is_binary() const { return true; }
+	void begin(std::ostream& os);
+	void write_row(const PurchaseExportRow& obj_row);
+	void end();
+};
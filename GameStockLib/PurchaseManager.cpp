@@ -3,27 +3,12 @@
 void PurchaseManager::fetch_purchases(User& obj_user) {
 	// Clear any previous purchases first
 	_vec_purchases.clear();
-	sqlite3_stmt* stmt_fetch_purchases;
-
-	// Fetch all purchases of user and order by datetime of purchase
-	std::string str_fetch_purchases = "SELECT id, total, date FROM purchases WHERE user_id = ? ORDER BY datetime(date) DESC";
-
-	if (sqlite3_prepare_v2(_db, str_fetch_purchases.c_str(), -1, &stmt_fetch_purchases, NULL) != SQLITE_OK) {
-		std::string str_error_msg = "Failed to prepare fetch statement: ";
-		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
-		throw std::runtime_error(str_error_msg);
-	}
-
-	sqlite3_bind_int(stmt_fetch_purchases, 1, obj_user.get_id());
+	PurchaseCursor obj_cursor = open_purchase_cursor(obj_user);
+	Purchase obj_purchase;
 
-	while (sqlite3_step(stmt_fetch_purchases) == SQLITE_ROW) {
-		_vec_purchases.push_back(Purchase(
-			sqlite3_column_int(stmt_fetch_purchases, 0),
-			sqlite3_column_double(stmt_fetch_purchases, 1),
-			(char*)sqlite3_column_text(stmt_fetch_purchases, 2)));
+	while (obj_cursor.next(obj_purchase)) {
+		_vec_purchases.push_back(obj_purchase);
 	}
-
-	sqlite3_finalize(stmt_fetch_purchases);
 }
 
 void PurchaseManager::populate_purchase_details(Purchase& obj_purchase) {
@@ -31,8 +16,10 @@ void PurchaseManager::populate_purchase_details(Purchase& obj_purchase) {
 	obj_purchase.get_vec_purchase_items().clear();
 	sqlite3_stmt* stmt_fetch_purchase_items;
 
-	// Select all purchases that are related to the provided purchase id
-	std::string str_fetch_purchase_items = "SELECT id, game_name, game_price, game_genre, game_rating, count, total FROM purchase_items WHERE purchase_id = ?";
+	// Select all purchases that are related to the provided purchase id, which may have been archived
+	std::string str_fetch_purchase_items =
+		"SELECT i.id, s.name, i.game_price, s.genre, s.rating, i.count, i.total FROM purchase_items AS i INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE i.purchase_id = ?1 " \
+		"UNION ALL SELECT i.id, s.name, i.game_price, s.genre, s.rating, i.count, i.count * i.game_price FROM purchase_items_archive AS i INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE i.purchase_id = ?1";
 
 	if (sqlite3_prepare_v2(_db, str_fetch_purchase_items.c_str(), -1, &stmt_fetch_purchase_items, NULL) != SQLITE_OK) {
 		std::string str_error_msg = "Failed to prepare fetch statement: ";
@@ -47,26 +34,197 @@ void PurchaseManager::populate_purchase_details(Purchase& obj_purchase) {
 			PurchaseItem(
 				sqlite3_column_int(stmt_fetch_purchase_items, 0),
 				(char*)sqlite3_column_text(stmt_fetch_purchase_items, 1),
-				sqlite3_column_double(stmt_fetch_purchase_items, 2),
+				Money(sqlite3_column_int64(stmt_fetch_purchase_items, 2)),
 				(char*)sqlite3_column_text(stmt_fetch_purchase_items, 3),
 				(char*)sqlite3_column_text(stmt_fetch_purchase_items, 4),
 				sqlite3_column_int(stmt_fetch_purchase_items, 5),
-				sqlite3_column_double(stmt_fetch_purchase_items, 6)));
+				Money(sqlite3_column_int64(stmt_fetch_purchase_items, 6))));
 	}
 
 	sqlite3_finalize(stmt_fetch_purchase_items);
 }
 
-double PurchaseManager::get_purchase_grand_total() {
+void PurchaseManager::fetch_purchases_with_details(User& obj_user) {
+	// Clear any previous purchases first
+	_vec_purchases.clear();
+	PurchaseCursor obj_cursor = open_purchase_cursor(obj_user, true);
+	Purchase obj_purchase;
+
+	while (obj_cursor.next(obj_purchase)) {
+		_vec_purchases.push_back(obj_purchase);
+	}
+}
+
+PurchaseCursor PurchaseManager::open_purchase_cursor(User& obj_user, bool bool_include_items) {
+	sqlite3_stmt* stmt_fetch_purchases;
+
+	// Fetch all purchases of user and order by date of purchase, dates are stored as seconds since the epoch so are formatted for display.
+	// Archived purchases follow on, both tables are already in date order for a user so the two are merged rather than sorted
+	std::string str_fetch_purchases =
+		"SELECT id, total, datetime(date, 'unixepoch'), date FROM purchases WHERE user_id = ?1 " \
+		"UNION ALL SELECT id, total, datetime(date, 'unixepoch'), date FROM purchases_archive WHERE user_id = ?1 ORDER BY 4 DESC, 1";
+
+	// When including items, join them on and order so each purchase's rows are together (left join keeps purchases with no items)
+	if (bool_include_items) {
+		str_fetch_purchases =
+			"SELECT p.id, p.total, datetime(p.date, 'unixepoch'), i.id, s.name, i.game_price, s.genre, s.rating, i.count, i.total, p.date FROM purchases AS p LEFT JOIN purchase_items AS i ON i.purchase_id = p.id LEFT JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE p.user_id = ?1 " \
+			"UNION ALL SELECT p.id, p.total, datetime(p.date, 'unixepoch'), i.id, s.name, i.game_price, s.genre, s.rating, i.count, i.count * i.game_price, p.date FROM purchases_archive AS p LEFT JOIN purchase_items_archive AS i ON i.purchase_id = p.id LEFT JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE p.user_id = ?1 " \
+			"ORDER BY 11 DESC, 1, 4";
+	}
+
+	if (sqlite3_prepare_v2(_db, str_fetch_purchases.c_str(), -1, &stmt_fetch_purchases, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int(stmt_fetch_purchases, 1, obj_user.get_id());
+
+	return PurchaseCursor(_db, stmt_fetch_purchases, bool_include_items);
+}
+
+PurchasePage PurchaseManager::fetch_purchase_page(User& obj_user, int i_page_size, PurchasePageKey obj_after) {
+	if (i_page_size < 1) {
+		throw std::invalid_argument("Page size must be at least 1.");
+	}
+
+	PurchasePage obj_page;
+	sqlite3_stmt* stmt_fetch_page;
+	int i_return_code;
+
+	// Both tables are read from the same snapshot, so purchases being archived in the meantime are not missed or read twice
+	ReadSnapshot obj_snapshot(_db);
+
+	// Later pages continue from the last purchase of the previous page, the date <= part lets the index jump straight to it
+	std::string str_after_sql = obj_after.is_start() ? "" : " AND date <= ?2 AND (date < ?2 OR id > ?3)";
+
+	// A purchase newer than the reports' watermark stays in the purchases table however old it is, so neither table is assumed to come first
+	// and the two are paged through as one, each side using the same key
+	std::string str_fetch_page_sql =
+		"SELECT id, total, datetime(date, 'unixepoch'), date FROM purchases WHERE user_id = ?1" + str_after_sql + " " \
+		"UNION ALL SELECT id, total, datetime(date, 'unixepoch'), date FROM purchases_archive WHERE user_id = ?1" + str_after_sql + " " \
+		"ORDER BY 4 DESC, 1 LIMIT ?4";
+
+	if (sqlite3_prepare_v2(_db, str_fetch_page_sql.c_str(), -1, &stmt_fetch_page, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	// Read one more than the page size, so we know whether there is another page without counting the purchases
+	sqlite3_bind_int(stmt_fetch_page, 1, obj_user.get_id());
+	sqlite3_bind_int64(stmt_fetch_page, 2, obj_after.get_date());
+	sqlite3_bind_int(stmt_fetch_page, 3, obj_after.get_id());
+	sqlite3_bind_int(stmt_fetch_page, 4, i_page_size + 1);
+
+	while ((i_return_code = sqlite3_step(stmt_fetch_page)) == SQLITE_ROW) {
+		if ((int)obj_page.get_vec_purchases().size() == i_page_size) {
+			obj_page.set_has_more(true);
+			continue;
+		}
+
+		obj_page.add_purchase(
+			Purchase(
+				sqlite3_column_int(stmt_fetch_page, 0),
+				Money(sqlite3_column_int64(stmt_fetch_page, 1)),
+				(char*)sqlite3_column_text(stmt_fetch_page, 2)),
+			sqlite3_column_int64(stmt_fetch_page, 3));
+	}
+
+	if (i_return_code != SQLITE_DONE) {
+		std::string str_error_msg = "Failed to fetch purchases: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		sqlite3_finalize(stmt_fetch_page);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_finalize(stmt_fetch_page);
+
+	return obj_page;
+}
+
+UserPurchaseSummary PurchaseManager::get_user_purchase_stats(User& obj_user) {
+	UserPurchaseSummary obj_summary(obj_user.get_id());
+	sqlite3_stmt* stmt_stats;
+
+	std::string str_stats_sql = "SELECT purchase_count, total, game_copies FROM user_purchase_stats WHERE user_id = ?";
+
+	if (sqlite3_prepare_v2(_db, str_stats_sql.c_str(), -1, &stmt_stats, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int(stmt_stats, 1, obj_user.get_id());
+
+	// No row means the user has not made any purchases yet
+	if (sqlite3_step(stmt_stats) == SQLITE_ROW) {
+		obj_summary = UserPurchaseSummary(obj_user.get_id(), sqlite3_column_int(stmt_stats, 0), Money(sqlite3_column_int64(stmt_stats, 1)), sqlite3_column_int(stmt_stats, 2));
+	}
+
+	sqlite3_finalize(stmt_stats);
+	return obj_summary;
+}
+
+std::vector<UserPurchaseSummary> PurchaseManager::get_user_purchase_summaries(std::vector<User>& vec_users, bool bool_include_purchases) {
+	std::vector<UserPurchaseSummary> vec_summaries;
+	std::unordered_map<int, size_t> map_summary_positions;
+	sqlite3_stmt* stmt_summaries;
+
+	// Summaries are returned in the same order as the users, so start with an empty summary for each
+	for (User& user : vec_users) {
+		map_summary_positions[user.get_id()] = vec_summaries.size();
+		vec_summaries.push_back(UserPurchaseSummary(user.get_id()));
+	}
+
+	// Either read the trigger maintained stats (one row per user), or read every purchase in one pass ordered by user when they are needed as well
+	std::string str_summaries_sql = "SELECT user_id, purchase_count, total, game_copies FROM user_purchase_stats";
+
+	if (bool_include_purchases) {
+		str_summaries_sql =
+			"SELECT user_id, id, total, datetime(date, 'unixepoch'), date FROM purchases " \
+			"UNION ALL SELECT user_id, id, total, datetime(date, 'unixepoch'), date FROM purchases_archive ORDER BY 1, 5 DESC, 2";
+	}
+
+	if (sqlite3_prepare_v2(_db, str_summaries_sql.c_str(), -1, &stmt_summaries, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	while (sqlite3_step(stmt_summaries) == SQLITE_ROW) {
+		auto position = map_summary_positions.find(sqlite3_column_int(stmt_summaries, 0));
+
+		// Skip purchases of users that were not asked for
+		if (position == map_summary_positions.end()) continue;
+
+		UserPurchaseSummary& obj_summary = vec_summaries[position->second];
+
+		if (bool_include_purchases) {
+			obj_summary.add_purchase(Purchase(
+				sqlite3_column_int(stmt_summaries, 1),
+				Money(sqlite3_column_int64(stmt_summaries, 2)),
+				(char*)sqlite3_column_text(stmt_summaries, 3)));
+		}
+		else {
+			obj_summary = UserPurchaseSummary(obj_summary.get_user_id(), sqlite3_column_int(stmt_summaries, 1), Money(sqlite3_column_int64(stmt_summaries, 2)), sqlite3_column_int(stmt_summaries, 3));
+		}
+	}
+
+	sqlite3_finalize(stmt_summaries);
+	return vec_summaries;
+}
+
+Money PurchaseManager::get_purchase_grand_total() {
 	// Sum the totals of all purchases and return
-	return std::accumulate(_vec_purchases.begin(),	_vec_purchases.end(), 0.0, [&](double total, Purchase& purchase) {
+	return std::accumulate(_vec_purchases.begin(),	_vec_purchases.end(), Money(), [&](Money total, Purchase& purchase) {
 		return total + purchase.get_total();
 	});
 }
 
-double PurchaseManager::get_purchase_average() {
+Money PurchaseManager::get_purchase_average() {
 	// Calculate average by getting total and then dividing by the number of purchases
-	return get_purchase_grand_total() / (double)_vec_purchases.size();
+	return get_purchase_grand_total().divide_by((std::int64_t)_vec_purchases.size());
 }
 
 int PurchaseManager::get_total_game_copies() {
@@ -81,4 +239,606 @@ void PurchaseManager::ensure_save_directory_exists() {
 	if (!std::filesystem::exists(_saves_path)) {
 		std::filesystem::create_directory(_saves_path);
 	}
+}
+
+std::shared_ptr<ReportJob> PurchaseManager::queue_report(std::string str_file_name, std::string str_unit_name, int i_total_units, ReportWriter fn_write_report) {
+	ensure_save_directory_exists();
+
+	return _ptr_report_scheduler->queue(_saves_path / str_file_name, str_unit_name, i_total_units, fn_write_report);
+}
+
+void PurchaseManager::export_purchases(PurchaseExportWriter& obj_writer, std::ostream& os, int i_user_id, ReportJob* ptr_job) {
+	sqlite3_stmt* stmt_export;
+
+	// Archived purchases are included. Both tables are read in user and date order (the purchases index and the archive's key), so the two are merged rather than sorted
+	std::string str_export_sql =
+		"SELECT p.id, p.user_id, p.date, strftime('%Y-%m-%dT%H:%M:%SZ', p.date, 'unixepoch'), s.name, s.genre, s.rating, i.count, i.game_price, i.total, i.id FROM purchases AS p INNER JOIN purchase_items AS i ON i.purchase_id = p.id INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id " \
+		"UNION ALL SELECT p.id, p.user_id, p.date, strftime('%Y-%m-%dT%H:%M:%SZ', p.date, 'unixepoch'), s.name, s.genre, s.rating, i.count, i.game_price, i.count * i.game_price, i.id FROM purchases_archive AS p INNER JOIN purchase_items_archive AS i ON i.purchase_id = p.id INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id " \
+		"ORDER BY 2, 3 DESC, 1, 11";
+
+	if (i_user_id != 0) {
+		str_export_sql =
+			"SELECT p.id, p.user_id, p.date, strftime('%Y-%m-%dT%H:%M:%SZ', p.date, 'unixepoch'), s.name, s.genre, s.rating, i.count, i.game_price, i.total, i.id FROM purchases AS p INNER JOIN purchase_items AS i ON i.purchase_id = p.id INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE p.user_id = ?1 " \
+			"UNION ALL SELECT p.id, p.user_id, p.date, strftime('%Y-%m-%dT%H:%M:%SZ', p.date, 'unixepoch'), s.name, s.genre, s.rating, i.count, i.game_price, i.count * i.game_price, i.id FROM purchases_archive AS p INNER JOIN purchase_items_archive AS i ON i.purchase_id = p.id INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE p.user_id = ?1 " \
+			"ORDER BY 3 DESC, 1, 11";
+	}
+
+	if (sqlite3_prepare_v2(_db, str_export_sql.c_str(), -1, &stmt_export, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	if (i_user_id != 0) sqlite3_bind_int(stmt_export, 1, i_user_id);
+
+	try {
+		PurchaseExportRow obj_row;
+		std::int64_t ll_bytes_reported = 0;
+
+		obj_writer.begin(os);
+
+		while (sqlite3_step(stmt_export) == SQLITE_ROW) {
+			if (ptr_job != NULL && ptr_job->is_cancel_requested()) break;
+
+			int i_purchase_id = sqlite3_column_int(stmt_export, 0);
+
+			// A new purchase id means the previous purchase has been fully written
+			if (ptr_job != NULL && obj_row.i_purchase_id != 0 && i_purchase_id != obj_row.i_purchase_id) {
+				ptr_job->add_progress(1, obj_writer.get_bytes_written() - ll_bytes_reported);
+				ll_bytes_reported = obj_writer.get_bytes_written();
+			}
+
+			obj_row.i_purchase_id = i_purchase_id;
+			obj_row.i_user_id = sqlite3_column_int(stmt_export, 1);
+			obj_row.ll_date = sqlite3_column_int64(stmt_export, 2);
+			obj_row.str_date = (char*)sqlite3_column_text(stmt_export, 3);
+			obj_row.str_game_name = (char*)sqlite3_column_text(stmt_export, 4);
+			obj_row.str_game_genre = (char*)sqlite3_column_text(stmt_export, 5);
+			obj_row.str_game_rating = (char*)sqlite3_column_text(stmt_export, 6);
+			obj_row.i_count = sqlite3_column_int(stmt_export, 7);
+			obj_row.obj_price = Money(sqlite3_column_int64(stmt_export, 8));
+			obj_row.obj_total = Money(sqlite3_column_int64(stmt_export, 9));
+
+			obj_writer.write_row(obj_row);
+		}
+
+		if (ptr_job == NULL || !ptr_job->is_cancel_requested()) {
+			obj_writer.end();
+
+			if (ptr_job != NULL && obj_row.i_purchase_id != 0) ptr_job->add_progress(1, obj_writer.get_bytes_written() - ll_bytes_reported);
+		}
+	}
+	catch (...) {
+		sqlite3_finalize(stmt_export);
+		throw;
+	}
+
+	sqlite3_finalize(stmt_export);
+}
+
+std::shared_ptr<ReportJob> PurchaseManager::queue_purchase_export(std::string str_file_name, PurchaseExportFormat format, int i_user_id) {
+	std::shared_ptr<PurchaseExportWriter> ptr_writer = PurchaseExportWriter::create(format);
+	sqlite3_stmt* stmt_count;
+	int i_purchase_count = 0;
+
+	// Progress is added as each purchase is written, and only purchases with items have any rows, so only they are counted towards the total
+	std::string str_count_sql =
+		"SELECT (SELECT COUNT(*) FROM purchases AS p WHERE (?1 = 0 OR p.user_id = ?1) AND EXISTS(SELECT 1 FROM purchase_items AS i INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE i.purchase_id = p.id)) " \
+		"+ (SELECT COUNT(*) FROM purchases_archive AS p WHERE (?1 = 0 OR p.user_id = ?1) AND EXISTS(SELECT 1 FROM purchase_items_archive AS i INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE i.purchase_id = p.id))";
+
+	if (sqlite3_prepare_v2(_db, str_count_sql.c_str(), -1, &stmt_count, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int(stmt_count, 1, i_user_id);
+
+	if (sqlite3_step(stmt_count) == SQLITE_ROW) {
+		i_purchase_count = sqlite3_column_int(stmt_count, 0);
+	}
+
+	sqlite3_finalize(stmt_count);
+	ensure_save_directory_exists();
+
+	return _ptr_report_scheduler->queue(_saves_path / (str_file_name + ptr_writer->get_file_extension()), "purchases", i_purchase_count, [=](ReportJob& obj_job, sqlite3* db, std::ostream& os) {
+		PurchaseManager(db).export_purchases(*ptr_writer, os, i_user_id, &obj_job);
+		}, ptr_writer->is_binary());
+}
+
+std::vector<SalesBucket> PurchaseManager::get_sales(SalesPeriod period, std::int64_t ll_from, std::int64_t ll_to) {
+	std::vector<SalesBucket> vec_buckets;
+	std::unordered_map<std::int64_t, size_t> map_bucket_positions;
+	sqlite3_stmt* stmt_sales;
+
+	// Start with an empty bucket for each period, so periods without sales are still returned
+	for (std::int64_t ll_start = SalesBucket::get_period_start(period, ll_from); ll_start < ll_to; ll_start = SalesBucket::add_periods(period, ll_start, 1)) {
+		map_bucket_positions[ll_start] = vec_buckets.size();
+		vec_buckets.push_back(SalesBucket(ll_start));
+	}
+
+	if (vec_buckets.empty()) return vec_buckets;
+
+	// Weeks do not line up with months, so are made up from the daily rollup (at most 7 rows a week)
+	std::string str_sales_sql = "SELECT day, revenue, units, orders FROM sales_daily WHERE day >= ? AND day < ? ORDER BY day";
+
+	if (period == SalesPeriod::Month) {
+		str_sales_sql = "SELECT month, revenue, units, orders FROM sales_monthly WHERE month >= ? AND month < ? ORDER BY month";
+	}
+
+	if (sqlite3_prepare_v2(_db, str_sales_sql.c_str(), -1, &stmt_sales, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int64(stmt_sales, 1, vec_buckets.front().get_start());
+	sqlite3_bind_int64(stmt_sales, 2, ll_to);
+
+	while (sqlite3_step(stmt_sales) == SQLITE_ROW) {
+		SalesBucket obj_rollup(
+			sqlite3_column_int64(stmt_sales, 0),
+			Money(sqlite3_column_int64(stmt_sales, 1)),
+			sqlite3_column_int(stmt_sales, 2),
+			sqlite3_column_int(stmt_sales, 3));
+
+		auto position = map_bucket_positions.find(SalesBucket::get_period_start(period, obj_rollup.get_start()));
+		if (position != map_bucket_positions.end()) vec_buckets[position->second].add(obj_rollup);
+	}
+
+	sqlite3_finalize(stmt_sales);
+	return vec_buckets;
+}
+
+std::vector<GameSales> PurchaseManager::read_best_sellers(sqlite3_stmt* stmt_best_sellers, int i_limit_index, int i_limit) {
+	std::vector<GameSales> vec_best_sellers;
+
+	sqlite3_bind_int(stmt_best_sellers, i_limit_index, i_limit);
+
+	while (sqlite3_step(stmt_best_sellers) == SQLITE_ROW) {
+		vec_best_sellers.push_back(
+			GameSales(
+				sqlite3_column_int(stmt_best_sellers, 0),
+				(char*)sqlite3_column_text(stmt_best_sellers, 1),
+				sqlite3_column_int(stmt_best_sellers, 2),
+				Money(sqlite3_column_int64(stmt_best_sellers, 3))));
+	}
+
+	sqlite3_finalize(stmt_best_sellers);
+	return vec_best_sellers;
+}
+
+std::vector<GameSales> PurchaseManager::get_best_sellers(int i_limit) {
+	if (i_limit < 1) {
+		throw std::invalid_argument("Best sellers limit must be at least 1.");
+	}
+
+	sqlite3_stmt* stmt_best_sellers;
+
+	// Each game's items are totalled in the game indexes of the purchase items and archive tables, so only the games (not the items) are sorted to
+	// find the best sellers
+	std::string str_best_sellers_sql =
+		"SELECT g.id, g.name, s.units, s.revenue FROM (SELECT game_id, SUM(units) AS units, SUM(revenue) AS revenue FROM (" \
+		"SELECT game_id, SUM(count) AS units, SUM(count * game_price) AS revenue FROM purchase_items WHERE game_id IS NOT NULL GROUP BY game_id " \
+		"UNION ALL SELECT game_id, SUM(count), SUM(count * game_price) FROM purchase_items_archive WHERE game_id IS NOT NULL GROUP BY game_id) GROUP BY game_id) AS s " \
+		"INNER JOIN games AS g ON g.id = s.game_id ORDER BY s.units DESC, g.id LIMIT ?";
+
+	if (sqlite3_prepare_v2(_db, str_best_sellers_sql.c_str(), -1, &stmt_best_sellers, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	return read_best_sellers(stmt_best_sellers, 1, i_limit);
+}
+
+std::vector<GameSales> PurchaseManager::get_best_sellers_by_genre(int i_genre_id, int i_limit) {
+	if (i_limit < 1) {
+		throw std::invalid_argument("Best sellers limit must be at least 1.");
+	}
+
+	sqlite3_stmt* stmt_best_sellers;
+
+	// Only the games in the genre have their items looked up in the game indexes, of both the purchase items and the archived items
+	std::string str_best_sellers_sql =
+		"SELECT id, name, SUM(units) AS units, SUM(revenue) FROM (" \
+		"SELECT g.id, g.name, i.count AS units, i.count * i.game_price AS revenue FROM games AS g INNER JOIN purchase_items AS i ON i.game_id = g.id WHERE g.genre_id = ?1 " \
+		"UNION ALL SELECT g.id, g.name, i.count, i.count * i.game_price FROM games AS g INNER JOIN purchase_items_archive AS i ON i.game_id = g.id WHERE g.genre_id = ?1) " \
+		"GROUP BY id ORDER BY units DESC, id LIMIT ?2";
+
+	if (sqlite3_prepare_v2(_db, str_best_sellers_sql.c_str(), -1, &stmt_best_sellers, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int(stmt_best_sellers, 1, i_genre_id);
+
+	return read_best_sellers(stmt_best_sellers, 2, i_limit);
+}
+
+std::vector<GameSales> PurchaseManager::get_best_sellers_in_period(std::int64_t ll_from, std::int64_t ll_to, int i_limit) {
+	if (i_limit < 1) {
+		throw std::invalid_argument("Best sellers limit must be at least 1.");
+	}
+
+	sqlite3_stmt* stmt_best_sellers;
+
+	// Purchases in the period are found through the date indexes (of the purchases and the archive), then their items through the purchase index
+	// or key of the matching items table
+	std::string str_best_sellers_sql =
+		"SELECT id, name, SUM(units) AS units, SUM(revenue) FROM (" \
+		"SELECT g.id, g.name, i.count AS units, i.count * i.game_price AS revenue FROM purchases AS p INNER JOIN purchase_items AS i ON i.purchase_id = p.id INNER JOIN games AS g ON g.id = i.game_id WHERE p.date >= ?1 AND p.date < ?2 " \
+		"UNION ALL SELECT g.id, g.name, i.count, i.count * i.game_price FROM purchases_archive AS p INNER JOIN purchase_items_archive AS i ON i.purchase_id = p.id INNER JOIN games AS g ON g.id = i.game_id WHERE p.date >= ?1 AND p.date < ?2) " \
+		"GROUP BY id ORDER BY units DESC, id LIMIT ?3";
+
+	if (sqlite3_prepare_v2(_db, str_best_sellers_sql.c_str(), -1, &stmt_best_sellers, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int64(stmt_best_sellers, 1, ll_from);
+	sqlite3_bind_int64(stmt_best_sellers, 2, ll_to);
+
+	return read_best_sellers(stmt_best_sellers, 3, i_limit);
+}
+
+std::vector<SalesGroup> PurchaseManager::get_sales_breakdown(SalesDimension dimension, std::int64_t ll_from, std::int64_t ll_to) {
+	_ptr_sales_store->load_new(_db);
+	return _ptr_sales_store->group_by(dimension, ll_from, ll_to);
+}
+
+std::vector<CoPurchase> PurchaseManager::get_recommendations(int i_game_id, int i_limit) {
+	if (i_limit < 1) {
+		throw std::invalid_argument("Recommendations limit must be at least 1.");
+	}
+
+	_ptr_co_purchase_index->load_new(_db);
+	return _ptr_co_purchase_index->get_top(i_game_id, (size_t)i_limit);
+}
+
+int PurchaseManager::update_report_totals(std::string str_report_name) {
+	sqlite3_stmt* stmt_watermark = NULL;
+	sqlite3_stmt* stmt_merge_totals = NULL;
+	sqlite3_stmt* stmt_set_watermark = NULL;
+	std::int64_t ll_last_purchase_id = 0;
+	std::int64_t ll_new_last_purchase_id = 0;
+	int i_purchase_count = 0;
+	bool bool_first_run = false;
+
+	// The current watermark, then the newest purchase and the number of purchases after the watermark, found from the primary key.
+	// Purchases are only archived once every report has merged them, so the archive is only read the first time a report is run
+	std::string str_watermark_sql =
+		"WITH w AS (SELECT COALESCE((SELECT last_purchase_id FROM report_watermarks WHERE report_name = ?1), 0) AS last_purchase_id, NOT EXISTS(SELECT 1 FROM report_watermarks WHERE report_name = ?1) AS first_run) " \
+		"SELECT w.last_purchase_id, COALESCE(MAX(p.id), w.last_purchase_id), COUNT(p.id) + CASE WHEN w.first_run THEN (SELECT COUNT(*) FROM purchases_archive) ELSE 0 END, w.first_run " \
+		"FROM w LEFT JOIN purchases AS p ON p.id > w.last_purchase_id";
+
+	// Only the purchases after the watermark are read, and their totals added onto what the report already has for each user
+	std::string str_merge_totals_sql =
+		"INSERT INTO report_user_totals(report_name, user_id, purchase_count, total, game_copies, last_purchase_date) " \
+		"SELECT ?1, p.user_id, COUNT(*), SUM(p.total), SUM(p.game_copies), MAX(p.date) FROM (" \
+		"SELECT id, user_id, total, date, (SELECT COALESCE(SUM(i.count), 0) FROM purchase_items AS i WHERE i.purchase_id = purchases.id) AS game_copies FROM purchases WHERE id > ?2 AND id <= ?3 " \
+		"UNION ALL SELECT id, user_id, total, date, (SELECT COALESCE(SUM(i.count), 0) FROM purchase_items_archive AS i WHERE i.purchase_id = purchases_archive.id) FROM purchases_archive WHERE ?4" \
+		") AS p GROUP BY p.user_id " \
+		"ON CONFLICT(report_name, user_id) DO UPDATE SET purchase_count = purchase_count + excluded.purchase_count, total = total + excluded.total, " \
+		"game_copies = game_copies + excluded.game_copies, last_purchase_date = MAX(last_purchase_date, excluded.last_purchase_date)";
+
+	std::string str_set_watermark_sql =
+		"INSERT INTO report_watermarks(report_name, last_purchase_id) VALUES (?1, ?2) " \
+		"ON CONFLICT(report_name) DO UPDATE SET last_purchase_id = excluded.last_purchase_id, updated = CAST(strftime('%s', 'now') AS INTEGER)";
+
+	// Taken for writing straight away, so a checkout cannot add a purchase between reading the watermark and moving it
+	if (sqlite3_exec(_db, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to update report totals: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	try {
+		if (sqlite3_prepare_v2(_db, str_watermark_sql.c_str(), -1, &stmt_watermark, NULL) != SQLITE_OK
+			|| sqlite3_prepare_v2(_db, str_merge_totals_sql.c_str(), -1, &stmt_merge_totals, NULL) != SQLITE_OK
+			|| sqlite3_prepare_v2(_db, str_set_watermark_sql.c_str(), -1, &stmt_set_watermark, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to prepare report statement: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		sqlite3_bind_text(stmt_watermark, 1, str_report_name.c_str(), -1, SQLITE_TRANSIENT);
+
+		if (sqlite3_step(stmt_watermark) == SQLITE_ROW) {
+			ll_last_purchase_id = sqlite3_column_int64(stmt_watermark, 0);
+			ll_new_last_purchase_id = sqlite3_column_int64(stmt_watermark, 1);
+			i_purchase_count = sqlite3_column_int(stmt_watermark, 2);
+			bool_first_run = sqlite3_column_int(stmt_watermark, 3) != 0;
+		}
+
+		if (i_purchase_count > 0) {
+			sqlite3_bind_text(stmt_merge_totals, 1, str_report_name.c_str(), -1, SQLITE_TRANSIENT);
+			sqlite3_bind_int64(stmt_merge_totals, 2, ll_last_purchase_id);
+			sqlite3_bind_int64(stmt_merge_totals, 3, ll_new_last_purchase_id);
+			sqlite3_bind_int(stmt_merge_totals, 4, bool_first_run);
+
+			sqlite3_bind_text(stmt_set_watermark, 1, str_report_name.c_str(), -1, SQLITE_TRANSIENT);
+			sqlite3_bind_int64(stmt_set_watermark, 2, ll_new_last_purchase_id);
+
+			if (sqlite3_step(stmt_merge_totals) != SQLITE_DONE || sqlite3_step(stmt_set_watermark) != SQLITE_DONE) {
+				std::string str_error_msg = "Failed to update report totals: ";
+				str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+				throw std::runtime_error(str_error_msg);
+			}
+		}
+
+		if (sqlite3_exec(_db, "COMMIT TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to update report totals: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			throw std::runtime_error(str_error_msg);
+		}
+	}
+	catch (std::exception&) {
+		sqlite3_finalize(stmt_watermark);
+		sqlite3_finalize(stmt_merge_totals);
+		sqlite3_finalize(stmt_set_watermark);
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+		throw;
+	}
+
+	sqlite3_finalize(stmt_watermark);
+	sqlite3_finalize(stmt_merge_totals);
+	sqlite3_finalize(stmt_set_watermark);
+	return i_purchase_count;
+}
+
+void PurchaseManager::reset_report_totals(std::string str_report_name) {
+	sqlite3_stmt* stmt_reset;
+	char* errorMessage;
+
+	// Both tables are cleared together, so the report is never left with totals but no watermark
+	sqlite3_exec(_db, "BEGIN TRANSACTION;", NULL, NULL, &errorMessage);
+
+	for (std::string str_table : { "report_user_totals", "report_watermarks" }) {
+		std::string str_delete_sql = "DELETE FROM " + str_table + " WHERE report_name = ?";
+
+		if (sqlite3_prepare_v2(_db, str_delete_sql.c_str(), -1, &stmt_reset, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to prepare delete statement: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		sqlite3_bind_text(stmt_reset, 1, str_report_name.c_str(), -1, SQLITE_TRANSIENT);
+
+		if (sqlite3_step(stmt_reset) != SQLITE_DONE) {
+			std::string str_error_msg = "Failed to reset report totals: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			sqlite3_finalize(stmt_reset);
+			sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		sqlite3_finalize(stmt_reset);
+	}
+
+	if (sqlite3_exec(_db, "COMMIT TRANSACTION;", NULL, NULL, &errorMessage) != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+		throw std::runtime_error("Failed to reset report totals.");
+	}
+}
+
+void PurchaseManager::write_report_totals(std::string str_report_name, std::ostream& os, ReportJob* ptr_job) {
+	sqlite3_stmt* stmt_totals;
+	std::int64_t ll_purchase_count = 0;
+	std::int64_t ll_game_copies = 0;
+	Money obj_all_purchase_total;
+
+	std::string str_totals_sql =
+		"SELECT u.email, t.purchase_count, t.game_copies, t.total, datetime(t.last_purchase_date, 'unixepoch') " \
+		"FROM report_user_totals AS t INNER JOIN users AS u ON u.id = t.user_id WHERE t.report_name = ? ORDER BY t.total DESC, u.email";
+
+	if (sqlite3_prepare_v2(_db, str_totals_sql.c_str(), -1, &stmt_totals, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_text(stmt_totals, 1, str_report_name.c_str(), -1, SQLITE_TRANSIENT);
+
+	try {
+		RowFormatter obj_formatter(os);
+		std::int64_t ll_bytes_reported = 0;
+
+		obj_formatter.text("All user purchase totals").end_row();
+		obj_formatter.text("This report shows the purchase count, game copies and total spent by each user that has made a purchase, most spent first.").end_row();
+		obj_formatter.end_row();
+		obj_formatter
+			.text("User", 40)
+			.text("Purchases", 12)
+			.text("Game copies", 14)
+			.text("Total", 15)
+			.text("Last purchase")
+			.end_row();
+
+		while (sqlite3_step(stmt_totals) == SQLITE_ROW) {
+			if (ptr_job != NULL && ptr_job->is_cancel_requested()) break;
+
+			Money obj_total = Money(sqlite3_column_int64(stmt_totals, 3));
+			ll_purchase_count += sqlite3_column_int64(stmt_totals, 1);
+			ll_game_copies += sqlite3_column_int64(stmt_totals, 2);
+			obj_all_purchase_total += obj_total;
+
+			obj_formatter
+				.text((char*)sqlite3_column_text(stmt_totals, 0), 40)
+				.integer(sqlite3_column_int64(stmt_totals, 1), 12)
+				.integer(sqlite3_column_int64(stmt_totals, 2), 14)
+				.money(obj_total, 15)
+				.text((char*)sqlite3_column_text(stmt_totals, 4))
+				.end_row();
+
+			if (ptr_job != NULL) {
+				ptr_job->add_progress(1, obj_formatter.get_bytes_written() - ll_bytes_reported);
+				ll_bytes_reported = obj_formatter.get_bytes_written();
+			}
+		}
+
+		obj_formatter.end_row();
+		obj_formatter.text("All purchases total: ").money(obj_all_purchase_total).end_row();
+		obj_formatter.text("All purchases count: ").integer(ll_purchase_count).end_row();
+		obj_formatter.text("All game copies: ").integer(ll_game_copies).end_row();
+		obj_formatter.flush();
+	}
+	catch (std::exception&) {
+		sqlite3_finalize(stmt_totals);
+		throw;
+	}
+
+	sqlite3_finalize(stmt_totals);
+}
+
+std::shared_ptr<ReportJob> PurchaseManager::queue_incremental_report(std::string str_file_name, std::string str_report_name) {
+	sqlite3_stmt* stmt_count;
+	int i_user_count = 0;
+
+	// Merged here rather than on the report's thread, as the report's connection is read only
+	update_report_totals(str_report_name);
+
+	std::string str_count_sql = "SELECT COUNT(*) FROM report_user_totals WHERE report_name = ?";
+
+	if (sqlite3_prepare_v2(_db, str_count_sql.c_str(), -1, &stmt_count, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_text(stmt_count, 1, str_report_name.c_str(), -1, SQLITE_TRANSIENT);
+
+	if (sqlite3_step(stmt_count) == SQLITE_ROW) {
+		i_user_count = sqlite3_column_int(stmt_count, 0);
+	}
+
+	sqlite3_finalize(stmt_count);
+
+	return queue_report(str_file_name, "users", i_user_count, [=](ReportJob& obj_job, sqlite3* db, std::ostream& os) {
+		PurchaseManager(db).write_report_totals(str_report_name, os, &obj_job);
+		});
+}
+
+int PurchaseManager::archive_purchases(int i_days) {
+	if (i_days < 1) {
+		throw std::invalid_argument("Purchases must be at least 1 day old to be archived.");
+	}
+
+	sqlite3_stmt* stmt_report_names;
+	sqlite3_stmt* stmt_range = NULL;
+	std::vector<std::string> vec_report_names;
+	int i_archived_count = 0;
+
+	// Incremental reports only read new purchases from the purchases table, so each one is brought up to date before anything is moved out of it
+	std::string str_report_names_sql = "SELECT report_name FROM report_watermarks";
+
+	if (sqlite3_prepare_v2(_db, str_report_names_sql.c_str(), -1, &stmt_report_names, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	while (sqlite3_step(stmt_report_names) == SQLITE_ROW) {
+		vec_report_names.push_back((char*)sqlite3_column_text(stmt_report_names, 0));
+	}
+
+	sqlite3_finalize(stmt_report_names);
+
+	for (std::string& str_report_name : vec_report_names) {
+		update_report_totals(str_report_name);
+	}
+
+	// Likewise the sales store and co-purchase index, once loaded they only read new items from the purchase_items table
+	if (_ptr_sales_store->get_row_count() > 0) _ptr_sales_store->load_new(_db);
+	if (_ptr_co_purchase_index->is_loaded()) _ptr_co_purchase_index->load_new(_db);
+
+	// Purchases made before the cutoff that every report has merged, ?1 is the cutoff and ?2 the highest id
+	std::string str_range_sql = "SELECT CAST(strftime('%s', 'now') AS INTEGER) - ? * 86400, COALESCE((SELECT MIN(last_purchase_id) FROM report_watermarks), (SELECT MAX(id) FROM purchases), 0)";
+	std::string str_archived_where = " WHERE p.date < ?1 AND p.id <= ?2";
+
+	// The stats and daily/monthly rollups still count archived purchases, so their totals are added back on before the delete triggers take them off.
+	// Items are deleted first (while their purchase still exists) so their triggers take off their copies, rather than relying on the cascade
+	std::vector<std::string> vec_archive_sql = {
+		"INSERT INTO purchases_archive(user_id, date, id, total) SELECT p.user_id, p.date, p.id, p.total FROM purchases AS p" + str_archived_where,
+		"INSERT INTO purchase_items_archive(purchase_id, id, snapshot_id, game_price, count, game_id) SELECT i.purchase_id, i.id, i.snapshot_id, i.game_price, i.count, i.game_id FROM purchases AS p INNER JOIN purchase_items AS i ON i.purchase_id = p.id" + str_archived_where,
+		"UPDATE user_purchase_stats SET purchase_count = purchase_count + a.archived_count, total = total + a.archived_total, game_copies = game_copies + a.archived_copies " \
+		"FROM (SELECT p.user_id, COUNT(*) AS archived_count, SUM(p.total) AS archived_total, SUM((SELECT COALESCE(SUM(i.count), 0) FROM purchase_items AS i WHERE i.purchase_id = p.id)) AS archived_copies FROM purchases AS p" + str_archived_where + " GROUP BY p.user_id) AS a " \
+		"WHERE user_purchase_stats.user_id = a.user_id",
+		"UPDATE sales_daily SET revenue = revenue + a.archived_revenue, units = units + a.archived_units, orders = orders + a.archived_orders " \
+		"FROM (SELECT CAST(strftime('%s', p.date, 'unixepoch', 'start of day') AS INTEGER) AS day, SUM(p.total) AS archived_revenue, SUM((SELECT COALESCE(SUM(i.count), 0) FROM purchase_items AS i WHERE i.purchase_id = p.id)) AS archived_units, COUNT(*) AS archived_orders FROM purchases AS p" + str_archived_where + " GROUP BY 1) AS a " \
+		"WHERE sales_daily.day = a.day",
+		"UPDATE sales_monthly SET revenue = revenue + a.archived_revenue, units = units + a.archived_units, orders = orders + a.archived_orders " \
+		"FROM (SELECT CAST(strftime('%s', p.date, 'unixepoch', 'start of month') AS INTEGER) AS month, SUM(p.total) AS archived_revenue, SUM((SELECT COALESCE(SUM(i.count), 0) FROM purchase_items AS i WHERE i.purchase_id = p.id)) AS archived_units, COUNT(*) AS archived_orders FROM purchases AS p" + str_archived_where + " GROUP BY 1) AS a " \
+		"WHERE sales_monthly.month = a.month",
+		"DELETE FROM purchase_items WHERE purchase_id IN (SELECT p.id FROM purchases AS p" + str_archived_where + ")",
+		"DELETE FROM purchases WHERE date < ?1 AND id <= ?2"
+	};
+
+	// Taken for writing straight away, so nothing can be added between finding the range and moving it
+	if (sqlite3_exec(_db, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to archive purchases: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	try {
+		std::int64_t ll_cutoff = 0;
+		std::int64_t ll_last_purchase_id = 0;
+
+		if (sqlite3_prepare_v2(_db, str_range_sql.c_str(), -1, &stmt_range, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to prepare fetch statement: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		sqlite3_bind_int(stmt_range, 1, i_days);
+
+		if (sqlite3_step(stmt_range) == SQLITE_ROW) {
+			ll_cutoff = sqlite3_column_int64(stmt_range, 0);
+			ll_last_purchase_id = sqlite3_column_int64(stmt_range, 1);
+		}
+
+		sqlite3_finalize(stmt_range);
+		stmt_range = NULL;
+
+		for (std::string& str_archive_sql : vec_archive_sql) {
+			sqlite3_stmt* stmt_archive;
+
+			if (sqlite3_prepare_v2(_db, str_archive_sql.c_str(), -1, &stmt_archive, NULL) != SQLITE_OK) {
+				std::string str_error_msg = "Failed to prepare archive statement: ";
+				str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+				throw std::runtime_error(str_error_msg);
+			}
+
+			sqlite3_bind_int64(stmt_archive, 1, ll_cutoff);
+			sqlite3_bind_int64(stmt_archive, 2, ll_last_purchase_id);
+
+			if (sqlite3_step(stmt_archive) != SQLITE_DONE) {
+				std::string str_error_msg = "Failed to archive purchases: ";
+				str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+				sqlite3_finalize(stmt_archive);
+				throw std::runtime_error(str_error_msg);
+			}
+
+			// The last statement deletes the purchases that were moved
+			i_archived_count = sqlite3_changes(_db);
+			sqlite3_finalize(stmt_archive);
+		}
+
+		if (sqlite3_exec(_db, "COMMIT TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to archive purchases: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			throw std::runtime_error(str_error_msg);
+		}
+	}
+	catch (std::exception&) {
+		sqlite3_finalize(stmt_range);
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+		throw;
+	}
+
+	return i_archived_count;
 }
\ No newline at end of file
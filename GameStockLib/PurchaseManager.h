@@ -3,10 +3,24 @@
 #include <stdexcept>
 #include <numeric>
 #include <filesystem>
+#include <unordered_map>
+#include <memory>
 #include "sqlite3.h"
 #include "Purchase.h"
 #include "PurchaseItem.h"
 #include "User.h"
+#include "UserPurchaseSummary.h"
+#include "PurchaseCursor.h"
+#include "PurchasePage.h"
+#include "ReportScheduler.h"
+#include "PurchaseExportWriter.h"
+#include "SalesBucket.h"
+#include "GameSales.h"
+#include "SalesColumnStore.h"
+#include "CoPurchaseIndex.h"
+#include "RowFormatter.h"
+#include "ReadSnapshot.h"
+#include "Money.h"
 
 /// <summary>
 /// Class that is used to perform operations related to purchases
@@ -16,12 +30,37 @@ class PurchaseManager
 	sqlite3* _db;
 
 	std::vector<Purchase> _vec_purchases;
+
+	/// <summary>
+	/// Binds the limit as the last parameter of a prepared best sellers statement, then reads and finalizes it
+	/// </summary>
+	/// <param name="stmt_best_sellers">Columns must be game id, game name, units and revenue</param>
+	/// <param name="i_limit_index">Index of the limit parameter</param>
+	/// <param name="i_limit"></param>
+	/// <returns></returns>
+	std::vector<GameSales> read_best_sellers(sqlite3_stmt* stmt_best_sellers, int i_limit_index, int i_limit);
 	std::filesystem::path _saves_path = std::filesystem::path(L"saves");
+
+	// Shared so that copies of the manager queue onto the same background thread
+	std::shared_ptr<ReportScheduler> _ptr_report_scheduler;
+
+	// Shared for the same reason, and so checkout can append to it
+	std::shared_ptr<SalesColumnStore> _ptr_sales_store;
+
+	// Shared for the same reason as the sales store
+	std::shared_ptr<CoPurchaseIndex> _ptr_co_purchase_index;
 public:
-	PurchaseManager(sqlite3* db) { _db = db; }
+	PurchaseManager(sqlite3* db) { _db = db; _ptr_report_scheduler = std::make_shared<ReportScheduler>(db); _ptr_sales_store = std::make_shared<SalesColumnStore>(); _ptr_co_purchase_index = std::make_shared<CoPurchaseIndex>(); }
 
 	std::vector<Purchase>& get_vec_purchases() { return _vec_purchases; }
 
+	/// <summary>
+	/// Begins a read snapshot on the manager's connection, so several reads (by this or any other manager using the same connection) see the database
+	/// at the same point in time until it goes out of scope. Must not be held around writes.
+	/// </summary>
+	/// <returns></returns>
+	ReadSnapshot read_snapshot() { return ReadSnapshot(_db); }
+
 	/// <summary>
 	/// Gets all of the purchases made by a user from the database
 	/// </summary>
@@ -34,17 +73,124 @@ public:
 	/// <param name="obj_purchase"></param>
 	void populate_purchase_details(Purchase& obj_purchase);
 
+	/// <summary>
+	/// Gets all of the purchases made by a user along with their purchase items, using a single query rather than fetch_purchases followed by populate_purchase_details for each purchase
+	/// </summary>
+	/// <param name="obj_user"></param>
+	void fetch_purchases_with_details(User& obj_user);
+
+	/// <summary>
+	/// Opens a cursor over a user's purchases (newest first), so they can be displayed or written one at a time rather than all being loaded first.
+	/// The cursor should not be kept open longer than needed, as it holds a read on the database.
+	/// </summary>
+	/// <param name="obj_user"></param>
+	/// <param name="bool_include_items">Also read each purchase's items</param>
+	/// <returns></returns>
+	PurchaseCursor open_purchase_cursor(User& obj_user, bool bool_include_items = false);
+
+	/// <summary>
+	/// Gets a single page of a user's purchases (newest first), starting straight after the provided key. Pages are found by date and id through
+	/// the purchases index rather than by skipping the earlier purchases, so later pages cost the same to fetch as the first.
+	/// </summary>
+	/// <param name="obj_user"></param>
+	/// <param name="i_page_size">Maximum number of purchases in the page, must be at least 1</param>
+	/// <param name="obj_after">Key returned by the previous page, or the default key for the first page</param>
+	/// <returns></returns>
+	PurchasePage fetch_purchase_page(User& obj_user, int i_page_size, PurchasePageKey obj_after = PurchasePageKey());
+
+	/// <summary>
+	/// Gets the purchase count, total, average and game copies of a user from user_purchase_stats, which is kept up to date by triggers so does not depend on the number of purchases
+	/// </summary>
+	/// <param name="obj_user"></param>
+	/// <returns></returns>
+	UserPurchaseSummary get_user_purchase_stats(User& obj_user);
+
+	/// <summary>
+	/// Gets the purchase count, total, average and game copies of each of the provided users with a single query, in the same order as the users provided.
+	/// Users without purchases are given an empty summary.
+	/// </summary>
+	/// <param name="vec_users"></param>
+	/// <param name="bool_include_purchases">Also populate each summary with the user's purchases (newest first) by reading every purchase, otherwise the totals are read from user_purchase_stats</param>
+	/// <returns></returns>
+	std::vector<UserPurchaseSummary> get_user_purchase_summaries(std::vector<User>& vec_users, bool bool_include_purchases = false);
+
+	/// <summary>
+	/// Gets the revenue, units and orders of each day, week or month within a range, read from the daily/monthly rollups that are kept up to date by the
+	/// database rather than from every purchase. Every period in the range is returned (oldest first), including those without sales.
+	/// </summary>
+	/// <param name="period"></param>
+	/// <param name="ll_from">Start of the range in seconds since the epoch, the period it falls within is included</param>
+	/// <param name="ll_to">End of the range in seconds since the epoch, periods starting at or after it are not included</param>
+	/// <returns></returns>
+	std::vector<SalesBucket> get_sales(SalesPeriod period, std::int64_t ll_from, std::int64_t ll_to);
+
+	/// <summary>
+	/// Returns the in-memory store of every purchase item sold, used for sales breakdowns. Empty until first loaded (get_sales_breakdown loads it).
+	/// </summary>
+	/// <returns></returns>
+	std::shared_ptr<SalesColumnStore> get_sales_store() { return _ptr_sales_store; }
+
+	/// <summary>
+	/// Gets the revenue, units and lines of each genre, rating, price band or user within a range, most revenue first. Any purchase items not yet in the
+	/// sales store are appended to it first.
+	/// </summary>
+	/// <param name="dimension"></param>
+	/// <param name="ll_from">Start of the range in seconds since the epoch</param>
+	/// <param name="ll_to">End of the range in seconds since the epoch, purchases made at or after it are not included</param>
+	/// <returns></returns>
+	std::vector<SalesGroup> get_sales_breakdown(SalesDimension dimension, std::int64_t ll_from, std::int64_t ll_to);
+
+	/// <summary>
+	/// Gets the games that have sold the most copies, most first, totalled from the game indexes of the purchase items and archived items. Only purchase
+	/// items linked to a game that still exists are counted.
+	/// </summary>
+	/// <param name="i_limit">Maximum number of games to return, must be at least 1</param>
+	/// <returns></returns>
+	std::vector<GameSales> get_best_sellers(int i_limit);
+
+	/// <summary>
+	/// Gets the games within a genre that have sold the most copies, most first. Games are grouped by the genre they are currently in.
+	/// </summary>
+	/// <param name="i_genre_id"></param>
+	/// <param name="i_limit">Maximum number of games to return, must be at least 1</param>
+	/// <returns></returns>
+	std::vector<GameSales> get_best_sellers_by_genre(int i_genre_id, int i_limit);
+
+	/// <summary>
+	/// Gets the games that sold the most copies within a period, most first, finding the purchases made in the period through the date index
+	/// </summary>
+	/// <param name="ll_from">Start of the period in seconds since the epoch</param>
+	/// <param name="ll_to">End of the period in seconds since the epoch, purchases made at or after it are not included</param>
+	/// <param name="i_limit">Maximum number of games to return, must be at least 1</param>
+	/// <returns></returns>
+	std::vector<GameSales> get_best_sellers_in_period(std::int64_t ll_from, std::int64_t ll_to, int i_limit);
+
+	/// <summary>
+	/// Returns the in-memory index of games bought together, used for recommendations. Empty until first loaded (get_recommendations loads it).
+	/// </summary>
+	/// <returns></returns>
+	std::shared_ptr<CoPurchaseIndex> get_co_purchase_index() { return _ptr_co_purchase_index; }
+
+	/// <summary>
+	/// Gets the games most often bought in the same purchase as a game ("customers who bought this also bought"), most purchases first. Any purchases
+	/// not yet in the co-purchase index are added to it first. Games that have since been deleted may be included.
+	/// </summary>
+	/// <param name="i_game_id"></param>
+	/// <param name="i_limit">Maximum number of games to return, must be at least 1</param>
+	/// <returns></returns>
+	std::vector<CoPurchase> get_recommendations(int i_game_id, int i_limit);
+
 	/// <summary>
 	/// Gets the total of all the purchase totals currently stored within the object
 	/// </summary>
 	/// <returns></returns>
-	double get_purchase_grand_total();
+	Money get_purchase_grand_total();
 
 	/// <summary>
-	/// Gets the average of all the purchase totals currenlty stored within the project
+	/// Gets the average of all the purchase totals currenlty stored within the project, rounded to the nearest cent (zero when there are no purchases)
 	/// </summary>
 	/// <returns></returns>
-	double get_purchase_average();
+	Money get_purchase_average();
 
 	/// <summary>
 	/// Get the total number of game copies currently within the purchases
@@ -58,5 +204,91 @@ public:
 	/// Ensures that the saves path exists when exporting purchase related summaries, should be called before writing any files.
 	/// </summary>
 	void ensure_save_directory_exists();
+
+	/// <summary>
+	/// Queues a report to be written to the saves directory in the background, so the console can still be used while it is written
+	/// </summary>
+	/// <param name="str_file_name">Name of the file within the saves directory</param>
+	/// <param name="str_unit_name">What progress is counted in, e.g. "users"</param>
+	/// <param name="i_total_units">Number of units expected, used for progress and ETA</param>
+	/// <param name="fn_write_report">Writes the report, anything it uses must be captured by value as it runs after the caller has returned</param>
+	/// <returns>The job, used to follow progress or cancel the report</returns>
+	std::shared_ptr<ReportJob> queue_report(std::string str_file_name, std::string str_unit_name, int i_total_units, ReportWriter fn_write_report);
+
+	/// <summary>
+	/// Writes every purchase item (with the purchase it belongs to) to the provided writer, grouped by user and newest purchase first, reading
+	/// them one row at a time. Progress is counted in purchases.
+	/// </summary>
+	/// <param name="obj_writer"></param>
+	/// <param name="os"></param>
+	/// <param name="i_user_id">Only export this user's purchases, or 0 for every user</param>
+	/// <param name="ptr_job">Job to report progress to and check for cancellation, if any</param>
+	void export_purchases(PurchaseExportWriter& obj_writer, std::ostream& os, int i_user_id = 0, ReportJob* ptr_job = NULL);
+
+	/// <summary>
+	/// Queues an export of purchases in the provided format to the saves directory in the background, the format's extension is added to the file name
+	/// </summary>
+	/// <param name="str_file_name">Name of the file within the saves directory, without an extension</param>
+	/// <param name="format"></param>
+	/// <param name="i_user_id">Only export this user's purchases, or 0 for every user</param>
+	/// <returns>The job, used to follow progress or cancel the export</returns>
+	std::shared_ptr<ReportJob> queue_purchase_export(std::string str_file_name, PurchaseExportFormat format, int i_user_id = 0);
+
+	/// <summary>
+	/// Brings a report's stored per-user totals up to date by merging in only the purchases made since the report was last updated (its watermark is
+	/// the highest purchase id already merged), so the cost is proportional to the purchases made since rather than to every purchase ever made.
+	/// Totals for users that are deleted are removed with them; call reset_report_totals to start a report again from the first purchase.
+	/// </summary>
+	/// <param name="str_report_name">Name the report's totals and watermark are stored under</param>
+	/// <returns>The number of purchases merged</returns>
+	int update_report_totals(std::string str_report_name);
+
+	/// <summary>
+	/// Removes a report's stored totals and watermark, so its next update merges every purchase again
+	/// </summary>
+	/// <param name="str_report_name"></param>
+	void reset_report_totals(std::string str_report_name);
+
+	/// <summary>
+	/// Writes a report's stored per-user totals (most spent first) followed by the grand totals, as they were when the report was last updated.
+	/// Progress is counted in users.
+	/// </summary>
+	/// <param name="str_report_name"></param>
+	/// <param name="os"></param>
+	/// <param name="ptr_job">Job to report progress to and check for cancellation, if any</param>
+	void write_report_totals(std::string str_report_name, std::ostream& os, ReportJob* ptr_job = NULL);
+
+	/// <summary>
+	/// Updates a report's stored totals with the purchases made since it was last run, then queues writing them to the saves directory in the background
+	/// </summary>
+	/// <param name="str_file_name">Name of the file within the saves directory</param>
+	/// <param name="str_report_name">Name the report's totals and watermark are stored under</param>
+	/// <returns>The job, used to follow progress or cancel the report</returns>
+	std::shared_ptr<ReportJob> queue_incremental_report(std::string str_file_name, std::string str_report_name);
+
+	/// <summary>
+	/// Moves purchases made more than the provided number of days ago, and their items, out of the purchases tables and into the archive tables, keeping
+	/// the purchases tables and their indexes to recent history. The archive is only ever added to and is stored in user and date order, so a user's
+	/// archived purchases are read as one range without needing an index of their own. Purchase history, summaries, exports and reports read on into the
+	/// archive, and the stats, daily/monthly sales and best sellers still count archived purchases.
+	/// The archive tables are kept in the same database rather than an attached one, so moving purchases is a single atomic transaction (SQLite only
+	/// commits each attached database atomically on its own in WAL mode) and the archive keeps its foreign keys and triggers, which cannot reach
+	/// across databases.
+	/// </summary>
+	/// <param name="i_days">Age in days a purchase must be older than to be archived, must be at least 1</param>
+	/// <returns>The number of purchases archived</returns>
+	int archive_purchases(int i_days);
+
+	/// <summary>
+	/// Returns every report job queued so far, oldest first
+	/// </summary>
+	/// <returns></returns>
+	std::vector<std::shared_ptr<ReportJob>> get_report_jobs() { return _ptr_report_scheduler->get_jobs(); }
+
+	/// <summary>
+	/// Returns the report jobs that have finished since this was last called, used to let the user know a report is ready
+	/// </summary>
+	/// <returns></returns>
+	std::vector<std::shared_ptr<ReportJob>> take_finished_report_jobs() { return _ptr_report_scheduler->take_finished_jobs(); }
 };
 
@@ -0,0 +1,20 @@
+#include "PurchasePage.h"
+
+PurchasePageKey::PurchasePageKey() {
+	_ll_date = 0;
+	_i_id = 0;
+}
+
+PurchasePageKey::PurchasePageKey(std::int64_t ll_date, int i_id) {
+	_ll_date = ll_date;
+	_i_id = i_id;
+}
+
+PurchasePage::PurchasePage() {
+	_bool_has_more = false;
+}
+
+void PurchasePage::add_purchase(Purchase obj_purchase, std::int64_t ll_date) {
+	_obj_next_key = PurchasePageKey(ll_date, obj_purchase.get_id());
+	_vec_purchases.push_back(obj_purchase);
+}
\ No newline at end of file
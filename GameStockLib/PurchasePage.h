@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Purchase.h"
+
+/// <summary>
+/// Class used to store the position of a purchase within a user's purchase history (newest first), so that the next page can be read starting straight after it.
+/// A default constructed key is the start of the history.
+/// </summary>
+class PurchasePageKey
+{
+	std::int64_t _ll_date;
+	int _i_id;
+public:
+	PurchasePageKey();
+	PurchasePageKey(std::int64_t ll_date, int i_id);
+
+	/// <summary>
+	/// Returns the purchase date, in seconds since the epoch
+	/// </summary>
+	/// <returns></returns>
+	std::int64_t get_date() { return _ll_date; }
+	int get_id() { return _i_id; }
+
+	/// <summary>
+	/// Returns true if this key is the start of the history, purchase ids start at 1 so no purchase has an id of 0
+	/// </summary>
+	/// <returns></returns>
+	bool is_start() { return _i_id == 0; }
+};
+
+/// <summary>
+/// Class used to store a single page of a user's purchase history, along with the key needed to fetch the page after it
+/// </summary>
+class PurchasePage
+{
+	std::vector<Purchase> _vec_purchases;
+	PurchasePageKey _obj_next_key;
+	bool _bool_has_more;
+public:
+	PurchasePage();
+
+	std::vector<Purchase>& get_vec_purchases() { return _vec_purchases; }
+
+	/// <summary>
+	/// Returns the key of the last purchase on this page, pass this when fetching the next page
+	/// </summary>
+	/// <returns></returns>
+	PurchasePageKey get_next_key() { return _obj_next_key; }
+
+	/// <summary>
+	/// Returns true if there are more purchases after this page
+	/// </summary>
+	/// <returns></returns>
+	bool get_has_more() { return _bool_has_more; }
+	void set_has_more(bool bool_has_more) { _bool_has_more = bool_has_more; }
+
+	/// <summary>
+	/// Adds a purchase to the end of the page, making it the purchase the next page starts after
+	/// </summary>
+	/// <param name="obj_purchase"></param>
+	/// <param name="ll_date">Purchase date in seconds since the epoch</param>
+	void add_purchase(Purchase obj_purchase, std::int64_t ll_date);
+};
+
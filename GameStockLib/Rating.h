@@ -12,10 +12,10 @@ public:
 	Rating(std::string);
 	Rating(int, std::string);
 
-	int get_id() { return _i_id; }
+	int get_id() const { return _i_id; }
 	void set_id(int i_id) { _i_id = i_id; }
 
-	std::string get_rating() { return _str_rating; }
+	std::string get_rating() const { return _str_rating; }
 	void set_rating(std::string str_rating) { _str_rating = str_rating; }
 };
 
@@ -0,0 +1,25 @@
+#include "ReadSnapshot.h"
+
+ReadSnapshot::ReadSnapshot(sqlite3* db) {
+	_db = db;
+	_bool_owns_transaction = sqlite3_get_autocommit(_db) != 0;
+
+	if (!_bool_owns_transaction) return;
+
+	// BEGIN on its own does not read anything, the snapshot is only taken once the first statement reads from the database
+	if (sqlite3_exec(_db, "BEGIN DEFERRED TRANSACTION; SELECT COUNT(*) FROM sqlite_master;", NULL, NULL, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to begin read snapshot: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+		throw std::runtime_error(str_error_msg);
+	}
+}
+
+ReadSnapshot::~ReadSnapshot() {
+	if (!_bool_owns_transaction) return;
+
+	// Nothing was written, so ending the transaction either way gives up the snapshot
+	if (sqlite3_exec(_db, "COMMIT TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <stdexcept>
+#include "sqlite3.h"
+
+/// <summary>
+/// Class that holds a read transaction open on a connection for as long as it exists, so every statement run on the connection in the meantime reads
+/// the same snapshot of the database (the database is in WAL mode, so checkouts can still be committed while it is held). Several managers sharing a
+/// connection can read within the same snapshot. When the connection is already within a transaction, that transaction is used instead and is left
+/// for its owner to end. Should only be held while reading, as it stops the connection's own writes from being committed on their own.
+/// </summary>
+class ReadSnapshot
+{
+	sqlite3* _db;
+	bool _bool_owns_transaction;
+public:
+	/// <summary>
+	/// Begins the read transaction and takes the snapshot straight away, rather than at the first read. Throws if it could not be started.
+	/// </summary>
+	/// <param name="db"></param>
+	ReadSnapshot(sqlite3* db);
+
+	/// <summary>
+	/// Ends the read transaction, if it was started by this snapshot
+	/// </summary>
+	~ReadSnapshot();
+
+	ReadSnapshot(const ReadSnapshot&) = delete;
+	ReadSnapshot& operator=(const ReadSnapshot&) = delete;
+
+	/// <summary>
+	/// Returns whether this snapshot began the transaction, rather than joining one that was already open
+	/// </summary>
+	/// <returns></returns>
+	bool owns_transaction() { return _bool_owns_transaction; }
+};
@@ -0,0 +1,87 @@
+#include "ReportJob.h"
+
+ReportJob::ReportJob(std::filesystem::path path_file, std::string str_unit_name, int i_total_units) {
+	_path_file = path_file;
+	_str_unit_name = str_unit_name;
+	_i_total_units = i_total_units;
+	_i_units_done = 0;
+	_ll_bytes_written = 0;
+	_bool_cancel_requested = false;
+	_status = ReportJobStatus::Queued;
+}
+
+std::int64_t ReportJob::get_eta_seconds() {
+	std::chrono::steady_clock::time_point time_started;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_status != ReportJobStatus::Running) return _status == ReportJobStatus::Queued ? -1 : 0;
+		time_started = _time_started;
+	}
+
+	int i_units_done = _i_units_done;
+	if (i_units_done < 1 || _i_total_units < 1) return -1;
+
+	// Assume the remaining units take as long each as the ones done so far
+	std::int64_t ll_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - time_started).count();
+	std::int64_t ll_units_remaining = _i_total_units > i_units_done ? _i_total_units - i_units_done : 0;
+
+	return (ll_elapsed * ll_units_remaining / i_units_done + 999) / 1000;
+}
+
+ReportJobStatus ReportJob::get_status() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _status;
+}
+
+std::string ReportJob::get_status_text() {
+	switch (get_status())
+	{
+	case ReportJobStatus::Queued:
+		return "Queued";
+	case ReportJobStatus::Running:
+		return is_cancel_requested() ? "Cancelling" : "Running";
+	case ReportJobStatus::Completed:
+		return "Completed";
+	case ReportJobStatus::Cancelled:
+		return "Cancelled";
+	default:
+		return "Failed";
+	}
+}
+
+std::string ReportJob::get_error() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _str_error;
+}
+
+bool ReportJob::is_finished() {
+	ReportJobStatus status = get_status();
+	return status != ReportJobStatus::Queued && status != ReportJobStatus::Running;
+}
+
+void ReportJob::add_progress(int i_units, std::int64_t ll_bytes) {
+	_i_units_done += i_units;
+	_ll_bytes_written += ll_bytes;
+}
+
+bool ReportJob::wait_for(std::chrono::milliseconds duration_timeout) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return _cv_finished.wait_for(lock, duration_timeout, [this] { return _status != ReportJobStatus::Queued && _status != ReportJobStatus::Running; });
+}
+
+void ReportJob::set_running() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_status = ReportJobStatus::Running;
+	_time_started = std::chrono::steady_clock::now();
+}
+
+void ReportJob::set_finished(ReportJobStatus status, std::string str_error) {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_status = status;
+		_str_error = str_error;
+	}
+
+	_cv_finished.notify_all();
+}
\ No newline at end of file
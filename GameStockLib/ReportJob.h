@@ -0,0 +1,106 @@
+#pragma once
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+/// <summary>
+/// The states a report job moves through, a job only ever finishes as one of Completed, Cancelled or Failed
+/// </summary>
+enum class ReportJobStatus { Queued, Running, Completed, Cancelled, Failed };
+
+/// <summary>
+/// Class used to follow a report that is being written in the background. Progress is counted in units (users, purchases etc) and bytes written,
+/// and can be read from any thread while the report is being written.
+/// </summary>
+class ReportJob
+{
+	std::filesystem::path _path_file;
+	std::string _str_unit_name;
+	int _i_total_units;
+	std::atomic<int> _i_units_done;
+	std::atomic<std::int64_t> _ll_bytes_written;
+	std::atomic<bool> _bool_cancel_requested;
+
+	ReportJobStatus _status;
+	std::string _str_error;
+	std::chrono::steady_clock::time_point _time_started;
+	std::mutex _mutex;
+	std::condition_variable _cv_finished;
+public:
+	/// <summary>
+	/// Creates a queued job
+	/// </summary>
+	/// <param name="path_file">File the report is written to</param>
+	/// <param name="str_unit_name">What progress is counted in, e.g. "users"</param>
+	/// <param name="i_total_units">Number of units expected, may be 0 if unknown</param>
+	ReportJob(std::filesystem::path path_file, std::string str_unit_name, int i_total_units);
+
+	ReportJob(const ReportJob&) = delete;
+	ReportJob& operator=(const ReportJob&) = delete;
+
+	std::filesystem::path get_file_path() { return _path_file; }
+	std::string get_file_name() { return _path_file.filename().string(); }
+	std::string get_unit_name() { return _str_unit_name; }
+	int get_total_units() { return _i_total_units; }
+	int get_units_done() { return _i_units_done; }
+	std::int64_t get_bytes_written() { return _ll_bytes_written; }
+
+	/// <summary>
+	/// Estimates the seconds remaining from the time taken so far for the units done
+	/// </summary>
+	/// <returns>Seconds remaining, or -1 if it cannot be estimated yet</returns>
+	std::int64_t get_eta_seconds();
+
+	ReportJobStatus get_status();
+
+	/// <summary>
+	/// Returns the status as text for display, e.g. "Running"
+	/// </summary>
+	/// <returns></returns>
+	std::string get_status_text();
+
+	/// <summary>
+	/// Returns the reason the job failed, empty unless the status is Failed
+	/// </summary>
+	/// <returns></returns>
+	std::string get_error();
+
+	bool is_finished();
+
+	/// <summary>
+	/// Asks for the job to stop, report writers check this between units. A cancelled job's file is removed.
+	/// </summary>
+	void cancel() { _bool_cancel_requested = true; }
+	bool is_cancel_requested() { return _bool_cancel_requested; }
+
+	/// <summary>
+	/// Called by report writers as each unit is written
+	/// </summary>
+	/// <param name="i_units"></param>
+	/// <param name="ll_bytes">Bytes written for these units</param>
+	void add_progress(int i_units, std::int64_t ll_bytes);
+
+	/// <summary>
+	/// Waits for the job to finish, or for the timeout to pass
+	/// </summary>
+	/// <param name="duration_timeout"></param>
+	/// <returns>True if the job has finished</returns>
+	bool wait_for(std::chrono::milliseconds duration_timeout);
+
+	/// <summary>
+	/// Marks the job as started, used by the scheduler
+	/// </summary>
+	void set_running();
+
+	/// <summary>
+	/// Marks the job as finished and wakes anything waiting on it, used by the scheduler
+	/// </summary>
+	/// <param name="status"></param>
+	/// <param name="str_error"></param>
+	void set_finished(ReportJobStatus status, std::string str_error = "");
+};
+
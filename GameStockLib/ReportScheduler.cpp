@@ -0,0 +1,149 @@
+#include "ReportScheduler.h"
+
+ReportScheduler::ReportScheduler(sqlite3* db) {
+	const char* str_filename = db != NULL ? sqlite3_db_filename(db, "main") : NULL;
+
+	_str_database_path = str_filename != NULL ? str_filename : "";
+	_bool_stopping = false;
+}
+
+ReportScheduler::~ReportScheduler() {
+	stop();
+}
+
+std::shared_ptr<ReportJob> ReportScheduler::queue(std::filesystem::path path_file, std::string str_unit_name, int i_total_units, ReportWriter fn_write_report, bool bool_binary) {
+	if (_str_database_path.empty()) {
+		throw std::invalid_argument("Reports can only be written from a database file.");
+	}
+
+	std::shared_ptr<ReportJob> ptr_job = std::make_shared<ReportJob>(path_file, str_unit_name, i_total_units);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_bool_stopping) {
+			throw std::runtime_error("Reports cannot currently be saved, please try again.");
+		}
+
+		// Worker is started on first use, so managers that never save a report do not have a thread sat waiting
+		if (!_thread_worker.joinable()) {
+			_thread_worker = std::thread(&ReportScheduler::run, this);
+		}
+
+		_deque_requests.push_back({ ptr_job, fn_write_report, bool_binary });
+		_vec_jobs.push_back(ptr_job);
+	}
+
+	_cv_requests.notify_one();
+	return ptr_job;
+}
+
+std::vector<std::shared_ptr<ReportJob>> ReportScheduler::get_jobs() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _vec_jobs;
+}
+
+std::vector<std::shared_ptr<ReportJob>> ReportScheduler::take_finished_jobs() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::vector<std::shared_ptr<ReportJob>> vec_finished_jobs;
+	vec_finished_jobs.swap(_vec_finished_jobs);
+
+	return vec_finished_jobs;
+}
+
+void ReportScheduler::stop() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_bool_stopping = true;
+	}
+
+	_cv_requests.notify_one();
+
+	if (_thread_worker.joinable()) {
+		_thread_worker.join();
+	}
+}
+
+void ReportScheduler::run() {
+	while (true) {
+		ReportRequest obj_request;
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cv_requests.wait(lock, [this] { return _bool_stopping || !_deque_requests.empty(); });
+
+			if (_deque_requests.empty()) return;
+
+			obj_request = std::move(_deque_requests.front());
+			_deque_requests.pop_front();
+		}
+
+		write_report(obj_request);
+	}
+}
+
+void ReportScheduler::write_report(ReportRequest& obj_request) {
+	ReportJob& obj_job = *obj_request.ptr_job;
+	ReportJobStatus status = ReportJobStatus::Completed;
+	std::string str_error;
+	sqlite3* db = NULL;
+
+	// Jobs cancelled while still queued are never started
+	if (obj_job.is_cancel_requested()) {
+		finish_job(obj_request.ptr_job, ReportJobStatus::Cancelled, "");
+		return;
+	}
+
+	obj_job.set_running();
+
+	try {
+		// Reports get their own connection, so they do not share (or hold up) the connection used by the console
+		if (sqlite3_open_v2(_str_database_path.c_str(), &db, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK) {
+			std::string str_error_msg = "Failed to open report connection: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		std::ofstream of_stream(obj_job.get_file_path(), obj_request.bool_binary ? std::ios::out | std::ios::binary : std::ios::out);
+
+		if (!of_stream.is_open()) {
+			throw std::runtime_error("Could not create " + obj_job.get_file_name() + ".");
+		}
+
+		// The whole report reads a single snapshot, so checkouts made while it is being written do not leave it with totals that do not add up
+		{
+			ReadSnapshot obj_snapshot(db);
+			obj_request.fn_write_report(obj_job, db, of_stream);
+		}
+
+		of_stream.close();
+
+		if (obj_job.is_cancel_requested()) status = ReportJobStatus::Cancelled;
+	}
+	catch (std::exception& ex) {
+		status = ReportJobStatus::Failed;
+		str_error = ex.what();
+	}
+	catch (...) {
+		// Anything else a report throws would otherwise end the worker thread and the whole program with it
+		status = ReportJobStatus::Failed;
+		str_error = "Unknown error while writing the report.";
+	}
+
+	sqlite3_close(db);
+
+	// Do not leave part written reports in the saves directory
+	if (status != ReportJobStatus::Completed) {
+		std::error_code error_code;
+		std::filesystem::remove(obj_job.get_file_path(), error_code);
+	}
+
+	finish_job(obj_request.ptr_job, status, str_error);
+}
+
+void ReportScheduler::finish_job(std::shared_ptr<ReportJob>& ptr_job, ReportJobStatus status, std::string str_error) {
+	// Done under the lock so a job is never seen as finished without also being in the finished jobs
+	std::lock_guard<std::mutex> lock(_mutex);
+	ptr_job->set_finished(status, str_error);
+	_vec_finished_jobs.push_back(ptr_job);
+}
\ No newline at end of file
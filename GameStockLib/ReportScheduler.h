@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "sqlite3.h"
+#include "ReportJob.h"
+#include "ReadSnapshot.h"
+
+/// <summary>
+/// Function that writes a report to the provided stream, using the provided read-only connection. The connection is within a read snapshot
+/// for the whole call, so everything the writer reads is from the same point in time. Writers should report progress through the job and stop early
+/// when cancellation has been requested.
+/// </summary>
+typedef std::function<void(ReportJob&, sqlite3*, std::ostream&)> ReportWriter;
+
+/// <summary>
+/// Class that writes queued reports one at a time on a background thread, so that the console can still be used while they are written.
+/// Each report is given its own read-only connection, and its file is removed if it is cancelled or fails.
+/// </summary>
+class ReportScheduler
+{
+	/// <summary>
+	/// A queued job and the function that writes its report
+	/// </summary>
+	struct ReportRequest {
+		std::shared_ptr<ReportJob> ptr_job;
+		ReportWriter fn_write_report;
+		bool bool_binary;
+	};
+
+	// Copied from the connection when constructed, so the worker never touches that connection (which may have been closed by the time a report is written)
+	std::string _str_database_path;
+	bool _bool_stopping;
+
+	std::deque<ReportRequest> _deque_requests;
+	std::vector<std::shared_ptr<ReportJob>> _vec_jobs;
+	std::vector<std::shared_ptr<ReportJob>> _vec_finished_jobs;
+	std::mutex _mutex;
+	std::condition_variable _cv_requests;
+	std::thread _thread_worker;
+
+	/// <summary>
+	/// Worker loop, writes each queued report in turn until stopped and the queue is empty
+	/// </summary>
+	void run();
+
+	/// <summary>
+	/// Writes a single report to its file and records how it finished
+	/// </summary>
+	/// <param name="obj_request"></param>
+	void write_report(ReportRequest& obj_request);
+
+	/// <summary>
+	/// Records how a job finished and adds it to the finished jobs waiting to be announced
+	/// </summary>
+	/// <param name="ptr_job"></param>
+	/// <param name="status"></param>
+	/// <param name="str_error"></param>
+	void finish_job(std::shared_ptr<ReportJob>& ptr_job, ReportJobStatus status, std::string str_error);
+public:
+	/// <summary>
+	/// Reports read from the same database file as the provided connection, which is only used here to find the file. The worker is only started
+	/// once the first report is queued
+	/// </summary>
+	/// <param name="db"></param>
+	ReportScheduler(sqlite3* db);
+
+	/// <summary>
+	/// Stops the scheduler, any reports already queued are still written
+	/// </summary>
+	~ReportScheduler();
+
+	ReportScheduler(const ReportScheduler&) = delete;
+	ReportScheduler& operator=(const ReportScheduler&) = delete;
+
+	/// <summary>
+	/// Queues a report to be written, throws if the scheduler has been stopped or the database is not a file
+	/// </summary>
+	/// <param name="path_file">File to write the report to, overwritten if it already exists</param>
+	/// <param name="str_unit_name">What progress is counted in, e.g. "users"</param>
+	/// <param name="i_total_units">Number of units expected</param>
+	/// <param name="fn_write_report"></param>
+	/// <param name="bool_binary">Open the file in binary mode, so line endings are not translated</param>
+	/// <returns>The job, used to follow progress or cancel the report</returns>
+	std::shared_ptr<ReportJob> queue(std::filesystem::path path_file, std::string str_unit_name, int i_total_units, ReportWriter fn_write_report, bool bool_binary = false);
+
+	/// <summary>
+	/// Returns every job queued so far, oldest first
+	/// </summary>
+	/// <returns></returns>
+	std::vector<std::shared_ptr<ReportJob>> get_jobs();
+
+	/// <summary>
+	/// Returns the jobs that have finished since this was last called, so each finished report is only announced once
+	/// </summary>
+	/// <returns></returns>
+	std::vector<std::shared_ptr<ReportJob>> take_finished_jobs();
+
+	/// <summary>
+	/// Writes anything still queued and then stops the worker, safe to call more than once
+	/// </summary>
+	void stop();
+};
+
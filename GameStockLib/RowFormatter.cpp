@@ -0,0 +1,141 @@
+#include "RowFormatter.h"
+
+RowFormatter::RowFormatter(std::ostream& os, size_t i_buffer_size) : _os(os) {
+	_vec_buffer.resize(i_buffer_size > 0 ? i_buffer_size : 1);
+	_i_length = 0;
+	_ll_bytes_written = 0;
+
+	// Numbers are punctuated the same way the stream would have
+	const std::numpunct<char>& obj_numpunct = std::use_facet<std::numpunct<char>>(os.getloc());
+	_ch_decimal_point = obj_numpunct.decimal_point();
+	_ch_thousands_sep = obj_numpunct.thousands_sep();
+	_str_grouping = obj_numpunct.grouping();
+}
+
+RowFormatter::~RowFormatter() {
+	flush();
+}
+
+void RowFormatter::append(const char* ptr_chars, size_t i_count) {
+	_ll_bytes_written += i_count;
+
+	if (_i_length + i_count > _vec_buffer.size()) {
+		flush();
+
+		// Too big to ever fit in the buffer, so write it straight out
+		if (i_count > _vec_buffer.size()) {
+			_os.write(ptr_chars, i_count);
+			return;
+		}
+	}
+
+	std::char_traits<char>::copy(_vec_buffer.data() + _i_length, ptr_chars, i_count);
+	_i_length += i_count;
+}
+
+void RowFormatter::pad(size_t i_written, int i_width) {
+	static const char str_spaces[] = "                                                                ";
+
+	while ((int)i_written < i_width) {
+		size_t i_count = (size_t)i_width - i_written;
+		if (i_count > sizeof(str_spaces) - 1) i_count = sizeof(str_spaces) - 1;
+
+		append(str_spaces, i_count);
+		i_written += i_count;
+	}
+}
+
+size_t RowFormatter::append_grouped(std::uint64_t ull_value) {
+	char str_digits[24];
+	char str_grouped[48];
+	std::to_chars_result result = std::to_chars(str_digits, str_digits + sizeof(str_digits), ull_value);
+	size_t i_digits = result.ptr - str_digits;
+
+	if (_str_grouping.empty() || _str_grouping[0] <= 0) {
+		append(str_digits, i_digits);
+		return i_digits;
+	}
+
+	// Work back from the last digit, adding a separator at the end of each group. The last group size in the grouping repeats,
+	// and a size of 0 or less (or CHAR_MAX) means the rest of the digits are not grouped
+	size_t i_out = sizeof(str_grouped);
+	size_t i_group_index = 0;
+	int i_group_size = _str_grouping[0];
+	int i_in_group = 0;
+
+	for (size_t i = i_digits; i > 0; i--) {
+		if (i_group_size > 0 && i_group_size != CHAR_MAX && i_in_group == i_group_size) {
+			str_grouped[--i_out] = _ch_thousands_sep;
+			i_in_group = 0;
+
+			if (i_group_index + 1 < _str_grouping.size()) {
+				i_group_index++;
+				i_group_size = _str_grouping[i_group_index];
+			}
+		}
+
+		str_grouped[--i_out] = str_digits[i - 1];
+		i_in_group++;
+	}
+
+	append(str_grouped + i_out, sizeof(str_grouped) - i_out);
+	return sizeof(str_grouped) - i_out;
+}
+
+RowFormatter& RowFormatter::text(std::string_view str_text, int i_width) {
+	append(str_text.data(), str_text.size());
+	pad(str_text.size(), i_width);
+
+	return *this;
+}
+
+RowFormatter& RowFormatter::integer(std::int64_t ll_value, int i_width) {
+	size_t i_written = 0;
+
+	if (ll_value < 0) {
+		append("-", 1);
+		i_written++;
+	}
+
+	// Negate as unsigned, so the lowest value does not overflow
+	std::uint64_t ull_value = ll_value < 0 ? 0 - (std::uint64_t)ll_value : (std::uint64_t)ll_value;
+	i_written += append_grouped(ull_value);
+	pad(i_written, i_width);
+
+	return *this;
+}
+
+RowFormatter& RowFormatter::money(Money obj_money, int i_width) {
+	std::int64_t ll_cents = obj_money.get_cents();
+	std::uint64_t ull_cents = ll_cents < 0 ? 0 - (std::uint64_t)ll_cents : (std::uint64_t)ll_cents;
+	size_t i_written = 0;
+
+	if (ll_cents < 0) {
+		append("-", 1);
+		i_written++;
+	}
+
+	// Cents are split into whole units and the 2 decimal places, rather than going through a double
+	i_written += append_grouped(ull_cents / 100);
+
+	char str_fraction[3] = { _ch_decimal_point, (char)('0' + ull_cents % 100 / 10), (char)('0' + ull_cents % 10) };
+	append(str_fraction, sizeof(str_fraction));
+	i_written += sizeof(str_fraction);
+
+	pad(i_written, i_width);
+
+	return *this;
+}
+
+RowFormatter& RowFormatter::end_row() {
+	append("\n", 1);
+
+	return *this;
+}
+
+void RowFormatter::flush() {
+	if (_i_length > 0) {
+		_os.write(_vec_buffer.data(), _i_length);
+		_i_length = 0;
+	}
+}
\ No newline at end of file
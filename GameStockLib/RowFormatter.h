@@ -0,0 +1,105 @@
+#pragma once
+#include <ostream>
+#include <locale>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstdint>
+#include <climits>
+#include "Money.h"
+
+/// <summary>
+/// Class used to write fixed-width report rows without going through the stream's formatting for every value. Values are formatted with std::to_chars
+/// into a preallocated buffer that is written to the stream in large blocks. Output matches writing the same values with std::setw/std::left,
+/// and money with std::fixed to 2 decimal places, including the decimal point and thousands grouping of the stream's locale.
+/// </summary>
+class RowFormatter
+{
+	std::ostream& _os;
+	std::vector<char> _vec_buffer;
+	size_t _i_length;
+	std::int64_t _ll_bytes_written;
+
+	char _ch_decimal_point;
+	char _ch_thousands_sep;
+	std::string _str_grouping;
+
+	/// <summary>
+	/// Copies characters into the buffer, writing the buffer out first if they will not fit
+	/// </summary>
+	/// <param name="ptr_chars"></param>
+	/// <param name="i_count"></param>
+	void append(const char* ptr_chars, size_t i_count);
+
+	/// <summary>
+	/// Pads with spaces up to the width, for values that were shorter than it
+	/// </summary>
+	/// <param name="i_written">Characters already written for the value</param>
+	/// <param name="i_width"></param>
+	void pad(size_t i_written, int i_width);
+
+	/// <summary>
+	/// Writes a whole number (without sign) using the locale's thousands grouping
+	/// </summary>
+	/// <param name="ull_value"></param>
+	/// <returns>Number of characters written</returns>
+	size_t append_grouped(std::uint64_t ull_value);
+public:
+	/// <summary>
+	/// Rows are written to the provided stream, using its locale's number punctuation
+	/// </summary>
+	/// <param name="os"></param>
+	/// <param name="i_buffer_size">Bytes collected before writing to the stream</param>
+	RowFormatter(std::ostream& os, size_t i_buffer_size = 64 * 1024);
+
+	/// <summary>
+	/// Writes anything still buffered to the stream
+	/// </summary>
+	~RowFormatter();
+
+	RowFormatter(const RowFormatter&) = delete;
+	RowFormatter& operator=(const RowFormatter&) = delete;
+
+	/// <summary>
+	/// Writes text, left aligned and padded to the width (0 for no padding). Longer text is not cut short.
+	/// </summary>
+	/// <param name="str_text"></param>
+	/// <param name="i_width"></param>
+	/// <returns></returns>
+	RowFormatter& text(std::string_view str_text, int i_width = 0);
+
+	/// <summary>
+	/// Writes a whole number, left aligned and padded to the width
+	/// </summary>
+	/// <param name="ll_value"></param>
+	/// <param name="i_width"></param>
+	/// <returns></returns>
+	RowFormatter& integer(std::int64_t ll_value, int i_width = 0);
+
+	/// <summary>
+	/// Writes money to 2 decimal places, left aligned and padded to the width
+	/// </summary>
+	/// <param name="obj_money"></param>
+	/// <param name="i_width"></param>
+	/// <returns></returns>
+	RowFormatter& money(Money obj_money, int i_width = 0);
+
+	/// <summary>
+	/// Ends the current row
+	/// </summary>
+	/// <returns></returns>
+	RowFormatter& end_row();
+
+	/// <summary>
+	/// Writes anything buffered to the stream, must be called before writing to the stream directly
+	/// </summary>
+	void flush();
+
+	/// <summary>
+	/// Returns the number of bytes formatted so far, including those still buffered
+	/// </summary>
+	/// <returns></returns>
+	std::int64_t get_bytes_written() { return _ll_bytes_written; }
+};
+
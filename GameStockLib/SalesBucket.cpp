@@ -0,0 +1,132 @@
+#include "SalesBucket.h"
+
+namespace {
+	const std::int64_t SECONDS_PER_DAY = 86400;
+
+	/// <summary>
+	/// Divides rounding towards negative infinity, so times before the epoch still fall in the right day
+	/// </summary>
+	std::int64_t floor_divide(std::int64_t ll_value, std::int64_t ll_divisor) {
+		std::int64_t ll_result = ll_value / ll_divisor;
+		if ((ll_value % ll_divisor != 0) && ((ll_value < 0) != (ll_divisor < 0))) ll_result--;
+		return ll_result;
+	}
+
+	/// <summary>
+	/// Converts days since the epoch to a year, month (1-12) and day (1-31) in the proleptic Gregorian calendar
+	/// </summary>
+	void civil_from_days(std::int64_t ll_days, std::int64_t& ll_year, int& i_month, int& i_day) {
+		ll_days += 719468;
+		std::int64_t ll_era = floor_divide(ll_days, 146097);
+		std::int64_t ll_day_of_era = ll_days - ll_era * 146097;
+		std::int64_t ll_year_of_era = (ll_day_of_era - ll_day_of_era / 1460 + ll_day_of_era / 36524 - ll_day_of_era / 146096) / 365;
+		std::int64_t ll_day_of_year = ll_day_of_era - (365 * ll_year_of_era + ll_year_of_era / 4 - ll_year_of_era / 100);
+		std::int64_t ll_month_index = (5 * ll_day_of_year + 2) / 153;
+
+		i_day = (int)(ll_day_of_year - (153 * ll_month_index + 2) / 5 + 1);
+		i_month = (int)(ll_month_index < 10 ? ll_month_index + 3 : ll_month_index - 9);
+		ll_year = ll_year_of_era + ll_era * 400 + (i_month <= 2 ? 1 : 0);
+	}
+
+	/// <summary>
+	/// Converts a year, month (1-12) and day (1-31) to days since the epoch, the reverse of civil_from_days
+	/// </summary>
+	std::int64_t days_from_civil(std::int64_t ll_year, int i_month, int i_day) {
+		ll_year -= i_month <= 2 ? 1 : 0;
+		std::int64_t ll_era = floor_divide(ll_year, 400);
+		std::int64_t ll_year_of_era = ll_year - ll_era * 400;
+		std::int64_t ll_day_of_year = (153 * (i_month > 2 ? i_month - 3 : i_month + 9) + 2) / 5 + i_day - 1;
+		std::int64_t ll_day_of_era = ll_year_of_era * 365 + ll_year_of_era / 4 - ll_year_of_era / 100 + ll_day_of_year;
+
+		return ll_era * 146097 + ll_day_of_era - 719468;
+	}
+}
+
+SalesBucket::SalesBucket() {
+	_ll_start = 0;
+	_i_units = 0;
+	_i_orders = 0;
+}
+
+SalesBucket::SalesBucket(std::int64_t ll_start) {
+	_ll_start = ll_start;
+	_i_units = 0;
+	_i_orders = 0;
+}
+
+SalesBucket::SalesBucket(std::int64_t ll_start, Money obj_revenue, int i_units, int i_orders) {
+	_ll_start = ll_start;
+	_obj_revenue = obj_revenue;
+	_i_units = i_units;
+	_i_orders = i_orders;
+}
+
+void SalesBucket::add(SalesBucket& obj_bucket) {
+	_obj_revenue += obj_bucket.get_revenue();
+	_i_units += obj_bucket.get_units();
+	_i_orders += obj_bucket.get_orders();
+}
+
+std::int64_t SalesBucket::get_period_start(SalesPeriod period, std::int64_t ll_time) {
+	std::int64_t ll_days = floor_divide(ll_time, SECONDS_PER_DAY);
+	std::int64_t ll_year;
+	int i_month;
+	int i_day;
+
+	switch (period)
+	{
+	case SalesPeriod::Day:
+		return ll_days * SECONDS_PER_DAY;
+	case SalesPeriod::Week: {
+		// The epoch was a Thursday, so shifting by 3 days gives the number of days since Monday
+		std::int64_t ll_days_since_monday = (ll_days + 3) - floor_divide(ll_days + 3, 7) * 7;
+		return (ll_days - ll_days_since_monday) * SECONDS_PER_DAY;
+	}
+	case SalesPeriod::Month:
+		civil_from_days(ll_days, ll_year, i_month, i_day);
+		return days_from_civil(ll_year, i_month, 1) * SECONDS_PER_DAY;
+	default:
+		throw std::invalid_argument("Unknown sales period.");
+	}
+}
+
+std::int64_t SalesBucket::add_periods(SalesPeriod period, std::int64_t ll_start, int i_count) {
+	std::int64_t ll_year;
+	int i_month;
+	int i_day;
+
+	switch (period)
+	{
+	case SalesPeriod::Day:
+		return ll_start + i_count * SECONDS_PER_DAY;
+	case SalesPeriod::Week:
+		return ll_start + i_count * 7 * SECONDS_PER_DAY;
+	case SalesPeriod::Month: {
+		civil_from_days(floor_divide(ll_start, SECONDS_PER_DAY), ll_year, i_month, i_day);
+		std::int64_t ll_month_index = ll_year * 12 + (i_month - 1) + i_count;
+		std::int64_t ll_new_year = floor_divide(ll_month_index, 12);
+
+		return days_from_civil(ll_new_year, (int)(ll_month_index - ll_new_year * 12) + 1, 1) * SECONDS_PER_DAY;
+	}
+	default:
+		throw std::invalid_argument("Unknown sales period.");
+	}
+}
+
+std::string SalesBucket::get_label(SalesPeriod period) {
+	std::int64_t ll_year;
+	int i_month;
+	int i_day;
+	char str_label[32];
+
+	civil_from_days(floor_divide(_ll_start, SECONDS_PER_DAY), ll_year, i_month, i_day);
+
+	if (period == SalesPeriod::Month) {
+		snprintf(str_label, sizeof(str_label), "%04lld-%02d", (long long)ll_year, i_month);
+	}
+	else {
+		snprintf(str_label, sizeof(str_label), "%04lld-%02d-%02d", (long long)ll_year, i_month, i_day);
+	}
+
+	return str_label;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <cstdio>
+#include "Money.h"
+
+/// <summary>
+/// Lengths of time sales can be grouped by. Weeks start on a Monday, and all periods are in UTC to match how purchase dates are stored.
+/// </summary>
+enum class SalesPeriod {
+	Day,
+	Week,
+	Month
+};
+
+/// <summary>
+/// Class used to store the revenue, game copies sold (units) and number of purchases (orders) within a single day, week or month
+/// </summary>
+class SalesBucket
+{
+	std::int64_t _ll_start;
+	Money _obj_revenue;
+	int _i_units;
+	int _i_orders;
+public:
+	SalesBucket();
+	SalesBucket(std::int64_t ll_start);
+	SalesBucket(std::int64_t ll_start, Money obj_revenue, int i_units, int i_orders);
+
+	/// <summary>
+	/// Returns the start of the bucket in seconds since the epoch
+	/// </summary>
+	/// <returns></returns>
+	std::int64_t get_start() { return _ll_start; }
+	Money get_revenue() { return _obj_revenue; }
+	int get_units() { return _i_units; }
+	int get_orders() { return _i_orders; }
+
+	/// <summary>
+	/// Adds another bucket's revenue, units and orders to this one
+	/// </summary>
+	/// <param name="obj_bucket"></param>
+	void add(SalesBucket& obj_bucket);
+
+	/// <summary>
+	/// Returns the start of the day, week or month that a time (in seconds since the epoch) falls within
+	/// </summary>
+	/// <param name="period"></param>
+	/// <param name="ll_time"></param>
+	/// <returns></returns>
+	static std::int64_t get_period_start(SalesPeriod period, std::int64_t ll_time);
+
+	/// <summary>
+	/// Moves the start of a period forward (or back, with a negative count) by a number of periods
+	/// </summary>
+	/// <param name="period"></param>
+	/// <param name="ll_start"></param>
+	/// <param name="i_count"></param>
+	/// <returns></returns>
+	static std::int64_t add_periods(SalesPeriod period, std::int64_t ll_start, int i_count);
+
+	/// <summary>
+	/// Returns the start of the bucket as a date for display, e.g. 2021-03-04 for days and weeks or 2021-03 for months
+	/// </summary>
+	/// <param name="period"></param>
+	/// <returns></returns>
+	std::string get_label(SalesPeriod period);
+};
@@ -0,0 +1,261 @@
+#include "SalesColumnStore.h"
+#include <algorithm>
+#include <mutex>
+
+SalesColumnStore::SalesColumnStore() {
+	_ll_last_item_id = 0;
+	_i_max_user_id = 0;
+}
+
+std::uint16_t SalesColumnStore::encode(const std::string& str_name, std::vector<std::string>& vec_names, std::unordered_map<std::string, std::uint16_t>& map_codes) {
+	auto position = map_codes.find(str_name);
+	if (position != map_codes.end()) return position->second;
+
+	if (vec_names.size() > UINT16_MAX) {
+		throw std::length_error("Too many distinct genres or ratings to store as sales codes.");
+	}
+
+	std::uint16_t i_code = (std::uint16_t)vec_names.size();
+	vec_names.push_back(str_name);
+	map_codes[str_name] = i_code;
+	return i_code;
+}
+
+void SalesColumnStore::append_locked(std::int64_t ll_date, int i_user_id, const std::string& str_genre, const std::string& str_rating, Money obj_price, int i_count) {
+	if (i_user_id < 0) {
+		throw std::invalid_argument("Sales lines cannot have a negative user id.");
+	}
+
+	_vec_dates.push_back(ll_date);
+	_vec_user_ids.push_back(i_user_id);
+	_vec_genre_codes.push_back(encode(str_genre, _vec_genres, _map_genre_codes));
+	_vec_rating_codes.push_back(encode(str_rating, _vec_ratings, _map_rating_codes));
+	_vec_price_bands.push_back((std::uint8_t)get_price_band(obj_price));
+	_vec_counts.push_back(i_count);
+	_vec_cents.push_back(obj_price.get_cents() * i_count);
+	_i_max_user_id = std::max(_i_max_user_id, (std::int32_t)i_user_id);
+}
+
+size_t SalesColumnStore::load_new(sqlite3* db) {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	sqlite3_stmt* stmt_lines;
+	size_t i_loaded = 0;
+	int i_return_code;
+
+	// Walks purchase items by primary key from the last one loaded, so catching up after a checkout only reads the new items.
+	// Archived items are only read by the first load, as purchases are archived long after they were made
+	std::string str_lines_sql =
+		"SELECT i.id, p.date, p.user_id, s.genre, s.rating, i.game_price, i.count FROM purchase_items AS i INNER JOIN purchases AS p ON p.id = i.purchase_id INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE i.id > ?1 " \
+		"UNION ALL SELECT i.id, p.date, p.user_id, s.genre, s.rating, i.game_price, i.count FROM purchases_archive AS p INNER JOIN purchase_items_archive AS i ON i.purchase_id = p.id INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id WHERE ?1 = 0 " \
+		"ORDER BY 1";
+
+	if (sqlite3_prepare_v2(db, str_lines_sql.c_str(), -1, &stmt_lines, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare fetch statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_bind_int64(stmt_lines, 1, _ll_last_item_id);
+
+	while ((i_return_code = sqlite3_step(stmt_lines)) == SQLITE_ROW) {
+		append_locked(
+			sqlite3_column_int64(stmt_lines, 1),
+			sqlite3_column_int(stmt_lines, 2),
+			(char*)sqlite3_column_text(stmt_lines, 3),
+			(char*)sqlite3_column_text(stmt_lines, 4),
+			Money(sqlite3_column_int64(stmt_lines, 5)),
+			sqlite3_column_int(stmt_lines, 6));
+
+		_ll_last_item_id = sqlite3_column_int64(stmt_lines, 0);
+		i_loaded++;
+	}
+
+	if (i_return_code != SQLITE_DONE) {
+		std::string str_error_msg = "Failed to read purchase items: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(db);
+		sqlite3_finalize(stmt_lines);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	sqlite3_finalize(stmt_lines);
+	return i_loaded;
+}
+
+void SalesColumnStore::append(std::int64_t ll_date, int i_user_id, const std::string& str_genre, const std::string& str_rating, Money obj_price, int i_count) {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	append_locked(ll_date, i_user_id, str_genre, str_rating, obj_price, i_count);
+}
+
+void SalesColumnStore::clear() {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+
+	_vec_dates.clear();
+	_vec_user_ids.clear();
+	_vec_genre_codes.clear();
+	_vec_rating_codes.clear();
+	_vec_price_bands.clear();
+	_vec_counts.clear();
+	_vec_cents.clear();
+	_vec_genres.clear();
+	_map_genre_codes.clear();
+	_vec_ratings.clear();
+	_map_rating_codes.clear();
+	_ll_last_item_id = 0;
+	_i_max_user_id = 0;
+}
+
+size_t SalesColumnStore::get_row_count() const {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	return _vec_dates.size();
+}
+
+template <typename T>
+std::vector<SalesGroup> SalesColumnStore::sum_by_code(const T* ptr_codes, size_t i_group_count, std::int64_t ll_from, std::int64_t ll_to) const {
+	const std::int64_t* ptr_dates = _vec_dates.data();
+	const std::int64_t* ptr_cents = _vec_cents.data();
+	const std::int32_t* ptr_counts = _vec_counts.data();
+	size_t i_rows = _vec_dates.size();
+
+	// Four sets of sums, with consecutive rows going to different sets, so rows in the same group do not each wait on the previous row's add.
+	// Rows outside the range are multiplied by zero rather than skipped, keeping the loop free of branches
+	const size_t i_lanes = 4;
+	std::vector<std::int64_t> vec_revenue(i_group_count * i_lanes, 0);
+	std::vector<std::int64_t> vec_units(i_group_count * i_lanes, 0);
+	std::vector<std::int64_t> vec_lines(i_group_count * i_lanes, 0);
+
+	size_t i = 0;
+	for (; i + i_lanes <= i_rows; i += i_lanes) {
+		for (size_t lane = 0; lane < i_lanes; lane++) {
+			std::int64_t ll_in_range = (std::int64_t)((ptr_dates[i + lane] >= ll_from) & (ptr_dates[i + lane] < ll_to));
+			size_t i_slot = (size_t)ptr_codes[i + lane] * i_lanes + lane;
+
+			vec_revenue[i_slot] += ptr_cents[i + lane] * ll_in_range;
+			vec_units[i_slot] += ptr_counts[i + lane] * ll_in_range;
+			vec_lines[i_slot] += ll_in_range;
+		}
+	}
+
+	for (; i < i_rows; i++) {
+		std::int64_t ll_in_range = (std::int64_t)((ptr_dates[i] >= ll_from) & (ptr_dates[i] < ll_to));
+		size_t i_slot = (size_t)ptr_codes[i] * i_lanes;
+
+		vec_revenue[i_slot] += ptr_cents[i] * ll_in_range;
+		vec_units[i_slot] += ptr_counts[i] * ll_in_range;
+		vec_lines[i_slot] += ll_in_range;
+	}
+
+	std::vector<SalesGroup> vec_groups(i_group_count);
+	for (size_t code = 0; code < i_group_count; code++) {
+		std::int64_t ll_revenue = 0;
+
+		for (size_t lane = 0; lane < i_lanes; lane++) {
+			ll_revenue += vec_revenue[code * i_lanes + lane];
+			vec_groups[code].ll_units += vec_units[code * i_lanes + lane];
+			vec_groups[code].ll_lines += vec_lines[code * i_lanes + lane];
+		}
+
+		vec_groups[code].obj_revenue = Money(ll_revenue);
+	}
+
+	return vec_groups;
+}
+
+std::vector<SalesGroup> SalesColumnStore::sum_by_user_id(std::int64_t ll_from, std::int64_t ll_to) const {
+	std::unordered_map<std::int32_t, SalesGroup> map_groups;
+	std::vector<SalesGroup> vec_groups;
+
+	for (size_t i = 0; i < _vec_dates.size(); i++) {
+		if (_vec_dates[i] < ll_from || _vec_dates[i] >= ll_to) continue;
+
+		SalesGroup& group = map_groups[_vec_user_ids[i]];
+		group.obj_revenue = Money(group.obj_revenue.get_cents() + _vec_cents[i]);
+		group.ll_units += _vec_counts[i];
+		group.ll_lines++;
+	}
+
+	// Returned in id order as the dense groups are, so groups with the same revenue are not left in hash order
+	std::vector<std::int32_t> vec_user_ids;
+	vec_user_ids.reserve(map_groups.size());
+	for (auto& pair : map_groups) vec_user_ids.push_back(pair.first);
+	std::sort(vec_user_ids.begin(), vec_user_ids.end());
+
+	vec_groups.reserve(vec_user_ids.size());
+	for (std::int32_t i_user_id : vec_user_ids) {
+		vec_groups.push_back(map_groups[i_user_id]);
+		vec_groups.back().str_label = std::to_string(i_user_id);
+	}
+
+	return vec_groups;
+}
+
+std::vector<SalesGroup> SalesColumnStore::group_by(SalesDimension dimension, std::int64_t ll_from, std::int64_t ll_to) const {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	std::vector<SalesGroup> vec_groups;
+
+	switch (dimension)
+	{
+	case SalesDimension::Genre:
+		vec_groups = sum_by_code(_vec_genre_codes.data(), _vec_genres.size(), ll_from, ll_to);
+		for (size_t code = 0; code < vec_groups.size(); code++) vec_groups[code].str_label = _vec_genres[code];
+		break;
+	case SalesDimension::Rating:
+		vec_groups = sum_by_code(_vec_rating_codes.data(), _vec_ratings.size(), ll_from, ll_to);
+		for (size_t code = 0; code < vec_groups.size(); code++) vec_groups[code].str_label = _vec_ratings[code];
+		break;
+	case SalesDimension::PriceBand:
+		vec_groups = sum_by_code(_vec_price_bands.data(), PRICE_BAND_COUNT, ll_from, ll_to);
+		for (size_t code = 0; code < vec_groups.size(); code++) vec_groups[code].str_label = get_price_band_label((int)code);
+		break;
+	case SalesDimension::User:
+	{
+		// User ids are used as the codes directly, giving a group for every id up to the highest, unless the ids are spread too thinly
+		// over the lines for that to be worth allocating
+		if (_i_max_user_id <= DENSE_USER_ID_LIMIT || (size_t)_i_max_user_id <= _vec_user_ids.size()) {
+			vec_groups = sum_by_code(_vec_user_ids.data(), (size_t)_i_max_user_id + 1, ll_from, ll_to);
+			for (size_t code = 0; code < vec_groups.size(); code++) vec_groups[code].str_label = std::to_string(code);
+		}
+		else {
+			vec_groups = sum_by_user_id(ll_from, ll_to);
+		}
+		break;
+	}
+	default:
+		throw std::invalid_argument("Unknown sales dimension.");
+	}
+
+	vec_groups.erase(std::remove_if(vec_groups.begin(), vec_groups.end(), [](SalesGroup& group) { return group.ll_lines == 0; }), vec_groups.end());
+	std::stable_sort(vec_groups.begin(), vec_groups.end(), [](const SalesGroup& a, const SalesGroup& b) { return b.obj_revenue < a.obj_revenue; });
+
+	return vec_groups;
+}
+
+Money SalesColumnStore::get_revenue(std::int64_t ll_from, std::int64_t ll_to) const {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	const std::int64_t* ptr_dates = _vec_dates.data();
+	const std::int64_t* ptr_cents = _vec_cents.data();
+	size_t i_rows = _vec_dates.size();
+	std::int64_t ll_revenue = 0;
+
+	// No branches or scatter, so the compiler can vectorise this loop
+	for (size_t i = 0; i < i_rows; i++) {
+		ll_revenue += ptr_cents[i] * (std::int64_t)((ptr_dates[i] >= ll_from) & (ptr_dates[i] < ll_to));
+	}
+
+	return Money(ll_revenue);
+}
+
+int SalesColumnStore::get_price_band(Money obj_price) {
+	std::int64_t ll_band = obj_price.get_cents() / 1000;
+
+	if (ll_band < 0) return 0;
+	if (ll_band >= PRICE_BAND_COUNT) return PRICE_BAND_COUNT - 1;
+	return (int)ll_band;
+}
+
+std::string SalesColumnStore::get_price_band_label(int i_price_band) {
+	if (i_price_band >= PRICE_BAND_COUNT - 1) {
+		return std::to_string((PRICE_BAND_COUNT - 1) * 10) + ".00 and over";
+	}
+
+	return std::to_string(i_price_band * 10) + ".00 - " + std::to_string(i_price_band * 10 + 9) + ".99";
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <shared_mutex>
+#include <stdexcept>
+#include <cstdint>
+#include "sqlite3.h"
+#include "Money.h"
+
+/// <summary>
+/// What sales lines can be grouped by when breaking sales down. Price bands are the game's price when purchased, in steps of 10.00.
+/// </summary>
+enum class SalesDimension {
+	Genre,
+	Rating,
+	PriceBand,
+	User
+};
+
+/// <summary>
+/// The revenue, game copies sold (units) and number of purchase items (lines) within one group of a sales breakdown
+/// </summary>
+struct SalesGroup {
+	std::string str_label;
+	Money obj_revenue;
+	std::int64_t ll_units = 0;
+	std::int64_t ll_lines = 0;
+};
+
+/// <summary>
+/// Class that keeps every purchase item ever sold in memory as columns (one array each of dates, user ids, genres, ratings, price bands, counts and totals),
+/// so sales can be grouped and totalled by looping over a few arrays rather than loading purchases. Genres and ratings are stored as small codes into a
+/// dictionary of their names. Lines are only ever appended; purchases deleted after being loaded stay counted until the store is cleared and loaded again.
+/// Safe to read from several threads while another appends.
+/// </summary>
+class SalesColumnStore
+{
+	std::vector<std::int64_t> _vec_dates;
+	std::vector<std::int32_t> _vec_user_ids;
+	std::vector<std::uint16_t> _vec_genre_codes;
+	std::vector<std::uint16_t> _vec_rating_codes;
+	std::vector<std::uint8_t> _vec_price_bands;
+	std::vector<std::int32_t> _vec_counts;
+	std::vector<std::int64_t> _vec_cents;
+
+	std::vector<std::string> _vec_genres;
+	std::unordered_map<std::string, std::uint16_t> _map_genre_codes;
+	std::vector<std::string> _vec_ratings;
+	std::unordered_map<std::string, std::uint16_t> _map_rating_codes;
+
+	// Highest purchase item id loaded from the database, load_new only reads items after it
+	std::int64_t _ll_last_item_id;
+
+	// Highest user id appended, so grouping by user knows how many groups there would be without scanning the column
+	std::int32_t _i_max_user_id;
+
+	mutable std::shared_mutex _mutex;
+
+	/// <summary>
+	/// Returns the code for a name, adding it to the dictionary if it is new. Caller must hold the lock exclusively.
+	/// </summary>
+	/// <param name="str_name"></param>
+	/// <param name="vec_names"></param>
+	/// <param name="map_codes"></param>
+	/// <returns></returns>
+	static std::uint16_t encode(const std::string& str_name, std::vector<std::string>& vec_names, std::unordered_map<std::string, std::uint16_t>& map_codes);
+
+	/// <summary>
+	/// Appends a single line to the columns, throws if the user id is negative. Caller must hold the lock exclusively.
+	/// </summary>
+	void append_locked(std::int64_t ll_date, int i_user_id, const std::string& str_genre, const std::string& str_rating, Money obj_price, int i_count);
+
+	/// <summary>
+	/// Sums the revenue, units and lines of each code for the lines dated within [ll_from, ll_to)
+	/// </summary>
+	/// <param name="ptr_codes">Code column to group by</param>
+	/// <param name="i_group_count">One more than the highest code</param>
+	/// <returns>Groups indexed by code, labels are left empty</returns>
+	template <typename T>
+	std::vector<SalesGroup> sum_by_code(const T* ptr_codes, size_t i_group_count, std::int64_t ll_from, std::int64_t ll_to) const;
+
+	/// <summary>
+	/// Sums the revenue, units and lines of each user for the lines dated within [ll_from, ll_to), keyed by user id rather than indexed by it,
+	/// for when the ids are too spread out to give every id up to the highest a group
+	/// </summary>
+	/// <returns>Groups labelled with their user id</returns>
+	std::vector<SalesGroup> sum_by_user_id(std::int64_t ll_from, std::int64_t ll_to) const;
+public:
+	/// <summary>
+	/// Number of 10.00 wide price bands, games priced above the last band are counted within it
+	/// </summary>
+	static const int PRICE_BAND_COUNT = 8;
+
+	/// <summary>
+	/// Highest user id that grouping by user will index groups by directly regardless of the number of lines, above it users are only indexed
+	/// directly while there are at least as many lines as ids
+	/// </summary>
+	static const int DENSE_USER_ID_LIMIT = 4096;
+
+	SalesColumnStore();
+
+	SalesColumnStore(const SalesColumnStore&) = delete;
+	SalesColumnStore& operator=(const SalesColumnStore&) = delete;
+
+	/// <summary>
+	/// Appends the purchase items stored in the database since the last load, in id order. Called once to fill the store and again after each checkout
+	/// to add just the new lines. Throws if the items could not be read, lines appended before the error are kept and the next load carries on after them.
+	/// </summary>
+	/// <param name="db"></param>
+	/// <returns>The number of lines appended</returns>
+	size_t load_new(sqlite3* db);
+
+	/// <summary>
+	/// Appends a single sales line that is not stored in the database (lines that are should be added through load_new, so they are not counted twice).
+	/// Throws if the user id is negative.
+	/// </summary>
+	/// <param name="ll_date">Seconds since the epoch</param>
+	/// <param name="i_user_id"></param>
+	/// <param name="str_genre"></param>
+	/// <param name="str_rating"></param>
+	/// <param name="obj_price">Price of a single copy</param>
+	/// <param name="i_count"></param>
+	void append(std::int64_t ll_date, int i_user_id, const std::string& str_genre, const std::string& str_rating, Money obj_price, int i_count);
+
+	/// <summary>
+	/// Removes every line, so the next load_new reads all purchase items again
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Returns the number of lines in the store
+	/// </summary>
+	/// <returns></returns>
+	size_t get_row_count() const;
+
+	/// <summary>
+	/// Groups the lines dated within [ll_from, ll_to) and totals each group, most revenue first. Groups without any lines in the range are left out.
+	/// </summary>
+	/// <param name="dimension"></param>
+	/// <param name="ll_from">Start of the range in seconds since the epoch</param>
+	/// <param name="ll_to">End of the range in seconds since the epoch, lines dated at or after it are not included</param>
+	/// <returns></returns>
+	std::vector<SalesGroup> group_by(SalesDimension dimension, std::int64_t ll_from, std::int64_t ll_to) const;
+
+	/// <summary>
+	/// Totals the revenue of the lines dated within [ll_from, ll_to)
+	/// </summary>
+	/// <param name="ll_from"></param>
+	/// <param name="ll_to"></param>
+	/// <returns></returns>
+	Money get_revenue(std::int64_t ll_from, std::int64_t ll_to) const;
+
+	/// <summary>
+	/// Returns the price band a single copy price falls within
+	/// </summary>
+	/// <param name="obj_price"></param>
+	/// <returns></returns>
+	static int get_price_band(Money obj_price);
+
+	/// <summary>
+	/// Returns the label of a price band, e.g. "10.00 - 19.99"
+	/// </summary>
+	/// <param name="i_price_band"></param>
+	/// <returns></returns>
+	static std::string get_price_band_label(int i_price_band);
+};
@@ -0,0 +1,12 @@
+#include "Session.h"
+
+Session::Session() {
+	_bool_login_valid = false;
+}
+
+Session::Session(std::string str_id, User obj_user) {
+	_str_id = str_id;
+	_obj_user = obj_user;
+	_bool_login_valid = true;
+	_obj_basket.set_user_id(obj_user.get_id());
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include "User.h"
+#include "Basket.h"
+#include "Genre.h"
+
+/// <summary>
+/// Class that holds the state of a single shopper: who they are logged in as, their basket and the genre they are browsing. Sessions started at login
+/// are held by the SessionManager under their id; a session without an id (the default) is a logged out session that is not held anywhere.
+/// A session should only be used by one thread at a time.
+/// </summary>
+class Session
+{
+	std::string _str_id;
+	User _obj_user;
+	bool _bool_login_valid;
+	Basket _obj_basket;
+	Genre _obj_filter_genre;
+public:
+	Session();
+
+	/// <summary>
+	/// Creates a logged in session for a user that has been authenticated, with an empty basket
+	/// </summary>
+	/// <param name="str_id"></param>
+	/// <param name="obj_user"></param>
+	Session(std::string str_id, User obj_user);
+
+	std::string get_id() { return _str_id; }
+
+	/// <summary>
+	/// Returns the user the session is logged in as. The user is fixed for the life of the session, changes to the user's details end the session instead.
+	/// </summary>
+	/// <returns></returns>
+	User& get_user() { return _obj_user; }
+
+	bool is_login_valid() { return _bool_login_valid; }
+	void set_login_valid(bool bool_login_valid) { _bool_login_valid = bool_login_valid; }
+
+	Basket& get_basket() { return _obj_basket; }
+
+	Genre& get_filter_genre() { return _obj_filter_genre; }
+	void set_filter_genre(Genre obj_filter_genre) { _obj_filter_genre = obj_filter_genre; }
+};
@@ -0,0 +1,83 @@
+#include "SessionManager.h"
+#include <mutex>
+#include <random>
+#include <cstdio>
+#include <stdexcept>
+
+SessionManager::SessionManager(size_t i_shard_count) : _vec_shards(i_shard_count) {
+	if (i_shard_count < 1) {
+		throw std::invalid_argument("Session manager must have at least 1 shard.");
+	}
+}
+
+SessionManager::SessionShard& SessionManager::get_shard(const std::string& str_session_id) {
+	return _vec_shards[std::hash<std::string>()(str_session_id) % _vec_shards.size()];
+}
+
+const SessionManager::SessionShard& SessionManager::get_shard(const std::string& str_session_id) const {
+	return _vec_shards[std::hash<std::string>()(str_session_id) % _vec_shards.size()];
+}
+
+std::shared_ptr<Session> SessionManager::create_session(User obj_user) {
+	// Each thread draws ids from its own generator, so creating sessions only locks the shard the id lands in
+	thread_local std::mt19937_64 obj_random(((std::uint64_t)std::random_device()() << 32) | std::random_device()());
+
+	while (true) {
+		char str_buffer[33];
+		snprintf(str_buffer, sizeof(str_buffer), "%016llx%016llx", (unsigned long long)obj_random(), (unsigned long long)obj_random());
+		std::string str_session_id = str_buffer;
+
+		SessionShard& obj_shard = get_shard(str_session_id);
+		std::unique_lock<std::shared_mutex> lock(obj_shard.mutex);
+
+		// Ids are 128 random bits, drawn again in the unlikely case one is already in use
+		if (obj_shard.map_sessions.count(str_session_id) > 0) continue;
+
+		std::shared_ptr<Session> ptr_session = std::make_shared<Session>(str_session_id, obj_user);
+		obj_shard.map_sessions[str_session_id] = ptr_session;
+		return ptr_session;
+	}
+}
+
+std::shared_ptr<Session> SessionManager::find_session(const std::string& str_session_id) const {
+	const SessionShard& obj_shard = get_shard(str_session_id);
+	std::shared_lock<std::shared_mutex> lock(obj_shard.mutex);
+	auto position = obj_shard.map_sessions.find(str_session_id);
+
+	if (position == obj_shard.map_sessions.end()) return nullptr;
+
+	return position->second;
+}
+
+void SessionManager::end_session(const std::string& str_session_id) {
+	SessionShard& obj_shard = get_shard(str_session_id);
+	std::unique_lock<std::shared_mutex> lock(obj_shard.mutex);
+	obj_shard.map_sessions.erase(str_session_id);
+}
+
+void SessionManager::end_user_sessions(int i_user_id) {
+	// A user's sessions can be in any shard, each is locked in turn rather than all at once
+	for (SessionShard& obj_shard : _vec_shards) {
+		std::unique_lock<std::shared_mutex> lock(obj_shard.mutex);
+
+		for (auto position = obj_shard.map_sessions.begin(); position != obj_shard.map_sessions.end();) {
+			if (position->second->get_user().get_id() == i_user_id) {
+				position = obj_shard.map_sessions.erase(position);
+			}
+			else {
+				position++;
+			}
+		}
+	}
+}
+
+size_t SessionManager::get_session_count() const {
+	size_t i_count = 0;
+
+	for (const SessionShard& obj_shard : _vec_shards) {
+		std::shared_lock<std::shared_mutex> lock(obj_shard.mutex);
+		i_count += obj_shard.map_sessions.size();
+	}
+
+	return i_count;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <memory>
+#include "User.h"
+#include "Session.h"
+
+/// <summary>
+/// Class that holds every logged in session by a random session id handed out at login, so a single process can serve many shoppers at once and a
+/// shopper can be found again by their id without going back to the database. Sessions are spread over several shards, each with its own lock, so
+/// shoppers starting, finding and ending sessions at the same time rarely wait on each other. Sessions last until ended or the manager is destroyed.
+/// Safe to use from several threads at once.
+/// </summary>
+class SessionManager
+{
+	/// <summary>
+	/// The sessions whose ids hash to the shard, with the lock guarding them
+	/// </summary>
+	struct SessionShard {
+		std::unordered_map<std::string, std::shared_ptr<Session>> map_sessions;
+		mutable std::shared_mutex mutex;
+	};
+
+	std::vector<SessionShard> _vec_shards;
+
+	/// <summary>
+	/// Returns the shard a session id belongs to
+	/// </summary>
+	/// <param name="str_session_id"></param>
+	/// <returns></returns>
+	SessionShard& get_shard(const std::string& str_session_id);
+	const SessionShard& get_shard(const std::string& str_session_id) const;
+public:
+	/// <summary>
+	/// Number of shards used when none is provided
+	/// </summary>
+	static const size_t DEFAULT_SHARD_COUNT = 16;
+
+	/// <summary>
+	/// Creates a manager without any sessions
+	/// </summary>
+	/// <param name="i_shard_count">Must be at least 1</param>
+	SessionManager(size_t i_shard_count = DEFAULT_SHARD_COUNT);
+
+	SessionManager(const SessionManager&) = delete;
+	SessionManager& operator=(const SessionManager&) = delete;
+
+	/// <summary>
+	/// Starts a session for a user that has just been authenticated
+	/// </summary>
+	/// <param name="obj_user"></param>
+	/// <returns>The new session, its id is 32 random hex characters</returns>
+	std::shared_ptr<Session> create_session(User obj_user);
+
+	/// <summary>
+	/// Finds a session by its id
+	/// </summary>
+	/// <param name="str_session_id"></param>
+	/// <returns>The session, or nullptr if it was not found</returns>
+	std::shared_ptr<Session> find_session(const std::string& str_session_id) const;
+
+	/// <summary>
+	/// Ends a session, nothing happens if it was not found. Anyone still holding the session can keep using it, but it can no longer be found.
+	/// </summary>
+	/// <param name="str_session_id"></param>
+	void end_session(const std::string& str_session_id);
+
+	/// <summary>
+	/// Ends every session of a user, used when their details change so they are next authenticated against the database
+	/// </summary>
+	/// <param name="i_user_id"></param>
+	void end_user_sessions(int i_user_id);
+
+	/// <summary>
+	/// Returns the number of sessions currently held
+	/// </summary>
+	/// <returns></returns>
+	size_t get_session_count() const;
+};
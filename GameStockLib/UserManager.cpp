@@ -1,60 +1,213 @@
 #include "UserManager.h"
+#include "InputValidator.h"
 
 UserManager::UserManager(sqlite3* db) { 
 	_db = db; 
-	_bool_login_valid = false;
+	_ptr_session_manager = std::make_shared<SessionManager>();
+	_ptr_login_statement = std::make_shared<LoginStatement>();
 }
 
 void UserManager::register_user(User& obj_user) {
-	char* errorMessage;
-	int i_return_code;
+	sqlite3_stmt* stmt_insert_user;
+	// Bound rather than built into the statement, so quotes within the details are stored as they are
+	std::string str_user_insert = "INSERT INTO users (name, age, email, password) VALUES (?, ?, ?, ?)";
 
-	// Build user insert string
-	std::string str_user_insert = "INSERT INTO users (name, age, email, password) VALUES ('" + 
-		obj_user.get_full_name() + "', " + 
-		std::to_string(obj_user.get_age()) + ", '" + 
-		obj_user.get_email() + "', '" + 
-		obj_user.get_password() +"');";
+	if (sqlite3_prepare_v2(_db, str_user_insert.c_str(), -1, &stmt_insert_user, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare insert statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
 
-	i_return_code = sqlite3_exec(_db, str_user_insert.c_str(), NULL, NULL, &errorMessage);
+	sqlite3_bind_text(stmt_insert_user, 1, obj_user.get_full_name().c_str(), -1, SQLITE_TRANSIENT);
+	sqlite3_bind_int(stmt_insert_user, 2, obj_user.get_age());
+	sqlite3_bind_text(stmt_insert_user, 3, obj_user.get_email().c_str(), -1, SQLITE_TRANSIENT);
+	sqlite3_bind_text(stmt_insert_user, 4, obj_user.get_password().c_str(), -1, SQLITE_TRANSIENT);
 
 	// Throw error if insert is not ok
-	if (i_return_code != SQLITE_OK) {
-		throw std::invalid_argument(errorMessage);
+	if (sqlite3_step(stmt_insert_user) != SQLITE_DONE) {
+		std::string str_error_msg = (char*)sqlite3_errmsg(_db);
+		sqlite3_finalize(stmt_insert_user);
+		throw std::invalid_argument(str_error_msg);
 	}
+
+	sqlite3_finalize(stmt_insert_user);
 }
 
-void UserManager::attempt_login(User& obj_user) {
-	int i_return_code;
-	sqlite3_stmt* stmt_user_query;
+UserImportResult UserManager::import_users(std::istream& is_users, int i_batch_size) {
+	if (i_batch_size < 1) {
+		throw std::invalid_argument("Import batch size must be at least 1.");
+	}
+
+	UserImportResult obj_result;
+	sqlite3_stmt* stmt_insert_user;
+	char* errorMessage;
+	// Emails already registered (or earlier in the import) are left as they are, so the statement finishing without a change marks a duplicate
+	std::string str_user_insert = "INSERT INTO users (name, age, email, password) VALUES (?, ?, ?, ?) ON CONFLICT(email) DO NOTHING";
+
+	if (sqlite3_prepare_v2(_db, str_user_insert.c_str(), -1, &stmt_insert_user, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to prepare insert statement: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		throw std::runtime_error(str_error_msg);
+	}
+
+	// Each commit waits on the disk, so users are inserted thousands to a transaction rather than one at a time
+	if (sqlite3_exec(_db, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, &errorMessage) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to start user import: ";
+		str_error_msg = str_error_msg + errorMessage;
+		sqlite3_free(errorMessage);
+		sqlite3_finalize(stmt_insert_user);
+		throw std::runtime_error(str_error_msg);
+	}
 
-	// Build user login attempt string
-	std::string str_find_user_sql = "SELECT * FROM users WHERE email = '" + obj_user.get_email() + "' AND password = '" + obj_user.get_password() + "'";
+	std::string str_line;
+	int i_line_number = 0;
+	int i_batch_count = 0;
+
+	while (std::getline(is_users, str_line)) {
+		i_line_number++;
+		if (!str_line.empty() && str_line.back() == '\r') str_line.pop_back();
+		if (str_line.empty() || (i_line_number == 1 && str_line == "name,age,email,password")) continue;
+
+		// Name, age and email cannot contain commas, everything after the third is the password
+		size_t i_name_end = str_line.find(',');
+		size_t i_age_end = i_name_end == std::string::npos ? std::string::npos : str_line.find(',', i_name_end + 1);
+		size_t i_email_end = i_age_end == std::string::npos ? std::string::npos : str_line.find(',', i_age_end + 1);
+
+		if (i_email_end == std::string::npos) {
+			obj_result.vec_invalid.push_back({ i_line_number, "", "Expected full name, age, email and password separated by commas" });
+			continue;
+		}
+
+		std::string str_full_name = str_line.substr(0, i_name_end);
+		std::string str_age = str_line.substr(i_name_end + 1, i_age_end - i_name_end - 1);
+		std::string str_email = str_line.substr(i_age_end + 1, i_email_end - i_age_end - 1);
+		std::string str_password = str_line.substr(i_email_end + 1);
+		int i_age = 0;
+
+		// The same rules as registering through the menu
+		std::string str_reason = validate::check_full_name(str_full_name, 1, 30);
+		if (str_reason.empty()) str_reason = validate::check_int(str_age, 1, 150, i_age);
+		if (str_reason.empty()) str_reason = validate::check_email(str_email, 1, 45);
+		if (str_reason.empty()) str_reason = validate::check_string(str_password, 8, 256);
+
+		if (!str_reason.empty()) {
+			obj_result.vec_invalid.push_back({ i_line_number, str_email, str_reason });
+			continue;
+		}
+
+		sqlite3_bind_text(stmt_insert_user, 1, str_full_name.c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_int(stmt_insert_user, 2, i_age);
+		sqlite3_bind_text(stmt_insert_user, 3, str_email.c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt_insert_user, 4, str_password.c_str(), -1, SQLITE_TRANSIENT);
+
+		if (sqlite3_step(stmt_insert_user) != SQLITE_DONE) {
+			std::string str_error_msg = "Failed to import users: ";
+			str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+			sqlite3_finalize(stmt_insert_user);
+			sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+			throw std::runtime_error(str_error_msg);
+		}
+
+		if (sqlite3_changes(_db) == 0) {
+			obj_result.vec_duplicates.push_back({ i_line_number, str_email, "Email is already registered" });
+		}
+		else {
+			obj_result.i_imported++;
+			i_batch_count++;
+		}
+
+		sqlite3_reset(stmt_insert_user);
+		sqlite3_clear_bindings(stmt_insert_user);
+
+		if (i_batch_count >= i_batch_size) {
+			if (sqlite3_exec(_db, "COMMIT TRANSACTION; BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+				std::string str_error_msg = "Failed to import users: ";
+				str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+				sqlite3_finalize(stmt_insert_user);
+				if (!sqlite3_get_autocommit(_db)) sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+				throw std::runtime_error(str_error_msg);
+			}
+
+			i_batch_count = 0;
+		}
+	}
 
-	sqlite3_prepare_v2(_db, str_find_user_sql.c_str(), -1, &stmt_user_query, NULL);
-	i_return_code = sqlite3_step(stmt_user_query);
+	sqlite3_finalize(stmt_insert_user);
 
-	// Throw if no matching user could be found
-	if (i_return_code != SQLITE_ROW) {
-		sqlite3_finalize(stmt_user_query);
-		throw std::invalid_argument("No matching user could be found with the provided details.");
+	if (sqlite3_exec(_db, "COMMIT TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+		std::string str_error_msg = "Failed to import users: ";
+		str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+		sqlite3_exec(_db, "ROLLBACK TRANSACTION;", NULL, NULL, NULL);
+		throw std::runtime_error(str_error_msg);
 	}
 
-	// Populate current user if we get this far, assuming found user matches provided details
-	obj_user.set_full_name((char*)sqlite3_column_text(stmt_user_query, 1));
-	obj_user.set_age(sqlite3_column_int(stmt_user_query, 2));
-	obj_user.set_is_admin(sqlite3_column_int(stmt_user_query, 5));
-	obj_user.set_id(sqlite3_column_int(stmt_user_query, 0));
+	return obj_result;
+}
+
+UserImportResult UserManager::import_users(std::filesystem::path path_file, int i_batch_size) {
+	std::ifstream ifs_users(path_file);
 
-	_bool_login_valid = true;
-	_obj_current_user = obj_user;
+	if (!ifs_users.is_open()) {
+		throw std::runtime_error("Failed to open user import file: " + path_file.string());
+	}
 
-	sqlite3_finalize(stmt_user_query);
+	return import_users(ifs_users, i_batch_size);
 }
 
-void UserManager::logout() {
-	_bool_login_valid = false;
-	_obj_current_user = User();
+std::shared_ptr<Session> UserManager::attempt_login(User& obj_user) {
+	int i_return_code;
+
+	{
+		// Held until the statement is reset, so concurrent logins cannot bind over each other's details
+		std::lock_guard<std::mutex> lock(_ptr_login_statement->mutex);
+
+		// Prepared once and bound each login, so it is neither planned again nor affected by quotes within the details. Email is unique, so this is a
+		// single lookup through its index
+		if (_ptr_login_statement->stmt == NULL) {
+			std::string str_find_user_sql = "SELECT id, name, age, is_admin FROM users WHERE email = ? AND password = ?";
+
+			if (sqlite3_prepare_v2(_db, str_find_user_sql.c_str(), -1, &_ptr_login_statement->stmt, NULL) != SQLITE_OK) {
+				sqlite3_finalize(_ptr_login_statement->stmt);
+				_ptr_login_statement->stmt = NULL;
+				std::string str_error_msg = "Failed to prepare fetch statement: ";
+				str_error_msg = str_error_msg + (char*)sqlite3_errmsg(_db);
+				throw std::runtime_error(str_error_msg);
+			}
+		}
+
+		sqlite3_stmt* stmt_user_query = _ptr_login_statement->stmt;
+		sqlite3_bind_text(stmt_user_query, 1, obj_user.get_email().c_str(), -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt_user_query, 2, obj_user.get_password().c_str(), -1, SQLITE_TRANSIENT);
+		i_return_code = sqlite3_step(stmt_user_query);
+
+		// Throw if no matching user could be found, the statement is reset either way so it does not hold a read on the database
+		if (i_return_code != SQLITE_ROW) {
+			sqlite3_reset(stmt_user_query);
+			sqlite3_clear_bindings(stmt_user_query);
+			throw std::invalid_argument("No matching user could be found with the provided details.");
+		}
+
+		// Populate the rest of the user's details if we get this far, assuming found user matches provided details
+		obj_user.set_id(sqlite3_column_int(stmt_user_query, 0));
+		obj_user.set_full_name((char*)sqlite3_column_text(stmt_user_query, 1));
+		obj_user.set_age(sqlite3_column_int(stmt_user_query, 2));
+		obj_user.set_is_admin(sqlite3_column_int(stmt_user_query, 3));
+
+		sqlite3_reset(stmt_user_query);
+		sqlite3_clear_bindings(stmt_user_query);
+	}
+
+	return _ptr_session_manager->create_session(obj_user);
+}
+
+std::shared_ptr<Session> UserManager::resume_session(std::string str_session_id) {
+	return _ptr_session_manager->find_session(str_session_id);
+}
+
+void UserManager::logout(Session& obj_session) {
+	if (!obj_session.get_id().empty()) _ptr_session_manager->end_session(obj_session.get_id());
+
+	obj_session.set_login_valid(false);
 }
 
 void UserManager::fetch_users(bool no_admins) {
@@ -101,6 +254,7 @@ void UserManager::update_user_password(User& obj_user) {
 	}
 
 	sqlite3_finalize(stmt_update_user_password);
+	_ptr_session_manager->end_user_sessions(obj_user.get_id());
 }
 
 void UserManager::update_user_age(User& obj_user) {
@@ -124,6 +278,7 @@ void UserManager::update_user_age(User& obj_user) {
 	}
 
 	sqlite3_finalize(stmt_update_user_age);
+	_ptr_session_manager->end_user_sessions(obj_user.get_id());
 }
 
 void UserManager::update_user_fullname(User& obj_user) {
@@ -147,6 +302,7 @@ void UserManager::update_user_fullname(User& obj_user) {
 	}
 
 	sqlite3_finalize(stmt_update_user_name);
+	_ptr_session_manager->end_user_sessions(obj_user.get_id());
 }
 
 void UserManager::update_user_email(User& obj_user) {
@@ -170,6 +326,7 @@ void UserManager::update_user_email(User& obj_user) {
 	}
 
 	sqlite3_finalize(stmt_update_user_email);
+	_ptr_session_manager->end_user_sessions(obj_user.get_id());
 }
 
 void UserManager::change_user_admin_status(User& obj_user) {
@@ -193,4 +350,5 @@ void UserManager::change_user_admin_status(User& obj_user) {
 	}
 
 	sqlite3_finalize(stmt_update_user_admin_status);
+	_ptr_session_manager->end_user_sessions(obj_user.get_id());
 }
\ No newline at end of file
@@ -2,18 +2,63 @@
 #include <string>
 #include <stdexcept>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <istream>
+#include <fstream>
+#include <filesystem>
 #include "sqlite3.h"
 #include "User.h"
+#include "Session.h"
+#include "SessionManager.h"
 
 /// <summary>
-/// Class that is used to manage users and perform user related operations
+/// A line of a user import that was not imported, with the line number (counting from 1) and why
+/// </summary>
+struct UserImportIssue {
+	int i_line_number = 0;
+	std::string str_email;
+	std::string str_reason;
+};
+
+/// <summary>
+/// Outcome of a user import: how many users were added, the lines whose email was already registered (or repeated earlier in the import) and the
+/// lines that did not pass validation
+/// </summary>
+struct UserImportResult {
+	int i_imported = 0;
+	std::vector<UserImportIssue> vec_duplicates;
+	std::vector<UserImportIssue> vec_invalid;
+};
+
+/// <summary>
+/// Class that is used to manage users and perform user related operations. Logins start a session in the session manager, which is handed back to
+/// the caller to keep; the manager itself does not hold a current user, so one manager can serve any number of sessions.
 /// </summary>
 class UserManager
 {
 	sqlite3* _db;
-	bool _bool_login_valid;
-	User _obj_current_user;
 	std::vector<User> _vec_users;
+
+	/// <summary>
+	/// The login statement, prepared on the first login and kept for the next. Logins from any number of sessions share it, so it is only
+	/// used (from binding the details through to resetting it) while holding the mutex, otherwise one login could step with another's details.
+	/// </summary>
+	struct LoginStatement {
+		std::mutex mutex;
+		sqlite3_stmt* stmt = NULL;
+
+		LoginStatement() = default;
+		~LoginStatement() { sqlite3_finalize(stmt); }
+
+		LoginStatement(const LoginStatement&) = delete;
+		LoginStatement& operator=(const LoginStatement&) = delete;
+	};
+
+	// Shared (and finalized by the last copy) so copies of the manager use the same statement and lock
+	std::shared_ptr<LoginStatement> _ptr_login_statement;
+
+	std::shared_ptr<SessionManager> _ptr_session_manager;
 public:
 	UserManager(sqlite3* db);
 
@@ -24,29 +69,57 @@ public:
 	void register_user(User& ptr_user);
 
 	/// <summary>
-	/// Attempts a login using the provided user details, throws if login fails, sets current user in object on success
+	/// Number of users inserted per transaction by import_users
 	/// </summary>
-	/// <param name="ptr_user"></param>
-	void attempt_login(User& ptr_user);
+	static const int DEFAULT_IMPORT_BATCH_SIZE = 5000;
 
 	/// <summary>
-	/// Unsets the current user and returns the user manager to it's "default" logged out state
+	/// Adds the users listed in a stream, one per line as "full name,age,email,password" (the password is the rest of the line, so it may contain
+	/// commas). Blank lines and a first line of "name,age,email,password" are skipped. Each line is checked with the same rules as registering
+	/// through the menu, and lines that fail or whose email is already registered are reported rather than stopping the import. Users are added
+	/// as non admins, through one prepared insert, committing every i_batch_size users. Throws if the database fails part way, in which case users
+	/// in batches already committed stay added.
 	/// </summary>
-	void logout();
+	/// <param name="is_users"></param>
+	/// <param name="i_batch_size"></param>
+	/// <returns></returns>
+	UserImportResult import_users(std::istream& is_users, int i_batch_size = DEFAULT_IMPORT_BATCH_SIZE);
 
 	/// <summary>
-	/// Returns a true/false on if there is currently a valid user logged in.
+	/// Adds the users listed in a file, see the stream overload for the format. Throws if the file could not be opened.
 	/// </summary>
+	/// <param name="path_file"></param>
+	/// <param name="i_batch_size"></param>
 	/// <returns></returns>
-	bool is_login_valid() { return _bool_login_valid; }
-	void set_login_valid(bool bool_login_valid) { _bool_login_valid = bool_login_valid; }
+	UserImportResult import_users(std::filesystem::path path_file, int i_batch_size = DEFAULT_IMPORT_BATCH_SIZE);
 
 	/// <summary>
-	/// Returns the currently logged in user Id, returns 0 if there is no user logged in.
+	/// Authenticates the provided user details and starts a new session for them in the session manager. Throws if no user matches the details,
+	/// the rest of the user's details are set in obj_user on success. Any session the caller already had is left as it is, end it with logout.
 	/// </summary>
-	/// <returns></returns>
-	int get_user_id() { return _obj_current_user.get_id(); }
-	User& get_current_user() { return _obj_current_user; }
+	/// <param name="obj_user"></param>
+	/// <returns>The new session</returns>
+	std::shared_ptr<Session> attempt_login(User& obj_user);
+
+	/// <summary>
+	/// Finds the session with the provided id, so its user does not have to be authenticated against the database again
+	/// </summary>
+	/// <param name="str_session_id"></param>
+	/// <returns>The session, or nullptr if it was not found (it was ended or the user's details have changed since)</returns>
+	std::shared_ptr<Session> resume_session(std::string str_session_id);
+
+	/// <summary>
+	/// Ends a session, so it can no longer be resumed, and marks it as logged out
+	/// </summary>
+	/// <param name="obj_session"></param>
+	void logout(Session& obj_session);
+
+	/// <summary>
+	/// Sets the manager sessions are held in, so several user managers can serve the same sessions. Each user manager has its own until this is set.
+	/// </summary>
+	/// <param name="ptr_session_manager"></param>
+	void set_session_manager(std::shared_ptr<SessionManager> ptr_session_manager) { _ptr_session_manager = ptr_session_manager; }
+	std::shared_ptr<SessionManager> get_session_manager() { return _ptr_session_manager; }
 
 	std::vector<User>& get_vec_users() { return _vec_users; }
 
@@ -57,6 +130,7 @@ public:
 
 	/// <summary>
 	/// Pass in user object to update, password stored in obj_user will be used to then persist the password to the database.
+	/// The user's sessions are ended, as with each of the other updates below.
 	/// </summary>
 	/// <param name="obj_user"></param>
 	void update_user_password(User& obj_user);
@@ -0,0 +1,34 @@
+#include "UserPurchaseSummary.h"
+
+UserPurchaseSummary::UserPurchaseSummary() {
+	_i_user_id = 0;
+	_i_purchase_count = 0;
+	_i_total_game_copies = 0;
+}
+
+UserPurchaseSummary::UserPurchaseSummary(int i_user_id) {
+	_i_user_id = i_user_id;
+	_i_purchase_count = 0;
+	_i_total_game_copies = 0;
+}
+
+UserPurchaseSummary::UserPurchaseSummary(int i_user_id, int i_purchase_count, Money obj_total) {
+	_i_user_id = i_user_id;
+	_i_purchase_count = i_purchase_count;
+	_obj_total = obj_total;
+	_i_total_game_copies = 0;
+}
+
+UserPurchaseSummary::UserPurchaseSummary(int i_user_id, int i_purchase_count, Money obj_total, int i_total_game_copies) {
+	_i_user_id = i_user_id;
+	_i_purchase_count = i_purchase_count;
+	_obj_total = obj_total;
+	_i_total_game_copies = i_total_game_copies;
+}
+
+void UserPurchaseSummary::add_purchase(Purchase obj_purchase) {
+	_i_purchase_count++;
+	_obj_total += obj_purchase.get_total();
+	_i_total_game_copies += obj_purchase.get_total_game_copies();
+	_vec_purchases.push_back(obj_purchase);
+}
\ No newline at end of file
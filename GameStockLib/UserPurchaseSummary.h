@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include "Purchase.h"
+#include "Money.h"
+
+/// <summary>
+/// Class used to store a user's purchase count and total for the all user purchase reports, optionally along with the purchases themselves
+/// </summary>
+class UserPurchaseSummary
+{
+	int _i_user_id;
+	int _i_purchase_count;
+	Money _obj_total;
+	int _i_total_game_copies;
+	std::vector<Purchase> _vec_purchases;
+public:
+	UserPurchaseSummary();
+	UserPurchaseSummary(int i_user_id);
+	UserPurchaseSummary(int i_user_id, int i_purchase_count, Money obj_total);
+	UserPurchaseSummary(int i_user_id, int i_purchase_count, Money obj_total, int i_total_game_copies);
+
+	int get_user_id() { return _i_user_id; }
+	void set_user_id(int i_user_id) { _i_user_id = i_user_id; }
+
+	int get_purchase_count() { return _i_purchase_count; }
+
+	Money get_total() { return _obj_total; }
+
+	/// <summary>
+	/// Returns the total number of game copies purchased, only counts purchases added with their items populated
+	/// </summary>
+	/// <returns></returns>
+	int get_total_game_copies() { return _i_total_game_copies; }
+
+	/// <summary>
+	/// Returns the average purchase total, rounded to the nearest cent (zero when there are no purchases)
+	/// </summary>
+	/// <returns></returns>
+	Money get_average() { return _obj_total.divide_by(_i_purchase_count); }
+
+	/// <summary>
+	/// Returns the purchases of the user, only populated when requested while fetching the summaries
+	/// </summary>
+	/// <returns></returns>
+	std::vector<Purchase>& get_vec_purchases() { return _vec_purchases; }
+
+	/// <summary>
+	/// Adds a purchase to the summary, updating the count and total
+	/// </summary>
+	/// <param name="obj_purchase"></param>
+	void add_purchase(Purchase obj_purchase);
+};
+
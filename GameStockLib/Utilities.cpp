@@ -92,10 +92,10 @@ void util::output_purchase_item_header() {
 	std::cout << "-------------------------------------------------------------------------------------------------------\n";
 }
 
-void util::output_purchase_item_header(std::ofstream& of_stream) {
-	of_stream << "-------------------------------------------------------------------------------------------------------\n";
-	of_stream << std::setw(45) << std::left << "Game Name" << std::setw(9) << std::left << "Copies" << std::setw(15) << std::left << "Game cost" << std::setw(15) << std::left << "Total" << std::setw(20) << std::left << "Total (before VAT)" << "\n";
-	of_stream << "-------------------------------------------------------------------------------------------------------\n";
+void util::output_purchase_item_header(RowFormatter& obj_formatter) {
+	obj_formatter.text("-------------------------------------------------------------------------------------------------------").end_row();
+	obj_formatter.text("Game Name", 45).text("Copies", 9).text("Game cost", 15).text("Total", 15).text("Total (before VAT)", 20).end_row();
+	obj_formatter.text("-------------------------------------------------------------------------------------------------------").end_row();
 }
 
 void util::output_purchase_item(PurchaseItem& obj_purchase_item) {
@@ -109,15 +109,81 @@ void util::output_purchase_item(PurchaseItem& obj_purchase_item) {
 		<< std::setw(20) << std::left << obj_purchase_item.get_total_before_vat() << "\n";
 }
 
-void util::output_purchase_item(PurchaseItem& obj_purchase_item, std::ofstream& of_stream) {
-	of_stream.precision(2);
-	of_stream
+void util::output_purchase_item(PurchaseItem& obj_purchase_item, RowFormatter& obj_formatter) {
+	obj_formatter
+		.text(obj_purchase_item.get_game().get_name(), 45)
+		.integer(obj_purchase_item.get_count(), 9)
+		.money(obj_purchase_item.get_price(), 15)
+		.money(obj_purchase_item.get_total(), 15)
+		.money(obj_purchase_item.get_total_before_vat(), 20)
+		.end_row();
+}
+
+void util::output_report_jobs_header() {
+	std::cout << "----------------------------------------------------------------------------------------------------------\n";
+	std::cout << std::setw(45) << std::left << "Report" << std::setw(12) << std::left << "Status" << std::setw(27) << std::left << "Progress" << std::setw(12) << std::left << "Bytes" << std::setw(10) << std::left << "ETA" << "\n";
+	std::cout << "----------------------------------------------------------------------------------------------------------\n";
+}
+
+void util::output_report_job(ReportJob& obj_job) {
+	std::string str_progress = std::to_string(obj_job.get_units_done()) + " of " + std::to_string(obj_job.get_total_units()) + " " + obj_job.get_unit_name();
+	std::int64_t ll_eta_seconds = obj_job.get_eta_seconds();
+
+	std::cout
+		<< std::setw(45) << std::left << obj_job.get_file_name()
+		<< std::setw(12) << std::left << obj_job.get_status_text()
+		<< std::setw(27) << std::left << str_progress
+		<< std::setw(12) << std::left << obj_job.get_bytes_written()
+		<< std::setw(10) << std::left << (ll_eta_seconds < 0 ? "-" : std::to_string(ll_eta_seconds) + "s") << "\n";
+}
+
+void util::output_sales_header() {
+	std::cout << "-------------------------------------------------------------------------------------\n";
+	std::cout << std::setw(14) << std::left << "Period" << std::setw(15) << std::left << "Revenue" << std::setw(10) << std::left << "Units" << std::setw(10) << std::left << "Orders" << std::setw(26) << std::left << "Revenue (a year earlier)" << std::setw(10) << std::left << "Change" << "\n";
+	std::cout << "-------------------------------------------------------------------------------------\n";
+}
+
+void util::output_sales_bucket(SalesBucket& obj_bucket, SalesPeriod period, SalesBucket& obj_year_earlier) {
+	std::string str_change = "-";
+
+	// Change can only be worked out if there were sales to compare against
+	if (obj_year_earlier.get_revenue().get_cents() > 0) {
+		std::int64_t ll_change = (obj_bucket.get_revenue() - obj_year_earlier.get_revenue()).get_cents() * 100 / obj_year_earlier.get_revenue().get_cents();
+		str_change = (ll_change > 0 ? "+" : "") + std::to_string(ll_change) + "%";
+	}
+
+	std::cout.precision(2);
+	std::cout
 		<< std::fixed
-		<< std::setw(45) << std::left << obj_purchase_item.get_game().get_name()
-		<< std::setw(9) << std::left << obj_purchase_item.get_count()
-		<< std::setw(15) << std::left << obj_purchase_item.get_price()
-		<< std::setw(15) << std::left << obj_purchase_item.get_total()
-		<< std::setw(20) << std::left << obj_purchase_item.get_total_before_vat() << "\n";
+		<< std::setw(14) << std::left << obj_bucket.get_label(period)
+		<< std::setw(15) << std::left << obj_bucket.get_revenue()
+		<< std::setw(10) << std::left << obj_bucket.get_units()
+		<< std::setw(10) << std::left << obj_bucket.get_orders()
+		<< std::setw(26) << std::left << obj_year_earlier.get_revenue()
+		<< std::setw(10) << std::left << str_change << "\n";
+}
+
+void util::output_sales_group_header(std::string str_group_name) {
+	std::cout << "-------------------------------------------------------------------------------------\n";
+	std::cout << std::setw(24) << std::left << str_group_name << std::setw(15) << std::left << "Revenue" << std::setw(10) << std::left << "Share" << std::setw(12) << std::left << "Units" << std::setw(12) << std::left << "Items" << "\n";
+	std::cout << "-------------------------------------------------------------------------------------\n";
+}
+
+void util::output_sales_group(SalesGroup& obj_group, Money obj_total_revenue) {
+	std::string str_share = "-";
+
+	if (obj_total_revenue.get_cents() > 0) {
+		str_share = std::to_string(obj_group.obj_revenue.get_cents() * 100 / obj_total_revenue.get_cents()) + "%";
+	}
+
+	std::cout.precision(2);
+	std::cout
+		<< std::fixed
+		<< std::setw(24) << std::left << obj_group.str_label
+		<< std::setw(15) << std::left << obj_group.obj_revenue
+		<< std::setw(10) << std::left << str_share
+		<< std::setw(12) << std::left << obj_group.ll_units
+		<< std::setw(12) << std::left << obj_group.ll_lines << "\n";
 }
 
 std::tm util::get_current_datetime() {
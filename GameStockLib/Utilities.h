@@ -10,6 +10,10 @@
 #include "Purchase.h"
 #include "PurchaseItem.h"
 #include "User.h"
+#include "ReportJob.h"
+#include "RowFormatter.h"
+#include "SalesBucket.h"
+#include "SalesColumnStore.h"
 
 /// <summary>
 /// Namespace used to contain all utility related functions, such as calculation templates, or 
@@ -142,14 +146,51 @@ namespace util {
 	/// Outputs the header for displaying the purchase item/details table
 	/// </summary>
 	void output_purchase_item_header();
-	void output_purchase_item_header(std::ofstream& of_stream);
+	void output_purchase_item_header(RowFormatter& obj_formatter);
 
 	/// <summary>
 	/// Outputs an individual purchase item (row) for the purchase item/detail table
 	/// </summary>
 	/// <param name="obj_purchase_item"></param>
 	void output_purchase_item(PurchaseItem& obj_purchase_item);
-	void output_purchase_item(PurchaseItem& obj_purchase_item, std::ofstream& of_stream);
+	void output_purchase_item(PurchaseItem& obj_purchase_item, RowFormatter& obj_formatter);
+
+	/// <summary>
+	/// Outputs the header for displaying the report jobs table
+	/// </summary>
+	void output_report_jobs_header();
+
+	/// <summary>
+	/// Outputs an individual report job (row) for the report jobs table, with its progress and estimated time remaining
+	/// </summary>
+	/// <param name="obj_job"></param>
+	void output_report_job(ReportJob& obj_job);
+
+	/// <summary>
+	/// Outputs the header for displaying the sales table
+	/// </summary>
+	void output_sales_header();
+
+	/// <summary>
+	/// Outputs an individual sales bucket (row) for the sales table, compared against the revenue of the same period a year earlier
+	/// </summary>
+	/// <param name="obj_bucket"></param>
+	/// <param name="period"></param>
+	/// <param name="obj_year_earlier"></param>
+	void output_sales_bucket(SalesBucket& obj_bucket, SalesPeriod period, SalesBucket& obj_year_earlier);
+
+	/// <summary>
+	/// Outputs the header of the sales breakdown table, with the first column named after what the sales are grouped by
+	/// </summary>
+	/// <param name="str_group_name"></param>
+	void output_sales_group_header(std::string str_group_name);
+
+	/// <summary>
+	/// Outputs an individual group (row) of the sales breakdown table, along with its share of the total revenue
+	/// </summary>
+	/// <param name="obj_group"></param>
+	/// <param name="obj_total_revenue"></param>
+	void output_sales_group(SalesGroup& obj_group, Money obj_total_revenue);
 
 	/// <summary>
 	/// Get the current (system) datetime as the std::tm struct
@@ -0,0 +1,209 @@
+#include "CppUnitTest.h"
+#include "AllUserReportBuilder.h"
+#include "PurchaseManager.h"
+#include "UserManager.h"
+#include "DatabaseManager.h"
+#include <chrono>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(AllUserReportBuilderTests)
+	{
+	public:
+		DatabaseManager obj_db_manager;
+		std::string test_database_name = "testReportDatabase.db";
+		PurchaseManager obj_purchase_manager = PurchaseManager(NULL);
+		UserManager obj_user_manager = UserManager(NULL);
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			obj_db_manager.connect(test_database_name);
+			obj_db_manager.create_tables_if_not_exist();
+			obj_db_manager.insert_initial();
+			obj_purchase_manager = PurchaseManager(obj_db_manager.get_database());
+			obj_user_manager = UserManager(obj_db_manager.get_database());
+		}
+
+		/// <summary>
+		/// Writes the report one user at a time the way the save menu used to, so the builder's output can be compared against it
+		/// </summary>
+		std::string build_sequential_report(std::vector<User>& vec_users) {
+			std::ostringstream ss_report;
+			Money obj_all_purchase_total;
+			std::vector<UserPurchaseSummary> vec_summaries = obj_purchase_manager.get_user_purchase_summaries(vec_users, true);
+
+			ss_report << "All user purchases summary\n";
+			ss_report << "This summary shows each user and if they have made any purchases displays each purchase with a calculated total.\nSee the end of the report for a grand total/average\n";
+
+			for (size_t i = 0; i < vec_users.size(); i++) {
+				ss_report << "\nSummary for user: " << vec_users[i].get_email() << "\n\n";
+				std::vector<Purchase>& vec_user_purchases = vec_summaries[i].get_vec_purchases();
+
+				if (vec_user_purchases.size() > 0) {
+					ss_report << "Purchases: \n";
+					for (Purchase& purchase : vec_user_purchases) {
+						ss_report.precision(2);
+						ss_report << std::fixed << std::setw(6) << std::left << "Date: " << std::setw(25) << std::left << purchase.get_date() << std::setw(7) << std::left << "Total: " << std::setw(15) << std::left << purchase.get_total() << "\n";
+					}
+
+					ss_report.precision(2);
+					ss_report << std::fixed << std::setw(23) << std::left << "\nUser purchases total: " << std::setw(15) << std::left << vec_summaries[i].get_total() << std::setw(27) << std::left << "User purchases average: " << std::setw(15) << std::left << vec_summaries[i].get_average() << "\n";
+
+					obj_all_purchase_total = obj_all_purchase_total + vec_summaries[i].get_total();
+				}
+				else {
+					ss_report << "This user has not yet made any purchases\n";
+				}
+				ss_report << "__________________________________________________________________________________________\n";
+			}
+
+			ss_report << "\nAll purchases total: " << obj_all_purchase_total << "\n";
+			ss_report << "All purchases average: " << obj_all_purchase_total.divide_by((std::int64_t)vec_users.size()) << "\n";
+			ss_report << "\nNOTE: The above average assumes that for users who have made no purchases the total of their purchases is zero.\n";
+
+			return ss_report.str();
+		}
+
+		/// <summary>
+		/// Adds the provided number of users (after the initial 2), each with the provided number of purchases
+		/// </summary>
+		void insert_users_with_purchases(int i_user_count, int i_purchases_per_user) {
+			char* errorMessage;
+			std::string str_insert_sql =
+				"BEGIN TRANSACTION;" \
+				"WITH RECURSIVE n(i) AS (SELECT 3 UNION ALL SELECT i + 1 FROM n WHERE i < " + std::to_string(i_user_count + 2) + ") " \
+				"INSERT INTO users(id, name, age, email, password) SELECT i, 'User ' || i, 30, 'user' || i || '@email.com', 'password' FROM n;" \
+				"WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < " + std::to_string(i_purchases_per_user) + ") " \
+				"INSERT INTO purchases(user_id, total, date) SELECT u.id, 1000 + n.i, 1600000000 + (n.i % 7) * 86400 FROM users AS u, n WHERE u.id > 2;" \
+				"COMMIT TRANSACTION;";
+			sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
+		}
+
+		TEST_METHOD(build_matches_sequential_report) {
+			// Arrange, the admin has no purchases so both kinds of section are written
+			char* errorMessage;
+			insert_users_with_purchases(10, 3);
+			sqlite3_exec(obj_db_manager.get_database(), "INSERT INTO purchases(user_id, total) VALUES (2, 5000); INSERT INTO purchases(user_id, total) VALUES (2, 1549);", NULL, NULL, &errorMessage);
+			obj_user_manager.fetch_users();
+			std::vector<User>& vec_users = obj_user_manager.get_vec_users();
+			std::ostringstream ss_single, ss_parallel;
+
+			// Act
+			AllUserReportBuilder(obj_db_manager.get_database(), 1).build(vec_users, ss_single);
+			AllUserReportBuilder(obj_db_manager.get_database(), 4).build(vec_users, ss_parallel);
+
+			// Assert
+			std::string str_expected = build_sequential_report(vec_users);
+			Assert::AreEqual(12, (int)vec_users.size());
+			Assert::AreEqual(str_expected, ss_single.str());
+			Assert::AreEqual(str_expected, ss_parallel.str());
+			Assert::IsTrue(str_expected.find("This user has not yet made any purchases") != std::string::npos);
+		}
+
+		TEST_METHOD(build_no_purchases) {
+			// Arrange
+			obj_user_manager.fetch_users();
+			std::vector<User>& vec_users = obj_user_manager.get_vec_users();
+			std::ostringstream ss_report;
+
+			// Act
+			AllUserReportBuilder(obj_db_manager.get_database(), 4).build(vec_users, ss_report);
+
+			// Assert
+			Assert::AreEqual(build_sequential_report(vec_users), ss_report.str());
+		}
+
+		TEST_METHOD(build_more_threads_than_users) {
+			// Arrange
+			std::vector<User> vec_users;
+			User user;
+			user.set_id(2);
+			user.set_email("email@email.com");
+			vec_users.push_back(user);
+			std::ostringstream ss_report;
+
+			// Act
+			AllUserReportBuilder(obj_db_manager.get_database(), 8).build(vec_users, ss_report);
+
+			// Assert
+			Assert::AreEqual(build_sequential_report(vec_users), ss_report.str());
+		}
+
+		TEST_METHOD(build_reports_progress) {
+			// Arrange
+			insert_users_with_purchases(10, 3);
+			obj_user_manager.fetch_users();
+			std::vector<User>& vec_users = obj_user_manager.get_vec_users();
+			ReportJob obj_job("Report.txt", "users", (int)vec_users.size());
+			std::ostringstream ss_report;
+
+			// Act
+			AllUserReportBuilder(obj_db_manager.get_database(), 4).build(vec_users, ss_report, &obj_job);
+
+			// Assert, bytes counted are the user sections
+			Assert::AreEqual(12, obj_job.get_units_done());
+			Assert::IsTrue(obj_job.get_bytes_written() > 0);
+			Assert::IsTrue(obj_job.get_bytes_written() < (std::int64_t)ss_report.str().size());
+		}
+
+		TEST_METHOD(build_cancelled) {
+			// Arrange
+			obj_user_manager.fetch_users();
+			std::vector<User>& vec_users = obj_user_manager.get_vec_users();
+			ReportJob obj_job("Report.txt", "users", (int)vec_users.size());
+			std::ostringstream ss_report;
+			obj_job.cancel();
+
+			// Act
+			AllUserReportBuilder(obj_db_manager.get_database(), 4).build(vec_users, ss_report, &obj_job);
+
+			// Assert, no user sections or totals are written
+			Assert::AreEqual(0, obj_job.get_units_done());
+			Assert::IsTrue(ss_report.str().find("Summary for user") == std::string::npos);
+			Assert::IsTrue(ss_report.str().find("All purchases total") == std::string::npos);
+		}
+
+		TEST_METHOD(default_thread_count) {
+			AllUserReportBuilder obj_builder(obj_db_manager.get_database());
+
+			Assert::IsTrue(obj_builder.get_thread_count() > 0);
+		}
+
+		TEST_METHOD(build_scaling_benchmark) {
+			// Arrange, 1000 users with 50 purchases each
+			insert_users_with_purchases(1000, 50);
+			obj_user_manager.fetch_users();
+			std::vector<User>& vec_users = obj_user_manager.get_vec_users();
+			size_t i_max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+			std::string str_first_report;
+			std::string str_message = "AllUserReportBuilder (" + std::to_string(vec_users.size()) + " users):";
+
+			// Act, double the threads each run up to one per core
+			for (size_t i_threads = 1; ; i_threads = i_threads * 2 > i_max_threads ? i_max_threads : i_threads * 2) {
+				std::ostringstream ss_report;
+				auto time_start = std::chrono::steady_clock::now();
+				AllUserReportBuilder(obj_db_manager.get_database(), i_threads).build(vec_users, ss_report);
+				auto time_taken = std::chrono::steady_clock::now() - time_start;
+
+				str_message += " " + std::to_string(i_threads) + " thread(s) " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(time_taken).count()) + "us,";
+
+				// Assert, every thread count writes the same report
+				if (str_first_report.empty()) str_first_report = ss_report.str();
+				Assert::AreEqual(str_first_report, ss_report.str());
+
+				if (i_threads == i_max_threads) break;
+			}
+
+			Logger::WriteMessage(str_message.c_str());
+		}
+
+		TEST_METHOD_CLEANUP(cleanup_test) {
+			sqlite3_close_v2(obj_db_manager.get_database());
+
+			if (std::filesystem::exists("database\\testReportDatabase.db")) {
+				std::filesystem::remove("database\\testReportDatabase.db");
+			}
+		}
+	};
+}
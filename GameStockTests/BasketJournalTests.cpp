@@ -0,0 +1,188 @@
+#include "CppUnitTest.h"
+#include "BasketJournal.h"
+#include "DatabaseManager.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(BasketJournalTests)
+	{
+	public:
+		DatabaseManager obj_db_manager;
+		std::string test_database_name = "testDatabase.db";
+		std::filesystem::path journal_path = std::filesystem::path(L"database") / L"testBaskets.journal";
+		int i_random_user_id = test_util::generate_random_int_range(1, 2);
+		int i_random_game_id = test_util::generate_random_int_range(1, 4);
+		int i_random_count = test_util::generate_random_int_range(1, 60);
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			obj_db_manager.connect(test_database_name);
+			obj_db_manager.create_tables_if_not_exist();
+			obj_db_manager.insert_initial();
+		}
+
+		TEST_METHOD(record_add) {
+			// Arrange
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+
+			// Act
+			journal.record_add(i_random_user_id, i_random_game_id, i_random_count);
+			auto vec_items = journal.load_basket(i_random_user_id);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_items.size());
+			Assert::AreEqual(i_random_game_id, vec_items[0].first);
+			Assert::AreEqual(i_random_count, vec_items[0].second);
+		}
+
+		TEST_METHOD(record_set_count) {
+			// Arrange
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+
+			// Act
+			journal.record_add(i_random_user_id, i_random_game_id, 1);
+			journal.record_set_count(i_random_user_id, i_random_game_id, i_random_count);
+			auto vec_items = journal.load_basket(i_random_user_id);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_items.size());
+			Assert::AreEqual(i_random_count, vec_items[0].second);
+		}
+
+		TEST_METHOD(record_remove) {
+			// Arrange
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+
+			// Act
+			journal.record_add(i_random_user_id, 1, i_random_count);
+			journal.record_add(i_random_user_id, 2, i_random_count);
+			journal.record_remove(i_random_user_id, 1);
+			auto vec_items = journal.load_basket(i_random_user_id);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_items.size());
+			Assert::AreEqual(2, vec_items[0].first);
+		}
+
+		TEST_METHOD(record_clear) {
+			// Arrange
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+
+			// Act
+			journal.record_add(1, 1, i_random_count);
+			journal.record_add(2, 1, i_random_count);
+			journal.record_clear(1);
+
+			// Assert
+			Assert::AreEqual(0, (int)journal.load_basket(1).size());
+			Assert::AreEqual(1, (int)journal.load_basket(2).size());
+		}
+
+		TEST_METHOD(compact_at_threshold) {
+			// Arrange
+			BasketJournal journal(obj_db_manager.get_database(), journal_path, 3);
+
+			// Act
+			journal.record_add(i_random_user_id, 1, 1);
+			journal.record_add(i_random_user_id, 2, 1);
+			int i_records_before_compact = journal.get_records_since_compact();
+			journal.record_add(i_random_user_id, 3, 1);
+
+			// Assert
+			Assert::AreEqual(2, i_records_before_compact);
+			Assert::AreEqual(0, journal.get_records_since_compact());
+			Assert::AreEqual((std::uintmax_t)0, std::filesystem::file_size(journal_path));
+		}
+
+		TEST_METHOD(replay_on_open) {
+			// Arrange, records left in the journal by a previous run that never compacted
+			{
+				BasketJournal journal(obj_db_manager.get_database(), journal_path);
+				journal.record_add(i_random_user_id, i_random_game_id, i_random_count);
+			}
+
+			// Act
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+			auto vec_items = journal.load_basket(i_random_user_id);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_items.size());
+			Assert::AreEqual(i_random_count, vec_items[0].second);
+		}
+
+		TEST_METHOD(replay_ignores_partial_record) {
+			// Arrange, the final record was cut short part way through being written
+			{
+				std::ofstream ofs_journal(journal_path);
+				ofs_journal << "A " << i_random_user_id << " " << i_random_game_id << " " << i_random_count << ";\n";
+				ofs_journal << "S " << i_random_user_id << " " << i_random_game_id;
+			}
+
+			// Act
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+			auto vec_items = journal.load_basket(i_random_user_id);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_items.size());
+			Assert::AreEqual(i_random_count, vec_items[0].second);
+		}
+
+		TEST_METHOD(replay_ignores_truncated_count) {
+			// Arrange, the final record was cut short part way through its count, what is left of it still reads as a record
+			{
+				std::ofstream ofs_journal(journal_path);
+				ofs_journal << "A " << i_random_user_id << " " << i_random_game_id << " " << i_random_count << ";\n";
+				ofs_journal << "S " << i_random_user_id << " " << i_random_game_id << " 1";
+			}
+
+			// Act
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+			auto vec_items = journal.load_basket(i_random_user_id);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_items.size());
+			Assert::AreEqual(i_random_count, vec_items[0].second);
+		}
+
+		TEST_METHOD(compact_within_transaction) {
+			// Arrange
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+			journal.record_add(i_random_user_id, i_random_game_id, i_random_count);
+			sqlite3_exec(obj_db_manager.get_database(), "BEGIN;", NULL, NULL, NULL);
+
+			// Act
+			journal.compact();
+			bool bool_still_in_transaction = sqlite3_get_autocommit(obj_db_manager.get_database()) == 0;
+			sqlite3_exec(obj_db_manager.get_database(), "ROLLBACK;", NULL, NULL, NULL);
+
+			// Assert, the caller's transaction was left open and rolling it back undoes the compaction with it
+			Assert::IsTrue(bool_still_in_transaction);
+			Assert::AreEqual(0, (int)journal.load_basket(i_random_user_id).size());
+		}
+
+		TEST_METHOD(replay_skips_deleted_games) {
+			// Arrange
+			BasketJournal journal(obj_db_manager.get_database(), journal_path);
+
+			// Act
+			journal.record_add(i_random_user_id, 5000, i_random_count);
+
+			// Assert
+			Assert::AreEqual(0, (int)journal.load_basket(i_random_user_id).size());
+		}
+
+		TEST_METHOD_CLEANUP(cleanup_test) {
+			sqlite3_close_v2(obj_db_manager.get_database());
+
+			if (std::filesystem::exists("database\\testDatabase.db")) {
+				std::filesystem::remove("database\\testDatabase.db");
+			}
+
+			if (std::filesystem::exists(journal_path)) {
+				std::filesystem::remove(journal_path);
+			}
+		}
+	};
+}
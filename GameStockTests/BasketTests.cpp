@@ -0,0 +1,134 @@
+#include "CppUnitTest.h"
+#include "Basket.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(BasketTests)
+	{
+	public:
+		int i_random_user_id = test_util::generate_random_int_range(1, 1000);
+		int i_random_count = test_util::generate_random_int_range(1, 60);
+		Money obj_random_price = test_util::generate_random_money_range(100, 100000);
+		Money obj_random_price_1 = test_util::generate_random_money_range(100, 100000);
+
+		Basket obj_basket = Basket(i_random_user_id);
+
+		TEST_METHOD(default_constructor_test) {
+			Basket basket;
+
+			Assert::AreEqual(0, basket.get_user_id());
+			Assert::AreEqual((std::int64_t)0, basket.get_total().get_cents());
+			Assert::AreEqual(0, basket.get_total_game_copies());
+			Assert::IsTrue(basket.is_empty());
+		}
+
+		TEST_METHOD(constructor_test_1_param) {
+			Assert::AreEqual(i_random_user_id, obj_basket.get_user_id());
+			Assert::IsTrue(obj_basket.is_empty());
+		}
+
+		TEST_METHOD(add_item) {
+			// Act
+			obj_basket.add_item(PurchaseItem(1, i_random_count, obj_random_price));
+			obj_basket.add_item(PurchaseItem(2, 1, obj_random_price_1));
+
+			// Assert
+			Assert::AreEqual(2, obj_basket.get_item_count());
+			Assert::AreEqual(i_random_count + 1, obj_basket.get_total_game_copies());
+			Assert::AreEqual((obj_random_price * i_random_count + obj_random_price_1).get_cents(), obj_basket.get_total().get_cents());
+			Assert::AreEqual((obj_random_price * i_random_count).get_before_vat().get_cents() + obj_random_price_1.get_before_vat().get_cents(), obj_basket.get_total_before_vat().get_cents());
+		}
+
+		TEST_METHOD(add_item_add_to_existing) {
+			// Act
+			obj_basket.add_item(PurchaseItem(1, i_random_count, obj_random_price));
+			obj_basket.add_item(PurchaseItem(1, 2, obj_random_price));
+
+			// Assert
+			Assert::AreEqual(1, obj_basket.get_item_count());
+			Assert::AreEqual(i_random_count + 2, obj_basket.find_item(1)->get_count());
+			Assert::AreEqual((obj_random_price * (i_random_count + 2)).get_cents(), obj_basket.get_total().get_cents());
+		}
+
+		TEST_METHOD(find_item_not_found) {
+			// Act/Assert
+			Assert::IsNull(obj_basket.find_item(1));
+		}
+
+		TEST_METHOD(set_item_count) {
+			// Arrange
+			obj_basket.add_item(PurchaseItem(1, 1, obj_random_price));
+
+			// Act
+			obj_basket.set_item_count(1, i_random_count);
+
+			// Assert
+			Assert::AreEqual(i_random_count, obj_basket.find_item(1)->get_count());
+			Assert::AreEqual(i_random_count, obj_basket.get_total_game_copies());
+			Assert::AreEqual((obj_random_price * i_random_count).get_cents(), obj_basket.get_total().get_cents());
+		}
+
+		TEST_METHOD(set_item_count_zero_removes) {
+			// Arrange
+			obj_basket.add_item(PurchaseItem(1, i_random_count, obj_random_price));
+
+			// Act
+			obj_basket.set_item_count(1, 0);
+
+			// Assert
+			Assert::IsTrue(obj_basket.is_empty());
+			Assert::AreEqual((std::int64_t)0, obj_basket.get_total().get_cents());
+		}
+
+		TEST_METHOD(set_item_count_error) {
+			// Act/Assert
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_basket.set_item_count(1, i_random_count);
+				});
+		}
+
+		TEST_METHOD(remove_item) {
+			// Arrange
+			obj_basket.add_item(PurchaseItem(1, i_random_count, obj_random_price));
+			obj_basket.add_item(PurchaseItem(2, 1, obj_random_price_1));
+			obj_basket.add_item(PurchaseItem(3, 1, obj_random_price));
+
+			// Act
+			obj_basket.remove_item(1);
+
+			// Assert, the remaining items must still be found after the last item is moved into the removed item's place
+			Assert::AreEqual(2, obj_basket.get_item_count());
+			Assert::IsNull(obj_basket.find_item(1));
+			Assert::AreEqual(2, obj_basket.find_item(2)->get_game_id());
+			Assert::AreEqual(3, obj_basket.find_item(3)->get_game_id());
+			Assert::AreEqual(2, obj_basket.get_total_game_copies());
+			Assert::AreEqual((obj_random_price + obj_random_price_1).get_cents(), obj_basket.get_total().get_cents());
+		}
+
+		TEST_METHOD(remove_item_error) {
+			// Act/Assert
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_basket.remove_item(1);
+				});
+		}
+
+		TEST_METHOD(clear) {
+			// Arrange
+			obj_basket.add_item(PurchaseItem(1, i_random_count, obj_random_price));
+			obj_basket.add_item(PurchaseItem(2, 1, obj_random_price_1));
+
+			// Act
+			obj_basket.clear();
+
+			// Assert
+			Assert::IsTrue(obj_basket.is_empty());
+			Assert::AreEqual(i_random_user_id, obj_basket.get_user_id());
+			Assert::AreEqual((std::int64_t)0, obj_basket.get_total().get_cents());
+			Assert::AreEqual((std::int64_t)0, obj_basket.get_total_before_vat().get_cents());
+			Assert::AreEqual(0, obj_basket.get_total_game_copies());
+		}
+	};
+}
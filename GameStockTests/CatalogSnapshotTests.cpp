@@ -0,0 +1,63 @@
+#include "CppUnitTest.h"
+#include "CatalogSnapshot.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(CatalogSnapshotTests)
+	{
+	public:
+		long long ll_random_version = test_util::generate_random_int_range(1, 1000);
+		int i_random_id = test_util::generate_random_int_range(1, 1000);
+		std::vector<Game> vec_games = {
+			Game(i_random_id, "Test game name", Genre(1, "Strategy"), Rating(1, "3"), test_util::generate_random_money_range(100, 10000), 10),
+			Game(i_random_id + 1, "Test game name 2", Genre(2, "Action"), Rating(2, "7"), test_util::generate_random_money_range(100, 10000), 20)
+		};
+
+		CatalogSnapshot obj_catalog = CatalogSnapshot(ll_random_version, vec_games);
+
+		TEST_METHOD(default_constructor_test) {
+			CatalogSnapshot catalog;
+
+			Assert::AreEqual(0LL, catalog.get_version());
+			Assert::AreEqual(0, (int)catalog.get_vec_games().size());
+		}
+
+		TEST_METHOD(constructor_test_2_param) {
+			Assert::AreEqual(ll_random_version, obj_catalog.get_version());
+			Assert::AreEqual(2, (int)obj_catalog.get_vec_games().size());
+			Assert::AreEqual(i_random_id, obj_catalog.get_vec_games()[0].get_id());
+		}
+
+		TEST_METHOD(find_game) {
+			// Act
+			const Game* ptr_game = obj_catalog.find_game(i_random_id + 1);
+
+			// Assert
+			Assert::IsNotNull(ptr_game);
+			Assert::AreEqual(std::string("Test game name 2"), ptr_game->get_name());
+		}
+
+		TEST_METHOD(find_game_not_found) {
+			// Act/Assert
+			Assert::IsNull(obj_catalog.find_game(i_random_id + 2));
+		}
+
+		TEST_METHOD(get_games_in_genre) {
+			// Act
+			std::vector<Game> vec_genre_games = obj_catalog.get_games_in_genre(2);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_genre_games.size());
+			Assert::AreEqual(i_random_id + 1, vec_genre_games[0].get_id());
+			Assert::AreEqual(0, (int)obj_catalog.get_games_in_genre(3).size());
+		}
+
+		TEST_METHOD(get_games_in_genre_no_filter) {
+			// Act/Assert
+			Assert::AreEqual(2, (int)obj_catalog.get_games_in_genre(0).size());
+		}
+	};
+}
@@ -0,0 +1,147 @@
+#include "CppUnitTest.h"
+#include "CheckoutPipeline.h"
+#include "GameManager.h"
+#include "DatabaseManager.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(CheckoutPipelineTests)
+	{
+	public:
+		DatabaseManager obj_db_manager;
+		std::string test_database_name = "testDatabase.db";
+		GameManager obj_game_manager = GameManager(NULL);
+		int i_random_user_id = test_util::generate_random_int_range(1, 2);
+		int i_random_count = test_util::generate_random_int_range(1, 5);
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			obj_db_manager.connect(test_database_name);
+			obj_db_manager.create_tables_if_not_exist();
+			obj_db_manager.insert_initial();
+			obj_game_manager = GameManager(obj_db_manager.get_database());
+			obj_game_manager.refresh_games();
+		}
+
+		int count_purchases() {
+			sqlite3_stmt* stmt_count;
+			sqlite3_prepare_v2(obj_db_manager.get_database(), "SELECT COUNT(*) FROM purchases", -1, &stmt_count, NULL);
+			sqlite3_step(stmt_count);
+			int i_count = sqlite3_column_int(stmt_count, 0);
+			sqlite3_finalize(stmt_count);
+			return i_count;
+		}
+
+		TEST_METHOD(submit) {
+			// Arrange
+			Game game = obj_game_manager.get_vec_games()[2];
+			Basket basket(i_random_user_id);
+			basket.add_item(PurchaseItem(game.get_id(), game, i_random_count, game.get_price()));
+
+			// Act
+			CheckoutPipeline pipeline(obj_db_manager.get_database());
+			Money obj_total = pipeline.submit(basket).get();
+			pipeline.stop();
+			obj_game_manager.refresh_games();
+
+			// Assert
+			Assert::AreEqual((game.get_price() * i_random_count).get_cents(), obj_total.get_cents());
+			Assert::AreEqual(game.get_copies() - i_random_count, obj_game_manager.get_vec_games()[2].get_copies());
+			Assert::AreEqual(1, count_purchases());
+		}
+
+		TEST_METHOD(submit_many) {
+			// Arrange
+			Game game = obj_game_manager.get_vec_games()[1];
+			std::vector<std::future<Money>> vec_futures;
+
+			// Act
+			CheckoutPipeline pipeline(obj_db_manager.get_database(), 16);
+			for (int i = 0; i < 100; i++) {
+				Basket basket(i_random_user_id);
+				basket.add_item(PurchaseItem(game.get_id(), game, 1, game.get_price()));
+				vec_futures.push_back(pipeline.submit(basket));
+			}
+
+			for (auto& future : vec_futures) {
+				future.get();
+			}
+
+			pipeline.stop();
+			obj_game_manager.refresh_games();
+
+			// Assert
+			Assert::AreEqual(100, count_purchases());
+			Assert::AreEqual(game.get_copies() - 100, obj_game_manager.get_vec_games()[1].get_copies());
+			Assert::IsTrue(pipeline.get_batches_committed() >= 7);
+			Assert::IsTrue(pipeline.get_batches_committed() <= 100);
+		}
+
+		TEST_METHOD(submit_failed_basket_does_not_affect_batch) {
+			// Arrange
+			Game game = obj_game_manager.get_vec_games()[2];
+			Game game1 = obj_game_manager.get_vec_games()[3];
+			Basket basket(i_random_user_id);
+			Basket basket_too_many(i_random_user_id);
+			basket.add_item(PurchaseItem(game.get_id(), game, i_random_count, game.get_price()));
+			// Valid item first, so the failure has to undo work already done for this basket
+			basket_too_many.add_item(PurchaseItem(game.get_id(), game, 1, game.get_price()));
+			basket_too_many.add_item(PurchaseItem(game1.get_id(), game1, game1.get_copies() + 1, game1.get_price()));
+
+			// Act
+			CheckoutPipeline pipeline(obj_db_manager.get_database());
+			std::future<Money> future_too_many = pipeline.submit(basket_too_many);
+			std::future<Money> future = pipeline.submit(basket);
+			pipeline.stop();
+			obj_game_manager.refresh_games();
+
+			// Assert
+			Assert::ExpectException<std::runtime_error>([&] {
+				future_too_many.get();
+				});
+			Assert::AreEqual((game.get_price() * i_random_count).get_cents(), future.get().get_cents());
+			Assert::AreEqual(game.get_copies() - i_random_count, obj_game_manager.get_vec_games()[2].get_copies());
+			Assert::AreEqual(game1.get_copies(), obj_game_manager.get_vec_games()[3].get_copies());
+			Assert::AreEqual(1, count_purchases());
+		}
+
+		TEST_METHOD(submit_empty_basket_error) {
+			// Act
+			CheckoutPipeline pipeline(obj_db_manager.get_database());
+			std::future<Money> future = pipeline.submit(Basket(i_random_user_id));
+
+			// Assert
+			Assert::ExpectException<std::invalid_argument>([&] {
+				future.get();
+				});
+		}
+
+		TEST_METHOD(submit_after_stop_error) {
+			// Arrange
+			Game game = obj_game_manager.get_vec_games()[2];
+			Basket basket(i_random_user_id);
+			basket.add_item(PurchaseItem(game.get_id(), game, i_random_count, game.get_price()));
+
+			// Act
+			CheckoutPipeline pipeline(obj_db_manager.get_database());
+			pipeline.stop();
+			std::future<Money> future = pipeline.submit(basket);
+
+			// Assert
+			Assert::ExpectException<std::runtime_error>([&] {
+				future.get();
+				});
+			Assert::AreEqual(0, count_purchases());
+		}
+
+		TEST_METHOD_CLEANUP(cleanup_test) {
+			sqlite3_close_v2(obj_db_manager.get_database());
+
+			if (std::filesystem::exists("database\\testDatabase.db")) {
+				std::filesystem::remove("database\\testDatabase.db");
+			}
+		}
+	};
+}
@@ -0,0 +1,126 @@
+#include "CppUnitTest.h"
+#include "CoPurchaseIndex.h"
+#include <chrono>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(CoPurchaseIndexTests)
+	{
+	public:
+		CoPurchaseIndex obj_index;
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			// Game 1 is bought with game 2 twice and with game 3 once
+			obj_index.add_purchase({ 1, 2 });
+			obj_index.add_purchase({ 1, 2, 3 });
+			obj_index.add_purchase({ 4 });
+		}
+
+		TEST_METHOD(get_top) {
+			std::vector<CoPurchase> vec_top = obj_index.get_top(1, 5);
+
+			// Most purchases first
+			Assert::AreEqual(2, (int)vec_top.size());
+			Assert::AreEqual(2, vec_top[0].i_game_id);
+			Assert::AreEqual(2, vec_top[0].i_purchases);
+			Assert::AreEqual(3, vec_top[1].i_game_id);
+			Assert::AreEqual(1, vec_top[1].i_purchases);
+		}
+
+		TEST_METHOD(get_top_limit) {
+			Assert::AreEqual(1, (int)obj_index.get_top(1, 1).size());
+			Assert::AreEqual(2, obj_index.get_top(1, 1)[0].i_game_id);
+		}
+
+		TEST_METHOD(get_top_ties_in_id_order) {
+			std::vector<CoPurchase> vec_top = obj_index.get_top(3, 5);
+
+			Assert::AreEqual(2, (int)vec_top.size());
+			Assert::AreEqual(1, vec_top[0].i_game_id);
+			Assert::AreEqual(2, vec_top[1].i_game_id);
+		}
+
+		TEST_METHOD(get_top_without_co_purchases) {
+			// Only ever bought on its own, or never bought
+			Assert::AreEqual(0, (int)obj_index.get_top(4, 5).size());
+			Assert::AreEqual(0, (int)obj_index.get_top(99, 5).size());
+		}
+
+		TEST_METHOD(add_purchase_moves_game_up) {
+			obj_index.add_purchase({ 1, 3 });
+			obj_index.add_purchase({ 3, 1, 3 });
+
+			std::vector<CoPurchase> vec_top = obj_index.get_top(1, 5);
+
+			// Game 3 is now bought with game 1 in three purchases, the repeated game 3 only counts once
+			Assert::AreEqual(3, vec_top[0].i_game_id);
+			Assert::AreEqual(3, vec_top[0].i_purchases);
+			Assert::AreEqual(2, vec_top[1].i_game_id);
+		}
+
+		TEST_METHOD(clear) {
+			obj_index.clear();
+
+			Assert::IsFalse(obj_index.is_loaded());
+			Assert::AreEqual(0, (int)obj_index.get_top(1, 5).size());
+		}
+
+		TEST_METHOD(load_new_matches_adding_purchases) {
+			// Arrange, 20,000 purchases of 1 to 4 games from 200 games
+			sqlite3* db;
+			sqlite3_open(":memory:", &db);
+			sqlite3_exec(db, "CREATE TABLE purchase_items(purchase_id INTEGER, game_id INTEGER); CREATE TABLE purchase_items_archive(purchase_id INTEGER, game_id INTEGER);", NULL, NULL, NULL);
+
+			sqlite3_stmt* stmt_insert;
+			sqlite3_prepare_v2(db, "INSERT INTO purchase_items(purchase_id, game_id) VALUES (?, ?)", -1, &stmt_insert, NULL);
+			sqlite3_exec(db, "BEGIN TRANSACTION;", NULL, NULL, NULL);
+			CoPurchaseIndex obj_added_index;
+
+			for (int purchase = 1; purchase <= 20000; purchase++) {
+				std::vector<int> vec_game_ids;
+
+				for (int item = 0; item <= purchase % 4; item++) {
+					vec_game_ids.push_back((purchase * 7 + item * 31) % 200 + 1);
+					sqlite3_bind_int(stmt_insert, 1, purchase);
+					sqlite3_bind_int(stmt_insert, 2, vec_game_ids.back());
+					sqlite3_step(stmt_insert);
+					sqlite3_reset(stmt_insert);
+				}
+
+				obj_added_index.add_purchase(vec_game_ids);
+			}
+
+			sqlite3_exec(db, "COMMIT;", NULL, NULL, NULL);
+			sqlite3_finalize(stmt_insert);
+			CoPurchaseIndex obj_loaded_index(4);
+
+			// Act
+			auto time_start = std::chrono::steady_clock::now();
+			size_t i_loaded = obj_loaded_index.load_new(db);
+			auto time_taken = std::chrono::steady_clock::now() - time_start;
+
+			std::string str_message = "load_new over 20000 purchases: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(time_taken).count()) + "us";
+			Logger::WriteMessage(str_message.c_str());
+
+			// Assert, counting across threads gives the same rows as adding each purchase in turn, and a second load has nothing new to add
+			Assert::AreEqual(20000, (int)i_loaded);
+			Assert::AreEqual(0, (int)obj_loaded_index.load_new(db));
+
+			for (int game = 1; game <= 200; game++) {
+				std::vector<CoPurchase> vec_loaded = obj_loaded_index.get_top(game, 10);
+				std::vector<CoPurchase> vec_added = obj_added_index.get_top(game, 10);
+
+				Assert::AreEqual((int)vec_added.size(), (int)vec_loaded.size());
+				for (size_t i = 0; i < vec_added.size(); i++) {
+					Assert::AreEqual(vec_added[i].i_game_id, vec_loaded[i].i_game_id);
+					Assert::AreEqual(vec_added[i].i_purchases, vec_loaded[i].i_purchases);
+				}
+			}
+
+			sqlite3_close(db);
+		}
+	};
+}
@@ -57,6 +57,245 @@ namespace GameStockTests
 			Assert::AreEqual(SQLITE_ROW, i_return_code);
 		}
 
+		TEST_METHOD(migrate_schema_money_to_integer) {
+			// Arrange, create a version 0 database that stores money as REAL
+			char* errorMessage;
+			dbManager.connect("testMigrationDatabase.db");
+			std::string str_old_sql =
+				"CREATE TABLE games(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, name TEXT NOT NULL, genre_id INTEGER NOT NULL, age_rating INTEGER NOT NULL, price REAL NOT NULL, copies INTEGER NOT NULL DEFAULT(0));" \
+				"CREATE TABLE purchases(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, user_id INTEGER NOT NULL, total REAL NOT NULL, date TEXT NOT NULL DEFAULT(datetime('now')));" \
+				"CREATE TABLE purchase_items(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, purchase_id INTEGER NOT NULL, game_name TEXT NOT NULL, game_price REAL NOT NULL, game_genre TEXT NOT NULL, game_rating TEXT NOT NULL, count INTEGER NOT NULL, total REAL NOT NULL AS(count * game_price) VIRTUAL);" \
+				"INSERT INTO games(name, genre_id, age_rating, price, copies) VALUES('Rogue Legacy 2', 2, 2, 15.49, 250);" \
+				"INSERT INTO purchases(user_id, total) VALUES(2, 30.98);" \
+				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(1, 'Rogue Legacy 2', 15.49, 'Action', '16', 2);";
+			sqlite3_exec(dbManager.get_database(), str_old_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act
+			dbManager.create_tables_if_not_exist();
+
+			sqlite3_stmt* stmt_money;
+			std::string str_money_sql = "SELECT g.price, p.total, i.game_price, i.total, typeof(g.price) FROM games AS g, purchases AS p, purchase_items AS i";
+			sqlite3_prepare_v2(dbManager.get_database(), str_money_sql.c_str(), -1, &stmt_money, NULL);
+			int i_return_code = sqlite3_step(stmt_money);
+
+			// Assert
+			Assert::AreEqual(SQLITE_OK, dbManager.get_return_code());
+			Assert::AreEqual(SQLITE_ROW, i_return_code);
+			Assert::AreEqual(1549, sqlite3_column_int(stmt_money, 0));
+			Assert::AreEqual(3098, sqlite3_column_int(stmt_money, 1));
+			Assert::AreEqual(1549, sqlite3_column_int(stmt_money, 2));
+			Assert::AreEqual(3098, sqlite3_column_int(stmt_money, 3));
+			Assert::AreEqual(std::string("integer"), std::string((char*)sqlite3_column_text(stmt_money, 4)));
+
+			sqlite3_finalize(stmt_money);
+		}
+
+		TEST_METHOD(migrate_schema_purchase_stats) {
+			// Arrange, create a version 1 database with purchases made before stats were kept
+			char* errorMessage;
+			dbManager.connect("testMigrationStatsDatabase.db");
+			dbManager.create_tables_if_not_exist();
+			dbManager.insert_initial();
+			std::string str_old_sql =
+				"DROP TRIGGER trg_purchases_insert_stats;" \
+				"DROP TRIGGER trg_purchase_items_insert_stats;" \
+				"INSERT INTO purchases(user_id, total) VALUES(2, 3098);" \
+				"INSERT INTO game_snapshots(id, name, genre, rating) VALUES(1, 'Rogue Legacy 2', 'Action', '16');" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(1, 1, 1549, 2);" \
+				"INSERT INTO purchases(user_id, total) VALUES(2, 1000);" \
+				"PRAGMA user_version = 1;";
+			sqlite3_exec(dbManager.get_database(), str_old_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act
+			dbManager.create_tables_if_not_exist();
+
+			sqlite3_stmt* stmt_stats;
+			std::string str_stats_sql = "SELECT user_id, purchase_count, total, game_copies FROM user_purchase_stats";
+			sqlite3_prepare_v2(dbManager.get_database(), str_stats_sql.c_str(), -1, &stmt_stats, NULL);
+			int i_return_code = sqlite3_step(stmt_stats);
+
+			// Assert
+			Assert::AreEqual(SQLITE_OK, dbManager.get_return_code());
+			Assert::AreEqual(SQLITE_ROW, i_return_code);
+			Assert::AreEqual(2, sqlite3_column_int(stmt_stats, 0));
+			Assert::AreEqual(2, sqlite3_column_int(stmt_stats, 1));
+			Assert::AreEqual(4098, sqlite3_column_int(stmt_stats, 2));
+			Assert::AreEqual(2, sqlite3_column_int(stmt_stats, 3));
+
+			sqlite3_finalize(stmt_stats);
+		}
+
+		TEST_METHOD(migrate_schema_integer_dates) {
+			// Arrange, create a version 2 database that stores purchase dates as TEXT
+			char* errorMessage;
+			dbManager.connect("testMigrationDatesDatabase.db");
+			dbManager.create_tables_if_not_exist();
+			dbManager.insert_initial();
+			std::string str_old_sql =
+				"DROP TRIGGER trg_purchase_items_insert_stats;" \
+				"DROP TRIGGER trg_purchase_items_delete_stats;" \
+				"DROP TABLE purchases;" \
+				"CREATE TABLE purchases(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, user_id INTEGER REFERENCES users(id) ON DELETE CASCADE NOT NULL, total INTEGER NOT NULL, date TEXT NOT NULL DEFAULT(datetime('now')));" \
+				"INSERT INTO purchases(user_id, total, date) VALUES(2, 3098, '2021-03-04 10:11:12');" \
+				"PRAGMA user_version = 2;";
+			sqlite3_exec(dbManager.get_database(), str_old_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act
+			dbManager.create_tables_if_not_exist();
+
+			sqlite3_stmt* stmt_date;
+			std::string str_date_sql = "SELECT date, typeof(date), datetime(date, 'unixepoch'), (SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_purchases_user_date') FROM purchases";
+			sqlite3_prepare_v2(dbManager.get_database(), str_date_sql.c_str(), -1, &stmt_date, NULL);
+			int i_return_code = sqlite3_step(stmt_date);
+
+			// Assert
+			Assert::AreEqual(SQLITE_OK, dbManager.get_return_code());
+			Assert::AreEqual(SQLITE_ROW, i_return_code);
+			Assert::AreEqual((std::int64_t)1614852672, (std::int64_t)sqlite3_column_int64(stmt_date, 0));
+			Assert::AreEqual(std::string("integer"), std::string((char*)sqlite3_column_text(stmt_date, 1)));
+			Assert::AreEqual(std::string("2021-03-04 10:11:12"), std::string((char*)sqlite3_column_text(stmt_date, 2)));
+			Assert::AreEqual(1, sqlite3_column_int(stmt_date, 3));
+
+			sqlite3_finalize(stmt_date);
+		}
+
+		TEST_METHOD(migrate_schema_sales_rollups) {
+			// Arrange, create a version 3 database with purchases made before sales were rolled up
+			char* errorMessage;
+			dbManager.connect("testMigrationSalesDatabase.db");
+			dbManager.create_tables_if_not_exist();
+			dbManager.insert_initial();
+			std::string str_old_sql =
+				"DROP TRIGGER trg_purchases_insert_sales;" \
+				"DROP TRIGGER trg_purchase_items_insert_sales;" \
+				"INSERT INTO purchases(user_id, total, date) VALUES(2, 3098, 1614852672);" \
+				"INSERT INTO game_snapshots(id, name, genre, rating) VALUES(1, 'Rogue Legacy 2', 'Action', '16');" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(1, 1, 1549, 2);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES(2, 1000, 1615334400);" \
+				"PRAGMA user_version = 3;";
+			sqlite3_exec(dbManager.get_database(), str_old_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act
+			dbManager.create_tables_if_not_exist();
+
+			sqlite3_stmt* stmt_sales;
+			std::string str_sales_sql = "SELECT (SELECT COUNT(*) FROM sales_daily), d.revenue, d.units, d.orders, m.month, m.revenue, m.units, m.orders FROM sales_daily AS d, sales_monthly AS m WHERE d.day = 1614816000";
+			sqlite3_prepare_v2(dbManager.get_database(), str_sales_sql.c_str(), -1, &stmt_sales, NULL);
+			int i_return_code = sqlite3_step(stmt_sales);
+
+			// Assert
+			Assert::AreEqual(SQLITE_OK, dbManager.get_return_code());
+			Assert::AreEqual(SQLITE_ROW, i_return_code);
+			Assert::AreEqual(2, sqlite3_column_int(stmt_sales, 0));
+			Assert::AreEqual(3098, sqlite3_column_int(stmt_sales, 1));
+			Assert::AreEqual(2, sqlite3_column_int(stmt_sales, 2));
+			Assert::AreEqual(1, sqlite3_column_int(stmt_sales, 3));
+			Assert::AreEqual(1614556800, sqlite3_column_int(stmt_sales, 4));
+			Assert::AreEqual(4098, sqlite3_column_int(stmt_sales, 5));
+			Assert::AreEqual(2, sqlite3_column_int(stmt_sales, 6));
+			Assert::AreEqual(2, sqlite3_column_int(stmt_sales, 7));
+
+			sqlite3_finalize(stmt_sales);
+		}
+
+		TEST_METHOD(migrate_schema_purchase_game_ids) {
+			// Arrange, create a version 4 database with purchase items recorded before their game id was kept
+			char* errorMessage;
+			dbManager.connect("testMigrationGameIdsDatabase.db");
+			dbManager.create_tables_if_not_exist();
+			dbManager.insert_initial();
+			std::string str_old_sql =
+				"DROP TABLE purchase_items;" \
+				"CREATE TABLE purchase_items(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, purchase_id INTEGER REFERENCES purchases(id) ON DELETE CASCADE NOT NULL, game_name TEXT NOT NULL, game_price INTEGER NOT NULL, game_genre TEXT NOT NULL, game_rating TEXT NOT NULL, count INTEGER NOT NULL, total INTEGER NOT NULL AS(count * game_price) VIRTUAL);" \
+				"INSERT INTO games(id, name, genre_id, age_rating, price, copies) VALUES(5, 'Fall Guys', 7, 6, 1599, 10);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES(2, 3098, 1614852672);" \
+				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(1, 'Rogue Legacy 2', 1549, 'Action', '16', 2);" \
+				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(1, 'Fall Guys', 1599, 'Action', 'PG', 1);" \
+				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(1, 'Removed Game', 999, 'Action', 'PG', 1);" \
+				"PRAGMA user_version = 4;";
+			sqlite3_exec(dbManager.get_database(), str_old_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act
+			dbManager.create_tables_if_not_exist();
+
+			sqlite3_stmt* stmt_items;
+			std::string str_items_sql = "SELECT game_id FROM purchase_items ORDER BY id";
+			sqlite3_prepare_v2(dbManager.get_database(), str_items_sql.c_str(), -1, &stmt_items, NULL);
+
+			// Assert, only names matching exactly one game are linked
+			Assert::AreEqual(SQLITE_OK, dbManager.get_return_code());
+			Assert::AreEqual(SQLITE_ROW, sqlite3_step(stmt_items));
+			Assert::AreEqual(2, sqlite3_column_int(stmt_items, 0));
+			Assert::AreEqual(SQLITE_ROW, sqlite3_step(stmt_items));
+			Assert::AreEqual(SQLITE_NULL, sqlite3_column_type(stmt_items, 0));
+			Assert::AreEqual(SQLITE_ROW, sqlite3_step(stmt_items));
+			Assert::AreEqual(SQLITE_NULL, sqlite3_column_type(stmt_items, 0));
+
+			sqlite3_finalize(stmt_items);
+
+			sqlite3_stmt* stmt_index;
+			sqlite3_prepare_v2(dbManager.get_database(), "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' AND name = 'idx_purchase_items_game_id'", -1, &stmt_index, NULL);
+			sqlite3_step(stmt_index);
+			Assert::AreEqual(1, sqlite3_column_int(stmt_index, 0));
+
+			sqlite3_finalize(stmt_index);
+		}
+
+		TEST_METHOD(migrate_schema_game_snapshots) {
+			// Arrange, create a version 5 database where every purchase item holds its own copy of the game's name, genre and rating
+			char* errorMessage;
+			dbManager.connect("testMigrationSnapshotsDatabase.db");
+			dbManager.create_tables_if_not_exist();
+			dbManager.insert_initial();
+			std::string str_old_sql =
+				"DROP TABLE purchase_items;" \
+				"CREATE TABLE purchase_items(id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, purchase_id INTEGER REFERENCES purchases(id) ON DELETE CASCADE NOT NULL, game_name TEXT NOT NULL, game_price INTEGER NOT NULL, game_genre TEXT NOT NULL, game_rating TEXT NOT NULL, count INTEGER NOT NULL, total INTEGER NOT NULL AS(count * game_price) VIRTUAL, game_id INTEGER REFERENCES games(id) ON DELETE SET NULL);" \
+				"INSERT INTO purchases(user_id, total) VALUES(2, 3098);" \
+				"WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 3000) " \
+				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count, game_id) " \
+				"SELECT 1, CASE i % 3 WHEN 0 THEN 'Rogue Legacy 2' WHEN 1 THEN 'Fall Guys' ELSE 'Factorio' END, 1549, 'Action', CASE i % 3 WHEN 0 THEN '16' ELSE 'PG' END, 1, (i % 3) + 1 FROM n;" \
+				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(1, 'Rogue Legacy 2', 1549, 'Action', '18', 2);" \
+				"PRAGMA user_version = 5;";
+			sqlite3_exec(dbManager.get_database(), str_old_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act
+			dbManager.create_tables_if_not_exist();
+
+			sqlite3_stmt* stmt_items;
+			std::string str_items_sql = "SELECT (SELECT COUNT(*) FROM game_snapshots), (SELECT COUNT(*) FROM purchase_items), s.name, s.genre, s.rating, i.game_price, i.count, i.total, i.game_id FROM purchase_items AS i INNER JOIN game_snapshots AS s ON s.id = i.snapshot_id ORDER BY i.id DESC LIMIT 1";
+			sqlite3_prepare_v2(dbManager.get_database(), str_items_sql.c_str(), -1, &stmt_items, NULL);
+			int i_return_code = sqlite3_step(stmt_items);
+
+			std::string str_message = "Game snapshots migration: " + std::to_string(dbManager.get_size_before_compaction()) + " bytes before, " +
+				std::to_string(dbManager.get_size_after_compaction()) + " bytes after";
+			Logger::WriteMessage(str_message.c_str());
+
+			// Assert, the 3001 items only hold 4 distinct name/genre/rating combinations
+			Assert::AreEqual(SQLITE_OK, dbManager.get_return_code());
+			Assert::AreEqual(SQLITE_ROW, i_return_code);
+			Assert::AreEqual(4, sqlite3_column_int(stmt_items, 0));
+			Assert::AreEqual(3001, sqlite3_column_int(stmt_items, 1));
+			Assert::AreEqual(std::string("Rogue Legacy 2"), std::string((char*)sqlite3_column_text(stmt_items, 2)));
+			Assert::AreEqual(std::string("Action"), std::string((char*)sqlite3_column_text(stmt_items, 3)));
+			Assert::AreEqual(std::string("18"), std::string((char*)sqlite3_column_text(stmt_items, 4)));
+			Assert::AreEqual(1549, sqlite3_column_int(stmt_items, 5));
+			Assert::AreEqual(2, sqlite3_column_int(stmt_items, 6));
+			Assert::AreEqual(3098, sqlite3_column_int(stmt_items, 7));
+			Assert::AreEqual(SQLITE_NULL, sqlite3_column_type(stmt_items, 8));
+			Assert::IsTrue(dbManager.get_size_after_compaction() > 0);
+			Assert::IsTrue(dbManager.get_size_after_compaction() < dbManager.get_size_before_compaction());
+
+			sqlite3_finalize(stmt_items);
+		}
+
+		TEST_METHOD(create_tables_no_compaction) {
+			dbManager.connect(testDatabaseName);
+			dbManager.create_tables_if_not_exist();
+
+			Assert::AreEqual((std::int64_t)0, dbManager.get_size_before_compaction());
+			Assert::AreEqual((std::int64_t)0, dbManager.get_size_after_compaction());
+		}
+
 		TEST_METHOD_CLEANUP(test_method_cleanup) {
 			sqlite3* db = dbManager.get_database();
 			sqlite3_close_v2(db);
@@ -67,6 +306,30 @@ namespace GameStockTests
 			if (std::filesystem::exists(L"database\\testDatabase.db")) {
 				std::filesystem::remove(L"database\\testDatabase.db");
 			}
+
+			if (std::filesystem::exists(L"database\\testMigrationDatabase.db")) {
+				std::filesystem::remove(L"database\\testMigrationDatabase.db");
+			}
+
+			if (std::filesystem::exists(L"database\\testMigrationStatsDatabase.db")) {
+				std::filesystem::remove(L"database\\testMigrationStatsDatabase.db");
+			}
+
+			if (std::filesystem::exists(L"database\\testMigrationDatesDatabase.db")) {
+				std::filesystem::remove(L"database\\testMigrationDatesDatabase.db");
+			}
+
+			if (std::filesystem::exists(L"database\\testMigrationSalesDatabase.db")) {
+				std::filesystem::remove(L"database\\testMigrationSalesDatabase.db");
+			}
+
+			if (std::filesystem::exists(L"database\\testMigrationGameIdsDatabase.db")) {
+				std::filesystem::remove(L"database\\testMigrationGameIdsDatabase.db");
+			}
+
+			if (std::filesystem::exists(L"database\\testMigrationSnapshotsDatabase.db")) {
+				std::filesystem::remove(L"database\\testMigrationSnapshotsDatabase.db");
+			}
 		}
 	};
 }
@@ -2,7 +2,10 @@
 #include "GameManager.h"
 #include "DatabaseManager.h"
 #include "PurchaseManager.h"
+#include "SessionManager.h"
 #include "TestUtilities.h"
+#include <thread>
+#include <atomic>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -15,11 +18,12 @@ namespace GameStockTests
 		std::string test_database_name = "testDatabase.db";
 		GameManager obj_game_manager = GameManager(NULL);
 		PurchaseManager obj_purchase_manager = PurchaseManager(NULL);
+		Session obj_session;
 		int i_random_basket_user_id = test_util::generate_random_int_range(1, 200);
 		int i_random_purchase_item_game_id = test_util::generate_random_int_range(500, 2500);
 		std::string str_game_name = "Test game name";
 		std::string str_genre_name = "Test genre name";
-		double d_random_game_price = test_util::generate_random_double_range(10.10, 120.5);
+		Money obj_random_game_price = test_util::generate_random_money_range(1010, 12050);
 		int i_random_game_copies = test_util::generate_random_int_range(5, 200);
 		int i_random_genre_id = test_util::generate_random_int_range(1, 10);
 		int i_random_rating_id = test_util::generate_random_int_range(1, 6);
@@ -32,6 +36,7 @@ namespace GameStockTests
 			obj_db_manager.insert_initial();
 			obj_game_manager = GameManager(obj_db_manager.get_database());
 			obj_purchase_manager = PurchaseManager(obj_db_manager.get_database());
+			obj_session = Session();
 		}
 
 		TEST_METHOD(initialise_games) {
@@ -50,6 +55,51 @@ namespace GameStockTests
 			Assert::AreEqual(4, (int)obj_game_manager.get_vec_games().size());
 		}
 
+		TEST_METHOD(get_catalog) {
+			// Arrange
+			obj_game_manager.refresh_games();
+			std::shared_ptr<const CatalogSnapshot> ptr_catalog = obj_game_manager.get_catalog();
+
+			// Act, a held snapshot is not changed by games being fetched again
+			obj_game_manager.update_game_name(1, str_game_name);
+			obj_game_manager.refresh_games();
+
+			// Assert
+			Assert::AreEqual(std::string("Factorio"), ptr_catalog->find_game(1)->get_name());
+			Assert::AreEqual(str_game_name, obj_game_manager.find_game(1)->get_name());
+			Assert::AreEqual(ptr_catalog->get_version() + 1, obj_game_manager.get_catalog()->get_version());
+		}
+
+		TEST_METHOD(get_catalog_concurrent_readers) {
+			// Arrange
+			obj_game_manager.refresh_games();
+			std::atomic<bool> bool_stop(false);
+			std::atomic<int> i_bad_reads(0);
+			std::vector<std::thread> vec_readers;
+
+			// Act, readers keep browsing the catalog while it is refreshed
+			for (int i = 0; i < 4; i++) {
+				vec_readers.push_back(std::thread([&] {
+					while (!bool_stop) {
+						std::shared_ptr<const CatalogSnapshot> ptr_catalog = obj_game_manager.get_catalog();
+						if (ptr_catalog->get_vec_games().size() != 4 || ptr_catalog->find_game(4) == nullptr) i_bad_reads++;
+					}
+					}));
+			}
+
+			for (int i = 0; i < 50; i++) {
+				obj_game_manager.refresh_games();
+			}
+
+			bool_stop = true;
+			for (auto& reader : vec_readers) {
+				reader.join();
+			}
+
+			// Assert
+			Assert::AreEqual(0, (int)i_bad_reads);
+		}
+
 		TEST_METHOD(get_vec_games) {
 			// Act
 			obj_game_manager.initialise_games();
@@ -61,109 +111,197 @@ namespace GameStockTests
 
 		TEST_METHOD(get_basket) {
 			// Act/Assert
-			Assert::AreEqual(0, (int)obj_game_manager.get_basket().get_vec_purchase_items().size());
+			Assert::AreEqual(0, (int)obj_session.get_basket().get_vec_purchase_items().size());
 		}
 
 		TEST_METHOD(set_basket_user) {
 			// Act
-			obj_game_manager.set_basket_user(i_random_basket_user_id);
+			obj_session.get_basket().set_user_id(i_random_basket_user_id);
 
 			// Assert
-			Assert::AreEqual(i_random_basket_user_id, obj_game_manager.get_basket().get_user_id());
+			Assert::AreEqual(i_random_basket_user_id, obj_session.get_basket().get_user_id());
 		}
 
 		TEST_METHOD(add_basket_item) {
 			// Arrange
 			obj_game_manager.refresh_games();
-			Game& game = obj_game_manager.get_vec_games()[2];
+			Game game = obj_game_manager.get_vec_games()[2];
 
 			// Act
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
 
 			// Assert
-			Assert::AreEqual(game.get_id(), obj_game_manager.get_basket().get_vec_purchase_items()[0].get_game_id());
-			Assert::AreEqual(1, (int)obj_game_manager.get_basket().get_vec_purchase_items().size());
+			Assert::AreEqual(game.get_id(), obj_session.get_basket().get_vec_purchase_items()[0].get_game_id());
+			Assert::AreEqual(1, (int)obj_session.get_basket().get_vec_purchase_items().size());
 		}
 
 		TEST_METHOD(add_basket_item_add_to_existing) {
 			// Arrange
 			obj_game_manager.refresh_games();
-			Game& game = obj_game_manager.get_vec_games()[2];
+			Game game = obj_game_manager.get_vec_games()[2];
 
 			// Act
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
 
 			// Assert
-			Assert::AreEqual(game.get_id(), obj_game_manager.get_basket().get_vec_purchase_items()[0].get_game_id());
-			Assert::AreEqual(10, obj_game_manager.get_basket().get_vec_purchase_items()[0].get_count());
-			Assert::AreEqual(1, (int)obj_game_manager.get_basket().get_vec_purchase_items().size());
+			Assert::AreEqual(game.get_id(), obj_session.get_basket().get_vec_purchase_items()[0].get_game_id());
+			Assert::AreEqual(10, obj_session.get_basket().get_vec_purchase_items()[0].get_count());
+			Assert::AreEqual(1, (int)obj_session.get_basket().get_vec_purchase_items().size());
 		}
 
 		TEST_METHOD(add_basket_item_error_if_count_exceeded) {
 			// Arrange
 			obj_game_manager.refresh_games();
-			Game& game = obj_game_manager.get_vec_games()[2];
+			Game game = obj_game_manager.get_vec_games()[2];
 
 			// Act
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
 
 			// Assert
 			Assert::ExpectException<std::runtime_error>([&] {
-				obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 1500, game.get_price()));
+				obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 1500, game.get_price()));
 				});
 		}
 
 		TEST_METHOD(remove_basket_item) {
 			// Arrange
 			obj_game_manager.refresh_games();
-			Game& game = obj_game_manager.get_vec_games()[2];
+			Game game = obj_game_manager.get_vec_games()[2];
 
 			// Act
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
-			obj_game_manager.remove_basket_item(game.get_id());
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.remove_basket_item(obj_session, game.get_id());
 
 			// Assert
-			Assert::AreEqual(0, (int)obj_game_manager.get_basket().get_vec_purchase_items().size());
+			Assert::AreEqual(0, (int)obj_session.get_basket().get_vec_purchase_items().size());
 		}
 
 		TEST_METHOD(remove_basket_item_error) {
 			// Act/Assert
 			Assert::ExpectException<std::invalid_argument>([&] {
-				obj_game_manager.remove_basket_item(i_random_purchase_item_game_id);
+				obj_game_manager.remove_basket_item(obj_session, i_random_purchase_item_game_id);
+				});
+		}
+
+		TEST_METHOD(set_basket_item_count) {
+			// Arrange
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+
+			// Act
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.set_basket_item_count(obj_session, game.get_id(), 2);
+
+			// Assert
+			Assert::AreEqual(2, obj_session.get_basket().get_vec_purchase_items()[0].get_count());
+			Assert::AreEqual((game.get_price() * 2).get_cents(), obj_session.get_basket().get_total().get_cents());
+		}
+
+		TEST_METHOD(set_basket_item_count_error_if_count_exceeded) {
+			// Arrange
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+
+			// Act
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
+
+			// Assert
+			Assert::ExpectException<std::runtime_error>([&] {
+				obj_game_manager.set_basket_item_count(obj_session, game.get_id(), game.get_copies() + 1);
 				});
 		}
 
 		TEST_METHOD(get_basket_total) {
 			// Arrange
 			obj_game_manager.refresh_games();
-			Game& game = obj_game_manager.get_vec_games()[1];
-			Game& game1 = obj_game_manager.get_vec_games()[2];
-			double d_expected_total = (game.get_price() * (double)5) + (game1.get_price() * (double)2);
+			Game game = obj_game_manager.get_vec_games()[1];
+			Game game1 = obj_game_manager.get_vec_games()[2];
+			Money obj_expected_total = (game.get_price() * 5) + (game1.get_price() * 2);
 
 			// Act
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
-			obj_game_manager.add_basket_item(PurchaseItem(game1.get_id(), game, 2, game1.get_price()));
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game1.get_id(), game, 2, game1.get_price()));
 
 			// Assert
-			Assert::AreEqual(d_expected_total, obj_game_manager.get_basket_total());
-			Assert::AreEqual(2, (int)obj_game_manager.get_basket().get_vec_purchase_items().size());
+			Assert::AreEqual(obj_expected_total.get_cents(), obj_session.get_basket().get_total().get_cents());
+			Assert::AreEqual(2, (int)obj_session.get_basket().get_vec_purchase_items().size());
 		}
 
 		TEST_METHOD(reset_basket) {
 			// Arrange
 			obj_game_manager.refresh_games();
-			Game& game = obj_game_manager.get_vec_games()[1];
-			Game& game1 = obj_game_manager.get_vec_games()[2];
+			Game game = obj_game_manager.get_vec_games()[1];
+			Game game1 = obj_game_manager.get_vec_games()[2];
+
+			// Act
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game1.get_id(), game, 2, game1.get_price()));
+			obj_game_manager.reset_basket(obj_session);
+
+			// Assert
+			Assert::AreEqual((std::int64_t)0, obj_session.get_basket().get_total().get_cents());
+			Assert::AreEqual(0, (int)obj_session.get_basket().get_vec_purchase_items().size());
+		}
+
+		TEST_METHOD(restore_basket) {
+			// Arrange
+			std::filesystem::path journal_path = std::filesystem::path(L"database") / L"testBaskets.journal";
+			obj_game_manager.set_basket_journal(std::make_shared<BasketJournal>(obj_db_manager.get_database(), journal_path));
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+			obj_session.get_basket().set_user_id(2);
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
 
 			// Act
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
-			obj_game_manager.add_basket_item(PurchaseItem(game1.get_id(), game, 2, game1.get_price()));
-			obj_game_manager.reset_basket();
+			obj_game_manager.logout();
+			// The next login starts a new session, whose basket is empty until restored
+			obj_session = Session();
+			int i_count_after_logout = obj_session.get_basket().get_item_count();
+			obj_game_manager.restore_basket(obj_session, 2);
+			obj_game_manager.set_basket_journal(nullptr);
+			std::filesystem::remove(journal_path);
 
 			// Assert
-			Assert::AreEqual((double)0, obj_game_manager.get_basket_total());
-			Assert::AreEqual(0, (int)obj_game_manager.get_basket().get_vec_purchase_items().size());
+			Assert::AreEqual(0, i_count_after_logout);
+			Assert::AreEqual(1, obj_session.get_basket().get_item_count());
+			Assert::AreEqual(5, obj_session.get_basket().find_item(game.get_id())->get_count());
+			Assert::AreEqual((game.get_price() * 5).get_cents(), obj_session.get_basket().get_total().get_cents());
+		}
+
+		TEST_METHOD(sessions_have_separate_baskets) {
+			// Arrange, two shoppers served by the same manager
+			SessionManager obj_session_manager;
+			User first_user;
+			first_user.set_id(1);
+			User second_user;
+			second_user.set_id(2);
+			std::shared_ptr<Session> ptr_first_session = obj_session_manager.create_session(first_user);
+			std::shared_ptr<Session> ptr_second_session = obj_session_manager.create_session(second_user);
+			obj_game_manager.refresh_games();
+			Game first_game = obj_game_manager.get_vec_games()[1];
+			Game second_game = obj_game_manager.get_vec_games()[2];
+
+			PurchaseItem first_item(first_game.get_id(), first_game, 1, first_game.get_price());
+			PurchaseItem second_item(second_game.get_id(), second_game, 2, second_game.get_price());
+
+			// Act
+			obj_game_manager.add_basket_item(*ptr_first_session, first_item);
+			obj_game_manager.add_basket_item(*ptr_second_session, second_item);
+			obj_game_manager.add_basket_item(*ptr_second_session, first_item);
+			obj_game_manager.make_purchase(*ptr_second_session);
+
+			// Assert, the purchase is made as the second session's user and the other sessions' baskets are untouched
+			Assert::AreEqual(1, ptr_first_session->get_basket().get_item_count());
+			Assert::AreEqual(1, ptr_first_session->get_basket().get_user_id());
+			Assert::AreEqual(2, ptr_second_session->get_basket().get_item_count());
+			Assert::AreEqual(0, obj_session.get_basket().get_item_count());
+
+			User user;
+			user.set_id(2);
+			obj_purchase_manager.fetch_purchases(user);
+			Assert::AreEqual(1, (int)obj_purchase_manager.get_vec_purchases().size());
+			Assert::AreEqual((first_game.get_price() + second_game.get_price() * 2).get_cents(), obj_purchase_manager.get_vec_purchases()[0].get_total().get_cents());
 		}
 
 		TEST_METHOD(get_admin_flag) {
@@ -190,7 +328,7 @@ namespace GameStockTests
 
 		TEST_METHOD(add_game) {
 			// Arrange
-			Game game(str_game_name, Genre(i_random_genre_id, ""), Rating(i_random_rating_id, ""), d_random_game_price, i_random_game_copies);
+			Game game(str_game_name, Genre(i_random_genre_id, ""), Rating(i_random_rating_id, ""), obj_random_game_price, i_random_game_copies);
 
 			// Act
 			obj_game_manager.add_game(game);
@@ -200,7 +338,7 @@ namespace GameStockTests
 			Assert::AreEqual(str_game_name, obj_game_manager.get_vec_games()[4].get_name());
 			Assert::AreEqual(i_random_genre_id, obj_game_manager.get_vec_games()[4].get_genre().get_id());
 			Assert::AreEqual(i_random_rating_id, obj_game_manager.get_vec_games()[4].get_rating().get_id());
-			Assert::AreEqual(d_random_game_price, obj_game_manager.get_vec_games()[4].get_price());
+			Assert::AreEqual(obj_random_game_price.get_cents(), obj_game_manager.get_vec_games()[4].get_price().get_cents());
 			Assert::AreEqual(i_random_game_copies, obj_game_manager.get_vec_games()[4].get_copies());
 		}
 
@@ -223,7 +361,7 @@ namespace GameStockTests
 			obj_game_manager.initialise_games();
 
 			Game updated_game;
-			for (Game& game : obj_game_manager.get_vec_games()) {
+			for (const Game& game : obj_game_manager.get_vec_games()) {
 				if (game.get_id() == i_random_valid_game_id) updated_game = game;
 			}
 
@@ -237,7 +375,7 @@ namespace GameStockTests
 			obj_game_manager.initialise_games();
 
 			Game updated_game;
-			for (Game& game : obj_game_manager.get_vec_games()) {
+			for (const Game& game : obj_game_manager.get_vec_games()) {
 				if (game.get_genre().get_id() == i_random_genre_id && game.get_id() == i_random_valid_game_id) updated_game = game;
 			}
 
@@ -247,16 +385,16 @@ namespace GameStockTests
 
 		TEST_METHOD(update_game_price) {
 			// Act
-			obj_game_manager.update_game_price(i_random_valid_game_id, d_random_game_price);
+			obj_game_manager.update_game_price(i_random_valid_game_id, obj_random_game_price);
 			obj_game_manager.initialise_games();
 
 			Game updated_game;
-			for (Game& game : obj_game_manager.get_vec_games()) {
-				if (game.get_price() == d_random_game_price && game.get_id() == i_random_valid_game_id) updated_game = game;
+			for (const Game& game : obj_game_manager.get_vec_games()) {
+				if (game.get_price() == obj_random_game_price && game.get_id() == i_random_valid_game_id) updated_game = game;
 			}
 
 			// Assert
-			Assert::AreEqual(d_random_game_price, updated_game.get_price());
+			Assert::AreEqual(obj_random_game_price.get_cents(), updated_game.get_price().get_cents());
 		}
 
 		TEST_METHOD(update_game_rating) {
@@ -265,7 +403,7 @@ namespace GameStockTests
 			obj_game_manager.initialise_games();
 
 			Game updated_game;
-			for (Game& game : obj_game_manager.get_vec_games()) {
+			for (const Game& game : obj_game_manager.get_vec_games()) {
 				if (game.get_rating().get_id() == i_random_rating_id && game.get_id() == i_random_valid_game_id) updated_game = game;
 			}
 
@@ -279,7 +417,7 @@ namespace GameStockTests
 			obj_game_manager.initialise_games();
 
 			Game updated_game;
-			for (Game& game : obj_game_manager.get_vec_games()) {
+			for (const Game& game : obj_game_manager.get_vec_games()) {
 				if (game.get_copies() == i_random_game_copies && game.get_id() == i_random_valid_game_id) updated_game = game;
 			}
 
@@ -352,11 +490,11 @@ namespace GameStockTests
 			Game game = obj_game_manager.get_vec_games()[2];
 			User user;
 			user.set_id(2);
-			obj_game_manager.set_basket_user(user.get_id());
+			obj_session.get_basket().set_user_id(user.get_id());
 
 			// Act
-			obj_game_manager.add_basket_item(PurchaseItem(game.get_id(), game, 5, game.get_price()));
-			obj_game_manager.make_purchase();
+			obj_game_manager.add_basket_item(obj_session, PurchaseItem(game.get_id(), game, 5, game.get_price()));
+			obj_game_manager.make_purchase(obj_session);
 			obj_purchase_manager.fetch_purchases(user);
 			auto user_purchases = obj_purchase_manager.get_vec_purchases();
 
@@ -370,7 +508,215 @@ namespace GameStockTests
 			Assert::AreEqual(game.get_copies() - 5, obj_game_manager.get_vec_games()[2].get_copies());
 			Assert::AreEqual(1, (int)user_purchases.size());
 			Assert::AreEqual(1, (int)user_purchases[0].get_vec_purchase_items().size());
-			Assert::AreEqual(game.get_price() * (double)5, user_purchases[0].get_total());
+			Assert::AreEqual((game.get_price() * 5).get_cents(), user_purchases[0].get_total().get_cents());
+		}
+
+		TEST_METHOD(make_purchase_not_enough_copies) {
+			// Arrange, another session has bought all but one copy since the basket was filled
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+			PurchaseItem first_item(obj_game_manager.get_vec_games()[1].get_id(), obj_game_manager.get_vec_games()[1], 1, obj_game_manager.get_vec_games()[1].get_price());
+			PurchaseItem second_item(game.get_id(), game, 2, game.get_price());
+			User user;
+			user.set_id(2);
+			obj_session.get_basket().set_user_id(user.get_id());
+			obj_game_manager.add_basket_item(obj_session, first_item);
+			obj_game_manager.add_basket_item(obj_session, second_item);
+			obj_game_manager.update_game_copies(game.get_id(), 1);
+
+			// Act/Assert
+			Assert::ExpectException<std::runtime_error>([&] {
+				obj_game_manager.make_purchase(obj_session);
+				});
+
+			// Assert, nothing from the basket was committed and the remaining copy is left in stock
+			obj_purchase_manager.fetch_purchases(user);
+			obj_game_manager.refresh_games();
+			Assert::AreEqual(0, (int)obj_purchase_manager.get_vec_purchases().size());
+			Assert::AreEqual(first_item.get_game().get_copies(), obj_game_manager.find_game(first_item.get_game_id())->get_copies());
+			Assert::AreEqual(1, obj_game_manager.find_game(game.get_id())->get_copies());
+		}
+
+		TEST_METHOD(make_purchase_concurrent_sessions) {
+			// Arrange, several sessions checking out at the same time through one manager without a pipeline
+			const int i_thread_count = 4;
+			const int i_purchases_per_thread = 10;
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+			std::vector<int> vec_failures(i_thread_count, 0);
+			std::vector<std::thread> vec_threads;
+
+			// Act
+			for (int thread = 0; thread < i_thread_count; thread++) {
+				vec_threads.push_back(std::thread([&, thread]() {
+					for (int i = 0; i < i_purchases_per_thread; i++) {
+						Session obj_thread_session;
+						PurchaseItem item(game.get_id(), game, 1, game.get_price());
+						obj_thread_session.get_basket().set_user_id(2);
+						obj_thread_session.get_basket().add_item(item);
+
+						try {
+							obj_game_manager.make_purchase(obj_thread_session);
+						}
+						catch (std::exception&) {
+							vec_failures[thread]++;
+						}
+					}
+					}));
+			}
+
+			for (std::thread& thread : vec_threads) {
+				thread.join();
+			}
+
+			User user;
+			user.set_id(2);
+			obj_purchase_manager.fetch_purchases(user);
+			obj_game_manager.refresh_games();
+
+			// Assert, each checkout was committed in its own transaction
+			for (int thread = 0; thread < i_thread_count; thread++) {
+				Assert::AreEqual(0, vec_failures[thread]);
+			}
+			Assert::AreEqual(i_thread_count * i_purchases_per_thread, (int)obj_purchase_manager.get_vec_purchases().size());
+			Assert::AreEqual(game.get_copies() - i_thread_count * i_purchases_per_thread, obj_game_manager.get_vec_games()[2].get_copies());
+		}
+
+		TEST_METHOD(make_purchase_through_checkout_pipeline) {
+			// Arrange, the pipeline commits on its own connection as it does in the console
+			sqlite3* db_checkout = obj_db_manager.open_connection();
+			std::shared_ptr<CheckoutPipeline> ptr_checkout_pipeline = std::make_shared<CheckoutPipeline>(db_checkout);
+			obj_game_manager.set_checkout_pipeline(ptr_checkout_pipeline);
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+			PurchaseItem item(game.get_id(), game, 3, game.get_price());
+			User user;
+			user.set_id(2);
+			obj_session.get_basket().set_user_id(user.get_id());
+
+			// Act
+			obj_game_manager.add_basket_item(obj_session, item);
+			Money obj_total = obj_game_manager.make_purchase(obj_session);
+			obj_purchase_manager.fetch_purchases(user);
+			obj_game_manager.refresh_games();
+			int i_batches_committed = ptr_checkout_pipeline->get_batches_committed();
+
+			ptr_checkout_pipeline->stop();
+			sqlite3_close(db_checkout);
+
+			// Assert
+			Assert::AreEqual(1, i_batches_committed);
+			Assert::AreEqual((game.get_price() * 3).get_cents(), obj_total.get_cents());
+			Assert::AreEqual(1, (int)obj_purchase_manager.get_vec_purchases().size());
+			Assert::AreEqual(game.get_copies() - 3, obj_game_manager.get_vec_games()[2].get_copies());
+		}
+
+		TEST_METHOD(make_purchase_through_checkout_pipeline_not_enough_copies) {
+			// Arrange, another session has bought all but one copy since the basket was filled
+			sqlite3* db_checkout = obj_db_manager.open_connection();
+			std::shared_ptr<CheckoutPipeline> ptr_checkout_pipeline = std::make_shared<CheckoutPipeline>(db_checkout);
+			obj_game_manager.set_checkout_pipeline(ptr_checkout_pipeline);
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+			PurchaseItem item(game.get_id(), game, 2, game.get_price());
+			obj_session.get_basket().set_user_id(2);
+			obj_game_manager.add_basket_item(obj_session, item);
+			obj_game_manager.update_game_copies(game.get_id(), 1);
+
+			// Act/Assert
+			Assert::ExpectException<std::runtime_error>([&] {
+				obj_game_manager.make_purchase(obj_session);
+				});
+
+			ptr_checkout_pipeline->stop();
+			sqlite3_close(db_checkout);
+		}
+
+		TEST_METHOD(make_purchase_appends_sales) {
+			// Arrange, a store already loaded with an earlier purchase
+			std::shared_ptr<SalesColumnStore> ptr_sales_store = std::make_shared<SalesColumnStore>();
+			obj_game_manager.set_sales_store(ptr_sales_store);
+			obj_game_manager.refresh_games();
+			Game first_game = obj_game_manager.get_vec_games()[1];
+			Game second_game = obj_game_manager.get_vec_games()[2];
+			PurchaseItem first_item(first_game.get_id(), first_game, 1, first_game.get_price());
+			PurchaseItem second_item(second_game.get_id(), second_game, 5, second_game.get_price());
+			obj_session.get_basket().set_user_id(2);
+			obj_game_manager.add_basket_item(obj_session, first_item);
+			obj_game_manager.make_purchase(obj_session);
+			obj_game_manager.reset_basket(obj_session);
+			ptr_sales_store->load_new(obj_db_manager.get_database());
+
+			// Act
+			obj_game_manager.add_basket_item(obj_session, second_item);
+			obj_game_manager.make_purchase(obj_session);
+
+			// Assert
+			Assert::AreEqual(2, (int)ptr_sales_store->get_row_count());
+			Assert::AreEqual((first_game.get_price() + second_game.get_price() * 5).get_cents(), ptr_sales_store->get_revenue(INT64_MIN, INT64_MAX).get_cents());
+		}
+
+		TEST_METHOD(make_purchase_leaves_unloaded_sales_store) {
+			// Arrange
+			std::shared_ptr<SalesColumnStore> ptr_sales_store = std::make_shared<SalesColumnStore>();
+			obj_game_manager.set_sales_store(ptr_sales_store);
+			obj_game_manager.refresh_games();
+			Game game = obj_game_manager.get_vec_games()[2];
+			PurchaseItem item(game.get_id(), game, 5, game.get_price());
+			obj_session.get_basket().set_user_id(2);
+
+			// Act
+			obj_game_manager.add_basket_item(obj_session, item);
+			obj_game_manager.make_purchase(obj_session);
+
+			// Assert, the store is left to load everything when first read
+			Assert::AreEqual(0, (int)ptr_sales_store->get_row_count());
+			Assert::AreEqual(1, (int)ptr_sales_store->load_new(obj_db_manager.get_database()));
+		}
+
+		TEST_METHOD(make_purchase_adds_co_purchases) {
+			// Arrange, an index already loaded with an earlier purchase of the same games
+			std::shared_ptr<CoPurchaseIndex> ptr_co_purchase_index = std::make_shared<CoPurchaseIndex>();
+			obj_game_manager.set_co_purchase_index(ptr_co_purchase_index);
+			obj_game_manager.refresh_games();
+			Game first_game = obj_game_manager.get_vec_games()[1];
+			Game second_game = obj_game_manager.get_vec_games()[2];
+			PurchaseItem first_item(first_game.get_id(), first_game, 1, first_game.get_price());
+			PurchaseItem second_item(second_game.get_id(), second_game, 2, second_game.get_price());
+			obj_session.get_basket().set_user_id(2);
+			obj_game_manager.add_basket_item(obj_session, first_item);
+			obj_game_manager.add_basket_item(obj_session, second_item);
+			obj_game_manager.make_purchase(obj_session);
+			ptr_co_purchase_index->load_new(obj_db_manager.get_database());
+
+			// Act, the basket is bought again
+			obj_game_manager.make_purchase(obj_session);
+			std::vector<CoPurchase> vec_top = ptr_co_purchase_index->get_top(first_game.get_id(), 5);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_top.size());
+			Assert::AreEqual(second_game.get_id(), vec_top[0].i_game_id);
+			Assert::AreEqual(2, vec_top[0].i_purchases);
+		}
+
+		TEST_METHOD(make_purchase_leaves_unloaded_co_purchase_index) {
+			// Arrange
+			std::shared_ptr<CoPurchaseIndex> ptr_co_purchase_index = std::make_shared<CoPurchaseIndex>();
+			obj_game_manager.set_co_purchase_index(ptr_co_purchase_index);
+			obj_game_manager.refresh_games();
+			Game first_game = obj_game_manager.get_vec_games()[1];
+			Game second_game = obj_game_manager.get_vec_games()[2];
+			PurchaseItem first_item(first_game.get_id(), first_game, 1, first_game.get_price());
+			PurchaseItem second_item(second_game.get_id(), second_game, 2, second_game.get_price());
+			obj_session.get_basket().set_user_id(2);
+
+			// Act
+			obj_game_manager.add_basket_item(obj_session, first_item);
+			obj_game_manager.add_basket_item(obj_session, second_item);
+			obj_game_manager.make_purchase(obj_session);
+
+			// Assert, the index is left to be built when recommendations are first asked for
+			Assert::IsFalse(ptr_co_purchase_index->is_loaded());
 		}
 
 		TEST_METHOD_CLEANUP(cleanup_test) {
@@ -12,18 +12,18 @@ namespace GameStockTests
 		std::string str_game_name = "Test game name";
 		std::string str_genre_name = "Genre name";
 		std::string str_rating_name = "Rating name";
-		double d_random_price = test_util::generate_random_double_range(1.0, 250.50);
+		Money obj_random_price = test_util::generate_random_money_range(100, 25050);
 		int i_random_copies = test_util::generate_random_int_range(1, 160);
 		int i_random_id = test_util::generate_random_int_range(1, 1000);
 
-		Game obj_game = Game(i_random_id, str_game_name, Genre(str_genre_name), Rating(str_rating_name), d_random_price, i_random_copies);
+		Game obj_game = Game(i_random_id, str_game_name, Genre(str_genre_name), Rating(str_rating_name), obj_random_price, i_random_copies);
 
 		TEST_METHOD(default_constructor_test) {
 			Game game;
 
 			Assert::AreEqual(0, game.get_id());
 			Assert::AreEqual(std::string(""), game.get_name());
-			Assert::AreEqual(0.0, game.get_price());
+			Assert::AreEqual((std::int64_t)0, game.get_price().get_cents());
 			Assert::AreEqual(0, game.get_copies());
 		}
 
@@ -32,29 +32,29 @@ namespace GameStockTests
 
 			Assert::AreEqual(0, game.get_id());
 			Assert::AreEqual(str_game_name, game.get_name());
-			Assert::AreEqual(0.0, game.get_price());
+			Assert::AreEqual((std::int64_t)0, game.get_price().get_cents());
 			Assert::AreEqual(0, game.get_copies());
 			Assert::AreEqual(str_genre_name, game.get_genre().get_genre());
 			Assert::AreEqual(str_rating_name, game.get_rating().get_rating());
 		}
 
 		TEST_METHOD(constructor_test_5_param) {
-			Game game = Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name), d_random_price, i_random_copies);
+			Game game = Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name), obj_random_price, i_random_copies);
 
 			Assert::AreEqual(0, game.get_id());
 			Assert::AreEqual(str_game_name, game.get_name());
-			Assert::AreEqual(d_random_price, game.get_price());
+			Assert::AreEqual(obj_random_price.get_cents(), game.get_price().get_cents());
 			Assert::AreEqual(i_random_copies, game.get_copies());
 			Assert::AreEqual(str_genre_name, game.get_genre().get_genre());
 			Assert::AreEqual(str_rating_name, game.get_rating().get_rating());
 		}
 
 		TEST_METHOD(constructor_test_6_param) {
-			Game game = Game(i_random_id, str_game_name, Genre(str_genre_name), Rating(str_rating_name), d_random_price, i_random_copies);
+			Game game = Game(i_random_id, str_game_name, Genre(str_genre_name), Rating(str_rating_name), obj_random_price, i_random_copies);
 
 			Assert::AreEqual(i_random_id, game.get_id());
 			Assert::AreEqual(str_game_name, game.get_name());
-			Assert::AreEqual(d_random_price, game.get_price());
+			Assert::AreEqual(obj_random_price.get_cents(), game.get_price().get_cents());
 			Assert::AreEqual(i_random_copies, game.get_copies());
 			Assert::AreEqual(str_genre_name, game.get_genre().get_genre());
 			Assert::AreEqual(str_rating_name, game.get_rating().get_rating());
@@ -77,7 +77,7 @@ namespace GameStockTests
 		}
 
 		TEST_METHOD(get_price) {
-			Assert::AreEqual(obj_game.get_price(), d_random_price);
+			Assert::AreEqual(obj_game.get_price().get_cents(), obj_random_price.get_cents());
 		}
 
 		TEST_METHOD(get_copies) {
@@ -117,11 +117,11 @@ namespace GameStockTests
 		}
 
 		TEST_METHOD(set_price) {
-			double d_random_set_price = test_util::generate_random_double_range(100, 300);
+			Money obj_random_set_price = test_util::generate_random_money_range(10000, 30000);
 
-			obj_game.set_price(d_random_set_price);
+			obj_game.set_price(obj_random_set_price);
 
-			Assert::AreEqual(obj_game.get_price(), d_random_set_price);
+			Assert::AreEqual(obj_game.get_price().get_cents(), obj_random_set_price.get_cents());
 		}
 
 		TEST_METHOD(set_copies) {
@@ -0,0 +1,76 @@
+#include "CppUnitTest.h"
+#include "Money.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(MoneyTests)
+	{
+	public:
+		int i_random_cents = test_util::generate_random_int_range(1, 100000);
+		int i_random_count = test_util::generate_random_int_range(1, 60);
+
+		Money obj_money = Money(i_random_cents);
+
+		TEST_METHOD(default_constructor_test) {
+			Money money;
+
+			Assert::AreEqual((std::int64_t)0, money.get_cents());
+		}
+
+		TEST_METHOD(constructor_test_1_param) {
+			Money money(i_random_cents);
+
+			Assert::AreEqual((std::int64_t)i_random_cents, money.get_cents());
+		}
+
+		TEST_METHOD(from_decimal) {
+			// 15.49 and 0.29 are not exact as doubles, so would truncate to 1548/28 without rounding
+			Assert::AreEqual((std::int64_t)1549, Money::from_decimal(15.49).get_cents());
+			Assert::AreEqual((std::int64_t)29, Money::from_decimal(0.29).get_cents());
+			Assert::AreEqual((std::int64_t)2100, Money::from_decimal(21.0).get_cents());
+		}
+
+		TEST_METHOD(to_decimal) {
+			Assert::AreEqual(15.49, Money(1549).to_decimal());
+		}
+
+		TEST_METHOD(get_before_vat) {
+			Assert::AreEqual((std::int64_t)800, Money(1000).get_before_vat().get_cents());
+			Assert::AreEqual((std::int64_t)1239, Money(1549).get_before_vat().get_cents());
+		}
+
+		TEST_METHOD(divide_by) {
+			Assert::AreEqual((std::int64_t)7500, Money(15000).divide_by(2).get_cents());
+			Assert::AreEqual((std::int64_t)333, Money(1000).divide_by(3).get_cents());
+			Assert::AreEqual((std::int64_t)667, Money(2000).divide_by(3).get_cents());
+		}
+
+		TEST_METHOD(divide_by_zero) {
+			Assert::AreEqual((std::int64_t)0, obj_money.divide_by(0).get_cents());
+		}
+
+		TEST_METHOD(operators) {
+			Money money_sum = obj_money + Money(100);
+			Money money_product = obj_money * i_random_count;
+
+			Assert::AreEqual((std::int64_t)i_random_cents + 100, money_sum.get_cents());
+			Assert::AreEqual((std::int64_t)i_random_cents, (money_sum - Money(100)).get_cents());
+			Assert::AreEqual((std::int64_t)i_random_cents * i_random_count, money_product.get_cents());
+			Assert::IsTrue(obj_money < money_sum);
+			Assert::IsTrue(obj_money == Money(i_random_cents));
+		}
+
+		TEST_METHOD(sum_is_exact) {
+			// Summing 0.10 ten times as a double does not equal 1.00, as cents it does
+			Money money_total;
+			for (int i = 0; i < 10; i++) {
+				money_total += Money::from_decimal(0.10);
+			}
+
+			Assert::AreEqual((std::int64_t)100, money_total.get_cents());
+		}
+	};
+}
@@ -0,0 +1,127 @@
+#include "CppUnitTest.h"
+#include "PurchaseCursor.h"
+#include "PurchaseManager.h"
+#include "DatabaseManager.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(PurchaseCursorTests)
+	{
+	public:
+		DatabaseManager obj_db_manager;
+		std::string test_database_name = "testCursorDatabase.db";
+		PurchaseManager obj_purchase_manager = PurchaseManager(NULL);
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			char* errorMessage;
+			obj_db_manager.connect(test_database_name);
+			obj_db_manager.create_tables_if_not_exist();
+			obj_db_manager.insert_initial();
+			obj_purchase_manager = PurchaseManager(obj_db_manager.get_database());
+
+			// Purchase 3 has no items, so checks a purchase is still returned without any. Purchase 1 was made on 2021-03-04 and purchases 2 and 3
+			// on 2021-04-02, so they are returned newest first as 2, 3, 1 with the purchases on the same date in id order
+			std::string str_insert_sql =
+				"INSERT INTO game_snapshots(id, name, genre, rating) VALUES(1, 'Test Game 1', '1', '1'), (2, 'Test Game 2', '1', '1'), (3, 'Test Game 3', '1', '1'), (4, 'Test Game 4', '1', '1');" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 5000, 1614852672);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(1, 1, 1000, 3);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(1, 2, 1000, 2);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 10000, 1617321600);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(2, 3, 500, 8);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(2, 4, 500, 12);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 0, 1617321600);";
+
+			sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
+		}
+
+		TEST_METHOD(next_without_items) {
+			// Arrange
+			User user;
+			user.set_id(2);
+			Purchase purchase;
+			std::vector<int> vec_expected_ids = { 2, 3, 1 };
+			int i_count = 0;
+
+			// Act
+			PurchaseCursor obj_cursor = obj_purchase_manager.open_purchase_cursor(user);
+
+			// Assert
+			while (obj_cursor.next(purchase)) {
+				Assert::AreEqual(vec_expected_ids[i_count], purchase.get_id());
+				Assert::AreEqual(0, (int)purchase.get_vec_purchase_items().size());
+				i_count++;
+			}
+
+			Assert::AreEqual(3, i_count);
+		}
+
+		TEST_METHOD(next_with_items) {
+			// Arrange
+			User user;
+			user.set_id(2);
+			Purchase purchase;
+
+			// Act
+			PurchaseCursor obj_cursor = obj_purchase_manager.open_purchase_cursor(user, true);
+
+			// Assert, each purchase only has it's own items
+			Assert::IsTrue(obj_cursor.next(purchase));
+			Assert::AreEqual(2, purchase.get_id());
+			Assert::AreEqual(2, (int)purchase.get_vec_purchase_items().size());
+			Assert::AreEqual(20, purchase.get_total_game_copies());
+			Assert::AreEqual(std::string("Test Game 3"), purchase.get_vec_purchase_items()[0].get_game().get_name());
+
+			Assert::IsTrue(obj_cursor.next(purchase));
+			Assert::AreEqual(3, purchase.get_id());
+			Assert::AreEqual(0, (int)purchase.get_vec_purchase_items().size());
+
+			Assert::IsTrue(obj_cursor.next(purchase));
+			Assert::AreEqual(1, purchase.get_id());
+			Assert::AreEqual(2, (int)purchase.get_vec_purchase_items().size());
+			Assert::AreEqual(5, purchase.get_total_game_copies());
+
+			Assert::IsFalse(obj_cursor.next(purchase));
+			Assert::IsFalse(obj_cursor.next(purchase));
+		}
+
+		TEST_METHOD(next_no_purchases) {
+			// Arrange
+			User user;
+			user.set_id(1);
+			Purchase purchase;
+
+			// Act
+			PurchaseCursor obj_cursor = obj_purchase_manager.open_purchase_cursor(user, true);
+
+			// Assert
+			Assert::IsFalse(obj_cursor.next(purchase));
+		}
+
+		TEST_METHOD(move_cursor) {
+			// Arrange
+			User user;
+			user.set_id(2);
+			Purchase purchase;
+			PurchaseCursor obj_cursor = obj_purchase_manager.open_purchase_cursor(user, true);
+			obj_cursor.next(purchase);
+
+			// Act, the moved to cursor carries on from where the original was
+			PurchaseCursor obj_moved_cursor = std::move(obj_cursor);
+
+			// Assert
+			Assert::IsFalse(obj_cursor.next(purchase));
+			Assert::IsTrue(obj_moved_cursor.next(purchase));
+			Assert::AreEqual(3, purchase.get_id());
+		}
+
+		TEST_METHOD_CLEANUP(cleanup_test) {
+			sqlite3_close_v2(obj_db_manager.get_database());
+
+			if (std::filesystem::exists("database\\testCursorDatabase.db")) {
+				std::filesystem::remove("database\\testCursorDatabase.db");
+			}
+		}
+	};
+}
@@ -0,0 +1,190 @@
+#include "CppUnitTest.h"
+#include "PurchaseExportWriter.h"
+#include <sstream>
+#include <cstring>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(PurchaseExportWriterTests)
+	{
+	public:
+		PurchaseExportRow create_row(int i_purchase_id, std::string str_game_name, int i_count, Money obj_price) {
+			PurchaseExportRow obj_row;
+			obj_row.i_purchase_id = i_purchase_id;
+			obj_row.i_user_id = 2;
+			obj_row.ll_date = 1614852672;
+			obj_row.str_date = "2021-03-04T10:11:12Z";
+			obj_row.str_game_name = str_game_name;
+			obj_row.str_game_genre = "Action";
+			obj_row.str_game_rating = "16";
+			obj_row.i_count = i_count;
+			obj_row.obj_price = obj_price;
+			obj_row.obj_total = obj_price * i_count;
+			return obj_row;
+		}
+
+		std::string write_export(PurchaseExportWriter& obj_writer, std::vector<PurchaseExportRow> vec_rows) {
+			std::ostringstream ss_export;
+			obj_writer.begin(ss_export);
+			for (PurchaseExportRow& obj_row : vec_rows) {
+				obj_writer.write_row(obj_row);
+			}
+			obj_writer.end();
+
+			return ss_export.str();
+		}
+
+		std::uint64_t read_le(const std::string& str_data, size_t i_offset, int i_bytes) {
+			std::uint64_t ll_value = 0;
+			for (int i = i_bytes - 1; i >= 0; i--) {
+				ll_value = (ll_value << 8) | (unsigned char)str_data[i_offset + i];
+			}
+			return ll_value;
+		}
+
+		TEST_METHOD(create) {
+			Assert::AreEqual(std::string(".csv"), PurchaseExportWriter::create(PurchaseExportFormat::Csv)->get_file_extension());
+			Assert::AreEqual(std::string(".ndjson"), PurchaseExportWriter::create(PurchaseExportFormat::Ndjson)->get_file_extension());
+			Assert::AreEqual(std::string(".gspc"), PurchaseExportWriter::create(PurchaseExportFormat::Columnar)->get_file_extension());
+			Assert::IsTrue(PurchaseExportWriter::create(PurchaseExportFormat::Columnar)->is_binary());
+			Assert::IsFalse(PurchaseExportWriter::create(PurchaseExportFormat::Csv)->is_binary());
+		}
+
+		TEST_METHOD(csv) {
+			CsvPurchaseExportWriter obj_writer;
+
+			std::string str_export = write_export(obj_writer, { create_row(1, "Rogue Legacy 2", 2, Money(1549)), create_row(2, "Game, \"Deluxe\"", 1, Money(5)) });
+
+			Assert::AreEqual(std::string(
+				"purchase_id,user_id,date,game_name,game_genre,game_rating,count,price,total\n"
+				"1,2,2021-03-04T10:11:12Z,Rogue Legacy 2,Action,16,2,15.49,30.98\n"
+				"2,2,2021-03-04T10:11:12Z,\"Game, \"\"Deluxe\"\"\",Action,16,1,0.05,0.05\n"), str_export);
+			Assert::AreEqual((std::int64_t)str_export.size(), obj_writer.get_bytes_written());
+		}
+
+		TEST_METHOD(ndjson) {
+			NdjsonPurchaseExportWriter obj_writer;
+
+			std::string str_export = write_export(obj_writer, { create_row(1, "Quote \" slash \\ tab \t\x01", 1, Money(-1250)) });
+
+			Assert::AreEqual(std::string(
+				"{\"purchase_id\":1,\"user_id\":2,\"date\":\"2021-03-04T10:11:12Z\",\"game_name\":\"Quote \\\" slash \\\\ tab \\t\\u0001\","
+				"\"game_genre\":\"Action\",\"game_rating\":\"16\",\"count\":1,\"price\":-12.50,\"total\":-12.50}\n"), str_export);
+		}
+
+		TEST_METHOD(large_export_written_in_blocks) {
+			// Arrange, enough rows for the buffer to be written several times
+			CsvPurchaseExportWriter obj_writer;
+			std::vector<PurchaseExportRow> vec_rows;
+			for (int i = 1; i <= 20000; i++) {
+				vec_rows.push_back(create_row(i, "Game " + std::to_string(i), i % 7 + 1, Money(i)));
+			}
+
+			// Act
+			std::string str_export = write_export(obj_writer, vec_rows);
+
+			// Assert
+			Assert::AreEqual(20001, (int)std::count(str_export.begin(), str_export.end(), '\n'));
+			Assert::AreEqual((std::int64_t)str_export.size(), obj_writer.get_bytes_written());
+			Assert::IsTrue(str_export.find("\n20000,2,2021-03-04T10:11:12Z,Game 20000,Action,16,2,200.00,400.00\n") != std::string::npos);
+		}
+
+		TEST_METHOD(columnar) {
+			// Arrange
+			ColumnarPurchaseExportWriter obj_writer;
+
+			// Act
+			std::string str_export = write_export(obj_writer, { create_row(1, "Rogue Legacy 2", 2, Money(1549)), create_row(7, "Hades", 3, Money(2099)) });
+
+			// Assert, header and trailer
+			size_t i_trailer = str_export.size() - ColumnarPurchaseExportWriter::TRAILER_SIZE;
+			Assert::AreEqual(std::string("GSPC"), str_export.substr(0, 4));
+			Assert::AreEqual((std::uint64_t)ColumnarPurchaseExportWriter::VERSION, read_le(str_export, 4, 4));
+			Assert::AreEqual((std::uint64_t)9, read_le(str_export, 8, 4));
+			Assert::AreEqual((std::uint64_t)ColumnarPurchaseExportWriter::ROW_GROUP_SIZE, read_le(str_export, 16, 8));
+			Assert::AreEqual((std::uint64_t)2, read_le(str_export, i_trailer + 8, 8));
+			Assert::AreEqual((std::uint64_t)1, read_le(str_export, i_trailer + 16, 8));
+			Assert::AreEqual(std::string("GSPC"), str_export.substr(i_trailer + 24, 4));
+			Assert::AreEqual((size_t)0, str_export.size() % 8);
+
+			// The single row group holds both rows, and every column is aligned and within the file
+			size_t i_index = (size_t)read_le(str_export, i_trailer, 8);
+			Assert::AreEqual((std::uint64_t)2, read_le(str_export, i_index, 8));
+			for (size_t i = 0; i < 9; i++) {
+				std::uint64_t ll_offset = read_le(str_export, i_index + 8 + i * 16, 8);
+				std::uint64_t ll_length = read_le(str_export, i_index + 16 + i * 16, 8);
+
+				Assert::AreEqual((std::uint64_t)0, ll_offset % 8);
+				Assert::IsTrue(ll_offset + ll_length <= i_index);
+			}
+
+			// purchase_id is the first column, Int32
+			size_t i_entry = ColumnarPurchaseExportWriter::HEADER_SIZE;
+			size_t i_offset = (size_t)read_le(str_export, i_index + 8, 8);
+			Assert::AreEqual(std::string("purchase_id"), std::string(str_export.c_str() + i_entry));
+			Assert::AreEqual((std::uint64_t)ColumnarType::Int32, read_le(str_export, i_entry + 24, 4));
+			Assert::AreEqual((std::uint64_t)8, read_le(str_export, i_index + 16, 8));
+			Assert::AreEqual((std::uint64_t)1, read_le(str_export, i_offset, 4));
+			Assert::AreEqual((std::uint64_t)7, read_le(str_export, i_offset + 4, 4));
+
+			// game_name is the fourth column, String
+			i_entry = ColumnarPurchaseExportWriter::HEADER_SIZE + 3 * ColumnarPurchaseExportWriter::COLUMN_ENTRY_SIZE;
+			i_offset = (size_t)read_le(str_export, i_index + 8 + 3 * 16, 8);
+			size_t i_bytes = i_offset + 3 * 8;
+			Assert::AreEqual(std::string("game_name"), std::string(str_export.c_str() + i_entry));
+			Assert::AreEqual((std::uint64_t)ColumnarType::String, read_le(str_export, i_entry + 24, 4));
+			Assert::AreEqual(std::string("Rogue Legacy 2"), str_export.substr(i_bytes + read_le(str_export, i_offset, 8), read_le(str_export, i_offset + 8, 8) - read_le(str_export, i_offset, 8)));
+			Assert::AreEqual(std::string("Hades"), str_export.substr(i_bytes + read_le(str_export, i_offset + 8, 8), read_le(str_export, i_offset + 16, 8) - read_le(str_export, i_offset + 8, 8)));
+
+			// total is the last column, Int64 cents
+			i_entry = ColumnarPurchaseExportWriter::HEADER_SIZE + 8 * ColumnarPurchaseExportWriter::COLUMN_ENTRY_SIZE;
+			i_offset = (size_t)read_le(str_export, i_index + 8 + 8 * 16, 8);
+			Assert::AreEqual(std::string("total"), std::string(str_export.c_str() + i_entry));
+			Assert::AreEqual((std::uint64_t)16, read_le(str_export, i_index + 16 + 8 * 16, 8));
+			Assert::AreEqual((std::uint64_t)3098, read_le(str_export, i_offset, 8));
+			Assert::AreEqual((std::uint64_t)6297, read_le(str_export, i_offset + 8, 8));
+		}
+
+		TEST_METHOD(columnar_row_groups) {
+			// Arrange, enough rows to fill one row group and start another
+			ColumnarPurchaseExportWriter obj_writer;
+			std::vector<PurchaseExportRow> vec_rows;
+			int i_rows = (int)ColumnarPurchaseExportWriter::ROW_GROUP_SIZE + 10;
+			for (int i = 1; i <= i_rows; i++) {
+				vec_rows.push_back(create_row(i, "Game " + std::to_string(i), 1, Money(i)));
+			}
+
+			// Act
+			std::string str_export = write_export(obj_writer, vec_rows);
+
+			// Assert
+			size_t i_trailer = str_export.size() - ColumnarPurchaseExportWriter::TRAILER_SIZE;
+			size_t i_index = (size_t)read_le(str_export, i_trailer, 8);
+			size_t i_index_entry_size = 8 + 9 * 16;
+			Assert::AreEqual((std::uint64_t)i_rows, read_le(str_export, i_trailer + 8, 8));
+			Assert::AreEqual((std::uint64_t)2, read_le(str_export, i_trailer + 16, 8));
+			Assert::AreEqual(i_index + 2 * i_index_entry_size, i_trailer);
+			Assert::AreEqual((std::uint64_t)ColumnarPurchaseExportWriter::ROW_GROUP_SIZE, read_le(str_export, i_index, 8));
+			Assert::AreEqual((std::uint64_t)10, read_le(str_export, i_index + i_index_entry_size, 8));
+
+			// The second row group carries on from the first, its first purchase id is the one after the full group
+			size_t i_offset = (size_t)read_le(str_export, i_index + i_index_entry_size + 8, 8);
+			Assert::AreEqual((std::uint64_t)ColumnarPurchaseExportWriter::ROW_GROUP_SIZE + 1, read_le(str_export, i_offset, 4));
+			Assert::AreEqual((std::int64_t)str_export.size(), obj_writer.get_bytes_written());
+		}
+
+		TEST_METHOD(columnar_empty) {
+			ColumnarPurchaseExportWriter obj_writer;
+
+			std::string str_export = write_export(obj_writer, {});
+
+			size_t i_trailer = str_export.size() - ColumnarPurchaseExportWriter::TRAILER_SIZE;
+			Assert::AreEqual(std::string("GSPC"), str_export.substr(0, 4));
+			Assert::AreEqual((std::uint64_t)0, read_le(str_export, i_trailer + 8, 8));
+			Assert::AreEqual((std::uint64_t)0, read_le(str_export, i_trailer + 16, 8));
+			Assert::AreEqual((std::int64_t)str_export.size(), obj_writer.get_bytes_written());
+		}
+	};
+}
@@ -17,55 +17,55 @@ namespace GameStockTests
 		int i_random_purchase_id= test_util::generate_random_int_range(1, 1000);
 		int i_random_game_id= test_util::generate_random_int_range(1, 1000);
 		int i_random_count = test_util::generate_random_int_range(1, 60);
-		double d_random_price = test_util::generate_random_double_range(1, 1000);
-		double d_random_total = test_util::generate_random_double_range(1, 1000);
+		Money obj_random_price = test_util::generate_random_money_range(100, 100000);
+		Money obj_random_total = test_util::generate_random_money_range(100, 100000);
 
-		PurchaseItem obj_purchase_item = PurchaseItem(i_random_id, i_random_purchase_id, i_random_game_id, Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name)), i_random_count, d_random_price);
+		PurchaseItem obj_purchase_item = PurchaseItem(i_random_id, i_random_purchase_id, i_random_game_id, Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name)), i_random_count, obj_random_price);
 
 		TEST_METHOD(constructor_test_3_param) {
-			PurchaseItem purchase_item(i_random_game_id, i_random_count, d_random_price);
+			PurchaseItem purchase_item(i_random_game_id, i_random_count, obj_random_price);
 
 			Assert::AreEqual(0, purchase_item.get_id());
 			Assert::AreEqual(i_random_game_id, purchase_item.get_game_id());
 			Assert::AreEqual(0, purchase_item.get_purchase_id());
 			Assert::AreEqual(i_random_count, purchase_item.get_count());
-			Assert::AreEqual(d_random_price, purchase_item.get_price());
-			Assert::AreEqual((double)i_random_count * d_random_price, purchase_item.get_total());
+			Assert::AreEqual(obj_random_price.get_cents(), purchase_item.get_price().get_cents());
+			Assert::AreEqual(obj_random_price.get_cents() * i_random_count, purchase_item.get_total().get_cents());
 		}
 
 		TEST_METHOD(constructor_test_4_param) {
-			PurchaseItem purchase_item(i_random_game_id, Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name)), i_random_count, d_random_price);
+			PurchaseItem purchase_item(i_random_game_id, Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name)), i_random_count, obj_random_price);
 
 			Assert::AreEqual(0, purchase_item.get_id());
 			Assert::AreEqual(i_random_game_id, purchase_item.get_game_id());
 			Assert::AreEqual(0, purchase_item.get_purchase_id());
 			Assert::AreEqual(i_random_count, purchase_item.get_count());
-			Assert::AreEqual(d_random_price, purchase_item.get_price());
-			Assert::AreEqual((double)i_random_count * d_random_price, purchase_item.get_total());
+			Assert::AreEqual(obj_random_price.get_cents(), purchase_item.get_price().get_cents());
+			Assert::AreEqual(obj_random_price.get_cents() * i_random_count, purchase_item.get_total().get_cents());
 			Assert::AreEqual(str_game_name, purchase_item.get_game().get_name());
 		}
 
 		TEST_METHOD(constructor_test_6_param) {
-			PurchaseItem purchase_item(i_random_id, i_random_purchase_id, i_random_game_id, Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name)), i_random_count, d_random_price);
+			PurchaseItem purchase_item(i_random_id, i_random_purchase_id, i_random_game_id, Game(str_game_name, Genre(str_genre_name), Rating(str_rating_name)), i_random_count, obj_random_price);
 
 			Assert::AreEqual(i_random_id, purchase_item.get_id());
 			Assert::AreEqual(i_random_game_id, purchase_item.get_game_id());
 			Assert::AreEqual(i_random_purchase_id, purchase_item.get_purchase_id());
 			Assert::AreEqual(i_random_count, purchase_item.get_count());
-			Assert::AreEqual(d_random_price, purchase_item.get_price());
-			Assert::AreEqual((double)i_random_count * d_random_price, purchase_item.get_total());
+			Assert::AreEqual(obj_random_price.get_cents(), purchase_item.get_price().get_cents());
+			Assert::AreEqual(obj_random_price.get_cents() * i_random_count, purchase_item.get_total().get_cents());
 			Assert::AreEqual(str_game_name, purchase_item.get_game().get_name());
 		}
 
 		TEST_METHOD(constructor_test_7_param) {
-			PurchaseItem purchase_item(i_random_id, str_game_name, d_random_price, str_genre_name, str_rating_name, i_random_count, d_random_total);
+			PurchaseItem purchase_item(i_random_id, str_game_name, obj_random_price, str_genre_name, str_rating_name, i_random_count, obj_random_total);
 
 			Assert::AreEqual(i_random_id, purchase_item.get_id());
 			Assert::AreEqual(0, purchase_item.get_game_id());
 			Assert::AreEqual(0, purchase_item.get_purchase_id());
 			Assert::AreEqual(i_random_count, purchase_item.get_count());
-			Assert::AreEqual(d_random_price, purchase_item.get_price());
-			Assert::AreEqual(d_random_total, purchase_item.get_total());
+			Assert::AreEqual(obj_random_price.get_cents(), purchase_item.get_price().get_cents());
+			Assert::AreEqual(obj_random_total.get_cents(), purchase_item.get_total().get_cents());
 			Assert::AreEqual(str_game_name, purchase_item.get_game().get_name());
 			Assert::AreEqual(str_genre_name, purchase_item.get_game().get_genre().get_genre());
 			Assert::AreEqual(str_rating_name, purchase_item.get_game().get_rating().get_rating());
@@ -88,15 +88,15 @@ namespace GameStockTests
 		}
 
 		TEST_METHOD(get_price) {
-			Assert::AreEqual(obj_purchase_item.get_price(), d_random_price);
+			Assert::AreEqual(obj_purchase_item.get_price().get_cents(), obj_random_price.get_cents());
 		}
 
 		TEST_METHOD(get_total) {
-			Assert::AreEqual(obj_purchase_item.get_total(), (double)i_random_count * d_random_price);
+			Assert::AreEqual(obj_purchase_item.get_total().get_cents(), obj_random_price.get_cents() * i_random_count);
 		}
 
 		TEST_METHOD(get_total_before_vat) {
-			Assert::AreEqual(obj_purchase_item.get_total_before_vat(), ((double)i_random_count * d_random_price) * 0.8);
+			Assert::AreEqual(obj_purchase_item.get_total_before_vat().get_cents(), (obj_random_price * i_random_count).get_before_vat().get_cents());
 		}
 
 		TEST_METHOD(get_count) {
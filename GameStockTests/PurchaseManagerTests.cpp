@@ -2,6 +2,9 @@
 #include "PurchaseManager.h"
 #include "DatabaseManager.h"
 #include "TestUtilities.h"
+#include <chrono>
+#include <sstream>
+#include <algorithm>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -22,12 +25,13 @@ namespace GameStockTests
 			obj_purchase_manager = PurchaseManager(obj_db_manager.get_database());
 
 			std::string str_insert_sql =
+				"INSERT INTO game_snapshots(id, name, genre, rating) VALUES(1, 'Test Game 1', '1', '1'), (2, 'Test Game 2', '1', '1'), (3, 'Test Game 3', '1', '1'), (4, 'Test Game 4', '1', '1');" \
 				"INSERT INTO purchases(user_id, total) VALUES (2, 5000);" \
-				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(1, 'Test Game 1', 1000, 1, 1, 3);" \
-				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(1, 'Test Game 2', 1000, 1, 1, 2);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(1, 1, 1000, 3);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(1, 2, 1000, 2);" \
 				"INSERT INTO purchases(user_id, total) VALUES (2, 10000);" \
-				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(2, 'Test Game 3', 500, 1, 1, 8);" \
-				"INSERT INTO purchase_items(purchase_id, game_name, game_price, game_genre, game_rating, count) VALUES(2, 'Test Game 4', 500, 1, 1, 12);";
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(2, 3, 500, 8);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(2, 4, 500, 12);";
 
 			sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
 		}
@@ -59,7 +63,7 @@ namespace GameStockTests
 
 		TEST_METHOD(populate_purchase_details) {
 			// Arrange
-			Purchase purchase(2, 10000, "Some date");
+			Purchase purchase(2, Money(10000), "Some date");
 
 			// Act
 			obj_purchase_manager.populate_purchase_details(purchase);
@@ -68,6 +72,220 @@ namespace GameStockTests
 			Assert::AreEqual(2, (int)purchase.get_vec_purchase_items().size());
 		}
 
+		TEST_METHOD(fetch_purchases_with_details) {
+			// Arrange
+			User user;
+			user.set_id(2);
+
+			// Act
+			obj_purchase_manager.fetch_purchases_with_details(user);
+			std::vector<Purchase>& vec_purchases = obj_purchase_manager.get_vec_purchases();
+
+			// Assert
+			Assert::AreEqual(2, (int)vec_purchases.size());
+			Assert::AreEqual(1, vec_purchases[0].get_id());
+			Assert::AreEqual(2, (int)vec_purchases[0].get_vec_purchase_items().size());
+			Assert::AreEqual(std::string("Test Game 2"), vec_purchases[0].get_vec_purchase_items()[1].get_game().get_name());
+			Assert::AreEqual(2, (int)vec_purchases[1].get_vec_purchase_items().size());
+			Assert::AreEqual(25, obj_purchase_manager.get_total_game_copies());
+		}
+
+		TEST_METHOD(fetch_purchase_page) {
+			// Arrange, purchases 5, 6 and 7 share a date so are ordered by id
+			char* errorMessage;
+			User user;
+			user.set_id(1);
+			std::string str_insert_sql =
+				"INSERT INTO purchases(user_id, total, date) VALUES (1, 100, 100);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (1, 100, 300);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (1, 100, 200);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (1, 100, 200);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (1, 100, 200);";
+			sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act
+			PurchasePage page_1 = obj_purchase_manager.fetch_purchase_page(user, 2);
+			PurchasePage page_2 = obj_purchase_manager.fetch_purchase_page(user, 2, page_1.get_next_key());
+			PurchasePage page_3 = obj_purchase_manager.fetch_purchase_page(user, 2, page_2.get_next_key());
+
+			// Assert
+			Assert::AreEqual(2, (int)page_1.get_vec_purchases().size());
+			Assert::AreEqual(4, page_1.get_vec_purchases()[0].get_id());
+			Assert::AreEqual(5, page_1.get_vec_purchases()[1].get_id());
+			Assert::AreEqual(std::string("1970-01-01 00:05:00"), page_1.get_vec_purchases()[0].get_date());
+			Assert::IsTrue(page_1.get_has_more());
+
+			Assert::AreEqual(6, page_2.get_vec_purchases()[0].get_id());
+			Assert::AreEqual(7, page_2.get_vec_purchases()[1].get_id());
+			Assert::IsTrue(page_2.get_has_more());
+
+			Assert::AreEqual(1, (int)page_3.get_vec_purchases().size());
+			Assert::AreEqual(3, page_3.get_vec_purchases()[0].get_id());
+			Assert::IsFalse(page_3.get_has_more());
+		}
+
+		TEST_METHOD(fetch_purchase_page_exact_size) {
+			// Arrange
+			User user;
+			user.set_id(2);
+
+			// Act
+			PurchasePage page = obj_purchase_manager.fetch_purchase_page(user, 2);
+
+			// Assert
+			Assert::AreEqual(2, (int)page.get_vec_purchases().size());
+			Assert::IsFalse(page.get_has_more());
+		}
+
+		TEST_METHOD(fetch_purchase_page_invalid_size) {
+			User user;
+			user.set_id(2);
+
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_purchase_manager.fetch_purchase_page(user, 0);
+				});
+		}
+
+		TEST_METHOD(fetch_purchases_with_details_no_items) {
+			// Arrange
+			char* errorMessage;
+			User user;
+			user.set_id(1);
+			sqlite3_exec(obj_db_manager.get_database(), "INSERT INTO purchases(user_id, total) VALUES (1, 0);", NULL, NULL, &errorMessage);
+
+			// Act
+			obj_purchase_manager.fetch_purchases_with_details(user);
+
+			// Assert
+			Assert::AreEqual(1, (int)obj_purchase_manager.get_vec_purchases().size());
+			Assert::AreEqual(0, (int)obj_purchase_manager.get_vec_purchases()[0].get_vec_purchase_items().size());
+		}
+
+		TEST_METHOD(fetch_purchases_with_details_benchmark) {
+			// Arrange, a customer with 2000 purchases of 3 items each
+			char* errorMessage;
+			User user;
+			user.set_id(1);
+			sqlite3_exec(obj_db_manager.get_database(), "BEGIN TRANSACTION;", NULL, NULL, &errorMessage);
+			for (int i = 0; i < 2000; i++) {
+				std::string str_insert_sql =
+					"INSERT INTO purchases(user_id, total) VALUES (1, 6000);" \
+					"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(last_insert_rowid(), 1, 1000, 1);" \
+					"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) SELECT purchase_id, 2, 1000, 2 FROM purchase_items WHERE id = last_insert_rowid();" \
+					"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) SELECT purchase_id, 3, 1000, 3 FROM purchase_items WHERE id = last_insert_rowid();";
+				sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
+			}
+			sqlite3_exec(obj_db_manager.get_database(), "COMMIT TRANSACTION;", NULL, NULL, &errorMessage);
+
+			// Act, current path of one query per purchase
+			auto time_start = std::chrono::steady_clock::now();
+			obj_purchase_manager.fetch_purchases(user);
+			for (Purchase& purchase : obj_purchase_manager.get_vec_purchases()) {
+				obj_purchase_manager.populate_purchase_details(purchase);
+			}
+			auto time_per_purchase = std::chrono::steady_clock::now() - time_start;
+			int i_per_purchase_copies = obj_purchase_manager.get_total_game_copies();
+			int i_per_purchase_count = (int)obj_purchase_manager.get_vec_purchases().size();
+
+			// Act, single query
+			time_start = std::chrono::steady_clock::now();
+			obj_purchase_manager.fetch_purchases_with_details(user);
+			auto time_single_query = std::chrono::steady_clock::now() - time_start;
+
+			std::string str_message = "fetch_purchases + populate_purchase_details: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(time_per_purchase).count()) + "us, " +
+				"fetch_purchases_with_details: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(time_single_query).count()) + "us";
+			Logger::WriteMessage(str_message.c_str());
+
+			// Assert, both paths load the same purchases
+			Assert::AreEqual(2000, i_per_purchase_count);
+			Assert::AreEqual(i_per_purchase_count, (int)obj_purchase_manager.get_vec_purchases().size());
+			Assert::AreEqual(12000, i_per_purchase_copies);
+			Assert::AreEqual(i_per_purchase_copies, obj_purchase_manager.get_total_game_copies());
+		}
+
+		TEST_METHOD(get_user_purchase_stats) {
+			// Arrange
+			User user;
+			user.set_id(2);
+
+			// Act
+			UserPurchaseSummary obj_stats = obj_purchase_manager.get_user_purchase_stats(user);
+
+			// Assert
+			Assert::AreEqual(2, obj_stats.get_purchase_count());
+			Assert::AreEqual((std::int64_t)15000, obj_stats.get_total().get_cents());
+			Assert::AreEqual((std::int64_t)7500, obj_stats.get_average().get_cents());
+			Assert::AreEqual(25, obj_stats.get_total_game_copies());
+		}
+
+		TEST_METHOD(get_user_purchase_stats_no_purchases) {
+			// Arrange
+			User user;
+			user.set_id(1);
+
+			// Act
+			UserPurchaseSummary obj_stats = obj_purchase_manager.get_user_purchase_stats(user);
+
+			// Assert
+			Assert::AreEqual(1, obj_stats.get_user_id());
+			Assert::AreEqual(0, obj_stats.get_purchase_count());
+			Assert::AreEqual((std::int64_t)0, obj_stats.get_total().get_cents());
+		}
+
+		TEST_METHOD(get_user_purchase_stats_after_delete) {
+			// Arrange
+			char* errorMessage;
+			User user;
+			user.set_id(2);
+
+			// Act, deleting a purchase also deletes its items
+			sqlite3_exec(obj_db_manager.get_database(), "DELETE FROM purchases WHERE id = 1;", NULL, NULL, &errorMessage);
+			UserPurchaseSummary obj_stats = obj_purchase_manager.get_user_purchase_stats(user);
+
+			// Assert
+			Assert::AreEqual(1, obj_stats.get_purchase_count());
+			Assert::AreEqual((std::int64_t)10000, obj_stats.get_total().get_cents());
+			Assert::AreEqual(20, obj_stats.get_total_game_copies());
+		}
+
+		TEST_METHOD(get_user_purchase_summaries) {
+			// Arrange
+			std::vector<User> vec_users(2);
+			vec_users[0].set_id(2);
+			vec_users[1].set_id(1);
+
+			// Act
+			std::vector<UserPurchaseSummary> vec_summaries = obj_purchase_manager.get_user_purchase_summaries(vec_users);
+
+			// Assert, summaries are in the same order as the users
+			Assert::AreEqual(2, (int)vec_summaries.size());
+			Assert::AreEqual(2, vec_summaries[0].get_user_id());
+			Assert::AreEqual(2, vec_summaries[0].get_purchase_count());
+			Assert::AreEqual((std::int64_t)15000, vec_summaries[0].get_total().get_cents());
+			Assert::AreEqual((std::int64_t)7500, vec_summaries[0].get_average().get_cents());
+			Assert::AreEqual(25, vec_summaries[0].get_total_game_copies());
+			Assert::AreEqual(0, (int)vec_summaries[0].get_vec_purchases().size());
+			Assert::AreEqual(1, vec_summaries[1].get_user_id());
+			Assert::AreEqual(0, vec_summaries[1].get_purchase_count());
+		}
+
+		TEST_METHOD(get_user_purchase_summaries_include_purchases) {
+			// Arrange
+			std::vector<User> vec_users(2);
+			vec_users[0].set_id(1);
+			vec_users[1].set_id(2);
+
+			// Act
+			std::vector<UserPurchaseSummary> vec_summaries = obj_purchase_manager.get_user_purchase_summaries(vec_users, true);
+
+			// Assert
+			Assert::AreEqual(0, (int)vec_summaries[0].get_vec_purchases().size());
+			Assert::AreEqual(2, (int)vec_summaries[1].get_vec_purchases().size());
+			Assert::AreEqual(1, vec_summaries[1].get_vec_purchases()[0].get_id());
+			Assert::AreEqual((std::int64_t)15000, vec_summaries[1].get_total().get_cents());
+			Assert::AreEqual((std::int64_t)7500, vec_summaries[1].get_average().get_cents());
+		}
+
 		TEST_METHOD(get_purchase_grand_total) {
 			// Arrange
 			User user;
@@ -77,7 +295,7 @@ namespace GameStockTests
 			obj_purchase_manager.fetch_purchases(user);
 
 			// Assert
-			Assert::AreEqual((double)15000, obj_purchase_manager.get_purchase_grand_total());
+			Assert::AreEqual((std::int64_t)15000, obj_purchase_manager.get_purchase_grand_total().get_cents());
 		}
 
 		TEST_METHOD(get_purchase_average) {
@@ -89,7 +307,7 @@ namespace GameStockTests
 			obj_purchase_manager.fetch_purchases(user);
 
 			// Assert
-			Assert::AreEqual((double)7500, obj_purchase_manager.get_purchase_average());
+			Assert::AreEqual((std::int64_t)7500, obj_purchase_manager.get_purchase_average().get_cents());
 		}
 
 		TEST_METHOD(get_total_game_copies) {
@@ -125,6 +343,562 @@ namespace GameStockTests
 			Assert::IsTrue(std::filesystem::exists("saves"));
 		}
 
+		TEST_METHOD(queue_report) {
+			// Act
+			std::shared_ptr<ReportJob> ptr_job = obj_purchase_manager.queue_report("TestReport.txt", "purchases", 1, [](ReportJob& obj_job, sqlite3*, std::ostream& os) {
+				os << "Report";
+				obj_job.add_progress(1, 6);
+				});
+
+			// Assert, report is written to the saves directory
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Completed);
+			Assert::IsTrue(std::filesystem::exists(obj_purchase_manager.get_saves_path() / "TestReport.txt"));
+			Assert::AreEqual(1, (int)obj_purchase_manager.get_report_jobs().size());
+			Assert::AreEqual(1, (int)obj_purchase_manager.take_finished_report_jobs().size());
+		}
+
+		TEST_METHOD(get_sales) {
+			// Arrange, purchases on 2021-03-04 (twice), 2021-03-10 and 2021-04-02
+			char* errorMessage;
+			std::string str_insert_sql =
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 1000, 1614852672);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(3, 1, 500, 2);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 2000, 1614890000);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(4, 1, 500, 4);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 4000, 1615334400);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(5, 1, 500, 8);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 8000, 1617321600);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(6, 1, 500, 16);";
+			sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act, from 2021-03-01 to 2021-05-01
+			std::vector<SalesBucket> vec_daily = obj_purchase_manager.get_sales(SalesPeriod::Day, 1614556800, 1619827200);
+			std::vector<SalesBucket> vec_weekly = obj_purchase_manager.get_sales(SalesPeriod::Week, 1614556800, 1619827200);
+			std::vector<SalesBucket> vec_monthly = obj_purchase_manager.get_sales(SalesPeriod::Month, 1614556800, 1619827200);
+
+			// Assert, every period is returned
+			Assert::AreEqual(61, (int)vec_daily.size());
+			Assert::AreEqual(9, (int)vec_weekly.size());
+			Assert::AreEqual(2, (int)vec_monthly.size());
+
+			Assert::AreEqual((std::int64_t)3000, vec_daily[3].get_revenue().get_cents());
+			Assert::AreEqual(6, vec_daily[3].get_units());
+			Assert::AreEqual(2, vec_daily[3].get_orders());
+			Assert::AreEqual(0, vec_daily[4].get_orders());
+
+			Assert::AreEqual((std::int64_t)3000, vec_weekly[0].get_revenue().get_cents());
+			Assert::AreEqual((std::int64_t)4000, vec_weekly[1].get_revenue().get_cents());
+			Assert::AreEqual((std::int64_t)8000, vec_weekly[4].get_revenue().get_cents());
+
+			Assert::AreEqual((std::int64_t)7000, vec_monthly[0].get_revenue().get_cents());
+			Assert::AreEqual(14, vec_monthly[0].get_units());
+			Assert::AreEqual(3, vec_monthly[0].get_orders());
+			Assert::AreEqual((std::int64_t)1617235200, vec_monthly[1].get_start());
+			Assert::AreEqual((std::int64_t)8000, vec_monthly[1].get_revenue().get_cents());
+		}
+
+		TEST_METHOD(get_sales_after_delete) {
+			// Arrange
+			char* errorMessage;
+			std::string str_insert_sql =
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 1000, 1614852672);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(3, 1, 500, 2);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 2000, 1614890000);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count) VALUES(4, 1, 500, 4);";
+			sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
+
+			// Act, delete a purchase along with its items
+			sqlite3_exec(obj_db_manager.get_database(), "DELETE FROM purchases WHERE id = 4;", NULL, NULL, &errorMessage);
+			std::vector<SalesBucket> vec_daily = obj_purchase_manager.get_sales(SalesPeriod::Day, 1614852672, 1614852672 + 1);
+			std::vector<SalesBucket> vec_monthly = obj_purchase_manager.get_sales(SalesPeriod::Month, 1614852672, 1614852672 + 1);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_daily.size());
+			Assert::AreEqual((std::int64_t)1000, vec_daily[0].get_revenue().get_cents());
+			Assert::AreEqual(2, vec_daily[0].get_units());
+			Assert::AreEqual(1, vec_daily[0].get_orders());
+			Assert::AreEqual((std::int64_t)1000, vec_monthly[0].get_revenue().get_cents());
+			Assert::AreEqual(2, vec_monthly[0].get_units());
+		}
+
+		TEST_METHOD(get_sales_empty_range) {
+			Assert::AreEqual(0, (int)obj_purchase_manager.get_sales(SalesPeriod::Day, 1614852672, 1614816000).size());
+		}
+
+		void insert_best_seller_purchases() {
+			// Purchases on 2021-03-04 and 2021-04-02, the purchase items from init_test are not linked to a game so are not counted
+			char* errorMessage;
+			std::string str_insert_sql =
+				"INSERT INTO game_snapshots(id, name, genre, rating) VALUES(5, 'Rogue Legacy 2', 'Action', '16'), (6, 'Fall Guys', 'Action', 'PG'), (7, 'Factorio', 'Strategy', '12');" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 18938, 1614852672);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count, game_id) VALUES(3, 5, 1549, 5, 2);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count, game_id) VALUES(3, 6, 1599, 7, 4);" \
+				"INSERT INTO purchases(user_id, total, date) VALUES (2, 22549, 1617321600);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count, game_id) VALUES(4, 7, 2100, 10, 1);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count, game_id) VALUES(4, 5, 1549, 1, 2);";
+			sqlite3_exec(obj_db_manager.get_database(), str_insert_sql.c_str(), NULL, NULL, &errorMessage);
+		}
+
+		TEST_METHOD(get_best_sellers) {
+			// Arrange
+			insert_best_seller_purchases();
+
+			// Act
+			std::vector<GameSales> vec_best_sellers = obj_purchase_manager.get_best_sellers(2);
+			std::vector<GameSales> vec_all_sellers = obj_purchase_manager.get_best_sellers(10);
+
+			// Assert
+			Assert::AreEqual(2, (int)vec_best_sellers.size());
+			Assert::AreEqual(1, vec_best_sellers[0].get_game_id());
+			Assert::AreEqual(std::string("Factorio"), vec_best_sellers[0].get_game_name());
+			Assert::AreEqual(10, vec_best_sellers[0].get_units());
+			Assert::AreEqual((std::int64_t)21000, vec_best_sellers[0].get_revenue().get_cents());
+			Assert::AreEqual(4, vec_best_sellers[1].get_game_id());
+
+			Assert::AreEqual(3, (int)vec_all_sellers.size());
+			Assert::AreEqual(2, vec_all_sellers[2].get_game_id());
+			Assert::AreEqual(6, vec_all_sellers[2].get_units());
+			Assert::AreEqual((std::int64_t)9294, vec_all_sellers[2].get_revenue().get_cents());
+		}
+
+		TEST_METHOD(get_best_sellers_by_genre) {
+			// Arrange
+			insert_best_seller_purchases();
+
+			// Act, Action
+			std::vector<GameSales> vec_best_sellers = obj_purchase_manager.get_best_sellers_by_genre(2, 5);
+
+			// Assert
+			Assert::AreEqual(2, (int)vec_best_sellers.size());
+			Assert::AreEqual(4, vec_best_sellers[0].get_game_id());
+			Assert::AreEqual(7, vec_best_sellers[0].get_units());
+			Assert::AreEqual((std::int64_t)11193, vec_best_sellers[0].get_revenue().get_cents());
+			Assert::AreEqual(2, vec_best_sellers[1].get_game_id());
+			Assert::AreEqual(0, (int)obj_purchase_manager.get_best_sellers_by_genre(10, 5).size());
+		}
+
+		TEST_METHOD(get_best_sellers_in_period) {
+			// Arrange
+			insert_best_seller_purchases();
+
+			// Act, from 2021-03-01 to 2021-04-01
+			std::vector<GameSales> vec_best_sellers = obj_purchase_manager.get_best_sellers_in_period(1614556800, 1617235200, 5);
+
+			// Assert, Factorio was bought in April so is not included
+			Assert::AreEqual(2, (int)vec_best_sellers.size());
+			Assert::AreEqual(4, vec_best_sellers[0].get_game_id());
+			Assert::AreEqual(2, vec_best_sellers[1].get_game_id());
+			Assert::AreEqual(5, vec_best_sellers[1].get_units());
+		}
+
+		TEST_METHOD(get_best_sellers_after_rename) {
+			// Arrange
+			insert_best_seller_purchases();
+
+			// Act
+			sqlite3_exec(obj_db_manager.get_database(), "UPDATE games SET name = 'Factorio: Space Age' WHERE id = 1;", NULL, NULL, NULL);
+			std::vector<GameSales> vec_best_sellers = obj_purchase_manager.get_best_sellers(1);
+
+			// Assert, the sales are still found by id and reported under the new name
+			Assert::AreEqual(1, vec_best_sellers[0].get_game_id());
+			Assert::AreEqual(std::string("Factorio: Space Age"), vec_best_sellers[0].get_game_name());
+			Assert::AreEqual(10, vec_best_sellers[0].get_units());
+		}
+
+		TEST_METHOD(get_best_sellers_invalid_limit) {
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_purchase_manager.get_best_sellers(0);
+				});
+		}
+
+		TEST_METHOD(get_recommendations) {
+			// Arrange, games 2 and 4 are bought together, then games 1 and 2
+			insert_best_seller_purchases();
+			std::vector<CoPurchase> vec_before = obj_purchase_manager.get_recommendations(2, 5);
+			sqlite3_exec(obj_db_manager.get_database(),
+				"INSERT INTO purchases(user_id, total) VALUES (2, 3148);" \
+				"INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count, game_id) VALUES(5, 5, 1549, 1, 2), (5, 6, 1599, 1, 4);", NULL, NULL, NULL);
+
+			// Act, only the new purchase is added
+			std::vector<CoPurchase> vec_after = obj_purchase_manager.get_recommendations(2, 5);
+
+			// Assert
+			Assert::AreEqual(2, (int)vec_before.size());
+			Assert::AreEqual(1, vec_before[0].i_game_id);
+			Assert::AreEqual(4, vec_before[1].i_game_id);
+			Assert::AreEqual(2, (int)vec_after.size());
+			Assert::AreEqual(4, vec_after[0].i_game_id);
+			Assert::AreEqual(2, vec_after[0].i_purchases);
+			Assert::AreEqual(1, (int)obj_purchase_manager.get_recommendations(4, 5).size());
+		}
+
+		TEST_METHOD(get_recommendations_invalid_limit) {
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_purchase_manager.get_recommendations(2, 0);
+				});
+		}
+
+		TEST_METHOD(get_sales_breakdown) {
+			// Arrange, the purchase items from init_test are all the same genre
+			std::vector<SalesGroup> vec_before = obj_purchase_manager.get_sales_breakdown(SalesDimension::Genre, INT64_MIN, INT64_MAX);
+			insert_best_seller_purchases();
+
+			// Act, only the new items are appended
+			std::vector<SalesGroup> vec_after = obj_purchase_manager.get_sales_breakdown(SalesDimension::Genre, INT64_MIN, INT64_MAX);
+
+			// Assert
+			Assert::AreEqual(1, (int)vec_before.size());
+			Assert::AreEqual((std::int64_t)15000, vec_before[0].obj_revenue.get_cents());
+			Assert::AreEqual(8, (int)obj_purchase_manager.get_sales_store()->get_row_count());
+			Assert::AreEqual(3, (int)vec_after.size());
+			Assert::AreEqual(std::string("Strategy"), vec_after[0].str_label);
+			Assert::AreEqual((std::int64_t)21000, vec_after[0].obj_revenue.get_cents());
+			Assert::AreEqual(std::string("Action"), vec_after[1].str_label);
+			Assert::AreEqual((std::int64_t)20487, vec_after[1].obj_revenue.get_cents());
+			Assert::AreEqual(std::string("1"), vec_after[2].str_label);
+		}
+
+		TEST_METHOD(export_purchases) {
+			// Arrange
+			CsvPurchaseExportWriter obj_writer;
+			std::ostringstream ss_export;
+
+			// Act
+			obj_purchase_manager.export_purchases(obj_writer, ss_export);
+
+			// Assert, a header and a row per purchase item. Both purchases share a date, so are in id order
+			std::string str_export = ss_export.str();
+			Assert::AreEqual(5, (int)std::count(str_export.begin(), str_export.end(), '\n'));
+			Assert::AreEqual(std::string("purchase_id,user_id,date,game_name,game_genre,game_rating,count,price,total\n1,2,"), str_export.substr(0, 80));
+			Assert::IsTrue(str_export.find(",Test Game 4,1,1,12,5.00,60.00\n") != std::string::npos);
+			Assert::AreEqual((std::int64_t)str_export.size(), obj_writer.get_bytes_written());
+		}
+
+		TEST_METHOD(export_purchases_single_user) {
+			// Arrange, user 1 has not made any purchases
+			NdjsonPurchaseExportWriter obj_writer;
+			std::ostringstream ss_user_1_export;
+			std::ostringstream ss_user_2_export;
+
+			// Act
+			obj_purchase_manager.export_purchases(obj_writer, ss_user_1_export, 1);
+			obj_purchase_manager.export_purchases(obj_writer, ss_user_2_export, 2);
+
+			// Assert
+			std::string str_export = ss_user_2_export.str();
+			Assert::AreEqual(std::string(""), ss_user_1_export.str());
+			Assert::AreEqual(4, (int)std::count(str_export.begin(), str_export.end(), '\n'));
+		}
+
+		TEST_METHOD(queue_purchase_export) {
+			// Act
+			std::shared_ptr<ReportJob> ptr_job = obj_purchase_manager.queue_purchase_export("TestExport", PurchaseExportFormat::Columnar);
+
+			// Assert, extension is added and progress is counted in purchases
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Completed);
+			Assert::AreEqual(std::string("TestExport.gspc"), ptr_job->get_file_name());
+			Assert::AreEqual(2, ptr_job->get_units_done());
+			Assert::AreEqual((std::int64_t)std::filesystem::file_size(obj_purchase_manager.get_saves_path() / "TestExport.gspc"), ptr_job->get_bytes_written());
+		}
+
+		TEST_METHOD(queue_purchase_export_purchase_without_items) {
+			// Arrange, a purchase without any items has no rows to export
+			char* errorMessage;
+			sqlite3_exec(obj_db_manager.get_database(), "INSERT INTO purchases(user_id, total, date) VALUES (2, 0, 1614852672);", NULL, NULL, &errorMessage);
+
+			// Act
+			std::shared_ptr<ReportJob> ptr_job = obj_purchase_manager.queue_purchase_export("TestExport", PurchaseExportFormat::Csv);
+
+			// Assert, so it is not counted towards the total either and the export still finishes at 100%
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Completed);
+			Assert::AreEqual(2, ptr_job->get_total_units());
+			Assert::AreEqual(2, ptr_job->get_units_done());
+		}
+
+		TEST_METHOD(update_report_totals) {
+			// Act, the first run merges every purchase
+			int i_merged = obj_purchase_manager.update_report_totals("test_report");
+
+			// Assert
+			Assert::AreEqual(2, i_merged);
+			std::stringstream ss_report;
+			obj_purchase_manager.write_report_totals("test_report", ss_report);
+			Assert::IsTrue(ss_report.str().find("email@email.com") != std::string::npos);
+			Assert::IsTrue(ss_report.str().find("All purchases count: 2") != std::string::npos);
+			Assert::IsTrue(ss_report.str().find("All game copies: 25") != std::string::npos);
+			Assert::IsTrue(ss_report.str().find("All purchases total: 150.00") != std::string::npos);
+		}
+
+		TEST_METHOD(update_report_totals_only_new_purchases) {
+			// Arrange
+			obj_purchase_manager.update_report_totals("test_report");
+			insert_best_seller_purchases();
+			char* errorMessage;
+			sqlite3_exec(obj_db_manager.get_database(), "INSERT INTO purchases(user_id, total) VALUES (1, 100);", NULL, NULL, &errorMessage);
+
+			// Act, only the three purchases made since the last run are merged, then nothing is left to merge
+			int i_merged = obj_purchase_manager.update_report_totals("test_report");
+			int i_merged_again = obj_purchase_manager.update_report_totals("test_report");
+
+			// Assert, totals are the same as adding up every purchase
+			Assert::AreEqual(3, i_merged);
+			Assert::AreEqual(0, i_merged_again);
+			std::stringstream ss_report;
+			obj_purchase_manager.write_report_totals("test_report", ss_report);
+			Assert::IsTrue(ss_report.str().find("admin@gamestock.com") != std::string::npos);
+			Assert::IsTrue(ss_report.str().find("All purchases count: 5") != std::string::npos);
+			Assert::IsTrue(ss_report.str().find("All game copies: 48") != std::string::npos);
+			Assert::IsTrue(ss_report.str().find("All purchases total: 565.87") != std::string::npos);
+
+			// Other reports keep their own watermark
+			Assert::AreEqual(5, obj_purchase_manager.update_report_totals("other_report"));
+		}
+
+		TEST_METHOD(reset_report_totals) {
+			// Arrange
+			obj_purchase_manager.update_report_totals("test_report");
+
+			// Act
+			obj_purchase_manager.reset_report_totals("test_report");
+
+			// Assert, every purchase is merged again
+			std::stringstream ss_report;
+			obj_purchase_manager.write_report_totals("test_report", ss_report);
+			Assert::IsTrue(ss_report.str().find("email@email.com") == std::string::npos);
+			Assert::AreEqual(2, obj_purchase_manager.update_report_totals("test_report"));
+		}
+
+		TEST_METHOD(queue_incremental_report) {
+			// Act
+			std::shared_ptr<ReportJob> ptr_job = obj_purchase_manager.queue_incremental_report("TestTotals.txt", "test_report");
+
+			// Assert, progress is counted in users with purchases
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Completed);
+			Assert::AreEqual(1, ptr_job->get_units_done());
+			Assert::IsTrue(std::filesystem::exists(obj_purchase_manager.get_saves_path() / "TestTotals.txt"));
+		}
+
+		int count_rows(std::string str_table) {
+			sqlite3_stmt* stmt_count;
+			int i_count = 0;
+			std::string str_count_sql = "SELECT COUNT(*) FROM " + str_table;
+
+			sqlite3_prepare_v2(obj_db_manager.get_database(), str_count_sql.c_str(), -1, &stmt_count, NULL);
+			if (sqlite3_step(stmt_count) == SQLITE_ROW) i_count = sqlite3_column_int(stmt_count, 0);
+			sqlite3_finalize(stmt_count);
+
+			return i_count;
+		}
+
+		TEST_METHOD(archive_purchases) {
+			// Arrange, purchases 3 and 4 were made in 2021, 1 and 2 today
+			insert_best_seller_purchases();
+			User user;
+			user.set_id(2);
+			UserPurchaseSummary obj_stats_before = obj_purchase_manager.get_user_purchase_stats(user);
+
+			// Act
+			int i_archived = obj_purchase_manager.archive_purchases(30);
+
+			// Assert, only the old purchases are moved
+			Assert::AreEqual(2, i_archived);
+			Assert::AreEqual(2, count_rows("purchases"));
+			Assert::AreEqual(4, count_rows("purchase_items"));
+			Assert::AreEqual(2, count_rows("purchases_archive"));
+			Assert::AreEqual(4, count_rows("purchase_items_archive"));
+
+			// Stats and rollups still count the archived purchases
+			UserPurchaseSummary obj_stats_after = obj_purchase_manager.get_user_purchase_stats(user);
+			Assert::AreEqual(obj_stats_before.get_purchase_count(), obj_stats_after.get_purchase_count());
+			Assert::AreEqual(obj_stats_before.get_total().get_cents(), obj_stats_after.get_total().get_cents());
+			Assert::AreEqual(obj_stats_before.get_total_game_copies(), obj_stats_after.get_total_game_copies());
+			std::vector<SalesBucket> vec_monthly = obj_purchase_manager.get_sales(SalesPeriod::Month, 1614556800, 1619827200);
+			Assert::AreEqual((std::int64_t)18938, vec_monthly[0].get_revenue().get_cents());
+			Assert::AreEqual(12, vec_monthly[0].get_units());
+			Assert::AreEqual(1, vec_monthly[1].get_orders());
+
+			// Nothing else is old enough
+			Assert::AreEqual(0, obj_purchase_manager.archive_purchases(30));
+		}
+
+		TEST_METHOD(archive_purchases_keeps_best_sellers) {
+			// Arrange
+			insert_best_seller_purchases();
+			std::vector<GameSales> vec_best_before = obj_purchase_manager.get_best_sellers(10);
+			std::vector<GameSales> vec_genre_before = obj_purchase_manager.get_best_sellers_by_genre(2, 5);
+			std::vector<GameSales> vec_period_before = obj_purchase_manager.get_best_sellers_in_period(1614556800, 1617235200, 5);
+
+			// Act, a purchase of Factorio today stays in the purchases table
+			sqlite3_exec(obj_db_manager.get_database(), "INSERT INTO purchases(user_id, total) VALUES (2, 2100); INSERT INTO purchase_items(purchase_id, snapshot_id, game_price, count, game_id) VALUES(5, 7, 2100, 1, 1);", NULL, NULL, NULL);
+			obj_purchase_manager.archive_purchases(30);
+			std::vector<GameSales> vec_best_after = obj_purchase_manager.get_best_sellers(10);
+			std::vector<GameSales> vec_genre_after = obj_purchase_manager.get_best_sellers_by_genre(2, 5);
+			std::vector<GameSales> vec_period_after = obj_purchase_manager.get_best_sellers_in_period(1614556800, 1617235200, 5);
+
+			// Assert, archived sales are still counted, and added to the purchases made since
+			Assert::AreEqual(3, (int)vec_best_after.size());
+			Assert::AreEqual(1, vec_best_after[0].get_game_id());
+			Assert::AreEqual(vec_best_before[0].get_units() + 1, vec_best_after[0].get_units());
+			Assert::AreEqual(vec_best_before[0].get_revenue().get_cents() + 2100, vec_best_after[0].get_revenue().get_cents());
+
+			for (size_t i = 1; i < vec_best_before.size(); i++) {
+				Assert::AreEqual(vec_best_before[i].get_game_id(), vec_best_after[i].get_game_id());
+				Assert::AreEqual(vec_best_before[i].get_units(), vec_best_after[i].get_units());
+			}
+
+			Assert::AreEqual((int)vec_genre_before.size(), (int)vec_genre_after.size());
+			for (size_t i = 0; i < vec_genre_before.size(); i++) {
+				Assert::AreEqual(vec_genre_before[i].get_game_id(), vec_genre_after[i].get_game_id());
+				Assert::AreEqual(vec_genre_before[i].get_revenue().get_cents(), vec_genre_after[i].get_revenue().get_cents());
+			}
+
+			Assert::AreEqual((int)vec_period_before.size(), (int)vec_period_after.size());
+			for (size_t i = 0; i < vec_period_before.size(); i++) {
+				Assert::AreEqual(vec_period_before[i].get_game_id(), vec_period_after[i].get_game_id());
+				Assert::AreEqual(vec_period_before[i].get_units(), vec_period_after[i].get_units());
+			}
+		}
+
+		TEST_METHOD(archive_purchases_read_through) {
+			// Arrange
+			insert_best_seller_purchases();
+			obj_purchase_manager.archive_purchases(30);
+			User user;
+			user.set_id(2);
+
+			// Act
+			obj_purchase_manager.fetch_purchases_with_details(user);
+			PurchasePage page_1 = obj_purchase_manager.fetch_purchase_page(user, 3);
+			PurchasePage page_2 = obj_purchase_manager.fetch_purchase_page(user, 3, page_1.get_next_key());
+			CsvPurchaseExportWriter obj_writer;
+			std::ostringstream ss_export;
+			obj_purchase_manager.export_purchases(obj_writer, ss_export);
+
+			// Assert, archived purchases follow on from the others, newest first
+			std::vector<Purchase>& vec_purchases = obj_purchase_manager.get_vec_purchases();
+			Assert::AreEqual(4, (int)vec_purchases.size());
+			Assert::AreEqual(4, vec_purchases[2].get_id());
+			Assert::AreEqual(3, vec_purchases[3].get_id());
+			Assert::AreEqual(2, (int)vec_purchases[3].get_vec_purchase_items().size());
+			Assert::AreEqual(std::string("2021-03-04 10:11:12"), vec_purchases[3].get_date());
+			Assert::AreEqual(std::int64_t(18938), vec_purchases[3].get_total().get_cents());
+
+			Assert::AreEqual(3, (int)page_1.get_vec_purchases().size());
+			Assert::AreEqual(4, page_1.get_vec_purchases()[2].get_id());
+			Assert::IsTrue(page_1.get_has_more());
+			Assert::AreEqual(1, (int)page_2.get_vec_purchases().size());
+			Assert::AreEqual(3, page_2.get_vec_purchases()[0].get_id());
+			Assert::IsFalse(page_2.get_has_more());
+
+			std::string str_export = ss_export.str();
+			Assert::AreEqual(9, (int)std::count(str_export.begin(), str_export.end(), '\n'));
+			Assert::IsTrue(str_export.find("3,2,2021-03-04T10:11:12Z,Rogue Legacy 2,Action,16,5,15.49,77.45\n") != std::string::npos);
+
+			Purchase obj_archived_purchase(3, Money(18938), "");
+			obj_purchase_manager.populate_purchase_details(obj_archived_purchase);
+			Assert::AreEqual(2, (int)obj_archived_purchase.get_vec_purchase_items().size());
+		}
+
+		TEST_METHOD(fetch_purchase_page_hot_older_than_archive) {
+			// Arrange, a purchase dated before the archived ones that is still in the purchases table, as when it was made after the reports' watermark was read
+			char* errorMessage;
+			insert_best_seller_purchases();
+			obj_purchase_manager.archive_purchases(30);
+			sqlite3_exec(obj_db_manager.get_database(), "INSERT INTO purchases(user_id, total, date) VALUES (2, 999, 1610668800);", NULL, NULL, &errorMessage);
+			User user;
+			user.set_id(2);
+
+			// Act
+			PurchasePage page_1 = obj_purchase_manager.fetch_purchase_page(user, 3);
+			PurchasePage page_2 = obj_purchase_manager.fetch_purchase_page(user, 3, page_1.get_next_key());
+
+			// Assert, pages follow the purchase dates whichever table they are in
+			Assert::AreEqual(3, count_rows("purchases"));
+			Assert::AreEqual(3, (int)page_1.get_vec_purchases().size());
+			Assert::AreEqual(4, page_1.get_vec_purchases()[2].get_id());
+			Assert::IsTrue(page_1.get_has_more());
+			Assert::AreEqual(2, (int)page_2.get_vec_purchases().size());
+			Assert::AreEqual(3, page_2.get_vec_purchases()[0].get_id());
+			Assert::AreEqual(5, page_2.get_vec_purchases()[1].get_id());
+			Assert::IsFalse(page_2.get_has_more());
+		}
+
+		TEST_METHOD(archive_purchases_report_totals) {
+			// Arrange, the report has only merged purchases 1 and 2 when 3 and 4 are archived
+			obj_purchase_manager.update_report_totals("test_report");
+			insert_best_seller_purchases();
+
+			// Act
+			obj_purchase_manager.archive_purchases(30);
+			obj_purchase_manager.reset_report_totals("other_report");
+			int i_merged = obj_purchase_manager.update_report_totals("other_report");
+
+			// Assert, the existing report was brought up to date first and a new report reads the archive
+			Assert::AreEqual(4, i_merged);
+			std::stringstream ss_report;
+			obj_purchase_manager.write_report_totals("test_report", ss_report);
+			Assert::IsTrue(ss_report.str().find("All purchases count: 4") != std::string::npos);
+			std::stringstream ss_other_report;
+			obj_purchase_manager.write_report_totals("other_report", ss_other_report);
+			Assert::IsTrue(ss_other_report.str().find("All purchases total: 564.87") != std::string::npos);
+			Assert::IsTrue(ss_other_report.str().find("All game copies: 48") != std::string::npos);
+		}
+
+		TEST_METHOD(archive_purchases_invalid_days) {
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_purchase_manager.archive_purchases(0);
+				});
+		}
+
+		TEST_METHOD(archive_purchases_deleted_with_user) {
+			// Arrange
+			char* errorMessage;
+			insert_best_seller_purchases();
+			obj_purchase_manager.archive_purchases(30);
+
+			// Act
+			sqlite3_exec(obj_db_manager.get_database(), "DELETE FROM users WHERE id = 2;", NULL, NULL, &errorMessage);
+
+			// Assert, the rollups no longer count the archived purchases
+			Assert::AreEqual(0, count_rows("purchases_archive"));
+			Assert::AreEqual(0, count_rows("purchase_items_archive"));
+			std::vector<SalesBucket> vec_monthly = obj_purchase_manager.get_sales(SalesPeriod::Month, 1614556800, 1619827200);
+			Assert::AreEqual((std::int64_t)0, vec_monthly[0].get_revenue().get_cents());
+			Assert::AreEqual(0, vec_monthly[0].get_units());
+			Assert::AreEqual(0, vec_monthly[1].get_orders());
+			std::vector<SalesBucket> vec_daily = obj_purchase_manager.get_sales(SalesPeriod::Day, 1614852672, 1614852672 + 1);
+			Assert::AreEqual(0, vec_daily[0].get_orders());
+		}
+
+		TEST_METHOD(archive_purchases_deleted_directly) {
+			// Arrange
+			char* errorMessage;
+			insert_best_seller_purchases();
+			obj_purchase_manager.archive_purchases(30);
+			User user;
+			user.set_id(2);
+			UserPurchaseSummary obj_stats_before = obj_purchase_manager.get_user_purchase_stats(user);
+
+			// Act
+			sqlite3_exec(obj_db_manager.get_database(), "DELETE FROM purchases_archive WHERE id = 3;", NULL, NULL, &errorMessage);
+
+			// Assert
+			UserPurchaseSummary obj_stats_after = obj_purchase_manager.get_user_purchase_stats(user);
+			Assert::AreEqual(obj_stats_before.get_purchase_count() - 1, obj_stats_after.get_purchase_count());
+			Assert::AreEqual(obj_stats_before.get_total().get_cents() - 18938, obj_stats_after.get_total().get_cents());
+			Assert::AreEqual(obj_stats_before.get_total_game_copies() - 12, obj_stats_after.get_total_game_copies());
+			std::vector<SalesBucket> vec_monthly = obj_purchase_manager.get_sales(SalesPeriod::Month, 1614556800, 1619827200);
+			Assert::AreEqual((std::int64_t)0, vec_monthly[0].get_revenue().get_cents());
+			Assert::AreEqual(0, vec_monthly[0].get_units());
+			Assert::AreEqual((std::int64_t)22549, vec_monthly[1].get_revenue().get_cents());
+			Assert::AreEqual(1, count_rows("purchases_archive"));
+			Assert::AreEqual(2, count_rows("purchase_items_archive"));
+		}
+
 		TEST_METHOD_CLEANUP(cleanup_test) {
 			sqlite3_close_v2(obj_db_manager.get_database());
 
@@ -0,0 +1,52 @@
+#include "CppUnitTest.h"
+#include "PurchasePage.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(PurchasePageTests)
+	{
+	public:
+		int i_random_id = test_util::generate_random_int_range(1, 1000);
+		int i_random_date = test_util::generate_random_int_range(1, 2000000000);
+
+		TEST_METHOD(default_key_is_start) {
+			PurchasePageKey key;
+
+			Assert::IsTrue(key.is_start());
+			Assert::AreEqual(0, key.get_id());
+		}
+
+		TEST_METHOD(key_constructor_test_2_param) {
+			PurchasePageKey key(i_random_date, i_random_id);
+
+			Assert::IsFalse(key.is_start());
+			Assert::AreEqual((std::int64_t)i_random_date, key.get_date());
+			Assert::AreEqual(i_random_id, key.get_id());
+		}
+
+		TEST_METHOD(default_constructor_test) {
+			PurchasePage page;
+
+			Assert::AreEqual(0, (int)page.get_vec_purchases().size());
+			Assert::IsFalse(page.get_has_more());
+			Assert::IsTrue(page.get_next_key().is_start());
+		}
+
+		TEST_METHOD(add_purchase) {
+			// Arrange
+			PurchasePage page;
+
+			// Act
+			page.add_purchase(Purchase(i_random_id, Money(1000), "Some date"), i_random_date);
+			page.add_purchase(Purchase(i_random_id + 1, Money(1000), "Some date"), i_random_date - 1);
+
+			// Assert, next page starts after the last purchase added
+			Assert::AreEqual(2, (int)page.get_vec_purchases().size());
+			Assert::AreEqual(i_random_id + 1, page.get_next_key().get_id());
+			Assert::AreEqual((std::int64_t)i_random_date - 1, page.get_next_key().get_date());
+		}
+	};
+}
@@ -13,22 +13,22 @@ namespace GameStockTests
 		int i_random_id = test_util::generate_random_int_range(1, 1000);
 		int i_random_user_id = test_util::generate_random_int_range(1, 1000);
 		int i_random_count = test_util::generate_random_int_range(1, 60);
-		double d_random_total = test_util::generate_random_double_range(1, 1000);
+		Money obj_random_total = test_util::generate_random_money_range(100, 100000);
 		std::vector<PurchaseItem> vec_purchase_items = {
-			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_double_range(1, 1000)),
-			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_double_range(1, 1000)),
-			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_double_range(1, 1000)),
-			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_double_range(1, 1000))
+			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_money_range(100, 100000)),
+			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_money_range(100, 100000)),
+			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_money_range(100, 100000)),
+			PurchaseItem(test_util::generate_random_int_range(1, 1000), i_random_count, test_util::generate_random_money_range(100, 100000))
 		};
 
-		Purchase obj_purchase = Purchase(i_random_id, i_random_user_id, vec_purchase_items, d_random_total, str_date);
+		Purchase obj_purchase = Purchase(i_random_id, i_random_user_id, vec_purchase_items, obj_random_total, str_date);
 
 		TEST_METHOD(default_constructor_test) {
 			Purchase purchase;
 
 			Assert::AreEqual(0, purchase.get_id());
 			Assert::AreEqual(0, purchase.get_user_id());
-			Assert::AreEqual(0.0, purchase.get_total());
+			Assert::AreEqual((std::int64_t)0, purchase.get_total().get_cents());
 			Assert::AreEqual(std::string(""), purchase.get_date());
 			Assert::AreEqual(0, (int)purchase.get_vec_purchase_items().size());
 		}
@@ -38,27 +38,27 @@ namespace GameStockTests
 
 			Assert::AreEqual(0, purchase.get_id());
 			Assert::AreEqual(i_random_user_id, purchase.get_user_id());
-			Assert::AreEqual(0.0, purchase.get_total());
+			Assert::AreEqual((std::int64_t)0, purchase.get_total().get_cents());
 			Assert::AreEqual(std::string(""), purchase.get_date());
 			Assert::AreEqual(4, (int)purchase.get_vec_purchase_items().size());
 		}
 
 		TEST_METHOD(constructor_test_3_param) {
-			Purchase purchase(i_random_id, d_random_total, str_date);
+			Purchase purchase(i_random_id, obj_random_total, str_date);
 
 			Assert::AreEqual(i_random_id, purchase.get_id());
 			Assert::AreEqual(0, purchase.get_user_id());
-			Assert::AreEqual(d_random_total, purchase.get_total());
+			Assert::AreEqual(obj_random_total.get_cents(), purchase.get_total().get_cents());
 			Assert::AreEqual(str_date, purchase.get_date());
 			Assert::AreEqual(0, (int)purchase.get_vec_purchase_items().size());
 		}
 
 		TEST_METHOD(constructor_test_5_param) {
-			Purchase purchase(i_random_id, i_random_user_id, vec_purchase_items, d_random_total, str_date);
+			Purchase purchase(i_random_id, i_random_user_id, vec_purchase_items, obj_random_total, str_date);
 
 			Assert::AreEqual(i_random_id, purchase.get_id());
 			Assert::AreEqual(i_random_user_id, purchase.get_user_id());
-			Assert::AreEqual(d_random_total, purchase.get_total());
+			Assert::AreEqual(obj_random_total.get_cents(), purchase.get_total().get_cents());
 			Assert::AreEqual(str_date, purchase.get_date());
 			Assert::AreEqual(4, (int)purchase.get_vec_purchase_items().size());
 		}
@@ -76,7 +76,7 @@ namespace GameStockTests
 		}
 
 		TEST_METHOD(get_total) {
-			Assert::AreEqual(obj_purchase.get_total(), d_random_total);
+			Assert::AreEqual(obj_purchase.get_total().get_cents(), obj_random_total.get_cents());
 		}
 
 		TEST_METHOD(get_date) {
@@ -104,11 +104,11 @@ namespace GameStockTests
 		}
 
 		TEST_METHOD(set_total) {
-			double d_random_set_total = test_util::generate_random_double_range(2000, 3000);
+			Money obj_random_set_total = test_util::generate_random_money_range(200000, 300000);
 
-			obj_purchase.set_total(d_random_set_total);
+			obj_purchase.set_total(obj_random_set_total);
 
-			Assert::AreEqual(obj_purchase.get_total(), d_random_set_total);
+			Assert::AreEqual(obj_purchase.get_total().get_cents(), obj_random_set_total.get_cents());
 		}
 
 		TEST_METHOD(set_date) {
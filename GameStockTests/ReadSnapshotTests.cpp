@@ -0,0 +1,89 @@
+#include "CppUnitTest.h"
+#include "ReadSnapshot.h"
+#include "DatabaseManager.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(ReadSnapshotTests)
+	{
+	public:
+		DatabaseManager obj_db_manager;
+		std::string test_database_name = "testSnapshotDatabase.db";
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			obj_db_manager.connect(test_database_name);
+			obj_db_manager.create_tables_if_not_exist();
+			obj_db_manager.insert_initial();
+		}
+
+		int count_purchases(sqlite3* db) {
+			sqlite3_stmt* stmt_count;
+			sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM purchases", -1, &stmt_count, NULL);
+			sqlite3_step(stmt_count);
+			int i_count = sqlite3_column_int(stmt_count, 0);
+			sqlite3_finalize(stmt_count);
+			return i_count;
+		}
+
+		TEST_METHOD(reads_same_point_in_time) {
+			// Arrange, a second connection as a report would use
+			sqlite3* db = obj_db_manager.get_database();
+			sqlite3* db_reader;
+			sqlite3_open_v2(sqlite3_db_filename(db, "main"), &db_reader, SQLITE_OPEN_READONLY, NULL);
+			int i_before = count_purchases(db_reader);
+
+			{
+				ReadSnapshot obj_snapshot(db_reader);
+
+				// Act, a checkout is committed while the snapshot is held
+				int i_result = sqlite3_exec(db, "INSERT INTO purchases (user_id, total) VALUES (2, 1000);", NULL, NULL, NULL);
+
+				// Assert
+				Assert::AreEqual(SQLITE_OK, i_result);
+				Assert::IsTrue(obj_snapshot.owns_transaction());
+				Assert::AreEqual(i_before, count_purchases(db_reader));
+			}
+
+			// The new purchase is seen once the snapshot is released
+			Assert::AreEqual(i_before + 1, count_purchases(db_reader));
+			sqlite3_close_v2(db_reader);
+		}
+
+		TEST_METHOD(ends_transaction) {
+			sqlite3* db = obj_db_manager.get_database();
+
+			{
+				ReadSnapshot obj_snapshot(db);
+				Assert::AreEqual(0, sqlite3_get_autocommit(db));
+			}
+
+			Assert::AreNotEqual(0, sqlite3_get_autocommit(db));
+		}
+
+		TEST_METHOD(joins_existing_transaction) {
+			// Arrange
+			sqlite3* db = obj_db_manager.get_database();
+			sqlite3_exec(db, "BEGIN IMMEDIATE TRANSACTION;", NULL, NULL, NULL);
+
+			// Act
+			{
+				ReadSnapshot obj_snapshot(db);
+				Assert::IsFalse(obj_snapshot.owns_transaction());
+			}
+
+			// Assert, the transaction is left for its owner to end
+			Assert::AreEqual(0, sqlite3_get_autocommit(db));
+			sqlite3_exec(db, "ROLLBACK;", NULL, NULL, NULL);
+		}
+
+		TEST_METHOD_CLEANUP(cleanup_test) {
+			sqlite3_close_v2(obj_db_manager.get_database());
+
+			if (std::filesystem::exists("database\\testSnapshotDatabase.db")) {
+				std::filesystem::remove("database\\testSnapshotDatabase.db");
+			}
+		}
+	};
+}
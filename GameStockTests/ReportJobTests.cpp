@@ -0,0 +1,86 @@
+#include "CppUnitTest.h"
+#include "ReportJob.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(ReportJobTests)
+	{
+	public:
+		int i_random_total = test_util::generate_random_int_range(10, 1000);
+
+		TEST_METHOD(constructor_test) {
+			ReportJob job(std::filesystem::path("saves") / "Report.txt", "users", i_random_total);
+
+			Assert::AreEqual(std::string("Report.txt"), job.get_file_name());
+			Assert::AreEqual(std::string("users"), job.get_unit_name());
+			Assert::AreEqual(i_random_total, job.get_total_units());
+			Assert::AreEqual(0, job.get_units_done());
+			Assert::IsTrue(job.get_status() == ReportJobStatus::Queued);
+			Assert::AreEqual(std::string("Queued"), job.get_status_text());
+			Assert::IsFalse(job.is_finished());
+		}
+
+		TEST_METHOD(add_progress) {
+			// Arrange
+			ReportJob job("Report.txt", "users", i_random_total);
+			job.set_running();
+
+			// Act
+			job.add_progress(1, 100);
+			job.add_progress(2, 250);
+
+			// Assert
+			Assert::AreEqual(3, job.get_units_done());
+			Assert::AreEqual((std::int64_t)350, job.get_bytes_written());
+			Assert::IsTrue(job.get_eta_seconds() >= 0);
+		}
+
+		TEST_METHOD(get_eta_seconds_unknown) {
+			ReportJob job("Report.txt", "users", i_random_total);
+
+			// Not started, then started with nothing done yet
+			Assert::AreEqual((std::int64_t)-1, job.get_eta_seconds());
+			job.set_running();
+			Assert::AreEqual((std::int64_t)-1, job.get_eta_seconds());
+		}
+
+		TEST_METHOD(cancel) {
+			// Arrange
+			ReportJob job("Report.txt", "users", i_random_total);
+			job.set_running();
+
+			// Act
+			job.cancel();
+
+			// Assert, still running until the writer notices
+			Assert::IsTrue(job.is_cancel_requested());
+			Assert::AreEqual(std::string("Cancelling"), job.get_status_text());
+			Assert::IsFalse(job.is_finished());
+		}
+
+		TEST_METHOD(set_finished) {
+			// Arrange
+			ReportJob job("Report.txt", "users", i_random_total);
+			job.set_running();
+
+			// Act
+			job.set_finished(ReportJobStatus::Failed, "Disk full");
+
+			// Assert
+			Assert::IsTrue(job.is_finished());
+			Assert::IsTrue(job.wait_for(std::chrono::milliseconds(0)));
+			Assert::AreEqual(std::string("Failed"), job.get_status_text());
+			Assert::AreEqual(std::string("Disk full"), job.get_error());
+			Assert::AreEqual((std::int64_t)0, job.get_eta_seconds());
+		}
+
+		TEST_METHOD(wait_for_timeout) {
+			ReportJob job("Report.txt", "users", i_random_total);
+
+			Assert::IsFalse(job.wait_for(std::chrono::milliseconds(10)));
+		}
+	};
+}
@@ -0,0 +1,214 @@
+#include "CppUnitTest.h"
+#include "ReportScheduler.h"
+#include "DatabaseManager.h"
+#include <future>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(ReportSchedulerTests)
+	{
+	public:
+		DatabaseManager obj_db_manager;
+		std::string test_database_name = "testSchedulerDatabase.db";
+		std::filesystem::path path_report = std::filesystem::path("database") / "testSchedulerReport.txt";
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			obj_db_manager.connect(test_database_name);
+			obj_db_manager.create_tables_if_not_exist();
+			obj_db_manager.insert_initial();
+		}
+
+		TEST_METHOD(queue_writes_report) {
+			// Arrange
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+
+			// Act, the writer reads through its own connection
+			std::shared_ptr<ReportJob> ptr_job = obj_scheduler.queue(path_report, "users", 1, [](ReportJob& obj_job, sqlite3* db, std::ostream& os) {
+				sqlite3_stmt* stmt_users;
+				sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM users", -1, &stmt_users, NULL);
+				sqlite3_step(stmt_users);
+				os << "Users: " << sqlite3_column_int(stmt_users, 0);
+				sqlite3_finalize(stmt_users);
+				obj_job.add_progress(1, 8);
+				});
+
+			// Assert
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Completed);
+			Assert::AreEqual(1, ptr_job->get_units_done());
+
+			std::ifstream if_stream(path_report);
+			std::string str_contents((std::istreambuf_iterator<char>(if_stream)), std::istreambuf_iterator<char>());
+			Assert::AreEqual(std::string("Users: 2"), str_contents);
+		}
+
+		TEST_METHOD(queue_after_connection_closed) {
+			// Arrange, the connection the scheduler was made from is closed before the report is written
+			sqlite3* db_other = obj_db_manager.open_connection();
+			ReportScheduler obj_scheduler(db_other);
+			sqlite3_close(db_other);
+
+			// Act
+			std::shared_ptr<ReportJob> ptr_job = obj_scheduler.queue(path_report, "users", 1, [](ReportJob& obj_job, sqlite3*, std::ostream& os) {
+				os << "Users";
+				obj_job.add_progress(1, 5);
+				});
+
+			// Assert, the report is still read from the same file
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Completed);
+		}
+
+		TEST_METHOD(queue_returns_straight_away) {
+			// Arrange
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+			std::promise<void> obj_release;
+			std::shared_future<void> obj_released = obj_release.get_future().share();
+
+			// Act, the writer does not finish until released
+			std::shared_ptr<ReportJob> ptr_job = obj_scheduler.queue(path_report, "users", 1, [obj_released](ReportJob&, sqlite3*, std::ostream&) {
+				obj_released.wait();
+				});
+
+			// Assert
+			Assert::IsFalse(ptr_job->is_finished());
+			obj_release.set_value();
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+		}
+
+		TEST_METHOD(cancel_removes_report) {
+			// Arrange
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+			std::promise<void> obj_started;
+			std::future<void> obj_has_started = obj_started.get_future();
+
+			// Act, writer keeps writing until it sees the cancel
+			std::shared_ptr<ReportJob> ptr_job = obj_scheduler.queue(path_report, "rows", 1000000, [&obj_started](ReportJob& obj_job, sqlite3*, std::ostream& os) {
+				obj_started.set_value();
+				while (!obj_job.is_cancel_requested()) {
+					os << "Row\n";
+					obj_job.add_progress(1, 4);
+				}
+				});
+
+			obj_has_started.wait();
+			ptr_job->cancel();
+
+			// Assert
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Cancelled);
+			Assert::IsFalse(std::filesystem::exists(path_report));
+		}
+
+		TEST_METHOD(cancel_while_queued) {
+			// Arrange, hold the worker up with a first report so the second is still queued
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+			std::promise<void> obj_release;
+			std::shared_future<void> obj_released = obj_release.get_future().share();
+			bool bool_second_ran = false;
+
+			std::shared_ptr<ReportJob> ptr_first_job = obj_scheduler.queue(path_report, "users", 1, [obj_released](ReportJob&, sqlite3*, std::ostream&) {
+				obj_released.wait();
+				});
+			std::shared_ptr<ReportJob> ptr_second_job = obj_scheduler.queue(std::filesystem::path("database") / "testSchedulerReport2.txt", "users", 1, [&bool_second_ran](ReportJob&, sqlite3*, std::ostream&) {
+				bool_second_ran = true;
+				});
+
+			// Act
+			ptr_second_job->cancel();
+			obj_release.set_value();
+
+			// Assert
+			Assert::IsTrue(ptr_second_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_first_job->get_status() == ReportJobStatus::Completed);
+			Assert::IsTrue(ptr_second_job->get_status() == ReportJobStatus::Cancelled);
+			Assert::IsFalse(bool_second_ran);
+		}
+
+		TEST_METHOD(failed_report) {
+			// Arrange
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+
+			// Act
+			std::shared_ptr<ReportJob> ptr_job = obj_scheduler.queue(path_report, "users", 1, [](ReportJob&, sqlite3*, std::ostream& os) {
+				os << "Part of a report";
+				throw std::runtime_error("Something went wrong");
+				});
+
+			// Assert
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Failed);
+			Assert::AreEqual(std::string("Something went wrong"), ptr_job->get_error());
+			Assert::IsFalse(std::filesystem::exists(path_report));
+		}
+
+		TEST_METHOD(failed_report_non_standard_exception) {
+			// Arrange
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+
+			// Act, the worker carries on to the next job rather than ending the program
+			std::shared_ptr<ReportJob> ptr_job = obj_scheduler.queue(path_report, "users", 1, [](ReportJob&, sqlite3*, std::ostream&) {
+				throw 1;
+				});
+			std::shared_ptr<ReportJob> ptr_next_job = obj_scheduler.queue(path_report, "users", 0, [](ReportJob&, sqlite3*, std::ostream&) {});
+
+			// Assert
+			Assert::IsTrue(ptr_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_job->get_status() == ReportJobStatus::Failed);
+			Assert::IsFalse(ptr_job->get_error().empty());
+			Assert::IsTrue(ptr_next_job->wait_for(std::chrono::seconds(10)));
+			Assert::IsTrue(ptr_next_job->get_status() == ReportJobStatus::Completed);
+		}
+
+		TEST_METHOD(take_finished_jobs) {
+			// Arrange
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+			std::shared_ptr<ReportJob> ptr_job = obj_scheduler.queue(path_report, "users", 0, [](ReportJob&, sqlite3*, std::ostream&) {});
+			ptr_job->wait_for(std::chrono::seconds(10));
+
+			// Act
+			std::vector<std::shared_ptr<ReportJob>> vec_finished = obj_scheduler.take_finished_jobs();
+
+			// Assert, each finished job is only returned once
+			Assert::AreEqual(1, (int)vec_finished.size());
+			Assert::IsTrue(vec_finished[0] == ptr_job);
+			Assert::AreEqual(0, (int)obj_scheduler.take_finished_jobs().size());
+			Assert::AreEqual(1, (int)obj_scheduler.get_jobs().size());
+		}
+
+		TEST_METHOD(queue_after_stop) {
+			ReportScheduler obj_scheduler(obj_db_manager.get_database());
+			obj_scheduler.stop();
+
+			Assert::ExpectException<std::runtime_error>([&] {
+				obj_scheduler.queue(path_report, "users", 0, [](ReportJob&, sqlite3*, std::ostream&) {});
+				});
+		}
+
+		TEST_METHOD(queue_without_database_file) {
+			ReportScheduler obj_scheduler(NULL);
+
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_scheduler.queue(path_report, "users", 0, [](ReportJob&, sqlite3*, std::ostream&) {});
+				});
+		}
+
+		TEST_METHOD_CLEANUP(cleanup_test) {
+			sqlite3_close_v2(obj_db_manager.get_database());
+
+			if (std::filesystem::exists("database\\testSchedulerDatabase.db")) {
+				std::filesystem::remove("database\\testSchedulerDatabase.db");
+			}
+
+			if (std::filesystem::exists("database\\testSchedulerReport.txt")) {
+				std::filesystem::remove("database\\testSchedulerReport.txt");
+			}
+
+			if (std::filesystem::exists("database\\testSchedulerReport2.txt")) {
+				std::filesystem::remove("database\\testSchedulerReport2.txt");
+			}
+		}
+	};
+}
@@ -0,0 +1,213 @@
+#include "CppUnitTest.h"
+#include "RowFormatter.h"
+#include "Utilities.h"
+#include "TestUtilities.h"
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	/// <summary>
+	/// Groups thousands with a comma the way the en_GB locale used by reports does, without relying on the locale being installed
+	/// </summary>
+	struct GroupedNumpunct : std::numpunct<char> {
+		char do_thousands_sep() const override { return ','; }
+		std::string do_grouping() const override { return "\3"; }
+	};
+
+	TEST_CLASS(RowFormatterTests)
+	{
+	public:
+		std::locale loc_grouped = std::locale(std::locale::classic(), new GroupedNumpunct);
+
+		/// <summary>
+		/// Writes a purchase item row through iostream formatting, the way reports were written before the formatter
+		/// </summary>
+		void write_stream_row(std::ostream& os, PurchaseItem& obj_purchase_item) {
+			os.precision(2);
+			os
+				<< std::fixed
+				<< std::setw(45) << std::left << obj_purchase_item.get_game().get_name()
+				<< std::setw(9) << std::left << obj_purchase_item.get_count()
+				<< std::setw(15) << std::left << obj_purchase_item.get_price()
+				<< std::setw(15) << std::left << obj_purchase_item.get_total()
+				<< std::setw(20) << std::left << obj_purchase_item.get_total_before_vat() << "\n";
+		}
+
+		PurchaseItem create_purchase_item(std::string str_name, int i_count, Money obj_price) {
+			Game obj_game(1, str_name, Genre("Action"), Rating("16"), obj_price, 100);
+			return PurchaseItem(1, obj_game, i_count, obj_price);
+		}
+
+		TEST_METHOD(text_padded_to_width) {
+			std::ostringstream ss_output;
+			{
+				RowFormatter obj_formatter(ss_output);
+				obj_formatter.text("Total: ", 10).text("end").end_row();
+			}
+
+			Assert::AreEqual(std::string("Total:    end\n"), ss_output.str());
+		}
+
+		TEST_METHOD(text_longer_than_width) {
+			std::ostringstream ss_expected;
+			std::ostringstream ss_output;
+			ss_expected << std::setw(4) << std::left << "Game Name" << "|";
+			{
+				RowFormatter obj_formatter(ss_output);
+				obj_formatter.text("Game Name", 4).text("|");
+			}
+
+			Assert::AreEqual(ss_expected.str(), ss_output.str());
+		}
+
+		TEST_METHOD(integer_matches_stream) {
+			std::int64_t vec_values[] = { 0, 7, -7, 999, 1000, -1000, 123456789, -2147483648LL, INT64_MAX, INT64_MIN };
+
+			for (std::int64_t ll_value : vec_values) {
+				std::ostringstream ss_expected;
+				std::ostringstream ss_output;
+				ss_expected.imbue(loc_grouped);
+				ss_output.imbue(loc_grouped);
+
+				ss_expected << std::setw(12) << std::left << ll_value << "|";
+				{
+					RowFormatter obj_formatter(ss_output);
+					obj_formatter.integer(ll_value, 12).text("|");
+				}
+
+				Assert::AreEqual(ss_expected.str(), ss_output.str());
+			}
+		}
+
+		TEST_METHOD(money_matches_stream) {
+			std::int64_t vec_cents[] = { 0, 1, 9, 10, 99, 100, 1549, -1549, -5, 99999, 100000, 123456789, -123456789 };
+
+			for (std::int64_t ll_cents : vec_cents) {
+				std::ostringstream ss_expected;
+				std::ostringstream ss_output;
+				ss_expected.imbue(loc_grouped);
+				ss_output.imbue(loc_grouped);
+
+				ss_expected.precision(2);
+				ss_expected << std::fixed << std::setw(15) << std::left << Money(ll_cents) << "|";
+				{
+					RowFormatter obj_formatter(ss_output);
+					obj_formatter.money(Money(ll_cents), 15).text("|");
+				}
+
+				Assert::AreEqual(ss_expected.str(), ss_output.str());
+			}
+		}
+
+		TEST_METHOD(money_random_matches_stream) {
+			std::ostringstream ss_expected;
+			std::ostringstream ss_output;
+			ss_expected.imbue(loc_grouped);
+			ss_output.imbue(loc_grouped);
+			ss_expected.precision(2);
+			ss_expected << std::fixed;
+			{
+				RowFormatter obj_formatter(ss_output);
+
+				for (int i = 0; i < 1000; i++) {
+					Money obj_money = test_util::generate_random_money_range(-100000000, 100000000);
+					ss_expected << std::setw(15) << std::left << obj_money << "\n";
+					obj_formatter.money(obj_money, 15).end_row();
+				}
+			}
+
+			Assert::AreEqual(ss_expected.str(), ss_output.str());
+		}
+
+		TEST_METHOD(purchase_item_matches_stream) {
+			std::ostringstream ss_expected;
+			std::ostringstream ss_output;
+			ss_expected.imbue(loc_grouped);
+			ss_output.imbue(loc_grouped);
+			PurchaseItem obj_purchase_item = create_purchase_item("Rogue Legacy 2", 1200, Money(1549));
+
+			write_stream_row(ss_expected, obj_purchase_item);
+			{
+				RowFormatter obj_formatter(ss_output);
+				util::output_purchase_item(obj_purchase_item, obj_formatter);
+			}
+
+			Assert::AreEqual(ss_expected.str(), ss_output.str());
+		}
+
+		TEST_METHOD(small_buffer) {
+			// Buffer is smaller than a single row, so rows are written in pieces and long values straight to the stream
+			std::ostringstream ss_expected;
+			std::ostringstream ss_output;
+			PurchaseItem obj_purchase_item = create_purchase_item("A game with a name longer than the formatter's buffer", 3, Money(2099));
+
+			for (int i = 0; i < 10; i++) {
+				write_stream_row(ss_expected, obj_purchase_item);
+			}
+			{
+				RowFormatter obj_formatter(ss_output, 16);
+				for (int i = 0; i < 10; i++) {
+					util::output_purchase_item(obj_purchase_item, obj_formatter);
+				}
+
+				Assert::AreEqual((std::int64_t)ss_expected.str().size(), obj_formatter.get_bytes_written());
+			}
+
+			Assert::AreEqual(ss_expected.str(), ss_output.str());
+		}
+
+		TEST_METHOD(flush_writes_buffer) {
+			std::ostringstream ss_output;
+			RowFormatter obj_formatter(ss_output);
+
+			obj_formatter.text("Header").end_row();
+			Assert::AreEqual(std::string(""), ss_output.str());
+
+			obj_formatter.flush();
+			Assert::AreEqual(std::string("Header\n"), ss_output.str());
+		}
+
+		TEST_METHOD(rows_per_second_benchmark) {
+			// Arrange, 200000 purchase item rows
+			const int i_row_count = 200000;
+			std::vector<PurchaseItem> vec_purchase_items;
+			for (int i = 0; i < 100; i++) {
+				vec_purchase_items.push_back(create_purchase_item("Game " + std::to_string(i), test_util::generate_random_int_range(1, 5000), test_util::generate_random_money_range(1, 100000)));
+			}
+
+			std::ostringstream ss_stream_report;
+			std::ostringstream ss_formatter_report;
+			ss_stream_report.imbue(loc_grouped);
+			ss_formatter_report.imbue(loc_grouped);
+
+			// Act
+			auto time_start = std::chrono::steady_clock::now();
+			for (int i = 0; i < i_row_count; i++) {
+				write_stream_row(ss_stream_report, vec_purchase_items[i % vec_purchase_items.size()]);
+			}
+			auto time_stream = std::chrono::steady_clock::now() - time_start;
+
+			time_start = std::chrono::steady_clock::now();
+			{
+				RowFormatter obj_formatter(ss_formatter_report);
+				for (int i = 0; i < i_row_count; i++) {
+					util::output_purchase_item(vec_purchase_items[i % vec_purchase_items.size()], obj_formatter);
+				}
+			}
+			auto time_formatter = std::chrono::steady_clock::now() - time_start;
+
+			// Assert, both write the same report
+			Assert::AreEqual(ss_stream_report.str(), ss_formatter_report.str());
+
+			long long ll_stream_us = std::chrono::duration_cast<std::chrono::microseconds>(time_stream).count() + 1;
+			long long ll_formatter_us = std::chrono::duration_cast<std::chrono::microseconds>(time_formatter).count() + 1;
+			std::string str_message = "RowFormatter (" + std::to_string(i_row_count) + " rows): iostream " + std::to_string(i_row_count * 1000000LL / ll_stream_us) + " rows/s, " +
+				"RowFormatter " + std::to_string(i_row_count * 1000000LL / ll_formatter_us) + " rows/s";
+			Logger::WriteMessage(str_message.c_str());
+		}
+	};
+}
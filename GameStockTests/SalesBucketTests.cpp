@@ -0,0 +1,73 @@
+#include "CppUnitTest.h"
+#include "SalesBucket.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(SalesBucketTests)
+	{
+	public:
+		// 2021-03-04 10:11:12 UTC, a Thursday
+		std::int64_t ll_time = 1614852672;
+
+		TEST_METHOD(default_constructor_test) {
+			SalesBucket obj_bucket;
+
+			Assert::AreEqual((std::int64_t)0, obj_bucket.get_start());
+			Assert::AreEqual((std::int64_t)0, obj_bucket.get_revenue().get_cents());
+			Assert::AreEqual(0, obj_bucket.get_units());
+			Assert::AreEqual(0, obj_bucket.get_orders());
+		}
+
+		TEST_METHOD(add) {
+			SalesBucket obj_bucket(1614816000, Money(1000), 2, 1);
+			SalesBucket obj_other(1614902400, Money(550), 3, 2);
+
+			obj_bucket.add(obj_other);
+
+			Assert::AreEqual((std::int64_t)1614816000, obj_bucket.get_start());
+			Assert::AreEqual((std::int64_t)1550, obj_bucket.get_revenue().get_cents());
+			Assert::AreEqual(5, obj_bucket.get_units());
+			Assert::AreEqual(3, obj_bucket.get_orders());
+		}
+
+		TEST_METHOD(get_period_start) {
+			Assert::AreEqual((std::int64_t)1614816000, SalesBucket::get_period_start(SalesPeriod::Day, ll_time));
+			Assert::AreEqual((std::int64_t)1614556800, SalesBucket::get_period_start(SalesPeriod::Week, ll_time));
+			Assert::AreEqual((std::int64_t)1614556800, SalesBucket::get_period_start(SalesPeriod::Month, ll_time));
+
+			// Start of a period is its own start
+			Assert::AreEqual((std::int64_t)1614556800, SalesBucket::get_period_start(SalesPeriod::Week, 1614556800));
+			Assert::AreEqual((std::int64_t)1614729600, SalesBucket::get_period_start(SalesPeriod::Day, 1614729600));
+		}
+
+		TEST_METHOD(get_period_start_before_epoch) {
+			// 1969-12-31 23:59:59, a Wednesday
+			Assert::AreEqual((std::int64_t)-86400, SalesBucket::get_period_start(SalesPeriod::Day, -1));
+			Assert::AreEqual((std::int64_t)-259200, SalesBucket::get_period_start(SalesPeriod::Week, -1));
+			Assert::AreEqual((std::int64_t)-2678400, SalesBucket::get_period_start(SalesPeriod::Month, -1));
+		}
+
+		TEST_METHOD(add_periods) {
+			Assert::AreEqual((std::int64_t)1614729600, SalesBucket::add_periods(SalesPeriod::Day, 1614816000, -1));
+			Assert::AreEqual((std::int64_t)1614556800 + 7 * 86400, SalesBucket::add_periods(SalesPeriod::Week, 1614556800, 1));
+		}
+
+		TEST_METHOD(add_periods_months) {
+			// 2020-12 forward across the year, and 2021-03 back a year (through a leap year February)
+			Assert::AreEqual((std::int64_t)1643673600, SalesBucket::add_periods(SalesPeriod::Month, 1606780800, 14));
+			Assert::AreEqual((std::int64_t)1609459200, SalesBucket::add_periods(SalesPeriod::Month, 1606780800, 1));
+			Assert::AreEqual((std::int64_t)1580515200, SalesBucket::add_periods(SalesPeriod::Month, 1614556800, -13));
+			Assert::AreEqual((std::int64_t)1577836800, SalesBucket::add_periods(SalesPeriod::Month, 1614556800, -14));
+		}
+
+		TEST_METHOD(get_label) {
+			SalesBucket obj_bucket(1614816000);
+
+			Assert::AreEqual(std::string("2021-03-04"), obj_bucket.get_label(SalesPeriod::Day));
+			Assert::AreEqual(std::string("2021-03"), SalesBucket(1614556800).get_label(SalesPeriod::Month));
+			Assert::AreEqual(std::string("1969-12-29"), SalesBucket(-259200).get_label(SalesPeriod::Week));
+		}
+	};
+}
@@ -0,0 +1,150 @@
+#include "CppUnitTest.h"
+#include "SalesColumnStore.h"
+#include "TestUtilities.h"
+#include <chrono>
+#include <map>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(SalesColumnStoreTests)
+	{
+	public:
+		SalesColumnStore obj_store;
+
+		TEST_METHOD_INITIALIZE(init_test) {
+			// Two purchases in March 2021 and one in April
+			obj_store.append(1614852672, 2, "Action", "16", Money(1549), 2);
+			obj_store.append(1614852672, 2, "Strategy", "12", Money(2100), 1);
+			obj_store.append(1615334400, 3, "Action", "PG", Money(599), 4);
+			obj_store.append(1617321600, 3, "Action", "16", Money(8999), 1);
+		}
+
+		TEST_METHOD(get_row_count) {
+			Assert::AreEqual(4, (int)obj_store.get_row_count());
+		}
+
+		TEST_METHOD(group_by_genre) {
+			std::vector<SalesGroup> vec_groups = obj_store.group_by(SalesDimension::Genre, INT64_MIN, INT64_MAX);
+
+			// Most revenue first
+			Assert::AreEqual(2, (int)vec_groups.size());
+			Assert::AreEqual(std::string("Action"), vec_groups[0].str_label);
+			Assert::AreEqual((std::int64_t)14493, vec_groups[0].obj_revenue.get_cents());
+			Assert::AreEqual((std::int64_t)7, vec_groups[0].ll_units);
+			Assert::AreEqual((std::int64_t)3, vec_groups[0].ll_lines);
+			Assert::AreEqual(std::string("Strategy"), vec_groups[1].str_label);
+			Assert::AreEqual((std::int64_t)2100, vec_groups[1].obj_revenue.get_cents());
+		}
+
+		TEST_METHOD(group_by_rating_in_range) {
+			// March only, groups with nothing in the range are left out
+			std::vector<SalesGroup> vec_groups = obj_store.group_by(SalesDimension::Rating, 1614556800, 1617235200);
+
+			Assert::AreEqual(3, (int)vec_groups.size());
+			Assert::AreEqual(std::string("16"), vec_groups[0].str_label);
+			Assert::AreEqual((std::int64_t)3098, vec_groups[0].obj_revenue.get_cents());
+			Assert::AreEqual(std::string("PG"), vec_groups[1].str_label);
+			Assert::AreEqual(std::string("12"), vec_groups[2].str_label);
+			Assert::AreEqual(0, (int)obj_store.group_by(SalesDimension::Rating, 1617321600 + 1, INT64_MAX).size());
+		}
+
+		TEST_METHOD(group_by_price_band) {
+			std::vector<SalesGroup> vec_groups = obj_store.group_by(SalesDimension::PriceBand, INT64_MIN, INT64_MAX);
+
+			Assert::AreEqual(4, (int)vec_groups.size());
+			Assert::AreEqual(std::string("70.00 and over"), vec_groups[0].str_label);
+			Assert::AreEqual(std::string("10.00 - 19.99"), vec_groups[1].str_label);
+			Assert::AreEqual(std::string("0.00 - 9.99"), vec_groups[2].str_label);
+			Assert::AreEqual((std::int64_t)4, vec_groups[2].ll_units);
+		}
+
+		TEST_METHOD(group_by_user) {
+			std::vector<SalesGroup> vec_groups = obj_store.group_by(SalesDimension::User, INT64_MIN, INT64_MAX);
+
+			Assert::AreEqual(2, (int)vec_groups.size());
+			Assert::AreEqual(std::string("3"), vec_groups[0].str_label);
+			Assert::AreEqual((std::int64_t)11395, vec_groups[0].obj_revenue.get_cents());
+			Assert::AreEqual(std::string("2"), vec_groups[1].str_label);
+		}
+
+		TEST_METHOD(group_by_user_sparse_ids) {
+			// Arrange, ids far above the number of lines are grouped without a group for every id below them
+			obj_store.append(1614852672, 2000000000, "Action", "16", Money(1000), 1);
+			obj_store.append(1614852672, 1999999999, "Action", "16", Money(1000), 1);
+
+			// Act
+			std::vector<SalesGroup> vec_groups = obj_store.group_by(SalesDimension::User, INT64_MIN, INT64_MAX);
+			std::vector<SalesGroup> vec_march_groups = obj_store.group_by(SalesDimension::User, 1614556800, 1617235200);
+
+			// Assert
+			Assert::AreEqual(4, (int)vec_groups.size());
+			Assert::AreEqual(std::string("3"), vec_groups[0].str_label);
+			Assert::AreEqual((std::int64_t)11395, vec_groups[0].obj_revenue.get_cents());
+			Assert::AreEqual(std::string("1999999999"), vec_groups[2].str_label);
+			Assert::AreEqual(std::string("2000000000"), vec_groups[3].str_label);
+			Assert::AreEqual((std::int64_t)1, vec_groups[3].ll_lines);
+			Assert::AreEqual(4, (int)vec_march_groups.size());
+			Assert::AreEqual((std::int64_t)2396, vec_march_groups[1].obj_revenue.get_cents());
+		}
+
+		TEST_METHOD(append_negative_user_id) {
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_store.append(1614852672, -1, "Action", "16", Money(1549), 1);
+				});
+
+			Assert::AreEqual(4, (int)obj_store.get_row_count());
+		}
+
+		TEST_METHOD(get_revenue) {
+			Assert::AreEqual((std::int64_t)16593, obj_store.get_revenue(INT64_MIN, INT64_MAX).get_cents());
+			Assert::AreEqual((std::int64_t)7594, obj_store.get_revenue(1614556800, 1617235200).get_cents());
+		}
+
+		TEST_METHOD(clear) {
+			obj_store.clear();
+
+			Assert::AreEqual(0, (int)obj_store.get_row_count());
+			Assert::AreEqual(0, (int)obj_store.group_by(SalesDimension::Genre, INT64_MIN, INT64_MAX).size());
+		}
+
+		TEST_METHOD(get_price_band) {
+			Assert::AreEqual(0, SalesColumnStore::get_price_band(Money(999)));
+			Assert::AreEqual(1, SalesColumnStore::get_price_band(Money(1000)));
+			Assert::AreEqual(SalesColumnStore::PRICE_BAND_COUNT - 1, SalesColumnStore::get_price_band(Money(100000)));
+			Assert::AreEqual(0, SalesColumnStore::get_price_band(Money(-500)));
+		}
+
+		TEST_METHOD(group_by_benchmark) {
+			// Arrange, 2 million lines across 10 genres over a year
+			const int i_lines = 2000000;
+			SalesColumnStore obj_large_store;
+			std::vector<std::string> vec_genres = { "Strategy", "Action", "FPS", "Romance", "Horror", "MMORPG", "Battle Royale", "RPG", "Tower Defence", "Simulation" };
+			std::map<std::string, std::int64_t> map_expected;
+
+			for (int i = 0; i < i_lines; i++) {
+				std::int64_t ll_date = 1609459200 + (std::int64_t)(i % 365) * 86400;
+				int i_count = i % 3 + 1;
+				Money obj_price = Money(500 + (i % 7) * 1000);
+				obj_large_store.append(ll_date, i % 50 + 1, vec_genres[i % vec_genres.size()], "16", obj_price, i_count);
+
+				if (ll_date < 1617235200) map_expected[vec_genres[i % vec_genres.size()]] += obj_price.get_cents() * i_count;
+			}
+
+			// Act, the first quarter of 2021
+			auto time_start = std::chrono::steady_clock::now();
+			std::vector<SalesGroup> vec_groups = obj_large_store.group_by(SalesDimension::Genre, 1609459200, 1617235200);
+			auto time_taken = std::chrono::steady_clock::now() - time_start;
+
+			std::string str_message = "group_by over " + std::to_string(i_lines) + " lines: " + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(time_taken).count()) + "us";
+			Logger::WriteMessage(str_message.c_str());
+
+			// Assert, the same as totalling each line one at a time
+			Assert::AreEqual((int)vec_genres.size(), (int)vec_groups.size());
+			for (SalesGroup& group : vec_groups) {
+				Assert::AreEqual(map_expected[group.str_label], group.obj_revenue.get_cents());
+			}
+		}
+	};
+}
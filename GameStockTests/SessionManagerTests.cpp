@@ -0,0 +1,131 @@
+#include "CppUnitTest.h"
+#include "SessionManager.h"
+#include <thread>
+#include <chrono>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(SessionManagerTests)
+	{
+	public:
+		SessionManager obj_session_manager;
+
+		User create_user(int i_user_id) {
+			User obj_user;
+			obj_user.set_id(i_user_id);
+			obj_user.set_email("user" + std::to_string(i_user_id) + "@test.com");
+			return obj_user;
+		}
+
+		TEST_METHOD(create_session) {
+			// Act
+			std::shared_ptr<Session> ptr_session = obj_session_manager.create_session(create_user(2));
+
+			// Assert
+			Assert::AreEqual(32, (int)ptr_session->get_id().size());
+			Assert::IsTrue(ptr_session->is_login_valid());
+			Assert::AreEqual(2, ptr_session->get_user().get_id());
+			Assert::AreEqual(2, ptr_session->get_basket().get_user_id());
+			Assert::AreEqual(0, ptr_session->get_filter_genre().get_id());
+			Assert::AreEqual(1, (int)obj_session_manager.get_session_count());
+		}
+
+		TEST_METHOD(session_set_login_valid) {
+			// Arrange
+			Session obj_session;
+
+			// Act
+			obj_session.set_login_valid(true);
+
+			// Assert
+			Assert::IsTrue(obj_session.is_login_valid());
+		}
+
+		TEST_METHOD(find_session) {
+			// Arrange
+			std::shared_ptr<Session> ptr_session = obj_session_manager.create_session(create_user(2));
+			obj_session_manager.create_session(create_user(3));
+
+			// Act/Assert, the same session is returned rather than a copy
+			Assert::IsTrue(obj_session_manager.find_session(ptr_session->get_id()) == ptr_session);
+			Assert::IsTrue(obj_session_manager.find_session("not a session") == nullptr);
+		}
+
+		TEST_METHOD(end_session) {
+			// Arrange
+			std::shared_ptr<Session> ptr_session = obj_session_manager.create_session(create_user(2));
+
+			// Act
+			obj_session_manager.end_session(ptr_session->get_id());
+			obj_session_manager.end_session("not a session");
+
+			// Assert
+			Assert::IsTrue(obj_session_manager.find_session(ptr_session->get_id()) == nullptr);
+			Assert::AreEqual(0, (int)obj_session_manager.get_session_count());
+		}
+
+		TEST_METHOD(end_user_sessions) {
+			// Arrange, the same user logged in twice
+			obj_session_manager.create_session(create_user(2));
+			obj_session_manager.create_session(create_user(2));
+			std::shared_ptr<Session> ptr_other_session = obj_session_manager.create_session(create_user(3));
+
+			// Act
+			obj_session_manager.end_user_sessions(2);
+
+			// Assert
+			Assert::AreEqual(1, (int)obj_session_manager.get_session_count());
+			Assert::IsTrue(obj_session_manager.find_session(ptr_other_session->get_id()) == ptr_other_session);
+		}
+
+		TEST_METHOD(invalid_shard_count) {
+			Assert::ExpectException<std::invalid_argument>([&] {
+				SessionManager obj_invalid_manager(0);
+				});
+		}
+
+		TEST_METHOD(concurrent_sessions) {
+			// Arrange, shoppers on several threads starting sessions, filling their baskets and finding their sessions again
+			const int i_thread_count = 8;
+			const int i_sessions_per_thread = 2000;
+			std::vector<std::thread> vec_threads;
+			std::vector<int> vec_failures(i_thread_count, 0);
+			Game obj_game;
+			obj_game.set_id(1);
+
+			// Act
+			auto time_start = std::chrono::steady_clock::now();
+
+			for (int thread = 0; thread < i_thread_count; thread++) {
+				vec_threads.push_back(std::thread([&, thread]() {
+					for (int i = 0; i < i_sessions_per_thread; i++) {
+						int i_user_id = thread * i_sessions_per_thread + i + 1;
+						std::shared_ptr<Session> ptr_session = obj_session_manager.create_session(create_user(i_user_id));
+						ptr_session->get_basket().add_item(PurchaseItem(1, obj_game, i_user_id, Money(100)));
+
+						std::shared_ptr<Session> ptr_found_session = obj_session_manager.find_session(ptr_session->get_id());
+						if (ptr_found_session == nullptr || ptr_found_session->get_basket().get_total_game_copies() != i_user_id) vec_failures[thread]++;
+					}
+					}));
+			}
+
+			for (std::thread& thread : vec_threads) {
+				thread.join();
+			}
+
+			auto time_taken = std::chrono::steady_clock::now() - time_start;
+			std::string str_message = std::to_string(i_thread_count * i_sessions_per_thread) + " sessions across " + std::to_string(i_thread_count) + " threads: " +
+				std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(time_taken).count()) + "us";
+			Logger::WriteMessage(str_message.c_str());
+
+			// Assert
+			for (int thread = 0; thread < i_thread_count; thread++) {
+				Assert::AreEqual(0, vec_failures[thread]);
+			}
+			Assert::AreEqual(i_thread_count * i_sessions_per_thread, (int)obj_session_manager.get_session_count());
+		}
+	};
+}
@@ -16,4 +16,9 @@ double test_util::generate_random_double_range(double d_start, double d_end) {
 	std::uniform_real_distribution<> distr(d_start, d_end);
 
 	return distr(gen);
+}
+
+Money test_util::generate_random_money_range(int i_start_cents, int i_end_cents) {
+	// Generate random amount of money (in whole cents) within provided range
+	return Money(generate_random_int_range(i_start_cents, i_end_cents));
 }
\ No newline at end of file
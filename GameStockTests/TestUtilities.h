@@ -1,8 +1,10 @@
 #pragma once
 #include <random>
+#include "Money.h"
 
 namespace test_util {
 	int generate_random_int_range(int i_start, int i_end);
 	double generate_random_double_range(double d_start, double d_end);
+	Money generate_random_money_range(int i_start_cents, int i_end_cents);
 }
 
@@ -3,6 +3,10 @@
 #include "DatabaseManager.h"
 #include "sqlite3.h"
 #include "TestUtilities.h"
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <sstream>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -61,21 +65,144 @@ namespace GameStockTests
 				});
 		}
 
+		TEST_METHOD(register_user_quoted_details) {
+			// Arrange
+			User user("Test O'Brien", i_random_age, "o'brien@test.com", "pass'word123", false);
+			User obj_login("", 0, "o'brien@test.com", "pass'word123", false);
+
+			// Act
+			obj_user_manager.register_user(user);
+			obj_user_manager.attempt_login(obj_login);
+
+			// Assert
+			Assert::AreEqual(std::string("Test O'Brien"), obj_login.get_full_name());
+		}
+
+		TEST_METHOD(import_users) {
+			// Arrange, the second password contains a comma
+			std::istringstream iss_users(
+				"name,age,email,password\n"
+				"Jane Doe,30,jane@doe.com,password123\n"
+				"\n"
+				"John Smith,45,john@smith.com,pass,word456\r\n");
+			User obj_login("", 0, "john@smith.com", "pass,word456", false);
+
+			// Act
+			UserImportResult obj_result = obj_user_manager.import_users(iss_users);
+			obj_user_manager.fetch_users();
+			obj_user_manager.attempt_login(obj_login);
+
+			// Assert
+			Assert::AreEqual(2, obj_result.i_imported);
+			Assert::AreEqual(0, (int)obj_result.vec_duplicates.size());
+			Assert::AreEqual(0, (int)obj_result.vec_invalid.size());
+			Assert::AreEqual(4, (int)obj_user_manager.get_vec_users().size());
+			Assert::AreEqual(std::string("John Smith"), obj_login.get_full_name());
+			Assert::AreEqual(45, obj_login.get_age());
+			Assert::IsFalse(obj_login.get_is_admin());
+		}
+
+		TEST_METHOD(import_users_duplicate_email) {
+			// Arrange, one email is already registered and another is listed twice
+			std::istringstream iss_users(
+				"Jane Doe,30,jane@doe.com,password123\n"
+				"Test User,25,email@email.com,password123\n"
+				"Jane Other,31,jane@doe.com,password456\n"
+				"John Smith,45,john@smith.com,password789\n");
+
+			// Act
+			UserImportResult obj_result = obj_user_manager.import_users(iss_users);
+			obj_user_manager.fetch_users();
+
+			// Assert, the rest of the import still went ahead
+			Assert::AreEqual(2, obj_result.i_imported);
+			Assert::AreEqual(2, (int)obj_result.vec_duplicates.size());
+			Assert::AreEqual(2, obj_result.vec_duplicates[0].i_line_number);
+			Assert::AreEqual(std::string("email@email.com"), obj_result.vec_duplicates[0].str_email);
+			Assert::AreEqual(3, obj_result.vec_duplicates[1].i_line_number);
+			Assert::AreEqual(4, (int)obj_user_manager.get_vec_users().size());
+		}
+
+		TEST_METHOD(import_users_invalid_lines) {
+			// Arrange
+			std::istringstream iss_users(
+				"jane doe,30,jane@doe.com,password123\n"
+				"Jane Doe,200,jane@doe.com,password123\n"
+				"Jane Doe,thirty,jane@doe.com,password123\n"
+				"Jane Doe,30,jane.doe.com,password123\n"
+				"Jane Doe,30,jane@doe.com,short\n"
+				"Jane Doe,30,jane@doe.com\n"
+				"Jane Doe,30,jane@doe.com,password123\n");
+
+			// Act
+			UserImportResult obj_result = obj_user_manager.import_users(iss_users);
+
+			// Assert
+			Assert::AreEqual(1, obj_result.i_imported);
+			Assert::AreEqual(6, (int)obj_result.vec_invalid.size());
+			for (int i = 0; i < 6; i++) {
+				Assert::AreEqual(i + 1, obj_result.vec_invalid[i].i_line_number);
+				Assert::IsFalse(obj_result.vec_invalid[i].str_reason.empty());
+			}
+		}
+
+		TEST_METHOD(import_users_invalid_batch_size) {
+			std::istringstream iss_users("Jane Doe,30,jane@doe.com,password123\n");
+
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_user_manager.import_users(iss_users, 0);
+				});
+		}
+
+		TEST_METHOD(import_users_missing_file) {
+			Assert::ExpectException<std::runtime_error>([&] {
+				obj_user_manager.import_users(std::filesystem::path("database\\missing_users.csv"));
+				});
+		}
+
+		TEST_METHOD(import_users_benchmark) {
+			// Arrange, 20000 users with every tenth email repeated
+			const int i_users = 20000;
+			std::string str_users;
+
+			for (int i = 0; i < i_users; i++) {
+				int i_email = i % 10 == 9 ? i - 1 : i;
+				str_users += "Imported User,30,user" + std::to_string(i_email) + "@import.com,password" + std::to_string(i) + "\n";
+			}
+
+			std::istringstream iss_users(str_users);
+
+			// Act
+			auto time_start = std::chrono::steady_clock::now();
+			UserImportResult obj_result = obj_user_manager.import_users(iss_users, 5000);
+			auto time_taken = std::chrono::steady_clock::now() - time_start;
+
+			std::string str_message = "import_users of " + std::to_string(i_users) + " lines: " + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(time_taken).count()) + "ms";
+			Logger::WriteMessage(str_message.c_str());
+
+			// Assert
+			obj_user_manager.fetch_users();
+			Assert::AreEqual(i_users - i_users / 10, obj_result.i_imported);
+			Assert::AreEqual(i_users / 10, (int)obj_result.vec_duplicates.size());
+			Assert::AreEqual(2 + obj_result.i_imported, (int)obj_user_manager.get_vec_users().size());
+		}
+
 		TEST_METHOD(attempt_login) {
 			// Arrange
 			User user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
 
 			// Act
 			obj_user_manager.register_user(user);
-			obj_user_manager.attempt_login(user);
+			std::shared_ptr<Session> ptr_session = obj_user_manager.attempt_login(user);
 
 			//Assert
-			Assert::AreEqual(3, obj_user_manager.get_current_user().get_id());
-			Assert::AreEqual(str_user_email, obj_user_manager.get_current_user().get_email());
-			Assert::AreEqual(str_user_full_name, obj_user_manager.get_current_user().get_full_name());
-			Assert::AreEqual(i_random_age, obj_user_manager.get_current_user().get_age());
-			Assert::AreEqual(str_user_password, obj_user_manager.get_current_user().get_password());
-			Assert::IsFalse(obj_user_manager.get_current_user().get_is_admin());
+			Assert::IsTrue(ptr_session->is_login_valid());
+			Assert::AreEqual(3, ptr_session->get_user().get_id());
+			Assert::AreEqual(str_user_email, ptr_session->get_user().get_email());
+			Assert::AreEqual(str_user_full_name, ptr_session->get_user().get_full_name());
+			Assert::AreEqual(i_random_age, ptr_session->get_user().get_age());
+			Assert::AreEqual(str_user_password, ptr_session->get_user().get_password());
+			Assert::IsFalse(ptr_session->get_user().get_is_admin());
 		}
 
 		TEST_METHOD(attempt_login_invalid) {
@@ -88,38 +215,223 @@ namespace GameStockTests
 				});
 		}
 
-		TEST_METHOD(logout) {
+		TEST_METHOD(attempt_login_quoted_details) {
+			// Arrange, details that would have matched every user if they were added into the SQL
+			User user(str_user_full_name, i_random_age, "' OR '1'='1", "' OR '1'='1", false);
+
+			// Act/Assert
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_user_manager.attempt_login(user);
+				});
+			Assert::AreEqual(0, (int)obj_user_manager.get_session_manager()->get_session_count());
+		}
+
+		TEST_METHOD(attempt_login_reuses_statement) {
 			// Arrange
 			User user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
+			User invalid_user(str_user_full_name, i_random_age, str_user_email, "invalidpassword", false);
+			obj_user_manager.register_user(user);
+
+			// Act, a failed login in between does not stop the next
+			std::shared_ptr<Session> ptr_first_session = obj_user_manager.attempt_login(user);
+			Assert::ExpectException<std::invalid_argument>([&] {
+				obj_user_manager.attempt_login(invalid_user);
+				});
+			std::shared_ptr<Session> ptr_second_session = obj_user_manager.attempt_login(user);
+
+			// Assert, each login is its own session
+			Assert::AreEqual(3, ptr_second_session->get_user().get_id());
+			Assert::AreNotEqual(ptr_first_session->get_id(), ptr_second_session->get_id());
+			Assert::AreEqual(2, (int)obj_user_manager.get_session_manager()->get_session_count());
+		}
+
+		TEST_METHOD(resume_session) {
+			// Arrange, a second manager without a database sharing the same sessions
+			User user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
+			obj_user_manager.register_user(user);
+			std::shared_ptr<Session> ptr_session = obj_user_manager.attempt_login(user);
+			UserManager obj_other_user_manager = UserManager(NULL);
+			obj_other_user_manager.set_session_manager(obj_user_manager.get_session_manager());
 
 			// Act
+			std::shared_ptr<Session> ptr_resumed_session = obj_other_user_manager.resume_session(ptr_session->get_id());
+
+			// Assert
+			Assert::AreEqual(32, (int)ptr_session->get_id().size());
+			Assert::IsNotNull(ptr_resumed_session.get());
+			Assert::IsTrue(ptr_resumed_session->is_login_valid());
+			Assert::AreEqual(3, ptr_resumed_session->get_user().get_id());
+			Assert::AreEqual(str_user_full_name, ptr_resumed_session->get_user().get_full_name());
+		}
+
+		TEST_METHOD(resume_session_after_logout) {
+			// Arrange
+			User user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
 			obj_user_manager.register_user(user);
-			obj_user_manager.attempt_login(user);
-			obj_user_manager.logout();
+			std::shared_ptr<Session> ptr_session = obj_user_manager.attempt_login(user);
+			std::string str_token = ptr_session->get_id();
 
-			//Assert
-			Assert::AreEqual(0, obj_user_manager.get_current_user().get_id());
-			Assert::IsFalse(obj_user_manager.is_login_valid());
+			// Act
+			obj_user_manager.logout(*ptr_session);
+
+			// Assert
+			Assert::IsNull(obj_user_manager.resume_session(str_token).get());
+			Assert::IsNull(obj_user_manager.resume_session("not a session").get());
+			Assert::IsFalse(ptr_session->is_login_valid());
 		}
 
-		TEST_METHOD(is_login_valid) {
+		TEST_METHOD(update_user_password_ends_sessions) {
 			// Arrange
 			User user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
+			obj_user_manager.register_user(user);
+			std::string str_token = obj_user_manager.attempt_login(user)->get_id();
 
 			// Act
+			user.set_password("changedpassword");
+			obj_user_manager.update_user_password(user);
+
+			// Assert, the old password has to be checked against the database again
+			Assert::IsNull(obj_user_manager.resume_session(str_token).get());
+			Assert::AreEqual(0, (int)obj_user_manager.get_session_manager()->get_session_count());
+		}
+
+		TEST_METHOD(attempt_login_concurrent_users) {
+			// Arrange, two users logging in at the same time through one manager, so both share its login statement
+			const int i_logins_per_thread = 500;
+			User first_user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
+			User second_user(str_user_full_name, i_random_age, "second@test.com", "otherpassword", false);
+			obj_user_manager.register_user(first_user);
+			obj_user_manager.register_user(second_user);
+			std::vector<User> vec_users = { first_user, second_user };
+			std::vector<int> vec_user_ids = { 3, 4 };
+			std::vector<int> vec_mismatches(vec_users.size(), 0);
+			std::vector<std::thread> vec_threads;
+
+			// Act
+			for (int thread = 0; thread < (int)vec_users.size(); thread++) {
+				vec_threads.push_back(std::thread([&, thread]() {
+					for (int i = 0; i < i_logins_per_thread; i++) {
+						User obj_login(vec_users[thread].get_full_name(), vec_users[thread].get_age(), vec_users[thread].get_email(), vec_users[thread].get_password(), false);
+
+						try {
+							std::shared_ptr<Session> ptr_session = obj_user_manager.attempt_login(obj_login);
+							if (ptr_session->get_user().get_id() != vec_user_ids[thread]) vec_mismatches[thread]++;
+							obj_user_manager.logout(*ptr_session);
+						}
+						catch (std::exception&) {
+							vec_mismatches[thread]++;
+						}
+					}
+					}));
+			}
+
+			for (std::thread& thread : vec_threads) {
+				thread.join();
+			}
+
+			// Assert, every login was given its own user
+			Assert::AreEqual(0, vec_mismatches[0]);
+			Assert::AreEqual(0, vec_mismatches[1]);
+		}
+
+		TEST_METHOD(attempt_login_concurrent_load) {
+			// Arrange, each thread logs in through its own connection, as separate customers would, sharing one session manager
+			const int i_thread_count = 8;
+			const int i_logins_per_thread = 500;
+			User user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
 			obj_user_manager.register_user(user);
-			obj_user_manager.attempt_login(user);
+			std::shared_ptr<SessionManager> ptr_session_manager = std::make_shared<SessionManager>();
+			std::vector<std::vector<long long>> vec_login_times(i_thread_count);
+			std::vector<std::vector<long long>> vec_resume_times(i_thread_count);
+			std::vector<int> vec_failures(i_thread_count, 0);
+			std::vector<std::thread> vec_threads;
+			std::string str_database_path = sqlite3_db_filename(obj_db_manager.get_database(), "main");
 
-			//Assert
-			Assert::IsTrue(obj_user_manager.is_login_valid());
+			// Act
+			for (int thread = 0; thread < i_thread_count; thread++) {
+				vec_threads.push_back(std::thread([&, thread]() {
+					sqlite3* db;
+					sqlite3_open_v2(str_database_path.c_str(), &db, SQLITE_OPEN_READONLY, NULL);
+					UserManager obj_thread_user_manager = UserManager(db);
+					obj_thread_user_manager.set_session_manager(ptr_session_manager);
+
+					std::shared_ptr<Session> ptr_session = std::make_shared<Session>();
+
+					for (int i = 0; i < i_logins_per_thread; i++) {
+						User obj_login(user.get_full_name(), user.get_age(), user.get_email(), user.get_password(), false);
+						auto time_start = std::chrono::steady_clock::now();
+
+						// Each login replaces the thread's previous session, as a customer logging out and back in would
+						try {
+							std::shared_ptr<Session> ptr_new_session = obj_thread_user_manager.attempt_login(obj_login);
+							obj_thread_user_manager.logout(*ptr_session);
+							ptr_session = ptr_new_session;
+						}
+						catch (std::exception&) {
+							vec_failures[thread]++;
+						}
+
+						auto time_logged_in = std::chrono::steady_clock::now();
+						if (!obj_thread_user_manager.resume_session(ptr_session->get_id())) vec_failures[thread]++;
+						auto time_resumed = std::chrono::steady_clock::now();
+
+						vec_login_times[thread].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(time_logged_in - time_start).count());
+						vec_resume_times[thread].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(time_resumed - time_logged_in).count());
+					}
+
+					obj_thread_user_manager = UserManager(NULL);
+					sqlite3_close(db);
+					}));
+			}
+
+			for (std::thread& thread : vec_threads) {
+				thread.join();
+			}
+
+			std::vector<long long> vec_all_login_times;
+			std::vector<long long> vec_all_resume_times;
+			for (int thread = 0; thread < i_thread_count; thread++) {
+				vec_all_login_times.insert(vec_all_login_times.end(), vec_login_times[thread].begin(), vec_login_times[thread].end());
+				vec_all_resume_times.insert(vec_all_resume_times.end(), vec_resume_times[thread].begin(), vec_resume_times[thread].end());
+			}
+
+			std::sort(vec_all_login_times.begin(), vec_all_login_times.end());
+			std::sort(vec_all_resume_times.begin(), vec_all_resume_times.end());
+			std::string str_message = std::to_string(vec_all_login_times.size()) + " logins across " + std::to_string(i_thread_count) + " threads, median " +
+				std::to_string(vec_all_login_times[vec_all_login_times.size() / 2] / 1000) + "us, 99th percentile " + std::to_string(vec_all_login_times[vec_all_login_times.size() * 99 / 100] / 1000) +
+				"us. Resumed sessions median " + std::to_string(vec_all_resume_times[vec_all_resume_times.size() / 2]) + "ns";
+			Logger::WriteMessage(str_message.c_str());
+
+			// Assert, every login succeeded and each thread only has its latest session left
+			for (int thread = 0; thread < i_thread_count; thread++) {
+				Assert::AreEqual(0, vec_failures[thread]);
+			}
+			Assert::AreEqual(i_thread_count, (int)ptr_session_manager->get_session_count());
 		}
 
-		TEST_METHOD(set_login_valid) {
+		TEST_METHOD(logout) {
+			// Arrange
+			User user(str_user_full_name, i_random_age, str_user_email, str_user_password, false);
+
 			// Act
-			obj_user_manager.set_login_valid(true);
+			obj_user_manager.register_user(user);
+			std::shared_ptr<Session> ptr_session = obj_user_manager.attempt_login(user);
+			obj_user_manager.logout(*ptr_session);
+
+			//Assert
+			Assert::IsFalse(ptr_session->is_login_valid());
+			Assert::AreEqual(0, (int)obj_user_manager.get_session_manager()->get_session_count());
+		}
+
+		TEST_METHOD(logout_logged_out_session) {
+			// Arrange
+			Session obj_session;
+
+			// Act, a session that was never logged in is not held anywhere, so there is nothing to end
+			obj_user_manager.logout(obj_session);
 
 			//Assert
-			Assert::IsTrue(obj_user_manager.is_login_valid());
+			Assert::IsFalse(obj_session.is_login_valid());
 		}
 
 		TEST_METHOD(fetch_users) {
@@ -246,6 +558,8 @@ namespace GameStockTests
 		}
 
 		TEST_METHOD_CLEANUP(cleanup_test) {
+			// Let go of the login statement first, otherwise the connection stays open and the database cannot be removed
+			obj_user_manager = UserManager(NULL);
 			sqlite3_close_v2(obj_db_manager.get_database());
 			if (std::filesystem::exists(L"database\\testDatabase.db")) {
 				std::filesystem::remove(L"database\\testDatabase.db");
@@ -0,0 +1,69 @@
+#include "CppUnitTest.h"
+#include "UserPurchaseSummary.h"
+#include "TestUtilities.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GameStockTests
+{
+	TEST_CLASS(UserPurchaseSummaryTests)
+	{
+	public:
+		int i_random_user_id = test_util::generate_random_int_range(1, 1000);
+		int i_random_count = test_util::generate_random_int_range(1, 60);
+		Money obj_random_total = test_util::generate_random_money_range(100, 100000);
+
+		UserPurchaseSummary obj_summary = UserPurchaseSummary(i_random_user_id, i_random_count, obj_random_total);
+
+		TEST_METHOD(default_constructor_test) {
+			UserPurchaseSummary summary;
+
+			Assert::AreEqual(0, summary.get_user_id());
+			Assert::AreEqual(0, summary.get_purchase_count());
+			Assert::AreEqual(0, summary.get_total_game_copies());
+			Assert::AreEqual((std::int64_t)0, summary.get_total().get_cents());
+			Assert::AreEqual((std::int64_t)0, summary.get_average().get_cents());
+		}
+
+		TEST_METHOD(constructor_test_1_param) {
+			UserPurchaseSummary summary(i_random_user_id);
+
+			Assert::AreEqual(i_random_user_id, summary.get_user_id());
+			Assert::AreEqual(0, summary.get_purchase_count());
+		}
+
+		TEST_METHOD(constructor_test_3_param) {
+			Assert::AreEqual(i_random_user_id, obj_summary.get_user_id());
+			Assert::AreEqual(i_random_count, obj_summary.get_purchase_count());
+			Assert::AreEqual(obj_random_total.get_cents(), obj_summary.get_total().get_cents());
+		}
+
+		TEST_METHOD(constructor_test_4_param) {
+			UserPurchaseSummary summary(i_random_user_id, i_random_count, obj_random_total, i_random_count * 2);
+
+			Assert::AreEqual(i_random_user_id, summary.get_user_id());
+			Assert::AreEqual(i_random_count, summary.get_purchase_count());
+			Assert::AreEqual(obj_random_total.get_cents(), summary.get_total().get_cents());
+			Assert::AreEqual(i_random_count * 2, summary.get_total_game_copies());
+		}
+
+		TEST_METHOD(get_average) {
+			Assert::AreEqual(obj_random_total.divide_by(i_random_count).get_cents(), obj_summary.get_average().get_cents());
+		}
+
+		TEST_METHOD(add_purchase) {
+			// Arrange
+			UserPurchaseSummary summary(i_random_user_id);
+
+			// Act
+			summary.add_purchase(Purchase(1, Money(1000), "Some date"));
+			summary.add_purchase(Purchase(2, Money(2001), "Some date"));
+
+			// Assert
+			Assert::AreEqual(2, summary.get_purchase_count());
+			Assert::AreEqual((std::int64_t)3001, summary.get_total().get_cents());
+			Assert::AreEqual((std::int64_t)1501, summary.get_average().get_cents());
+			Assert::AreEqual(2, (int)summary.get_vec_purchases().size());
+		}
+	};
+}